@@ -0,0 +1,152 @@
+// Version solving over a synthetic registry.
+//
+//   vix_cli_resolver_bench [packages] [versions] [seed]
+//
+// Every package has `versions` releases over two majors; each release
+// depends on a few later packages with caret ranges, and the newest major
+// of some packages asks for a major that is older than what others need,
+// so the solver has to backtrack. Prints the wall time, the solver
+// counters and how often the provider was asked; fails when a package or
+// a (package, version) is asked for twice, or when the solution does not
+// satisfy every range.
+#include <vix/cli/util/Pubgrub.hpp>
+#include <vix/cli/util/Semver.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace vix::cli::util::pubgrub;
+namespace semver = vix::cli::util::semver;
+
+namespace
+{
+  std::string name_of(int p) { return "bench/p" + std::to_string(p); }
+
+  std::string version_of(int v, int versions)
+  {
+    const int half = (versions + 1) / 2;
+    return std::to_string(1 + v / half) + "." + std::to_string(v % half) + ".0";
+  }
+
+  class SyntheticProvider : public Provider
+  {
+  public:
+    SyntheticProvider(int packages, int versions, unsigned seed)
+    {
+      std::mt19937 rng(seed);
+      for (int p = 0; p < packages; ++p)
+      {
+        for (int v = 0; v < versions; ++v)
+        {
+          std::vector<Requirement> deps;
+          const int count = static_cast<int>(rng() % 4);
+          for (int d = 0; d < count && p + 1 < packages; ++d)
+          {
+            const int span = std::min(packages - p - 1, 50);
+            const int q = p + 1 + static_cast<int>(rng() % static_cast<unsigned>(span));
+            const bool newest = v >= versions / 2;
+            const int major = newest && rng() % 5 == 0 ? 1 : (newest ? 2 : 1);
+            deps.push_back({name_of(q), "^" + std::to_string(major) + ".0.0"});
+          }
+          registry_[name_of(p)][version_of(v, versions)] = std::move(deps);
+        }
+      }
+    }
+
+    std::vector<std::string> versions(const std::string &package) override
+    {
+      if (!askedVersions_.insert(package).second)
+        fail("versions asked twice for " + package);
+
+      std::vector<std::string> out;
+      for (const auto &[v, deps] : registry_[package])
+        out.push_back(v);
+      return out;
+    }
+
+    std::vector<Requirement> dependencies(const std::string &package, const std::string &version) override
+    {
+      if (!askedDependencies_.insert(package + "@" + version).second)
+        fail("dependencies asked twice for " + package + "@" + version);
+      return registry_.at(package).at(version);
+    }
+
+    bool satisfied(const std::vector<Requirement> &roots, const std::map<std::string, std::string> &solution) const
+    {
+      auto holds = [&](const Requirement &r)
+      {
+        const auto it = solution.find(r.package);
+        return it != solution.end() && semver::satisfies(it->second, r.range);
+      };
+      for (const auto &r : roots)
+        if (!holds(r))
+          return false;
+      for (const auto &[package, version] : solution)
+        for (const auto &r : registry_.at(package).at(version))
+          if (!holds(r))
+            return false;
+      return true;
+    }
+
+    std::size_t askedVersions() const { return askedVersions_.size(); }
+    std::size_t askedDependencies() const { return askedDependencies_.size(); }
+
+  private:
+    [[noreturn]] static void fail(const std::string &message)
+    {
+      std::fprintf(stderr, "resolver bench: %s\n", message.c_str());
+      std::exit(1);
+    }
+
+    std::map<std::string, std::map<std::string, std::vector<Requirement>>> registry_;
+    std::set<std::string> askedVersions_;
+    std::set<std::string> askedDependencies_;
+  };
+}
+
+int main(int argc, char **argv)
+{
+  const int packages = argc > 1 ? std::atoi(argv[1]) : 5000;
+  const int versions = argc > 2 ? std::atoi(argv[2]) : 8;
+  const unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 1;
+
+  SyntheticProvider provider(packages, versions, seed);
+
+  std::vector<Requirement> roots;
+  for (int p = 0; p < packages; p += std::max(1, packages / 20))
+    roots.push_back({name_of(p), ""});
+
+  const auto start = std::chrono::steady_clock::now();
+  Stats stats;
+  std::map<std::string, std::string> solution;
+  bool solved = true;
+  try
+  {
+    solution = solve(roots, provider, &stats);
+  }
+  catch (const SolveFailure &)
+  {
+    solved = false;
+  }
+  const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  std::printf("packages=%d versions=%d seed=%u solved=%s selected=%zu\n",
+              packages, versions, seed, solved ? "yes" : "no", solution.size());
+  std::printf("time_ms=%.1f decisions=%zu conflicts=%zu incompatibilities=%zu\n",
+              ms, stats.decisions, stats.conflicts, stats.incompatibilities);
+  std::printf("provider_versions=%zu provider_dependencies=%zu\n",
+              provider.askedVersions(), provider.askedDependencies());
+
+  if (solved && !provider.satisfied(roots, solution))
+  {
+    std::fprintf(stderr, "resolver bench: solution violates a range\n");
+    return 1;
+  }
+  return 0;
+}
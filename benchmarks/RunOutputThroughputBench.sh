@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+# Throughput of the `vix run` runtime output filter, in MB/s.
+#
+# A direct-compiled script writes LOG_MB of log lines as fast as it can; the
+# same run is timed with the high-volume fast path disabled (before) and
+# enabled (after). Output goes to /dev/null so the terminal is not measured.
+set -euo pipefail
+VIX_BIN="${1:-/vixcpp/vix/modules/cli/build-ninja/vix}"
+LOG_MB="${LOG_MB:-256}"
+RUNS="${RUNS:-3}"
+ROOT="$(mktemp -d)"; trap 'rm -rf "$ROOT"' EXIT
+export HOME="$ROOT/home"; mkdir -p "$HOME"
+
+cat >"$ROOT/spam.cpp" <<CPP
+#include <cstdio>
+#include <cstring>
+int main() {
+  static const char line[] =
+      "[I] 2026-01-01T00:00:00Z GET /api/v1/items?page=42 status=200 bytes=5120 latency_us=183\n";
+  const long long total = ${LOG_MB}LL * 1024 * 1024;
+  for (long long written = 0; written < total; written += sizeof(line) - 1)
+    std::fwrite(line, 1, sizeof(line) - 1, stdout);
+  return 0;
+}
+CPP
+
+"$VIX_BIN" run "$ROOT/spam.cpp" --no-san >/dev/null 2>&1 || { echo "warm-up run failed" >&2; exit 1; }
+
+measure() {
+  local label="$1" fast="$2" best=""
+  for _ in $(seq 1 "$RUNS"); do
+    local start end ms
+    start=$(date +%s%N)
+    VIX_RUN_OUTPUT_FAST_PATH="$fast" "$VIX_BIN" run "$ROOT/spam.cpp" --no-san >/dev/null 2>&1
+    end=$(date +%s%N)
+    ms=$(( (end - start) / 1000000 ))
+    if [[ -z "$best" || "$ms" -lt "$best" ]]; then best="$ms"; fi
+  done
+  awk -v label="$label" -v mb="$LOG_MB" -v ms="$best" \
+    'BEGIN { printf "%-8s %6d MiB in %6d ms  %8.1f MB/s\n", label, mb, ms, mb / (ms / 1000.0) }'
+}
+
+measure before 0
+measure after 1
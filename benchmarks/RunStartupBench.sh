@@ -0,0 +1,66 @@
+#!/usr/bin/env bash
+# Cold and warm startup latency of `vix run <file.cpp>`.
+#
+# Each sample script is run once against an empty cache (cold) and then
+# WARM_RUNS times against the populated cache (warm). Latency is the
+# `time_to_exec_ms` reported by `--timings=json`: everything Vix does before
+# the program starts, so the scripts' own run time is not measured.
+#
+# The median warm latency of each script is compared with the baseline kept
+# in BASELINE (default: next to the vix binary). The benchmark fails when a
+# script is more than TOLERANCE slower than its baseline, or slower than
+# WARM_BUDGET_MS. Run with UPDATE_BASELINE=1 to record a new baseline.
+set -euo pipefail
+VIX_BIN="${1:-/vixcpp/vix/modules/cli/build-ninja/vix}"
+SCRIPTS_DIR="$(cd "$(dirname "$0")" && pwd)/scripts"
+WARM_RUNS="${WARM_RUNS:-7}"
+TOLERANCE="${TOLERANCE:-0.25}"
+WARM_BUDGET_MS="${WARM_BUDGET_MS:-250}"
+BASELINE="${BASELINE:-$(dirname "$VIX_BIN")/run-startup-baseline.txt}"
+UPDATE_BASELINE="${UPDATE_BASELINE:-0}"
+ROOT="$(mktemp -d)"; trap 'rm -rf "$ROOT"' EXIT
+export HOME="$ROOT/home"; mkdir -p "$HOME"
+
+time_to_exec() {
+  local script="$1" err="$ROOT/timings.err"
+  "$VIX_BIN" run "$script" --no-san --timings=json >/dev/null 2>"$err" || {
+    echo "vix run failed for $script" >&2
+    cat "$err" >&2
+    exit 1
+  }
+  grep -F '"vix_run_timings":1' "$err" | grep -oE '"time_to_exec_ms":[0-9.]+' | cut -d: -f2
+}
+
+median() { sort -n | awk '{ v[NR] = $1 } END { print (NR % 2) ? v[(NR + 1) / 2] : (v[NR / 2] + v[NR / 2 + 1]) / 2 }'; }
+
+baseline_for() {
+  [[ -f "$BASELINE" ]] && awk -v name="$1" '$1 == name { print $2 }' "$BASELINE" || true
+}
+
+status=0
+results=()
+printf '%-18s %10s %10s %10s  %s\n' script cold_ms warm_ms base_ms verdict
+for script in "$SCRIPTS_DIR"/*.cpp; do
+  name="$(basename "$script")"
+  cp "$script" "$ROOT/$name"
+  cold="$(time_to_exec "$ROOT/$name")"
+  warm="$(for _ in $(seq 1 "$WARM_RUNS"); do time_to_exec "$ROOT/$name"; done | median)"
+  base="$(baseline_for "$name")"
+  verdict=ok
+  if awk -v w="$warm" -v b="$WARM_BUDGET_MS" 'BEGIN { exit !(w > b) }'; then
+    verdict="over budget (${WARM_BUDGET_MS} ms)"
+  elif [[ -n "$base" && "$UPDATE_BASELINE" != "1" ]] &&
+       awk -v w="$warm" -v b="$base" -v t="$TOLERANCE" 'BEGIN { exit !(w > b * (1 + t)) }'; then
+    verdict="regressed (> +$(awk -v t="$TOLERANCE" 'BEGIN { print t * 100 }')%)"
+  fi
+  [[ "$verdict" == ok ]] || status=1
+  printf '%-18s %10.2f %10.2f %10s  %s\n' "$name" "$cold" "$warm" "${base:--}" "$verdict"
+  results+=("$name $warm")
+done
+
+if [[ "$UPDATE_BASELINE" == "1" || ! -f "$BASELINE" ]]; then
+  printf '%s\n' "${results[@]}" >"$BASELINE"
+  echo "baseline written to $BASELINE"
+fi
+
+exit "$status"
@@ -0,0 +1,196 @@
+// Ranked package search over a synthetic registry.
+//
+//   vix_cli_search_bench [packages] [queries] [seed] [budget_ms]
+//
+// Writes `packages` JSON entries with generated names, keywords and
+// descriptions (word frequencies skewed like natural text), compiles the
+// registry index and the search index, then times `queries` searches mixing
+// exact names, common and rare words, short prefixes, substrings, typos and
+// multi-word queries, each ranking one page of 20 hits as `vix search`
+// does. Prints build times and latency percentiles; fails
+// when the p99 latency exceeds `budget_ms` (default 5) or when a package
+// is not found by its own name.
+#include <vix/cli/registry/SearchIndex.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+using namespace vix::cli::registry;
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  double ms_since(Clock::time_point start)
+  {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+
+  std::vector<std::string> make_words(std::size_t count, std::mt19937 &rng)
+  {
+    static const char *const syllables[] = {"ar", "ba", "co", "de", "el", "fi", "go", "ha", "in", "jo", "ka", "lu",
+                                            "me", "no", "or", "pa", "qu", "ra", "si", "to", "ul", "ve", "wa", "xe",
+                                            "yo", "za", "json", "http", "sql", "net", "io", "log"};
+    std::vector<std::string> words;
+    while (words.size() < count)
+    {
+      std::string word;
+      const int parts = 2 + static_cast<int>(rng() % 3);
+      for (int i = 0; i < parts; ++i)
+        word += syllables[rng() % (sizeof syllables / sizeof *syllables)];
+      words.push_back(word);
+    }
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    std::shuffle(words.begin(), words.end(), rng);
+    return words;
+  }
+
+  // Zipf-like: low ranks are much more frequent.
+  const std::string &pick(const std::vector<std::string> &words, std::mt19937 &rng)
+  {
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    const double r = std::pow(u(rng), 3.0);
+    return words[static_cast<std::size_t>(r * static_cast<double>(words.size() - 1))];
+  }
+
+  std::string typo(std::string word, std::mt19937 &rng)
+  {
+    if (word.size() < 4)
+      return word;
+    const std::size_t i = 1 + rng() % (word.size() - 2);
+    std::swap(word[i], word[i + 1]);
+    return word;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const int packages = argc > 1 ? std::atoi(argv[1]) : 100000;
+  const int queries = argc > 2 ? std::atoi(argv[2]) : 2000;
+  const unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 1;
+  const double budgetMs = argc > 4 ? std::atof(argv[4]) : 5.0;
+
+  std::mt19937 rng(seed);
+  const auto words = make_words(20000, rng);
+
+  const fs::path root = fs::temp_directory_path() / ("vix-search-bench-" + std::to_string(::getpid()));
+  const fs::path repo = root / "registry" / "index";
+  fs::remove_all(root);
+  fs::create_directories(repo / "index");
+
+  std::vector<std::string> names;
+  auto start = Clock::now();
+  for (int p = 0; p < packages; ++p)
+  {
+    const std::string ns = "ns" + std::to_string(p % 997);
+    std::string name = pick(words, rng) + "-" + std::to_string(p);
+    names.push_back(ns + "/" + name);
+
+    std::string description;
+    const int length = 6 + static_cast<int>(rng() % 20);
+    for (int w = 0; w < length; ++w)
+      description += (w ? " " : "") + pick(words, rng);
+
+    std::ofstream(repo / "index" / (ns + "." + name + ".json"))
+        << R"({"namespace":")" << ns << R"(","name":")" << name << R"(","description":")" << description
+        << R"(","keywords":[")" << pick(words, rng) << R"(",")" << pick(words, rng)
+        << R"("],"versions":{"1.0.0":{"tag":"v1.0.0","commit":"0"}}})";
+  }
+  const double writeMs = ms_since(start);
+
+  start = Clock::now();
+  std::string error;
+  const auto index = open_registry_index(repo, &error);
+  const double compileMs = ms_since(start);
+  if (!index)
+  {
+    std::fprintf(stderr, "search bench: %s\n", error.c_str());
+    return 1;
+  }
+
+  start = Clock::now();
+  const auto built = open_search_index(repo, *index, &error);
+  const double buildMs = ms_since(start);
+  start = Clock::now();
+  const auto search = RegistrySearchIndex::open(search_index_path(repo));
+  const double openMs = ms_since(start);
+  if (!built || !search)
+  {
+    std::fprintf(stderr, "search bench: search index not built\n");
+    return 1;
+  }
+
+  std::vector<std::string> mix;
+  for (int q = 0; q < queries; ++q)
+  {
+    const std::string &word = pick(words, rng);
+    switch (q % 7)
+    {
+    case 0: mix.push_back(names[rng() % names.size()]); break;
+    case 1: mix.push_back(word); break;
+    case 2: mix.push_back(words[rng() % words.size()]); break;
+    case 3: mix.push_back(word.substr(0, 2)); break;
+    case 4: mix.push_back(word.substr(1, 4)); break;
+    case 5: mix.push_back(typo(words[rng() % words.size()], rng)); break;
+    default: mix.push_back(word + " " + pick(words, rng)); break;
+    }
+  }
+
+  std::vector<double> latencies;
+  std::size_t totalHits = 0;
+  int misses = 0;
+  for (int q = 0; q < queries; ++q)
+  {
+    start = Clock::now();
+    const auto hits = search->search(mix[static_cast<std::size_t>(q)], 20);
+    latencies.push_back(ms_since(start));
+    totalHits += hits.size();
+
+    if (q % 7 == 0)
+    {
+      const auto first = hits.empty() ? std::string() : [&]
+      {
+        const auto p = index->package(hits.front().package);
+        return std::string(p.namespaceName) + "/" + std::string(p.name);
+      }();
+      misses += first != mix[static_cast<std::size_t>(q)];
+    }
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p)
+  { return latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(p * static_cast<double>(latencies.size())))]; };
+
+  std::printf("packages=%d terms=%zu queries=%d seed=%u index_bytes=%ju search_bytes=%ju\n",
+              packages, search->terms(), queries, seed,
+              static_cast<std::uintmax_t>(fs::file_size(compiled_index_path(repo))),
+              static_cast<std::uintmax_t>(fs::file_size(search_index_path(repo))));
+  std::printf("write_ms=%.0f compile_ms=%.0f build_ms=%.0f open_ms=%.3f\n", writeMs, compileMs, buildMs, openMs);
+  std::printf("query_ms p50=%.3f p90=%.3f p99=%.3f max=%.3f avg_hits=%.0f\n",
+              percentile(0.50), percentile(0.90), percentile(0.99), latencies.back(),
+              static_cast<double>(totalHits) / queries);
+
+  fs::remove_all(root);
+
+  if (misses != 0)
+  {
+    std::fprintf(stderr, "search bench: %d exact names not ranked first\n", misses);
+    return 1;
+  }
+  if (percentile(0.99) > budgetMs)
+  {
+    std::fprintf(stderr, "search bench: p99 %.3f ms over the %.1f ms budget\n", percentile(0.99), budgetMs);
+    return 1;
+  }
+  return 0;
+}
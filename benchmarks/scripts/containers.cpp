@@ -0,0 +1,18 @@
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+int main()
+{
+  std::vector<std::string> words{"run", "build", "dev", "tests", "install"};
+  std::sort(words.begin(), words.end());
+
+  std::map<std::string, std::size_t> lengths;
+  for (const auto &w : words)
+    lengths[w] = w.size();
+
+  std::cout << lengths.size() << " commands\n";
+  return 0;
+}
@@ -0,0 +1,21 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main()
+{
+  std::atomic<int> total{0};
+  std::vector<std::thread> workers;
+
+  for (int i = 0; i < 4; ++i)
+    workers.emplace_back([&total, i]
+                         { total += i; });
+
+  for (auto &t : workers)
+    t.join();
+
+  std::cout << "total=" << total.load() << "\n";
+  return 0;
+}
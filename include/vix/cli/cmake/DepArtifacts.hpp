@@ -0,0 +1,189 @@
+/**
+ *
+ *  @file DepArtifacts.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Prebuilt registry dependency artifacts for project builds.
+ *
+ *  `vix install` builds each compiled registry dependency once per
+ *  (commit, compiler, build type, cmake options, target) and installs it
+ *  into a prefix of the global artifact cache:
+ *
+ *    ~/.vix/cache/build/<target>/<compiler>/<build-type>/<pkg>@<version>/<fingerprint>
+ *
+ *  The generated vix_deps.cmake then links the static libraries of that
+ *  prefix through imported targets; add_subdirectory on the dependency
+ *  sources is only the fallback.
+ *
+ */
+#ifndef VIX_CLI_CMAKE_DEPARTIFACTS_HPP
+#define VIX_CLI_CMAKE_DEPARTIFACTS_HPP
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace vix::cli::build
+{
+  namespace fs = std::filesystem;
+
+  /**
+   * @brief Everything a prebuilt dependency binary depends on.
+   */
+  struct DepArtifactKey
+  {
+    std::string id;        ///< Package id (ex: gk/json)
+    std::string version;   ///< Resolved version
+    std::string commit;    ///< Locked commit
+    std::string compiler;  ///< Compiler identity component
+    std::string target;    ///< Target triple
+    std::string buildType{"Release"};
+    std::vector<std::string> cmakeArgs; ///< -D arguments passed to the build
+  };
+
+  /**
+   * @brief State of one prefix of the artifact cache.
+   */
+  struct DepArtifact
+  {
+    std::string fingerprint;
+    fs::path prefix;
+
+    /// True once the prefix is installed and its manifest written.
+    bool ready = false;
+
+    /// True when a build of this exact key failed less than a day ago.
+    bool failed = false;
+
+    /// Static libraries, relative to the prefix.
+    std::vector<std::string> libs;
+
+    /// CMake package config names installed under the prefix.
+    std::vector<std::string> configPackages;
+  };
+
+  /**
+   * @brief Replace characters that are not safe in a cache path component.
+   */
+  std::string cache_component(std::string s);
+
+  /**
+   * @brief Target triple of the machine vix runs on.
+   */
+  std::string native_target_triple();
+
+  /**
+   * @brief Identity of the C++ compiler CMake will pick up ($CXX, else c++).
+   *
+   * Answered from ~/.vix/cache/compilers.json when the binary is unchanged.
+   * Empty when the compiler cannot be identified: nothing may then be
+   * cached for it.
+   */
+  std::string compiler_identity_component();
+
+  /**
+   * @brief Static libraries installed under prefix/lib and prefix/lib64,
+   * relative to the prefix.
+   */
+  std::vector<std::string> find_installed_static_libs(const fs::path &prefix);
+
+  /**
+   * @brief CMake package config names installed under a prefix.
+   */
+  std::vector<std::string> find_installed_config_packages(const fs::path &prefix);
+
+  /**
+   * @brief True when marker records a build that failed less than a day ago.
+   *
+   * Older failures are retried. The compiler is part of every key, so a new
+   * toolchain gets a fresh key and builds at once.
+   */
+  bool dep_build_failed_recently(const fs::path &marker);
+
+  /**
+   * @brief Exclusive advisory lock held while one process builds a key.
+   *
+   * Never acquired on Windows, where artifacts are not built.
+   */
+  class DepArtifactBuildLock
+  {
+  public:
+    explicit DepArtifactBuildLock(const fs::path &path);
+    ~DepArtifactBuildLock();
+
+    DepArtifactBuildLock(const DepArtifactBuildLock &) = delete;
+    DepArtifactBuildLock &operator=(const DepArtifactBuildLock &) = delete;
+
+    bool acquired() const { return fd_ >= 0; }
+
+  private:
+    int fd_{-1};
+  };
+
+  /**
+   * @brief Key for a dependency built on this machine with the default compiler.
+   */
+  DepArtifactKey make_dep_artifact_key(
+      const std::string &id,
+      const std::string &version,
+      const std::string &commit,
+      const std::string &buildType,
+      std::vector<std::string> cmakeArgs);
+
+  /**
+   * @brief Stable hash of every field of the key.
+   */
+  std::string dep_artifact_fingerprint(const DepArtifactKey &key);
+
+  /**
+   * @brief Prefix of the key below cacheRoot; nothing is created.
+   */
+  fs::path dep_artifact_prefix(const fs::path &cacheRoot, const DepArtifactKey &key);
+
+  /**
+   * @brief Look the key up in the cache. Only stats and reads the manifest.
+   */
+  DepArtifact describe_dep_artifact(const fs::path &cacheRoot, const DepArtifactKey &key);
+
+  /**
+   * @brief Make sure the artifact exists, building and installing it when needed.
+   *
+   * Builds of one key are serialized across processes with a file lock next
+   * to the prefix; a waiter reuses what the first build produced. A failed
+   * build is remembered and retried after a day. Returns the final state;
+   * error is set when the artifact is not ready.
+   */
+  DepArtifact ensure_dep_artifact(
+      const fs::path &cacheRoot,
+      const DepArtifactKey &key,
+      const fs::path &sourceDir,
+      std::string &error);
+
+  /**
+   * @brief Build types prebuilt by `vix install`: those of the dev and release presets.
+   */
+  std::vector<std::string> dep_artifact_build_types();
+
+  /**
+   * @brief Return false when variable is set to 0, false, off or no.
+   */
+  bool prebuilt_switch_enabled(const char *variable);
+
+  /**
+   * @brief Return true unless prebuilt dependencies are disabled.
+   *
+   * Set VIX_PREBUILT_DEPS=0 to always build dependencies from source, in
+   * projects and in scripts. Not available on Windows yet.
+   */
+  bool dep_artifacts_enabled();
+
+} // namespace vix::cli::build
+
+#endif
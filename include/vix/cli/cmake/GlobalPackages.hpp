@@ -58,6 +58,14 @@ namespace vix::cli::build
     fs::path installedPath;            ///< Installed source/package root path
   };
 
+  /**
+   * @brief Root of the compiled artifact cache: ~/.vix/cache/build
+   *
+   * Prefixes below it are laid out as
+   * <target>/<compiler>/<build-type>/<pkg>@<version>/<fingerprint>.
+   */
+  fs::path artifact_cache_root();
+
   /**
    * @brief Load globally installed packages from the global manifest
    *
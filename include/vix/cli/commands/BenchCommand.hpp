@@ -0,0 +1,34 @@
+/**
+ *
+ *  @file BenchCommand.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_BENCH_COMMAND_HPP
+#define VIX_BENCH_COMMAND_HPP
+
+#include <string>
+#include <vector>
+
+namespace vix::commands::BenchCommand
+{
+  /**
+   * @brief Run the `vix bench` command.
+   *
+   * Discovers benchmark executables, runs them pinned to one CPU, stores
+   * the results under .vix/bench/ and compares them with the baseline.
+   *
+   * @return 0, 1 when a benchmark failed or regressed, 2 when none exists.
+   */
+  int run(const std::vector<std::string> &args);
+
+  int help();
+}
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ *
+ *  @file BenchResults.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Benchmark results for `vix bench`.
+ *
+ *  Every run is stored as .vix/bench/<commit>.json; the saved baseline is
+ *  .vix/bench/baseline.json. Samples are seconds per iteration: one per
+ *  Google Benchmark repetition, or one per process run for executables
+ *  that are not Google Benchmark binaries.
+ */
+#ifndef VIX_BENCH_RESULTS_HPP
+#define VIX_BENCH_RESULTS_HPP
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace vix::commands::BenchCommand::detail
+{
+  namespace fs = std::filesystem;
+
+  struct BenchSeries
+  {
+    std::string name;
+    std::vector<double> samples; // seconds per iteration
+  };
+
+  struct BenchRun
+  {
+    std::string commit; // "<sha>", "<sha>-dirty" or "nogit"
+    std::string cpu;    // pinned CPU, empty when not pinned
+    std::vector<BenchSeries> series;
+
+    const BenchSeries *find(const std::string &name) const;
+  };
+
+  fs::path bench_dir(const fs::path &projectDir);
+  fs::path bench_run_path(const fs::path &projectDir, const std::string &commit);
+  fs::path bench_baseline_path(const fs::path &projectDir);
+
+  std::string bench_run_json(const BenchRun &run);
+  std::optional<BenchRun> parse_bench_run_json(const std::string &text);
+
+  /**
+   * @brief Per-repetition results of `--benchmark_format=json` output,
+   * named "<prefix>/<benchmark>".
+   *
+   * Aggregates (mean, median, stddev...) and errored benchmarks are left
+   * out; times are converted from their time_unit to seconds.
+   */
+  std::vector<BenchSeries> parse_google_benchmark_json(
+      const std::string &text,
+      const std::string &prefix);
+
+  enum class BenchVerdict
+  {
+    Unchanged,
+    Regressed,
+    Improved,
+    New
+  };
+
+  struct BenchComparison
+  {
+    std::string name;
+    double median{0.0};
+    double baselineMedian{0.0};
+    double change{0.0}; // median / baselineMedian - 1
+    double pValue{1.0};
+    BenchVerdict verdict{BenchVerdict::New};
+  };
+
+  struct BenchCompareOptions
+  {
+    double threshold{0.05}; // relative slowdown that counts as a regression
+    double alpha{0.05};     // significance level
+  };
+
+  /**
+   * @brief Compare every series of @p current with the same series of
+   * @p baseline.
+   *
+   * A series regresses when its median moved by more than the threshold
+   * and the Mann-Whitney U test finds the samples different at alpha; a
+   * large but insignificant move is noise.
+   */
+  std::vector<BenchComparison> compare_bench_runs(
+      const BenchRun &current,
+      const BenchRun *baseline,
+      const BenchCompareOptions &options);
+}
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ *
+ *  @file BenchStats.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Statistics for `vix bench` baseline comparisons.
+ *
+ *  Benchmark timings are skewed and carry outliers, so runs are compared
+ *  with the Mann-Whitney U test (ranks only, no normality assumption) and
+ *  summarized by their medians.
+ */
+#ifndef VIX_BENCH_STATS_HPP
+#define VIX_BENCH_STATS_HPP
+
+#include <vector>
+
+namespace vix::commands::BenchCommand::detail
+{
+  double median(std::vector<double> values);
+
+  struct MannWhitneyResult
+  {
+    double u{0.0}; // U statistic of the first sample
+    double pValue{1.0}; // two-sided
+    bool exact{false};
+  };
+
+  /**
+   * @brief Two-sided Mann-Whitney U test of @p a against @p b.
+   *
+   * Small samples without ties use the exact distribution of U; otherwise
+   * the normal approximation with tie and continuity corrections.
+   */
+  MannWhitneyResult mann_whitney_u(
+      const std::vector<double> &a,
+      const std::vector<double> &b);
+}
+
+#endif
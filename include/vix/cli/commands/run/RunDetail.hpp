@@ -28,6 +28,7 @@
 
 #include <vix/cli/ErrorHandler.hpp>
 #include <vix/cli/commands/replay/ReplayCapture.hpp>
+#include <vix/cli/commands/run/detail/RunTimings.hpp>
 
 #ifndef _WIN32
 #include <sys/wait.h>
@@ -127,10 +128,12 @@ namespace vix::commands::RunCommand::detail
     bool ui = false;
     bool envHint = false;
     bool traceCache = false;
+    TimingsFormat timings = TimingsFormat::Off; // --timings[=json]
     std::string compilerFingerprint = "fast";
 
     // Behavior switches
     bool watch = false;
+    bool hotReload = false; // --hot-reload, implies watch
     AutoDepsMode autoDeps = AutoDepsMode::None;
 
     bool forceServerLike = false;
@@ -154,6 +157,10 @@ namespace vix::commands::RunCommand::detail
     int timeoutSec = 0;
     std::string cwd;
 
+    // vix dev: listening sockets owned by the session and handed to each
+    // child generation ([host:]port, repeatable)
+    std::vector<std::string> listenAddresses;
+
     // Parse diagnostics / separators
     bool parseFailed = false;
     int parseExitCode = 0;
@@ -173,6 +180,7 @@ namespace vix::commands::RunCommand::detail
     bool localCache = false;
     bool devMode{false};
     bool replay = false;
+    int profileHz = 0; // --profile[=hz], 0 when not profiling
 
     std::vector<std::string> tempDeps;
     bool saveTempDeps = false;
@@ -793,6 +801,13 @@ namespace vix::commands::RunCommand::detail
    */
   int run_single_cpp(const Options &opt);
 
+  /**
+   * @brief Validate a script target and apply auto-deps before probing it.
+   *
+   * This is the common preparation shared by every single-file engine.
+   */
+  int prepare_single_cpp_options(Options &opt);
+
   /**
    * @brief Build a single C++ script and return the produced executable path.
    *
@@ -58,6 +58,26 @@ namespace vix::commands::RunCommand::detail
    */
   int run_single_cpp_direct(const Options &opt, const DirectScriptPlan &plan);
 
+  /**
+   * @brief Build the compile command producing a loadable shared object.
+   *
+   * Uses the same flags as the direct executable build, plus -shared -fPIC.
+   * The static Vix runtime is never linked in: scripts using it are not
+   * hot reloaded.
+   */
+  std::string make_direct_shared_object_compile_cmd(
+      const Options &opt,
+      const DirectScriptPlan &plan,
+      const fs::path &output);
+
+  /**
+   * @brief Fingerprint of the toolchain, flags and dependencies of a plan.
+   *
+   * The script contents are excluded: two plans with the same ABI fingerprint
+   * produce shared objects that can replace each other in a running host.
+   */
+  std::string make_direct_abi_fingerprint(const DirectScriptPlan &plan);
+
 } // namespace vix::commands::RunCommand::detail
 
 #endif
@@ -0,0 +1,151 @@
+/**
+ *
+ *  @file OutputFastPath.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira. All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by an MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Building blocks of the high-volume path of the runtime output filter.
+ *
+ *  `run_cmd_live_filtered_capture` normally pushes every PTY chunk through
+ *  line-based filters. When a program logs tens of megabytes per second, the
+ *  filter switches to a path that only scans complete lines for the few
+ *  markers those filters react to, and forwards trigger-free lines as-is.
+ *
+ */
+#ifndef VIX_CLI_OUTPUT_FAST_PATH_HPP
+#define VIX_CLI_OUTPUT_FAST_PATH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vix::commands::RunCommand::detail
+{
+  /**
+   * @brief Find needle in hay, 16 bytes at a time when SSE2 is available.
+   *
+   * With foldCase, ASCII letters compare case-insensitively.
+   *
+   * @return Offset of the first match, or std::string_view::npos.
+   */
+  std::size_t find_output_marker(
+      std::string_view hay,
+      std::string_view needle,
+      bool foldCase = false) noexcept;
+
+  /**
+   * @brief Return true when text reports that a listening port is taken.
+   */
+  bool output_reports_port_in_use(std::string_view text) noexcept;
+
+  /**
+   * @brief Return true when text contains a marker handled by the line filters.
+   *
+   * Covers sanitizer reports, uncaught exception and allocator crash noise,
+   * Vix error/tip lines and build tool interruption lines. Markers never span
+   * a newline, so scanning complete lines is exact.
+   */
+  bool output_has_filter_trigger(std::string_view text) noexcept;
+
+  /**
+   * @brief Return true when chunk starts with a build progress counter.
+   *
+   * Matches `[12/40]`-style prefixes (digits and slashes between the
+   * brackets), which the runtime filter drops. Log prefixes such as `[info]`
+   * or `[2026-01-02 ...]` do not match.
+   */
+  bool output_is_build_progress(std::string_view chunk) noexcept;
+
+  /**
+   * @brief Return true when text contains a line made only of blanks.
+   *
+   * The runtime filter drops those lines, so they also leave the fast path.
+   */
+  bool output_has_blank_line(std::string_view text) noexcept;
+
+  /**
+   * @brief Hysteresis detector for sustained high-volume output.
+   */
+  class OutputRateMeter
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Enter the fast path at 8 MiB/s, leave it below 2 MiB/s.
+    static constexpr double DEFAULT_ENTER_BYTES_PER_SEC = 8.0 * 1024 * 1024;
+    static constexpr double DEFAULT_LEAVE_BYTES_PER_SEC = 2.0 * 1024 * 1024;
+
+    explicit OutputRateMeter(
+        double enterBytesPerSec = DEFAULT_ENTER_BYTES_PER_SEC,
+        double leaveBytesPerSec = DEFAULT_LEAVE_BYTES_PER_SEC,
+        std::chrono::milliseconds window = std::chrono::milliseconds(200));
+
+    /**
+     * @brief Account bytes read at now and return whether output is hot.
+     */
+    bool observe(std::size_t bytes, Clock::time_point now) noexcept;
+
+    bool hot() const noexcept { return hot_; }
+
+  private:
+    double enter_;
+    double leave_;
+    std::chrono::milliseconds window_;
+
+    bool started_ = false;
+    bool hot_ = false;
+    std::size_t windowBytes_ = 0;
+    Clock::time_point windowStart_{};
+  };
+
+  /**
+   * @brief Capture buffer keeping the head and a ring of the tail of a stream.
+   *
+   * Crash and failure detectors look at the first lines (startup errors) and
+   * at the last ones (sanitizer reports, uncaught exceptions). Everything in
+   * between is counted but dropped once the limit is reached.
+   */
+  class BoundedOutputCapture
+  {
+  public:
+    static constexpr std::size_t DEFAULT_HEAD_BYTES = 1024 * 1024;
+    static constexpr std::size_t DEFAULT_TAIL_BYTES = 15 * 1024 * 1024;
+
+    explicit BoundedOutputCapture(
+        std::size_t headBytes = DEFAULT_HEAD_BYTES,
+        std::size_t tailBytes = DEFAULT_TAIL_BYTES);
+
+    void append(std::string_view data);
+
+    /**
+     * @brief Return the captured text, with an omission line when truncated.
+     */
+    std::string str() const;
+
+    std::uint64_t total_bytes() const noexcept { return total_; }
+    std::uint64_t dropped_bytes() const noexcept;
+
+  private:
+    std::size_t headLimit_;
+    std::size_t tailLimit_;
+
+    std::string head_;
+    std::vector<char> ring_;
+    std::size_t ringStart_ = 0;
+    std::size_t ringSize_ = 0;
+
+    std::uint64_t total_ = 0;
+  };
+
+} // namespace vix::commands::RunCommand::detail
+
+#endif
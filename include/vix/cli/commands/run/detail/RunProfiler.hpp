@@ -0,0 +1,190 @@
+/**
+ *
+ *  @file RunProfiler.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira. All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by an MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Sampling profiler behind `vix run --profile[=hz]`.
+ *
+ *  The program is sampled from the outside with perf_event_open: one
+ *  software cpu-clock event per CPU, following the child and everything it
+ *  forks, recording user-space callchains walked through frame pointers.
+ *  Addresses are kept as (module, file offset) while the run is live and
+ *  symbolized from the ELF symbol tables once it is over. The result is
+ *  written to .vix/profiles/ as a collapsed-stack file and an SVG
+ *  flamegraph that needs nothing else to be viewed.
+ *
+ */
+#ifndef VIX_CLI_RUN_PROFILER_HPP
+#define VIX_CLI_RUN_PROFILER_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace vix::commands::RunCommand::detail
+{
+  namespace fs = std::filesystem;
+
+  constexpr int DEFAULT_PROFILE_HZ = 999;
+  constexpr int MAX_PROFILE_HZ = 100000;
+
+  /// Compiler flags that keep stacks walkable and symbols resolvable.
+  std::vector<std::string> profile_compile_flags();
+
+  /// "root;caller;leaf" -> number of samples.
+  using FoldedStacks = std::map<std::string, std::uint64_t>;
+
+  /**
+   * @brief Collapsed-stack text, one "frame;frame;frame count" per line.
+   *
+   * This is the input format of flamegraph.pl, speedscope and inferno.
+   */
+  std::string render_folded_stacks(const FoldedStacks &stacks);
+
+  /**
+   * @brief Self-contained SVG flamegraph of @p stacks.
+   *
+   * Frames carry a <title> tooltip with their sample count; no script or
+   * external resource is referenced.
+   */
+  std::string render_flamegraph_svg(const FoldedStacks &stacks, const std::string &title);
+
+  struct ProcMapping
+  {
+    std::uint64_t start = 0;
+    std::uint64_t end = 0;
+    std::uint64_t offset = 0; // file offset of start
+    std::string path;
+  };
+
+  /**
+   * @brief Executable, file-backed mappings of a /proc/<pid>/maps listing.
+   */
+  std::vector<ProcMapping> parse_proc_maps(const std::string &text);
+
+  /**
+   * @brief Function symbols of one ELF64 image, looked up by file offset.
+   */
+  class ElfSymbolTable
+  {
+  public:
+    bool load(const fs::path &path);
+
+    /**
+     * @brief Demangled name of the function covering @p fileOffset.
+     */
+    std::optional<std::string> lookup(std::uint64_t fileOffset) const;
+
+    std::size_t size() const noexcept { return symbols_.size(); }
+
+  private:
+    struct Segment
+    {
+      std::uint64_t offset = 0;
+      std::uint64_t vaddr = 0;
+      std::uint64_t size = 0;
+    };
+
+    struct Symbol
+    {
+      std::uint64_t addr = 0;
+      std::uint64_t size = 0;
+      std::string name;
+    };
+
+    std::vector<Segment> segments_;
+    std::vector<Symbol> symbols_;
+  };
+
+  /// Directory holding the profiles of @p baseDir.
+  fs::path profiles_dir(const fs::path &baseDir);
+
+  /**
+   * @brief Process-wide profiler for `vix run --profile`.
+   *
+   * Like RunTimings, it does nothing until enable() is called. A
+   * ProfileScope arms it around the one command that runs the user
+   * program; run_cmd_live_filtered_capture() then attaches to the child it
+   * spawns and detaches once the child has been reaped, so build steps are
+   * never sampled.
+   */
+  class RunProfiler
+  {
+  public:
+    static RunProfiler &instance();
+
+    ~RunProfiler();
+
+    void enable(int hz);
+    bool enabled() const noexcept { return hz_ > 0; }
+    int hz() const noexcept { return hz_; }
+
+    bool armed() const noexcept { return armed_; }
+
+    /**
+     * @brief Start sampling @p pid and its descendants.
+     *
+     * Returns false, with last_error() set, when the kernel refuses the
+     * events.
+     */
+    bool attach(int pid);
+
+    /// Stop sampling and collect what is still buffered.
+    void detach();
+
+    const std::string &last_error() const noexcept { return error_; }
+    std::uint64_t samples() const noexcept;
+    std::uint64_t lost() const noexcept;
+
+    /// Symbolized stacks of the last attachment.
+    FoldedStacks folded() const;
+
+  private:
+    friend class ProfileScope;
+
+    RunProfiler();
+
+    struct Session;
+
+    int hz_ = 0;
+    bool armed_ = false;
+    std::string error_;
+    std::unique_ptr<Session> session_;
+  };
+
+  /**
+   * @brief Profile the program run inside this scope.
+   *
+   * finish() (or the destructor) writes <label>-<time>.folded and .svg to
+   * .vix/profiles/ and prints where they are.
+   */
+  class ProfileScope
+  {
+  public:
+    explicit ProfileScope(std::string label);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+    void finish();
+
+  private:
+    std::string label_;
+    bool active_ = false;
+  };
+
+} // namespace vix::commands::RunCommand::detail
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ *
+ *  @file RunTimings.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira. All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by an MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Startup stage timings reported by `vix run --timings[=json]`.
+ *
+ *  Every stage is stored with its start offset and duration, both measured on
+ *  the steady clock from the moment the CLI process started. Stages may nest
+ *  (dependency discovery runs inside fingerprinting); the depth is kept so the
+ *  text report can indent them.
+ *
+ */
+#ifndef VIX_CLI_RUN_TIMINGS_HPP
+#define VIX_CLI_RUN_TIMINGS_HPP
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace vix::commands::RunCommand::detail
+{
+  enum class TimingsFormat
+  {
+    Off,
+    Text,
+    Json
+  };
+
+  /**
+   * @brief Parse the value of --timings=<value>.
+   *
+   * Accepts "text" and "json". Returns false for anything else.
+   */
+  bool parse_timings_format(const std::string &value, TimingsFormat &out);
+
+  struct TimingStage
+  {
+    std::string name;
+    double startMs = 0.0;
+    double durationMs = 0.0;
+    int depth = 0;
+  };
+
+  /**
+   * @brief Process-wide recorder for `vix run` stage timings.
+   *
+   * Recording is a no-op until enable() is called, so instrumented code paths
+   * cost one branch when --timings is not given.
+   */
+  class RunTimings
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static RunTimings &instance();
+
+    /// Steady-clock time at which the CLI process started.
+    static Clock::time_point origin() noexcept;
+
+    void enable(TimingsFormat format, std::string target);
+    bool enabled() const noexcept { return format_ != TimingsFormat::Off; }
+    TimingsFormat format() const noexcept { return format_; }
+
+    void record(const std::string &name, Clock::time_point start, Clock::time_point end);
+
+    const std::vector<TimingStage> &stages() const noexcept { return stages_; }
+
+    /**
+     * @brief Offset of the first "exec" stage, or a negative value.
+     *
+     * This is the warm-start latency: everything Vix did before the user
+     * program started.
+     */
+    double time_to_exec_ms() const noexcept;
+
+    std::string render_text(double totalMs) const;
+    std::string render_json(double totalMs, int exitCode) const;
+
+    /**
+     * @brief Write the report for the finished run to out.
+     */
+    void report(std::ostream &out, int exitCode) const;
+
+  private:
+    friend class TimingScope;
+
+    TimingsFormat format_ = TimingsFormat::Off;
+    std::string target_;
+    std::vector<TimingStage> stages_;
+    int depth_ = 0;
+  };
+
+  /**
+   * @brief Record the lifetime of a scope as one stage.
+   *
+   * Call stop() to end the stage before the scope does.
+   */
+  class TimingScope
+  {
+  public:
+    explicit TimingScope(const char *name);
+    ~TimingScope();
+
+    TimingScope(const TimingScope &) = delete;
+    TimingScope &operator=(const TimingScope &) = delete;
+
+    void stop();
+
+  private:
+    const char *name_;
+    RunTimings::Clock::time_point start_{};
+    bool active_ = false;
+  };
+
+} // namespace vix::commands::RunCommand::detail
+
+#endif
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include <vix/cli/commands/run/RunDetail.hpp>
+#include <vix/cli/commands/run/detail/ScriptDepArtifacts.hpp>
 
 namespace vix::commands::RunCommand::detail
 {
@@ -32,6 +33,26 @@ namespace vix::commands::RunCommand::detail
    */
   fs::path get_scripts_root(bool localCache);
 
+  /**
+   * @brief Outcome of preparing one shared dependency artifact.
+   */
+  struct ScriptDepArtifactReport
+  {
+    std::string pkgDir;
+    ScriptDepArtifactStatus status = ScriptDepArtifactStatus::Unavailable;
+    std::string error;
+  };
+
+  /**
+   * @brief Build missing shared artifacts for the script's CMake dependencies.
+   *
+   * Must run before make_script_cmakelists() so the generated project can
+   * consume the installed prefixes instead of dependency sources.
+   */
+  std::vector<ScriptDepArtifactReport> prepare_script_dependency_artifacts(
+      const fs::path &cppPath,
+      const std::vector<std::string> &scriptFlags);
+
   /**
    * @brief Generate the CMakeLists.txt content for the fallback script engine.
    *
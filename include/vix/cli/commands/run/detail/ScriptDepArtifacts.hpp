@@ -0,0 +1,112 @@
+/**
+ *
+ *  @file ScriptDepArtifacts.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira. All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by an MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Shared prebuilt dependency artifacts for the script CMake fallback.
+ *
+ *  Registry dependencies used by generated script projects are built once per
+ *  (package, commit, compiler, flags, build type) and installed into a prefix
+ *  of the global artifact cache:
+ *
+ *    ~/.vix/cache/build/<target>/<compiler>/<build-type>/<pkg>@<commit>/<fingerprint>
+ *
+ *  Every script project then consumes that prefix through find_package or an
+ *  imported target instead of add_subdirectory'ing the dependency sources.
+ *
+ */
+#ifndef VIX_CLI_SCRIPT_DEP_ARTIFACTS_HPP
+#define VIX_CLI_SCRIPT_DEP_ARTIFACTS_HPP
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace vix::commands::RunCommand::detail
+{
+  namespace fs = std::filesystem;
+
+  /**
+   * @brief Inputs identifying one dependency build for the script fallback.
+   */
+  struct ScriptDepArtifactRequest
+  {
+    std::string pkgDir;  ///< Normalized package directory (ex: gk.json)
+    std::string commit;  ///< Locked commit, empty when unknown
+    fs::path sourceDir;  ///< Dependency source root containing CMakeLists.txt
+    std::string buildType{"Debug"};
+    std::string cxxStandard{"20"};
+    std::vector<std::string> cmakeArgs; ///< Extra ABI-relevant -D arguments
+  };
+
+  /**
+   * @brief Resolved location and consumption metadata of a dependency artifact.
+   */
+  struct ScriptDepArtifact
+  {
+    std::string pkgDir;
+    std::string fingerprint;
+    fs::path prefix;
+    fs::path lockPath;
+
+    /// False when the dependency cannot be shared (no commit, unsupported platform).
+    bool eligible = false;
+
+    /// True when the prefix has been fully installed and can be consumed.
+    bool ready = false;
+
+    /// True when a build of this exact key failed less than a day ago.
+    bool failed = false;
+
+    /// CMake package config names found under the installed prefix.
+    std::vector<std::string> configPackages;
+  };
+
+  enum class ScriptDepArtifactStatus
+  {
+    Reused,
+    Built,
+    Unavailable,
+    Failed
+  };
+
+  /**
+   * @brief Compute the artifact location for a dependency without building it.
+   *
+   * This is a pure lookup used by the CMakeLists generator: it only stats the
+   * cache, so it is safe to call on every `vix run`.
+   */
+  ScriptDepArtifact describe_script_dep_artifact(const ScriptDepArtifactRequest &request);
+
+  /**
+   * @brief Make sure the artifact exists, building and installing it when needed.
+   *
+   * Concurrent builds of the same key are serialized with a file lock placed
+   * next to the prefix. The second process waits for the lock, then reuses the
+   * prefix produced by the first one. Ninja is used when it is installed,
+   * CMake's default generator otherwise. A failed build is not retried for a
+   * day, unless the compiler changes; a missing build tool does not count.
+   */
+  ScriptDepArtifactStatus ensure_script_dep_artifact(
+      const ScriptDepArtifactRequest &request,
+      ScriptDepArtifact &artifact,
+      std::string &error);
+
+  /**
+   * @brief Return true unless shared dependency artifacts are disabled.
+   *
+   * Set VIX_SCRIPT_PREBUILT_DEPS=0 to restore the per-script add_subdirectory
+   * behavior.
+   */
+  bool script_dep_artifacts_enabled();
+
+} // namespace vix::commands::RunCommand::detail
+
+#endif
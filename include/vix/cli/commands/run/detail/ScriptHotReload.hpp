@@ -0,0 +1,83 @@
+/**
+ *
+ *  @file ScriptHotReload.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira. All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by an MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Hot code reload for `vix run <file.cpp> --hot-reload`.
+ *
+ *  The script is compiled as a shared object and loaded by a host process.
+ *  When a watched input changes, the next generation is compiled while the
+ *  current one keeps serving, then swapped in place between two steps. The
+ *  script opts in by exporting a single C hook:
+ *
+ *    struct vix_reload_context
+ *    {
+ *      int version;     // VIX_RELOAD_ABI_VERSION
+ *      int generation;  // 1 for the first load
+ *      int argc;
+ *      char **argv;
+ *      void *state;     // owned by the script, kept across generations
+ *      int exit_code;   // read by the host when step returns non-zero
+ *    };
+ *
+ *    extern "C" int vix_reload(vix_reload_context *ctx, int op);
+ *
+ *  op is 0 (load), 1 (step) or 2 (unload). load and unload return 0 on
+ *  success. step must return regularly: 0 keeps the program running, any
+ *  other value ends it with ctx->exit_code.
+ *
+ *  Lifetime of ctx->state: the host keeps the pointer across generations
+ *  but never frees or reads it. The old generation is unloaded (op 2), the
+ *  new one loaded (op 0), and only then is the old library dlclose()d, so
+ *  state may point into memory allocated with new or malloc, but never into
+ *  the old library's statics, string literals or functions: they disappear
+ *  with it. No vtable or function pointer coming from the old code may be
+ *  kept either; rebuild such objects in load. Unload also runs when the
+ *  program ends, so state that must be released at exit is best released
+ *  by the step that returns non-zero.
+ *
+ *  Scripts using the Vix runtime are restarted instead: the runtime is a
+ *  static library whose globals cannot be duplicated per generation.
+ *
+ *  A script may also export `extern "C" const char *vix_reload_abi()`. When
+ *  the returned string differs between two generations, the host is
+ *  restarted instead of swapping the code. Toolchain, flag or dependency
+ *  changes always restart.
+ *
+ */
+#ifndef VIX_CLI_SCRIPT_HOT_RELOAD_HPP
+#define VIX_CLI_SCRIPT_HOT_RELOAD_HPP
+
+#include <vix/cli/commands/run/RunDetail.hpp>
+
+namespace vix::commands::RunCommand::detail
+{
+  /// Version of the vix_reload_context layout passed to scripts.
+  inline constexpr int VIX_RELOAD_ABI_VERSION = 1;
+
+  enum class ReloadOp : int
+  {
+    Load = 0,
+    Step = 1,
+    Unload = 2
+  };
+
+  /**
+   * @brief Execute a single C++ file with hot code reload.
+   *
+   * Falls back to run_single_cpp_watch() when the script cannot be loaded as
+   * a shared object: generated CMake fallback, Vix runtime, sanitizers, no
+   * vix_reload hook, or an unsupported platform.
+   */
+  int run_single_cpp_hot_reload(const Options &opt);
+
+} // namespace vix::commands::RunCommand::detail
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ *
+ *  @file DevBuildSession.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2026, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Dev mode in-process build session
+ *
+ *  Keeps the build graph written by `vix build` loaded for the whole dev
+ *  session and rebuilds only the tasks affected by the changed paths,
+ *  without starting a new `vix build` process per save.
+ *
+ *  A rebuild may start on the first change event. Edits that arrive while
+ *  it runs cancel only the tasks reading the edited files: their compiler
+ *  is killed and they stay dirty for the follow-up rebuild.
+ *
+ */
+
+#ifndef VIX_CLI_COMMANDS_RUN_DEV_DEV_BUILD_SESSION_HPP
+#define VIX_CLI_COMMANDS_RUN_DEV_DEV_BUILD_SESSION_HPP
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <vix/cli/build/BuildGraph.hpp>
+#include <vix/cli/build/BuildTaskProcessExecutor.hpp>
+
+namespace vix::commands::RunCommand::dev
+{
+  namespace fs = std::filesystem;
+
+  struct DevBuildSessionOptions
+  {
+    fs::path projectDir;
+    fs::path buildDir;
+    std::string target{"all"};
+    int jobs{0};
+    bool verbose{false};
+  };
+
+  enum class DevBuildSessionStatus
+  {
+    Built,       // affected tasks were rebuilt in-process
+    UpToDate,    // the changes did not touch the graph
+    Unavailable, // needs a full `vix build` (no graph, new files, ...)
+    Failed,
+    Superseded   // tasks were cancelled by newer edits; rebuild again
+  };
+
+  struct DevBuildSessionResult
+  {
+    DevBuildSessionStatus status{DevBuildSessionStatus::Unavailable};
+    int exitCode{0};
+    std::size_t rebuiltTasks{0};
+    std::string output;
+  };
+
+  class DevBuildSession
+  {
+  public:
+    explicit DevBuildSession(DevBuildSessionOptions options);
+
+    /**
+     * @brief Rebuild what the changed paths affect.
+     *
+     * Paths come from DevFileIndex, which already compared content hashes,
+     * so nothing is hashed again here. Unavailable means the caller must
+     * run a full build and then call reload().
+     */
+    DevBuildSessionResult rebuild(const std::vector<fs::path> &changedPaths);
+
+    /**
+     * @brief Drop the in-memory graph and read the one on disk.
+     */
+    bool reload();
+
+    bool loaded() const;
+
+    /**
+     * @brief Cancel running or queued tasks that read any of these paths.
+     *
+     * Thread-safe; called while rebuild() runs on another thread.
+     */
+    void cancel_tasks_reading(const std::vector<fs::path> &paths);
+
+    /**
+     * @brief Cancel every task of the running rebuild.
+     */
+    void cancel_all();
+
+  private:
+    DevBuildSessionOptions options_;
+    std::optional<vix::cli::build::BuildGraph> graph_{};
+
+    // State of the rebuild in flight, guarded by mutex_.
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<std::string>> taskInputs_;
+    std::unordered_map<std::string, int> runningPids_;
+    std::unordered_set<std::string> cancelledTasks_;
+    bool cancelAll_{false};
+
+    vix::cli::build::BuildTaskResult execute_task(vix::cli::build::BuildTask &task);
+  };
+
+} // namespace vix::commands::RunCommand::dev
+
+#endif // VIX_CLI_COMMANDS_RUN_DEV_DEV_BUILD_SESSION_HPP
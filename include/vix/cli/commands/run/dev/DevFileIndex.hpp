@@ -12,15 +12,22 @@
  *
  *  Dev mode file index
  *
+ *  The index is seeded by one full scan. After that it follows the kernel
+ *  watcher (vix::engine::watch, as used by `vix build --watch`) and only
+ *  stats and hashes the files named in events. A full rescan happens only
+ *  when the watcher cannot start or its event queue overflows.
+ *
  */
 
 #ifndef VIX_CLI_COMMANDS_RUN_DEV_DEV_FILE_INDEX_HPP
 #define VIX_CLI_COMMANDS_RUN_DEV_DEV_FILE_INDEX_HPP
 
 #include <vix/cli/commands/run/dev/DevChangeClassifier.hpp>
+#include <vix/engine/Watch.hpp>
 
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -44,6 +51,10 @@ namespace vix::commands::RunCommand::dev
     fs::path path{};
     DevChangeKind kind{DevChangeKind::Ignore};
 
+    // Modification time of the file when the change was seen; used to report
+    // save-to-rebuild latency.
+    fs::file_time_type savedAt{};
+
     bool valid() const;
   };
 
@@ -58,20 +69,43 @@ namespace vix::commands::RunCommand::dev
 
     void reset(fs::path projectDir);
 
+    /**
+     * @brief Rescan the project and (re)start the watcher.
+     */
     void refresh();
 
+    /**
+     * @brief Return changes since the last call, without blocking.
+     */
     std::vector<DevIndexedChange> poll_changes();
 
     bool empty() const;
 
+    /// True when changes come from watcher events rather than rescans.
+    bool event_driven() const;
+
+    std::string watch_backend() const;
+
   private:
     fs::path projectDir_{};
     DevChangeClassifier classifier_{};
     std::unordered_map<std::string, DevIndexedFile> files_{};
+    std::unique_ptr<vix::engine::watch::FileWatcher> watcher_{};
 
     std::unordered_map<std::string, DevIndexedFile> scan_project() const;
 
+    std::vector<DevIndexedChange> poll_by_rescan();
+    void apply_event_batch(
+        const vix::engine::watch::Batch &batch,
+        std::vector<DevIndexedChange> &changes);
+    void apply_path(const fs::path &path, std::vector<DevIndexedChange> &changes);
+    void apply_directory(const fs::path &dir, std::vector<DevIndexedChange> &changes);
+
+    void start_watcher();
+    void stop_watcher();
+
     bool should_skip_directory(const fs::path &path) const;
+    bool should_skip_path(const fs::path &path) const;
     bool should_consider_file(const fs::path &path) const;
 
     std::optional<DevIndexedFile> read_file_state(const fs::path &path) const;
@@ -19,8 +19,10 @@
 
 #include <filesystem>
 #include <string>
+#include <vector>
 
 #include <vix/cli/commands/run/RunDetail.hpp>
+#include <vix/cli/commands/run/dev/DevBuildSession.hpp>
 
 namespace vix::commands::RunCommand::dev
 {
@@ -43,6 +45,8 @@ namespace vix::commands::RunCommand::dev
     bool ok{false};
     bool configured{false};
     bool built{false};
+    bool inProcess{false};
+    bool superseded{false};
 
     int exitCode{0};
     std::string message;
@@ -60,8 +64,30 @@ namespace vix::commands::RunCommand::dev
     DevRebuilderResult rebuild(bool cleanBeforeBuild = false) const;
     DevRebuilderResult reconfigure_and_rebuild() const;
 
+    /**
+     * @brief Rebuild after source edits, in-process when the graph allows.
+     *
+     * Falls back to a full `vix build` when the changes alter the task set
+     * or no build graph is available yet.
+     */
+    DevRebuilderResult rebuild_changed(const std::vector<fs::path> &changedPaths);
+
+    /**
+     * @brief Re-read the build graph after a build done outside the session.
+     */
+    void reload_build_graph();
+
+    /**
+     * @brief Kill in-flight compiles made stale by newer edits.
+     *
+     * Safe to call from another thread while rebuild_changed() runs.
+     */
+    void cancel_stale_tasks(const std::vector<fs::path> &changedPaths);
+    void cancel_all_tasks();
+
   private:
     DevRebuilderOptions options_;
+    DevBuildSession buildSession_;
 
     bool has_cmake_cache() const;
 
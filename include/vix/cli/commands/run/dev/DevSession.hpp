@@ -26,6 +26,7 @@
 #include <vix/cli/commands/run/RunDetail.hpp>
 #include <vix/cli/commands/run/dev/DevRebuilder.hpp>
 #include <vix/cli/commands/run/dev/DevFileIndex.hpp>
+#include <vix/cli/commands/run/dev/DevSocketHandoff.hpp>
 
 #include <vix/async/core/io_context.hpp>
 #include <vix/async/core/task.hpp>
@@ -100,7 +101,13 @@ namespace vix::commands::RunCommand::dev
     vix::async::core::task<DevRebuilderResult> rebuild_async(
         vix::async::core::io_context &ctx,
         DevChangeKind kind,
-        vix::async::core::cancel_token ct) const;
+        std::vector<fs::path> changedPaths,
+        vix::async::core::cancel_token ct);
+
+    vix::async::core::task<DevRebuilderResult> rebuild_speculative_async(
+        vix::async::core::io_context &ctx,
+        std::vector<fs::path> changedPaths,
+        vix::async::core::cancel_token ct);
 
     vix::async::core::task<DevIndexedChange> wait_for_indexed_change_async(
         vix::async::core::io_context &ctx,
@@ -111,13 +118,24 @@ namespace vix::commands::RunCommand::dev
 
     void print_reload_for_change(const DevIndexedChange &change) const;
 
+    void set_pending_change(const DevIndexedChange &change);
+    void remember_changed_paths(const std::vector<DevIndexedChange> &changes);
+
     DevSessionOptions options_;
     DevRebuilder rebuilder_;
     DevFileIndex fileIndex_;
     DevChangeKind pendingChangeKind_{DevChangeKind::Ignore};
+    std::optional<fs::file_time_type> pendingChangeSavedAt_{};
+    std::vector<fs::path> pendingChangedPaths_{};
 
 #ifndef _WIN32
     int vueFrontendPid_{-1};
+
+    // --listen: sockets shared by every child generation, and the previous
+    // generation kept serving until its replacement is ready.
+    DevSocketHandoff socketHandoff_;
+    int retiringPid_{-1};
+    int retiringOutputFd_{-1};
 #endif
 
     std::optional<fs::path> executable_path() const;
@@ -136,6 +154,23 @@ namespace vix::commands::RunCommand::dev
         int pid,
         vix::async::core::cancel_token ct) const;
 
+    /**
+     * @brief Wait for the new child to be ready, then retire the previous one.
+     *
+     * Returns false, with the previous generation still serving, when the
+     * new child exits before it is ready.
+     */
+    vix::async::core::task<bool> hand_over_to_child_async(
+        vix::async::core::io_context &ctx,
+        int pid,
+        int outputFd,
+        std::string &runtimeLog,
+        vix::async::core::cancel_token ct);
+
+    vix::async::core::task<void> retire_previous_child_async(
+        vix::async::core::io_context &ctx,
+        vix::async::core::cancel_token ct);
+
     bool has_vue_frontend() const;
     int start_vue_frontend();
     void stop_vue_frontend();
@@ -0,0 +1,96 @@
+/**
+ *
+ *  @file DevSocketHandoff.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2026, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Dev mode listening-socket handoff
+ *
+ *  With `vix dev --listen <port>` the dev session binds the app's listening
+ *  sockets itself and passes them to every child generation the way systemd
+ *  socket activation does: as fds 3.. with LISTEN_FDS / LISTEN_PID set.
+ *  Children may report readiness with "READY=1" on NOTIFY_SOCKET. The
+ *  previous generation is only stopped once the next one is ready, so the
+ *  port keeps accepting connections across restarts.
+ *
+ */
+
+#ifndef VIX_CLI_COMMANDS_RUN_DEV_DEV_SOCKET_HANDOFF_HPP
+#define VIX_CLI_COMMANDS_RUN_DEV_DEV_SOCKET_HANDOFF_HPP
+
+#include <string>
+#include <vector>
+
+namespace vix::commands::RunCommand::dev
+{
+  struct DevListenAddress
+  {
+    std::string host; // empty: all interfaces
+    int port{0};
+
+    std::string to_string() const;
+  };
+
+  /**
+   * @brief Parse "8080", "127.0.0.1:8080" or "[::1]:8080".
+   */
+  bool parse_listen_address(
+      const std::string &spec,
+      DevListenAddress &out,
+      std::string &err);
+
+  class DevSocketHandoff
+  {
+  public:
+    DevSocketHandoff() = default;
+    ~DevSocketHandoff();
+
+    DevSocketHandoff(const DevSocketHandoff &) = delete;
+    DevSocketHandoff &operator=(const DevSocketHandoff &) = delete;
+
+    /**
+     * @brief Bind and listen on every address; all or nothing.
+     */
+    bool open(const std::vector<std::string> &specs, std::string &err);
+
+    void close();
+
+    bool active() const;
+
+    const std::vector<DevListenAddress> &addresses() const;
+
+    /**
+     * @brief Child side, between fork() and exec(): install the sockets as
+     * fds 3.. and export LISTEN_FDS, LISTEN_PID, LISTEN_FDNAMES and
+     * NOTIFY_SOCKET.
+     */
+    void prepare_child() const;
+
+    /**
+     * @brief Drop readiness messages left by earlier generations.
+     */
+    void discard_notifications() const;
+
+    /**
+     * @brief Non-blocking: true once a child sent READY=1.
+     */
+    bool poll_ready() const;
+
+  private:
+    std::vector<DevListenAddress> addresses_{};
+    std::vector<int> fds_{};
+    int notifyFd_{-1};
+    std::string notifyPath_{};
+
+    bool open_notify_socket();
+  };
+
+} // namespace vix::commands::RunCommand::dev
+
+#endif // VIX_CLI_COMMANDS_RUN_DEV_DEV_SOCKET_HANDOFF_HPP
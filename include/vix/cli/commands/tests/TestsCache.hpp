@@ -0,0 +1,112 @@
+/**
+ *
+ *  @file TestsCache.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Local test result cache for `vix tests`.
+ *
+ *  A passing result is reused while the test's key is unchanged. The key
+ *  covers the test binary and the shared libraries it links, the command
+ *  line, the working directory, the ENVIRONMENT property, allowlisted
+ *  variables of the calling environment and the REQUIRED_FILES property.
+ *  Failed results are never reused, and a test that both failed and
+ *  passed with the same key is flaky: it is not cached under that key.
+ */
+#ifndef VIX_TESTS_CACHE_HPP
+#define VIX_TESTS_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <vix/cli/commands/tests/TestsImpact.hpp>
+#include <vix/cli/commands/tests/TestsScheduler.hpp>
+
+namespace vix::commands::TestsCommand::detail
+{
+  namespace fs = std::filesystem;
+
+  /**
+   * @brief Names of the calling environment variables that enter the key:
+   * TZ, LANG, LC_ALL and those listed in VIX_TEST_CACHE_ENV (comma or
+   * colon separated).
+   */
+  std::vector<std::string> test_cache_env_allowlist();
+
+  /**
+   * @brief Shared libraries among the transitive build inputs of
+   * @p binary, from build.ninja edges.
+   *
+   * A library can change without the test executable being relinked into
+   * a different file, so its content belongs in the key.
+   */
+  class SharedLibraryIndex
+  {
+  public:
+    explicit SharedLibraryIndex(const std::vector<ImpactEdge> &edges);
+
+    std::vector<fs::path> libraries_of(const std::string &binary) const;
+
+  private:
+    std::unordered_map<std::string, std::vector<std::string>> inputsByOutput_{};
+  };
+
+  class TestResultCache
+  {
+  public:
+    static fs::path default_path(const fs::path &buildDir);
+
+    bool load(const fs::path &path);
+    bool save(const fs::path &path) const;
+
+    /**
+     * @brief Key of @p job, or nothing when an input cannot be read.
+     */
+    std::optional<std::string> key_for(
+        const TestJob &job,
+        const std::vector<fs::path> &libraries,
+        const std::vector<std::string> &envAllowlist);
+
+    /**
+     * @brief Duration of the cached pass of @p name under @p key, if any.
+     */
+    std::optional<double> cached_pass(const std::string &name, const std::string &key) const;
+
+    void record(const std::string &name, const std::string &key, const TestJobResult &result);
+
+  private:
+    struct Entry
+    {
+      std::string key;
+      std::string status; // passed, failed, flaky
+      double seconds{0.0};
+    };
+
+    // Content hashes are reused while size and mtime match.
+    struct FileStamp
+    {
+      std::uintmax_t size{0};
+      long long mtime{0};
+      std::string hash;
+    };
+
+    std::optional<std::string> file_hash(const fs::path &path);
+
+    std::unordered_map<std::string, Entry> entries_{};
+    std::unordered_map<std::string, FileStamp> files_{};
+    std::unordered_set<std::string> usedFiles_{};
+  };
+}
+
+#endif
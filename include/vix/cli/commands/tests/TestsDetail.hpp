@@ -30,12 +30,41 @@ namespace vix::commands::TestsCommand::detail
     bool raw = false;
     std::string testPattern;
 
+    bool affected = false;   // --affected[=<git-rev>]
+    std::string affectedRev; // empty: uncommitted changes against HEAD
+    bool explain = false;    // --explain: why each affected test was chosen
+
+    int shardIndex = 0; // --shard i/n, 1-based; 0: unsharded
+    int shardCount = 0;
+    int shardReportCount = 0; // --shard-report[=<n>]: print the plan only
+    fs::path reportPath;      // --report <file>: JSON results for `vix tests merge`
+    fs::path durationsPath;   // --durations <file>: shared duration history
+
+    bool noTestCache = false; // --no-test-cache: run tests even when cached
+
     fs::path projectDir;
     std::vector<std::string> forwarded;
     std::vector<std::string> ctestArgs;
+    bool ctestPassthrough = false; // ctestArgs holds arguments given after `--`
   };
 
+  struct MergeOptions
+  {
+    std::vector<fs::path> inputs;
+    fs::path junitPath;
+    fs::path jsonPath;
+    fs::path durationsPath; // updated with the merged durations
+  };
+
+  /**
+   * @brief Parse `vix tests` arguments; throws std::invalid_argument.
+   */
   Options parse(const std::vector<std::string> &args);
+
+  /**
+   * @brief Parse `vix tests merge` arguments; throws std::invalid_argument.
+   */
+  MergeOptions parse_merge(const std::vector<std::string> &args);
 }
 
 #endif
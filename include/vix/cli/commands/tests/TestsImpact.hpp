@@ -0,0 +1,141 @@
+/**
+ *
+ *  @file TestsImpact.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Test impact analysis for `vix tests --affected`.
+ *
+ *  Changed files are followed through the build: header and source
+ *  dependencies recorded by Ninja (`ninja -t deps`), then the build edges
+ *  of build.ninja (objects -> libraries -> executables), and finally the
+ *  CTest entries whose command uses an affected file.
+ */
+#ifndef VIX_TESTS_IMPACT_HPP
+#define VIX_TESTS_IMPACT_HPP
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace vix::commands::TestsCommand::detail
+{
+  namespace fs = std::filesystem;
+
+  /**
+   * @brief One "outputs are rebuilt when any input changes" relation.
+   *
+   * Paths are absolute and lexically normalized.
+   */
+  struct ImpactEdge
+  {
+    std::vector<std::string> outputs;
+    std::vector<std::string> inputs;
+  };
+
+  struct CTestEntry
+  {
+    std::string name;
+    std::vector<std::string> command;
+
+    // From set_tests_properties(); read by the native scheduler.
+    fs::path workingDirectory;
+    double timeoutSeconds{0.0};
+    bool runSerial{false};
+    bool disabled{false};
+    std::vector<std::string> resourceLocks;
+    std::vector<std::string> environment;
+    std::vector<fs::path> requiredFiles;
+    std::vector<std::string> labels; // `vix bench` runs tests labelled bench
+
+    bool willFail{false};
+    std::vector<std::string> passRegex; // PASS_REGULAR_EXPRESSION
+    std::vector<std::string> failRegex; // FAIL_REGULAR_EXPRESSION
+    int skipReturnCode{-1};             // -1: none
+    std::vector<std::string> skipRegex; // SKIP_REGULAR_EXPRESSION
+    std::vector<std::string> depends;
+    std::vector<std::string> fixturesSetup;
+    std::vector<std::string> fixturesCleanup;
+    std::vector<std::string> fixturesRequired;
+
+    // Properties the native scheduler cannot honour; CTest runs the tests
+    // when any selected test has one.
+    std::vector<std::string> unsupportedProperties;
+  };
+
+  struct CTestFile
+  {
+    std::vector<CTestEntry> tests;
+    std::vector<fs::path> subdirs;
+    std::vector<fs::path> includes;
+  };
+
+  struct AffectedTest
+  {
+    std::string name;
+
+    // Changed file first, then every build output up to the file the test
+    // runs.
+    std::vector<std::string> chain;
+  };
+
+  struct AffectedTestsResult
+  {
+    bool runAll{false};
+    std::string runAllReason;
+
+    std::vector<AffectedTest> tests;
+
+    // Changed files that feed no build output and no test command.
+    std::vector<std::string> unusedFiles;
+  };
+
+  std::string impact_path_key(const fs::path &path, const fs::path &base);
+
+  /**
+   * @brief Parse the `build` statements of a build.ninja file.
+   *
+   * Explicit and implicit inputs count; order-only inputs do not, since
+   * Ninja does not rebuild an output when only those change.
+   */
+  std::vector<ImpactEdge> parse_ninja_build_edges(
+      const std::string &text,
+      const fs::path &buildDir);
+
+  /**
+   * @brief Parse the output of `ninja -t deps` (depfile dependencies).
+   */
+  std::vector<ImpactEdge> parse_ninja_deps_output(
+      const std::string &text,
+      const fs::path &buildDir);
+
+  /**
+   * @brief Parse the add_test(), set_tests_properties(), subdirs() and
+   * include() calls of a CTestTestfile.cmake located in @p dir.
+   */
+  CTestFile parse_ctest_testfile(const std::string &text, const fs::path &dir);
+
+  /**
+   * @brief Select the tests reached from @p changedFiles.
+   *
+   * Build system files, and sources the build does not know yet, select
+   * every test: their effect cannot be derived from the current graph.
+   */
+  AffectedTestsResult compute_affected_tests(
+      const std::vector<std::string> &changedFiles,
+      const std::vector<ImpactEdge> &edges,
+      const std::vector<CTestEntry> &tests);
+
+  /**
+   * @brief Anchored CTest -R regex matching exactly these test names.
+   */
+  std::string ctest_exact_names_regex(const std::vector<std::string> &names);
+}
+
+#endif
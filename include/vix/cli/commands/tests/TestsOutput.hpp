@@ -0,0 +1,158 @@
+/**
+ *
+ *  @file TestsOutput.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Bounded capture of test output for `vix tests`.
+ *
+ *  The complete output goes to a spool file under the build directory.
+ *  Memory keeps only what summaries and failure reports read: CTest status
+ *  lines, and the head and tail of the text each test printed. The memory
+ *  used grows with the number of tests, not with how much they log.
+ */
+#ifndef VIX_TESTS_OUTPUT_HPP
+#define VIX_TESTS_OUTPUT_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace vix::commands::TestsCommand::detail
+{
+  namespace fs = std::filesystem;
+
+  struct TestOutputLimits
+  {
+    std::size_t headBytes{16 * 1024};
+    std::size_t tailBytes{64 * 1024};
+  };
+
+  /**
+   * @brief build/.vix/test-output
+   */
+  fs::path test_output_dir(const fs::path &buildDir);
+
+  /**
+   * @brief Spool file of test @p name in @p dir, with a file-safe name.
+   */
+  fs::path test_output_file(const fs::path &dir, const std::string &name);
+
+  /**
+   * @brief Head and tail of a byte stream; the middle is only counted.
+   */
+  class OutputExcerpt
+  {
+  public:
+    explicit OutputExcerpt(TestOutputLimits limits = {});
+
+    void append(std::string_view data);
+    void clear();
+
+    bool empty() const { return bytes_ == 0; }
+    std::uintmax_t bytes() const { return bytes_; }
+    std::uintmax_t omitted_bytes() const;
+
+    /**
+     * @brief Head, an omission marker when bytes were dropped, and the
+     * tail starting at a line boundary.
+     */
+    std::string text() const;
+
+  private:
+    TestOutputLimits limits_;
+    std::string head_{};
+    std::string tail_{};
+    std::uintmax_t bytes_{0};
+  };
+
+  /**
+   * @brief Output of one test: everything to the spool file, an excerpt in
+   * memory.
+   */
+  class TestOutputSpool
+  {
+  public:
+    explicit TestOutputSpool(TestOutputLimits limits = {});
+
+    /**
+     * @brief Start spooling to @p file (truncated). Without a file, or when
+     * it cannot be opened, only the excerpt is kept.
+     */
+    bool open(const fs::path &file);
+    void close();
+
+    void append(std::string_view data);
+
+    const fs::path &file() const { return file_; }
+    const OutputExcerpt &excerpt() const { return excerpt_; }
+
+  private:
+    OutputExcerpt excerpt_;
+    std::ofstream out_{};
+    fs::path file_{};
+  };
+
+  /**
+   * @brief Line-oriented digest of a CTest (or build) run.
+   *
+   * Status lines are kept whole, so counts, result lines and the failed
+   * test list parse as from the full output. The text between two status
+   * lines, which is what one test printed, is kept as an excerpt.
+   */
+  class CTestOutputDigest
+  {
+  public:
+    explicit CTestOutputDigest(TestOutputLimits limits = {});
+
+    bool open(const fs::path &file);
+    void close();
+
+    /**
+     * @brief Add a line, or the next chunk of a line longer than the
+     * reader's buffer.
+     */
+    void append_line(std::string_view line);
+
+    std::string text() const;
+
+    const fs::path &file() const { return file_; }
+    bool truncated() const { return truncated_ || block_.omitted_bytes() > 0; }
+
+  private:
+    void flush_block();
+
+    TestOutputLimits limits_;
+    std::ofstream out_{};
+    fs::path file_{};
+    OutputExcerpt block_;
+    std::string text_{};
+
+    bool atLineStart_{true};
+    bool inStatusLine_{false};
+    bool inFailedList_{false};
+    bool truncated_{false};
+  };
+
+  /**
+   * @brief True for the CTest lines the summaries are computed from.
+   */
+  bool is_ctest_status_line(std::string_view trimmed);
+
+  /**
+   * @brief Copy @p file to @p out line by line, each line prefixed with
+   * @p indent. False when the file cannot be read.
+   */
+  bool stream_output_file(const fs::path &file, std::ostream &out, const std::string &indent = {});
+}
+
+#endif
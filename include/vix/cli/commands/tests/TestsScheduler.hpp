@@ -0,0 +1,171 @@
+/**
+ *
+ *  @file TestsScheduler.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Native test scheduler for `vix tests`.
+ *
+ *  Runs the tests registered in CTestTestfile.cmake directly, longest
+ *  expected duration first (LPT), on a fixed number of workers. Expected
+ *  durations come from the previous runs recorded in the build directory.
+ *  RUN_SERIAL tests run alone and tests sharing a RESOURCE_LOCK never
+ *  overlap; DEPENDS and FIXTURES_* order the run. Tests using a property
+ *  the scheduler does not know are left to CTest.
+ */
+#ifndef VIX_TESTS_SCHEDULER_HPP
+#define VIX_TESTS_SCHEDULER_HPP
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <vix/cli/commands/tests/TestsImpact.hpp>
+#include <vix/cli/commands/tests/TestsOutput.hpp>
+
+namespace vix::commands::TestsCommand::detail
+{
+  namespace fs = std::filesystem;
+
+  struct TestJob
+  {
+    std::string name;
+    std::vector<std::string> command;
+    fs::path workingDirectory;
+    std::vector<std::string> environment; // NAME=value overrides
+    std::chrono::milliseconds timeout{0}; // 0: none
+    std::vector<std::string> resourceLocks;
+    bool runSerial{false};
+    std::vector<fs::path> requiredFiles; // REQUIRED_FILES, part of the cache key
+
+    // Outcome rules, as CTest applies them.
+    bool willFail{false};
+    std::vector<std::string> passRegex;
+    std::vector<std::string> failRegex;
+    int skipReturnCode{-1};
+    std::vector<std::string> skipRegex;
+
+    // Ordering: DEPENDS and fixtures only bind jobs of the same run.
+    std::vector<std::string> depends;
+    std::vector<std::string> fixturesSetup;
+    std::vector<std::string> fixturesCleanup;
+    std::vector<std::string> fixturesRequired;
+
+    std::vector<std::string> unsupportedProperties; // run through CTest instead
+
+    double expectedSeconds{-1.0}; // < 0: no history
+  };
+
+  struct TestJobResult
+  {
+    std::string name;
+    bool ran{false};
+    bool passed{false};
+    bool timedOut{false};
+    bool skipped{false}; // SKIP_RETURN_CODE or SKIP_REGULAR_EXPRESSION; counts as passed
+    int exitCode{0};
+    double seconds{0.0};
+    std::string output; // head and tail only when the test printed a lot
+    fs::path outputFile; // complete output, when spooled
+  };
+
+  /**
+   * @brief Per-test durations of earlier runs, kept in the build directory.
+   */
+  class TestDurationHistory
+  {
+  public:
+    static fs::path default_path(const fs::path &buildDir);
+
+    bool load(const fs::path &path);
+    bool save(const fs::path &path) const;
+
+    std::optional<double> expected_seconds(const std::string &name) const;
+
+    /**
+     * @brief Blend a new measurement into the estimate (moving average).
+     */
+    void record(const std::string &name, double seconds);
+
+  private:
+    struct Entry
+    {
+      double seconds{0.0};
+      std::size_t runs{0};
+    };
+
+    std::unordered_map<std::string, Entry> entries_{};
+  };
+
+  TestJob make_test_job(
+      const CTestEntry &entry,
+      std::chrono::milliseconds defaultTimeout);
+
+  /**
+   * @brief Add the FIXTURES_SETUP and FIXTURES_CLEANUP tests, taken from
+   * @p available, of every fixture a job of @p jobs requires.
+   *
+   * CTest does the same when -R leaves them out of the selection.
+   */
+  void add_fixture_jobs(std::vector<TestJob> &jobs, const std::vector<TestJob> &available);
+
+  /**
+   * @brief Sort jobs longest expected duration first.
+   *
+   * Jobs without history are estimated at the mean of the known ones; with
+   * no history at all the CTest file order is kept.
+   */
+  void order_longest_first(std::vector<TestJob> &jobs);
+
+  /**
+   * @brief Lower bound of the makespan: max(total / workers, longest).
+   */
+  double ideal_makespan_seconds(const std::vector<double> &durations, int workers);
+
+  struct TestSchedulerOptions
+  {
+    int jobs{1};
+    bool failFast{false};
+
+    // Complete output of each test is spooled here; empty: excerpts only.
+    fs::path outputDir{};
+    TestOutputLimits outputLimits{};
+
+    std::function<bool()> stopRequested{};
+    std::function<void(const TestJob &)> onStart{};
+    std::function<void(const TestJobResult &)> onFinish{};
+    std::function<void()> onTick{}; // called between polls (~50 ms)
+  };
+
+  /**
+   * @brief True where run_test_jobs() can spawn tests itself (POSIX).
+   */
+  bool native_test_scheduler_supported();
+
+  /**
+   * @brief Run @p jobs in the given order, as soon as a worker and their
+   * resource locks are free.
+   *
+   * A job waits for the jobs it DEPENDS on, for the setup tests of the
+   * fixtures it requires, and, as a cleanup test, for every job requiring
+   * its fixtures. A job whose fixture setup failed is not run and fails.
+   *
+   * Results follow the order of @p jobs. Jobs left out by --fail-fast or an
+   * interruption have ran == false.
+   */
+  std::vector<TestJobResult> run_test_jobs(
+      const std::vector<TestJob> &jobs,
+      const TestSchedulerOptions &options);
+}
+
+#endif
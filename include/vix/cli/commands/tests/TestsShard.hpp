@@ -0,0 +1,123 @@
+/**
+ *
+ *  @file TestsShard.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Test sharding and shard reports for `vix tests --shard i/n` and
+ *  `vix tests merge`.
+ *
+ *  Tests are packed greedily into n shards by expected duration. The plan
+ *  depends only on the test names and the duration history, so every CI
+ *  machine computes the same partition.
+ */
+#ifndef VIX_TESTS_SHARD_HPP
+#define VIX_TESTS_SHARD_HPP
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace vix::commands::TestsCommand::detail
+{
+  struct ShardSpec
+  {
+    int index{0}; // 1-based
+    int count{0};
+  };
+
+  /**
+   * @brief Parse "i/n" with 1 <= i <= n.
+   */
+  std::optional<ShardSpec> parse_shard_spec(const std::string &text);
+
+  struct ShardTest
+  {
+    std::string name;
+    double expectedSeconds{-1.0}; // < 0: no history
+  };
+
+  struct TestShard
+  {
+    std::vector<std::string> names;
+    double expectedSeconds{0.0};
+  };
+
+  struct ShardPlan
+  {
+    std::vector<TestShard> shards;
+
+    // Tests without history, planned at the mean of the known ones.
+    std::size_t estimatedTests{0};
+  };
+
+  /**
+   * @brief Longest-first greedy bin packing into @p count shards.
+   *
+   * Durations are rounded to two significant digits first, so that run to
+   * run noise does not move tests between shards. Ties break on the test
+   * name, never on registration order.
+   */
+  ShardPlan plan_test_shards(std::vector<ShardTest> tests, int count);
+
+  std::string shard_plan_json(const ShardPlan &plan);
+
+  struct TestReportCase
+  {
+    std::string name;
+    std::string status; // passed, failed, timeout, skipped
+    double seconds{0.0};
+    std::string output;
+    int shard{0}; // 0: unsharded run
+  };
+
+  struct TestReportShard
+  {
+    int index{0};
+    double wallSeconds{0.0};
+  };
+
+  /**
+   * @brief Results of one `vix tests --report` run, or of several merged.
+   */
+  struct TestReport
+  {
+    int shardCount{0}; // 0: unsharded
+    std::vector<TestReportShard> shards;
+    std::vector<TestReportCase> cases;
+  };
+
+  std::string test_report_json(const TestReport &report);
+  std::optional<TestReport> parse_test_report_json(const std::string &text);
+
+  struct MergedTestReport
+  {
+    TestReport report;
+
+    std::vector<int> missingShards;
+    std::vector<int> repeatedShards;
+    std::vector<std::string> repeatedTests;
+    bool mixedShardCounts{false};
+  };
+
+  /**
+   * @brief Combine shard reports.
+   *
+   * A test reported twice keeps a failure over a pass, and a pass over a
+   * skip.
+   */
+  MergedTestReport merge_test_reports(const std::vector<TestReport> &reports);
+
+  /**
+   * @brief JUnit XML with one <testsuite> per shard.
+   */
+  std::string test_report_junit_xml(const TestReport &report);
+}
+
+#endif
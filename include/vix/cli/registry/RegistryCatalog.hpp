@@ -58,7 +58,7 @@ namespace vix::cli::registry
     std::vector<std::string> categories;
     std::vector<std::string> capabilities;
     std::vector<std::string> cellTypes;
-    int score{0};
+    double score{0};
     nlohmann::json raw = nlohmann::json::object();
   };
 
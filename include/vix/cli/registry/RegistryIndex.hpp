@@ -0,0 +1,128 @@
+/**
+ * @file RegistryIndex.hpp
+ * Compiled, memory-mapped form of the local registry index.
+ *
+ * The JSON entries under <registry>/index stay the source of truth.
+ * `vix registry sync` compiles them into <registry>.bin: a sorted table of
+ * packages with their versions and extension metadata, and one string pool.
+ * Readers map the file read-only and look packages up by binary search,
+ * without parsing JSON. The file records the revision it was compiled
+ * from and is rebuilt on open when the registry checkout moved.
+ */
+#ifndef VIX_CLI_REGISTRY_REGISTRY_INDEX_HPP
+#define VIX_CLI_REGISTRY_REGISTRY_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vix::cli::registry
+{
+  // Lists (keywords, capabilities, deps, ...) are stored newline-separated;
+  // see split_index_list.
+
+  struct IndexedVersion
+  {
+    std::string_view version;
+    std::string_view tag;
+    std::string_view commit;
+    std::string_view deps; ///< "ns/name@range" per line, as published in the index
+    bool declaresDeps{false};
+  };
+
+  struct IndexedExtension
+  {
+    std::string_view host;
+    std::string_view api;
+    std::string_view capabilities;
+    std::string_view cellTypes;
+  };
+
+  struct IndexedPackage
+  {
+    std::string_view file; ///< entry file stem: <ns>.<name>
+    std::string_view namespaceName;
+    std::string_view name;
+    std::string_view displayName;
+    std::string_view description;
+    std::string_view type;
+    std::string_view publisher;
+    std::string_view repository;
+    std::string_view latest;
+    std::string_view keywords;
+    std::string_view categories;
+    std::uint32_t firstVersion{0};
+    std::uint32_t versionCount{0};
+    std::uint32_t firstExtension{0};
+    std::uint32_t extensionCount{0};
+  };
+
+  class CompiledRegistryIndex
+  {
+  public:
+    /// Map a compiled file; nullopt when missing, truncated or of another format.
+    static std::optional<CompiledRegistryIndex> open(const std::filesystem::path &file);
+
+    /// Same checks over bytes held in memory.
+    static std::optional<CompiledRegistryIndex> from_bytes(std::string bytes);
+
+    std::string_view revision() const;
+    std::size_t size() const noexcept { return packageCount_; }
+
+    IndexedPackage package(std::size_t i) const;
+
+    /// Binary search by entry file stem (<ns>.<name>).
+    std::optional<IndexedPackage> find(std::string_view file) const;
+    std::optional<IndexedPackage> find(std::string_view ns, std::string_view name) const;
+
+    /// Versions in ascending semver order.
+    std::vector<IndexedVersion> versions(const IndexedPackage &package) const;
+    std::vector<IndexedExtension> extensions(const IndexedPackage &package) const;
+    std::optional<IndexedExtension> extension(const IndexedPackage &package, std::string_view host) const;
+
+  private:
+    CompiledRegistryIndex() = default;
+    static std::optional<CompiledRegistryIndex> from_storage(std::shared_ptr<const void> storage, const char *data, std::size_t size);
+    std::string_view str(std::uint32_t offset, std::uint32_t length) const;
+
+    std::shared_ptr<const void> storage_;
+    const char *data_{nullptr};
+    std::size_t size_{0};
+    std::size_t packageCount_{0};
+    std::size_t versionCount_{0};
+    std::size_t extensionCount_{0};
+    std::size_t packages_{0};
+    std::size_t versionsAt_{0};
+    std::size_t extensionsAt_{0};
+    std::size_t strings_{0};
+    std::size_t stringsSize_{0};
+  };
+
+  std::vector<std::string_view> split_index_list(std::string_view list);
+
+  /// <registry>.bin next to the registry checkout.
+  std::filesystem::path compiled_index_path(const std::filesystem::path &repositoryPath);
+
+  /**
+   * Git HEAD of the registry checkout, read from .git without running git.
+   * Outside a git checkout: names, sizes and mtimes of the entry files.
+   */
+  std::string registry_index_revision(const std::filesystem::path &repositoryPath);
+
+  /// Compile <repositoryPath>/index into compiled_index_path(); returns the package count.
+  std::optional<std::size_t> compile_registry_index(const std::filesystem::path &repositoryPath, std::string *error = nullptr);
+
+  /**
+   * Open the compiled index of a registry checkout, recompiling it first when
+   * it is missing or older than the checkout. When the file cannot be
+   * written the freshly compiled index is served from memory.
+   */
+  std::optional<CompiledRegistryIndex> open_registry_index(const std::filesystem::path &repositoryPath, std::string *error = nullptr);
+}
+
+#endif
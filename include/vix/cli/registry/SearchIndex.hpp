@@ -0,0 +1,109 @@
+/**
+ * @file SearchIndex.hpp
+ * Ranked full-text search over the compiled registry index.
+ *
+ * An inverted index over the tokens of package names, keywords and
+ * descriptions, plus trigram postings over its vocabulary so that a query
+ * token also matches terms containing it or one or two typos away. It is
+ * built from the compiled index, stored next to it as <registry>.search,
+ * and ranks packages with BM25, name tokens weighing more than keywords and
+ * keywords more than descriptions; an exact name or id match comes first.
+ */
+#ifndef VIX_CLI_REGISTRY_SEARCH_INDEX_HPP
+#define VIX_CLI_REGISTRY_SEARCH_INDEX_HPP
+
+#include <vix/cli/registry/RegistryIndex.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vix::cli::registry
+{
+  struct SearchHit
+  {
+    std::uint32_t package{0}; ///< position in the compiled index
+    double score{0};
+  };
+
+  class RegistrySearchIndex
+  {
+  public:
+    /// Map a search index file; nullopt when missing, truncated or of another format.
+    static std::optional<RegistrySearchIndex> open(const std::filesystem::path &file);
+
+    /// Same checks over bytes held in memory.
+    static std::optional<RegistrySearchIndex> from_bytes(std::string bytes);
+
+    /// Revision of the compiled index it was built from.
+    std::string_view revision() const;
+    std::size_t documents() const noexcept { return docCount_; }
+    std::size_t terms() const noexcept { return termCount_; }
+
+    /**
+     * Every package matching a query token. The first `ranked` hits are the
+     * best ones in order (see rank_search_hits); the rest follow unordered,
+     * so a caller can count all matches and still sort only one page.
+     */
+    std::vector<SearchHit> search(std::string_view query, std::size_t ranked = SIZE_MAX) const;
+
+  private:
+    struct Expansion
+    {
+      std::uint32_t term;
+      double weight;
+    };
+
+    RegistrySearchIndex() = default;
+    static std::optional<RegistrySearchIndex> from_storage(std::shared_ptr<const void> storage, const char *data, std::size_t size);
+    std::string_view str(std::uint32_t offset, std::uint32_t length) const;
+    std::string_view term(std::uint32_t i) const;
+    std::optional<std::uint32_t> find_term(std::string_view token) const;
+    std::vector<Expansion> expand(const std::string &token) const;
+
+    std::shared_ptr<const void> storage_;
+    const char *data_{nullptr};
+    std::size_t docCount_{0};
+    std::size_t termCount_{0};
+    std::size_t postingCount_{0};
+    std::size_t trigramCount_{0};
+    std::size_t trigramTermCount_{0};
+    double averageLength_{1};
+    std::size_t docsAt_{0};
+    std::size_t termsAt_{0};
+    std::size_t postingsAt_{0};
+    std::size_t trigramsAt_{0};
+    std::size_t trigramTermsAt_{0};
+    std::size_t strings_{0};
+    std::size_t stringsSize_{0};
+  };
+
+  /// Move the best `ranked` hits to the front, by score then index order.
+  void rank_search_hits(std::vector<SearchHit> &hits, std::size_t ranked = SIZE_MAX);
+
+  /// Lowercased ASCII letter and digit runs, as indexed and queried.
+  std::vector<std::string> search_tokens(std::string_view text);
+
+  /// Serialized search index over every package of `index`.
+  std::string build_search_index(const CompiledRegistryIndex &index);
+
+  /// <registry>.search next to the registry checkout.
+  std::filesystem::path search_index_path(const std::filesystem::path &repositoryPath);
+
+  /**
+   * Open the search index of a registry checkout, rebuilding it first when
+   * it was built from another revision of the compiled index. When the
+   * file cannot be written the rebuilt index is served from memory.
+   */
+  std::optional<RegistrySearchIndex> open_search_index(
+      const std::filesystem::path &repositoryPath,
+      const CompiledRegistryIndex &index,
+      std::string *error = nullptr);
+}
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ *
+ *  @file CompilerIdentity.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Persistent compiler identity cache.
+ *
+ *  Asking a compiler for its version, target and search paths costs a
+ *  process spawn. The answer only changes when the compiler binary does, so
+ *  it is stored in ~/.vix/cache/compilers.json, keyed by the path the
+ *  compiler is invoked as and validated by the inode, size and mtime of the
+ *  binary it resolves to. A warm lookup is one stat().
+ */
+#ifndef VIX_CLI_UTIL_COMPILER_IDENTITY_HPP
+#define VIX_CLI_UTIL_COMPILER_IDENTITY_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace vix::cli::util
+{
+  struct CompilerIdentity
+  {
+    std::string path;     // absolute path the compiler is invoked as
+    std::string family;   // gcc | clang | unknown
+    std::string version;  // e.g. 13.2.0
+    std::string target;   // e.g. x86_64-linux-gnu
+    std::string defaultStandard; // e.g. c++17
+    std::vector<std::string> builtinIncludeDirs;
+
+    std::uint64_t inode = 0;
+    std::uint64_t size = 0;
+    std::uint64_t mtimeNs = 0;
+
+    bool fromCache = false; // answered without running the compiler
+  };
+
+  /**
+   * @brief Compiler used when nothing else is configured: $CXX, else c++.
+   */
+  std::string default_cxx_compiler();
+
+  /**
+   * @brief Return the identity of compiler (a name on PATH or a path).
+   *
+   * Reads ~/.vix/cache/compilers.json and only runs the compiler when the
+   * binary is unknown or changed. Returns std::nullopt when the compiler
+   * cannot be found or does not answer.
+   */
+  std::optional<CompilerIdentity> compiler_identity(const std::string &compiler);
+
+  /**
+   * @brief Short stable tag such as "g++-13.2.0" or "clang++-18.1.3".
+   */
+  std::string compiler_identity_tag(const CompilerIdentity &id);
+
+  std::filesystem::path compiler_identity_cache_file();
+
+  /**
+   * @brief Fill id from the output of `<cxx> -x c++ -E -dM -v -`.
+   *
+   * Exposed for tests.
+   */
+  bool parse_compiler_probe_output(const std::string &output, CompilerIdentity &id);
+
+  // Test seam: forget identities memoized by this process.
+  void reset_compiler_identity_memo_for_test();
+
+} // namespace vix::cli::util
+
+#endif
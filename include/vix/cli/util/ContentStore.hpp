@@ -0,0 +1,48 @@
+/** Content-addressed file store that dependency trees are hardlinked from. */
+#ifndef VIX_CLI_UTIL_CONTENT_STORE_HPP
+#define VIX_CLI_UTIL_CONTENT_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace vix::cli::util
+{
+  // Paths, sizes and mtimes of every file under `tree` outside .git, as one
+  // order-independent value. Cheap enough to compute on every install.
+  std::string tree_signature(const std::filesystem::path &tree);
+
+  // Files live once under <root>/<sha256> (executables as <sha256>-x) and
+  // are read-only. A project copy of a dependency is a directory of
+  // hardlinks to them; reflinks are used where hardlinks are refused and a
+  // plain copy only across filesystems. An object whose only link is the
+  // store's own is referenced by no project, which is what gc() collects.
+  class ContentStore
+  {
+  public:
+    struct Materialized { std::size_t files{0}, linked{0}, cloned{0}, copied{0}, hashed{0}; };
+    struct Collected { std::size_t objects{0}, manifests{0}; std::uintmax_t bytes{0}; };
+
+    // <vixRoot>/store/cas, with manifests in <vixRoot>/store/cas-index.
+    explicit ContentStore(const std::filesystem::path &vixRoot);
+
+    const std::filesystem::path &root() const { return root_; }
+
+    // Replaces `dst` with the contents of `tree`. Files are only hashed when
+    // the tree changed since it was last materialized from.
+    Materialized materialize(const std::filesystem::path &tree, const std::filesystem::path &dst) const;
+
+    // True when `dst` was materialized from `tree` and the tree is unchanged.
+    bool is_materialized(const std::filesystem::path &tree, const std::filesystem::path &dst) const;
+
+    // Drops objects no project links to and manifests of trees that are gone.
+    // Staging files are only dropped once an hour old, so a concurrent
+    // materialize() keeps the ones it is still writing.
+    Collected gc(bool dryRun) const;
+
+  private:
+    std::filesystem::path root_, index_;
+  };
+}
+#endif
@@ -0,0 +1,106 @@
+/** Bounded worker pool and multi-line live progress for dependency fetches. */
+#ifndef VIX_CLI_UTIL_FETCH_POOL_HPP
+#define VIX_CLI_UTIL_FETCH_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vix::cli::util
+{
+  constexpr std::size_t DEFAULT_FETCH_JOBS = 8;
+  constexpr std::size_t MAX_FETCH_JOBS = 64;
+
+  // Runs submitted jobs on at most `workers` threads, in submission order.
+  // Callers consume results in their own order with wait(), so work that
+  // must stay serial (hash checks, lockfile edits) is pipelined behind the
+  // fetches instead of waiting for all of them.
+  class FetchPool
+  {
+  public:
+    using Job = std::function<void()>;
+
+    explicit FetchPool(std::size_t workers);
+    ~FetchPool();
+    FetchPool(const FetchPool &) = delete;
+    FetchPool &operator=(const FetchPool &) = delete;
+
+    std::size_t submit(Job job);
+
+    // Blocks until the job finished; rethrows what it threw.
+    void wait(std::size_t index);
+
+    // Drops jobs that have not started yet; running ones complete.
+    void cancel_pending();
+
+    std::size_t workers() const { return threads_.size(); }
+
+  private:
+    enum class State { Queued, Running, Done, Cancelled };
+    struct Entry { Job job; State state{State::Queued}; std::exception_ptr error; };
+
+    void worker_loop();
+
+    std::mutex mutex_;
+    std::condition_variable wake_, done_;
+    std::deque<Entry> entries_;
+    std::size_t next_{0};
+    bool stopping_{false};
+    std::vector<std::thread> threads_;
+  };
+
+  // One live line per running fetch. On a terminal the lines are redrawn in
+  // place below regular output; otherwise each row prints a plain line when
+  // its phase changes.
+  class LiveProgressBoard
+  {
+  public:
+    LiveProgressBoard(std::ostream &out, bool tty);
+    ~LiveProgressBoard();
+    LiveProgressBoard(const LiveProgressBoard &) = delete;
+    LiveProgressBoard &operator=(const LiveProgressBoard &) = delete;
+
+    std::size_t add_row(const std::string &key);
+    // `phase` decides when a plain (non-terminal) line is printed.
+    void update(std::size_t row, const std::string &phase, const std::string &text);
+    void remove_row(std::size_t row);
+
+    // Clears the live lines so the caller can print; resume() redraws them.
+    void pause();
+    void resume();
+
+    std::size_t live_rows() const;
+
+    class Pause
+    {
+    public:
+      explicit Pause(LiveProgressBoard *board) : board_(board) { if (board_) board_->pause(); }
+      ~Pause() { if (board_) board_->resume(); }
+      Pause(const Pause &) = delete;
+      Pause &operator=(const Pause &) = delete;
+    private:
+      LiveProgressBoard *board_;
+    };
+
+  private:
+    struct Row { std::string key, phase, text; bool live{true}; };
+
+    void clear_locked();
+    void draw_locked();
+
+    std::ostream &out_;
+    bool tty_;
+    mutable std::mutex mutex_;
+    std::vector<Row> rows_;
+    std::size_t drawn_{0};
+    int paused_{0};
+  };
+}
+#endif
@@ -0,0 +1,46 @@
+/** Per-remote bare mirrors that dependency checkouts share objects with. */
+#ifndef VIX_CLI_UTIL_GIT_MIRROR_HPP
+#define VIX_CLI_UTIL_GIT_MIRROR_HPP
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace vix::cli::util
+{
+  // Runs `git <args>` for the steps that touch the network, so callers can
+  // show their own progress. Returns false when git failed.
+  using GitNetworkRunner = std::function<bool(std::vector<std::string> args)>;
+
+  // <vixRoot>/cache/git-mirrors
+  std::filesystem::path git_mirror_dir(const std::filesystem::path &vixRoot);
+
+  // One bare repository per remote URL, fetched incrementally. Version
+  // checkouts are `clone --shared` of it: they borrow its objects through
+  // alternates, so a new version of a known dependency only downloads the
+  // objects the mirror does not have yet.
+  class GitMirror
+  {
+  public:
+    GitMirror(const std::filesystem::path &vixRoot, std::string url);
+
+    const std::filesystem::path &path() const { return path_; }
+
+    // Makes `commit` available in the mirror, cloning it on first use and
+    // fetching otherwise. Nothing is fetched when the commit is already there.
+    void ensure_commit(const std::string &commit, const GitNetworkRunner &network = {}) const;
+
+    // Checks `commit` out at `dst` (atomically, through a sibling directory).
+    // The commit is pinned under refs/vix/keep/ so a pruning fetch never
+    // drops objects a checkout still borrows.
+    void checkout(const std::string &commit, const std::filesystem::path &dst) const;
+
+    bool has_commit(const std::string &commit) const;
+
+  private:
+    std::string url_;
+    std::filesystem::path path_;
+  };
+}
+#endif
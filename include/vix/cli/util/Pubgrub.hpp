@@ -0,0 +1,83 @@
+/**
+ *
+ *  @file Pubgrub.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira. All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  PubGrub version solver.
+ *
+ *  Picks one version per package so that every dependency range holds.
+ *  Conflicts are learned as incompatibilities and propagated, so a dead
+ *  end is never explored twice, and a failure is reported as the chain
+ *  of facts that led to it rather than as the first range that missed.
+ */
+#ifndef VIX_CLI_UTIL_PUBGRUB_HPP
+#define VIX_CLI_UTIL_PUBGRUB_HPP
+
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace vix::cli::util::pubgrub
+{
+  struct Requirement
+  {
+    std::string package;
+    std::string range; ///< semver range; empty means any version
+  };
+
+  /**
+   * @brief Where the solver learns about packages.
+   *
+   * Each package and each (package, version) is asked for at most once per
+   * solve.
+   */
+  class Provider
+  {
+  public:
+    virtual ~Provider() = default;
+
+    /// Every published version, in any order. Empty when the package is unknown.
+    virtual std::vector<std::string> versions(const std::string &package) = 0;
+
+    virtual std::vector<Requirement> dependencies(
+        const std::string &package,
+        const std::string &version) = 0;
+  };
+
+  struct Stats
+  {
+    std::size_t decisions{0};
+    std::size_t conflicts{0};
+    std::size_t incompatibilities{0};
+  };
+
+  /**
+   * @brief Thrown when no solution exists; what() is the derivation.
+   */
+  class SolveFailure : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * @brief Solve `roots`, preferring the newest version of every package.
+   *
+   * Returns package -> version for every package in the solution.
+   */
+  std::map<std::string, std::string> solve(
+      const std::vector<Requirement> &roots,
+      Provider &provider,
+      Stats *stats = nullptr);
+}
+
+#endif
@@ -21,6 +21,13 @@
 
 namespace vix::cli::util::resolver
 {
+  /**
+   * @brief Pick one registry version per package for the manifest, transitively.
+   *
+   * Solved with PubGrub; when no solution exists the error explains which
+   * ranges are incompatible. Results are cached in ~/.vix/cache/resolve,
+   * keyed by the manifest constraints and the registry index revision.
+   */
   std::vector<vix::cli::util::lockfile::LockedDependency>
   resolve_project_dependencies_or_throw(
       const std::vector<vix::cli::util::manifest::Dependency> &manifestDependencies);
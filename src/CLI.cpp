@@ -25,6 +25,7 @@
 #include <vix/cli/commands/VerifyCommand.hpp>
 #include <vix/cli/commands/CheckCommand.hpp>
 #include <vix/cli/commands/TestsCommand.hpp>
+#include <vix/cli/commands/BenchCommand.hpp>
 #include <vix/cli/commands/ReplCommand.hpp>
 #include <vix/cli/commands/NoteCommand.hpp>
 #include <vix/cli/commands/DesktopCommand.hpp>
@@ -286,6 +287,8 @@ namespace vix
     { return commands::TestsCommand::run(args); };
     commands_["test"] = [](auto args)
     { return commands::TestsCommand::run(args); };
+    commands_["bench"] = [](auto args)
+    { return commands::BenchCommand::run(args); };
     commands_["repl"] = [](auto args)
     { return commands::ReplCommand::run(args); };
     commands_["note"] = [](auto args)
@@ -573,6 +576,8 @@ namespace vix
         return commands::CheckCommand::help();
       if (cmd == "tests" || cmd == "test")
         return commands::TestsCommand::help();
+      if (cmd == "bench")
+        return commands::BenchCommand::help();
       if (cmd == "repl")
         return commands::ReplCommand::help();
       if (cmd == "note")
@@ -705,6 +710,7 @@ namespace vix
     out << "Project:\n";
     out << "  make                       Generate C++ scaffolding\n";
     out << "  check                      Validate a project or source file\n";
+    out << "  bench                      Run benchmarks against a baseline\n";
     out << "  replay                     Replay a recorded execution\n";
     out << "  repl                       Start the interactive REPL\n";
     out << "  task                       Run project tasks\n";
@@ -0,0 +1,478 @@
+/**
+ *
+ *  @file DepArtifacts.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/cmake/DepArtifacts.hpp>
+#include <vix/cli/util/CompilerIdentity.hpp>
+#include <vix/cli/util/Fs.hpp>
+#include <vix/cli/util/Hash.hpp>
+#include <vix/process/Process.hpp>
+#include <vix/utils/Env.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+#include <nlohmann/json.hpp>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace vix::cli::build
+{
+  namespace
+  {
+    constexpr std::uint64_t DEP_ARTIFACT_FNV_OFFSET = 14695981039346656037ULL;
+    constexpr int DEP_ARTIFACT_FORMAT = 1;
+    constexpr const char *MANIFEST_FILE = "manifest.json";
+
+    // A failed build is retried once its marker is this old.
+    constexpr auto FAILED_RETRY_AFTER = std::chrono::hours(24);
+
+#ifdef _WIN32
+    constexpr const char *STATIC_LIB_SUFFIX = ".lib";
+#else
+    constexpr const char *STATIC_LIB_SUFFIX = ".a";
+#endif
+
+    fs::path sibling(const fs::path &prefix, const std::string &ext)
+    {
+      return prefix.parent_path() / (prefix.filename().string() + ext);
+    }
+
+    void load_state(const DepArtifactKey &key, DepArtifact &out)
+    {
+      out.ready = false;
+      out.libs.clear();
+      out.configPackages.clear();
+
+      std::ifstream in(out.prefix / MANIFEST_FILE, std::ios::binary);
+      const nlohmann::json manifest = in ? nlohmann::json::parse(in, nullptr, false) : nlohmann::json();
+
+      if (manifest.is_object() &&
+          manifest.value("format", 0) == DEP_ARTIFACT_FORMAT &&
+          manifest.value("fingerprint", "") == out.fingerprint &&
+          manifest.value("commit", "") == key.commit)
+      {
+        out.ready = true;
+        for (const auto &lib : manifest.value("libs", nlohmann::json::array()))
+          if (lib.is_string())
+            out.libs.push_back(lib.get<std::string>());
+        for (const auto &name : manifest.value("configs", nlohmann::json::array()))
+          if (name.is_string())
+            out.configPackages.push_back(name.get<std::string>());
+      }
+
+      out.failed = !out.ready && dep_build_failed_recently(sibling(out.prefix, ".failed"));
+    }
+
+    struct StepResult
+    {
+      bool ok{false};
+      std::string output;
+    };
+
+    StepResult run_cmake(std::vector<std::string> args)
+    {
+      vix::process::Command command("cmake");
+      command.args(std::move(args));
+      command.search_in_path(true);
+      command.stdout_mode(vix::process::PipeMode::Pipe);
+      command.stderr_mode(vix::process::PipeMode::Pipe);
+
+      const auto result = vix::process::output(std::move(command));
+      if (!result)
+        return {false, result.error().message() + "\n"};
+
+      return {result.value().success(), result.value().stdout_text + result.value().stderr_text};
+    }
+
+    bool build_and_install(
+        const DepArtifactKey &key,
+        const fs::path &sourceDir,
+        DepArtifact &artifact,
+        std::string &error)
+    {
+      std::error_code ec;
+      const fs::path buildDir = sibling(artifact.prefix, ".build");
+      const fs::path logPath = sibling(artifact.prefix, ".log");
+
+      fs::remove_all(artifact.prefix, ec);
+      fs::remove_all(buildDir, ec);
+
+      std::vector<std::string> configure = {
+          "-S", sourceDir.string(),
+          "-B", buildDir.string(),
+          "-DCMAKE_BUILD_TYPE=" + key.buildType,
+          "-DCMAKE_INSTALL_PREFIX=" + artifact.prefix.string()};
+      configure.insert(configure.end(), key.cmakeArgs.begin(), key.cmakeArgs.end());
+
+      const std::vector<std::vector<std::string>> steps = {
+          configure,
+          {"--build", buildDir.string(), "--config", key.buildType, "--parallel"},
+          {"--install", buildDir.string(), "--config", key.buildType}};
+
+      std::string log;
+      bool ok = true;
+      for (const auto &step : steps)
+      {
+        log += "$ cmake";
+        for (const auto &arg : step)
+          log += " " + arg;
+        log += "\n";
+
+        const StepResult r = run_cmake(step);
+        log += r.output;
+        if (!r.ok)
+        {
+          ok = false;
+          break;
+        }
+      }
+
+      fs::remove_all(buildDir, ec);
+      (void)util::write_text_file_atomic(logPath, log);
+
+      // A package without install rules leaves nothing to link against.
+      std::vector<std::string> libs;
+      std::vector<std::string> configs;
+      if (ok)
+      {
+        libs = find_installed_static_libs(artifact.prefix);
+        configs = find_installed_config_packages(artifact.prefix);
+        if (libs.empty() && configs.empty())
+        {
+          ok = false;
+          log += "no static library or package config was installed\n";
+        }
+      }
+
+      if (!ok)
+      {
+        error = "prebuilt build failed for " + key.id + " (" + key.buildType + "), log: " + logPath.string();
+        (void)util::write_text_file_atomic(sibling(artifact.prefix, ".failed"), log);
+        fs::remove_all(artifact.prefix, ec);
+        return false;
+      }
+
+      const nlohmann::json manifest = {
+          {"format", DEP_ARTIFACT_FORMAT},
+          {"package", key.id},
+          {"version", key.version},
+          {"commit", key.commit},
+          {"compiler", key.compiler},
+          {"target", key.target},
+          {"buildType", key.buildType},
+          {"cmakeArgs", key.cmakeArgs},
+          {"fingerprint", artifact.fingerprint},
+          {"libs", libs},
+          {"configs", configs}};
+
+      // The manifest is written last: its presence is what marks the prefix ready.
+      fs::create_directories(artifact.prefix / "include", ec);
+      if (!util::write_text_file_atomic(artifact.prefix / MANIFEST_FILE, manifest.dump(2)))
+      {
+        error = "cannot write artifact manifest in " + artifact.prefix.string();
+        return false;
+      }
+
+      // Built from source after all: forget the failure.
+      fs::remove(sibling(artifact.prefix, ".failed"), ec);
+      return true;
+    }
+  } // namespace
+
+  std::string cache_component(std::string s)
+  {
+    for (char &c : s)
+    {
+      const unsigned char uc = static_cast<unsigned char>(c);
+      if (!(std::isalnum(uc) || c == '.' || c == '_' || c == '-' || c == '+'))
+        c = '_';
+    }
+
+    if (s.empty())
+      return "unknown";
+
+    return s;
+  }
+
+  std::string native_target_triple()
+  {
+#if defined(__x86_64__) && defined(__linux__)
+    return "x86_64-linux-gnu";
+#elif defined(__aarch64__) && defined(__linux__)
+    return "aarch64-linux-gnu";
+#elif defined(__arm__) && defined(__linux__)
+    return "arm-linux-gnueabihf";
+#elif defined(__riscv) && (__riscv_xlen == 64) && defined(__linux__)
+    return "riscv64-linux-gnu";
+#elif defined(_WIN32) && defined(_M_X64)
+    return "x86_64-windows-msvc";
+#elif defined(_WIN32) && defined(_M_ARM64)
+    return "aarch64-windows-msvc";
+#elif defined(__APPLE__) && defined(__aarch64__)
+    return "aarch64-apple-darwin";
+#elif defined(__APPLE__) && defined(__x86_64__)
+    return "x86_64-apple-darwin";
+#else
+    return "unknown-target";
+#endif
+  }
+
+  std::string compiler_identity_component()
+  {
+    // The compiler that built vix says nothing about the one CMake will use.
+    if (const auto id = util::compiler_identity(util::default_cxx_compiler()))
+      return cache_component(util::compiler_identity_tag(*id));
+
+    return {};
+  }
+
+  std::vector<std::string> find_installed_static_libs(const fs::path &prefix)
+  {
+    std::vector<std::string> libs;
+    const std::string suffix = STATIC_LIB_SUFFIX;
+
+    for (const char *dir : {"lib", "lib64"})
+    {
+      std::error_code ec;
+      if (!fs::is_directory(prefix / dir, ec))
+        continue;
+
+      for (const auto &entry : fs::directory_iterator(prefix / dir, ec))
+      {
+        std::error_code fileEc;
+        const std::string file = entry.path().filename().string();
+        if (entry.is_regular_file(fileEc) && file.size() > suffix.size() && file.ends_with(suffix))
+          libs.push_back(entry.path().lexically_relative(prefix).generic_string());
+      }
+    }
+
+    std::sort(libs.begin(), libs.end());
+    return libs;
+  }
+
+  std::vector<std::string> find_installed_config_packages(const fs::path &prefix)
+  {
+    std::vector<std::string> names;
+
+    // find_package also looks in <prefix>/share/<name>*/, not only share/cmake.
+    for (const fs::path &root : {prefix / "lib" / "cmake", prefix / "lib64" / "cmake", prefix / "share"})
+    {
+      std::error_code ec;
+      if (!fs::is_directory(root, ec))
+        continue;
+
+      for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec))
+      {
+        const std::string file = it->path().filename().string();
+        std::string name;
+
+        if (file.size() > 12 && file.ends_with("Config.cmake"))
+          name = file.substr(0, file.size() - 12);
+        else if (file.size() > 13 && file.ends_with("-config.cmake"))
+          name = file.substr(0, file.size() - 13);
+
+        if (!name.empty() && std::find(names.begin(), names.end(), name) == names.end())
+          names.push_back(name);
+      }
+    }
+
+    std::sort(names.begin(), names.end());
+    return names;
+  }
+
+  bool dep_build_failed_recently(const fs::path &marker)
+  {
+    std::error_code ec;
+    const auto written = fs::last_write_time(marker, ec);
+    if (ec)
+      return false;
+
+    return fs::file_time_type::clock::now() - written < FAILED_RETRY_AFTER;
+  }
+
+#ifndef _WIN32
+  DepArtifactBuildLock::DepArtifactBuildLock(const fs::path &path)
+  {
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+
+    fd_ = ::open(path.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd_ >= 0 && ::flock(fd_, LOCK_EX) != 0)
+    {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  DepArtifactBuildLock::~DepArtifactBuildLock()
+  {
+    if (fd_ >= 0)
+    {
+      ::flock(fd_, LOCK_UN);
+      ::close(fd_);
+    }
+  }
+#else
+  DepArtifactBuildLock::DepArtifactBuildLock(const fs::path &)
+  {
+  }
+
+  DepArtifactBuildLock::~DepArtifactBuildLock() = default;
+#endif
+
+  DepArtifactKey make_dep_artifact_key(
+      const std::string &id,
+      const std::string &version,
+      const std::string &commit,
+      const std::string &buildType,
+      std::vector<std::string> cmakeArgs)
+  {
+    DepArtifactKey key;
+    key.id = id;
+    key.version = version;
+    key.commit = commit;
+    key.compiler = compiler_identity_component();
+    key.target = native_target_triple();
+    key.buildType = buildType;
+    key.cmakeArgs = std::move(cmakeArgs);
+    return key;
+  }
+
+  std::string dep_artifact_fingerprint(const DepArtifactKey &key)
+  {
+    std::ostringstream oss;
+    oss << "format=" << DEP_ARTIFACT_FORMAT << "\n";
+    oss << "package=" << key.id << "\n";
+    oss << "commit=" << key.commit << "\n";
+    oss << "compiler=" << key.compiler << "\n";
+    oss << "target=" << key.target << "\n";
+    oss << "buildType=" << key.buildType << "\n";
+    oss << "cmakeArgs:\n";
+    for (const auto &arg : key.cmakeArgs)
+      oss << arg << "\n";
+
+    return util::hex64(util::fnv1a64_str(oss.str(), DEP_ARTIFACT_FNV_OFFSET));
+  }
+
+  fs::path dep_artifact_prefix(const fs::path &cacheRoot, const DepArtifactKey &key)
+  {
+    std::string pkg = key.id;
+    std::replace(pkg.begin(), pkg.end(), '/', '.');
+
+    return cacheRoot /
+           cache_component(key.target) /
+           cache_component(key.compiler) /
+           cache_component(key.buildType) /
+           (cache_component(pkg) + "@" + cache_component(key.version)) /
+           dep_artifact_fingerprint(key);
+  }
+
+  DepArtifact describe_dep_artifact(const fs::path &cacheRoot, const DepArtifactKey &key)
+  {
+    DepArtifact out;
+    out.fingerprint = dep_artifact_fingerprint(key);
+    out.prefix = dep_artifact_prefix(cacheRoot, key);
+
+    // Without a compiler identity nothing is reused or built.
+    if (!key.compiler.empty())
+      load_state(key, out);
+
+    return out;
+  }
+
+  DepArtifact ensure_dep_artifact(
+      const fs::path &cacheRoot,
+      const DepArtifactKey &key,
+      const fs::path &sourceDir,
+      std::string &error)
+  {
+    DepArtifact artifact = describe_dep_artifact(cacheRoot, key);
+    if (artifact.ready)
+      return artifact;
+
+    if (key.compiler.empty())
+    {
+      error = "cannot identify the C++ compiler; " + key.id + " is built from source";
+      return artifact;
+    }
+
+    if (artifact.failed)
+    {
+      error = "a prebuilt build of " + key.id + " (" + key.buildType + ") failed less than a day ago";
+      return artifact;
+    }
+
+    std::error_code ec;
+    fs::create_directories(artifact.prefix.parent_path(), ec);
+    if (ec)
+    {
+      error = "cannot create " + artifact.prefix.parent_path().string() + ": " + ec.message();
+      return artifact;
+    }
+
+#ifndef _WIN32
+    DepArtifactBuildLock lock(sibling(artifact.prefix, ".lock"));
+    if (!lock.acquired())
+    {
+      error = "cannot lock " + sibling(artifact.prefix, ".lock").string();
+      return artifact;
+    }
+
+    // Another process may have produced the prefix while we waited.
+    load_state(key, artifact);
+    if (artifact.ready || artifact.failed)
+    {
+      if (artifact.failed)
+        error = "a prebuilt build of " + key.id + " (" + key.buildType + ") failed less than a day ago";
+      return artifact;
+    }
+#endif
+
+    (void)build_and_install(key, sourceDir, artifact, error);
+    load_state(key, artifact);
+    return artifact;
+  }
+
+  std::vector<std::string> dep_artifact_build_types()
+  {
+    return {"Debug", "Release"};
+  }
+
+  bool prebuilt_switch_enabled(const char *variable)
+  {
+    const char *v = vix::utils::vix_getenv(variable);
+    if (!v)
+      return true;
+
+    const std::string s(v);
+    return !(s == "0" || s == "false" || s == "off" || s == "no");
+  }
+
+  bool dep_artifacts_enabled()
+  {
+#ifdef _WIN32
+    return false;
+#else
+    return prebuilt_switch_enabled("VIX_PREBUILT_DEPS");
+#endif
+  }
+
+} // namespace vix::cli::build
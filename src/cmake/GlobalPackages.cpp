@@ -53,11 +53,6 @@ namespace vix::cli::build
       return vix_root() / "global" / "installed.json";
     }
 
-    static fs::path artifact_cache_root()
-    {
-      return vix_root() / "cache" / "build";
-    }
-
     static std::string dep_id_to_dir(std::string depId)
     {
       depId.erase(std::remove(depId.begin(), depId.end(), '@'), depId.end());
@@ -253,6 +248,11 @@ namespace vix::cli::build
     }
   } // namespace
 
+  fs::path artifact_cache_root()
+  {
+    return vix_root() / "cache" / "build";
+  }
+
   std::vector<GlobalPackage> load_global_packages()
   {
     std::vector<GlobalPackage> out;
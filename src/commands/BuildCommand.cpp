@@ -58,6 +58,7 @@
 #endif
 
 #include <vix/cli/cmake/CMakeBuild.hpp>
+#include <vix/cli/cmake/DepArtifacts.hpp>
 #include <vix/cli/cmake/GlobalPackages.hpp>
 #include <vix/cli/cmake/Toolchain.hpp>
 #include <vix/cli/util/Args.hpp>
@@ -1254,44 +1255,18 @@ namespace vix::commands::BuildCommand
 
     static std::string detect_native_target_triple()
     {
-#if defined(__x86_64__) && defined(__linux__)
-      return "x86_64-linux-gnu";
-#elif defined(__aarch64__) && defined(__linux__)
-      return "aarch64-linux-gnu";
-#elif defined(__arm__) && defined(__linux__)
-      return "arm-linux-gnueabihf";
-#elif defined(__riscv) && (__riscv_xlen == 64) && defined(__linux__)
-      return "riscv64-linux-gnu";
-#elif defined(_WIN32) && defined(_M_X64)
-      return "x86_64-windows-msvc";
-#elif defined(_WIN32) && defined(_M_ARM64)
-      return "aarch64-windows-msvc";
-#elif defined(__APPLE__) && defined(__aarch64__)
-      return "aarch64-apple-darwin";
-#elif defined(__APPLE__) && defined(__x86_64__)
-      return "x86_64-apple-darwin";
-#else
-      return "unknown-target";
-#endif
+      return vix::cli::build::native_target_triple();
     }
 
+    /**
+     * @brief Identify the C++ compiler CMake will pick up ($CXX, else c++).
+     *
+     * Shared with the prebuilt dependency artifacts of `vix install`, so both
+     * key their cache entries on the same compiler component.
+     */
     static std::string detect_compiler_identity()
     {
-#ifdef __clang__
-      return sanitize_cache_component(
-          "clang++-" + std::to_string(__clang_major__) + "." +
-          std::to_string(__clang_minor__) + "." +
-          std::to_string(__clang_patchlevel__));
-#elif defined(__GNUC__)
-      return sanitize_cache_component(
-          "g++-" + std::to_string(__GNUC__) + "." +
-          std::to_string(__GNUC_MINOR__) + "." +
-          std::to_string(__GNUC_PATCHLEVEL__));
-#elif defined(_MSC_VER)
-      return sanitize_cache_component("msvc-" + std::to_string(_MSC_VER));
-#else
-      return "unknown-compiler";
-#endif
+      return vix::cli::build::compiler_identity_component();
     }
 
     static std::string make_artifact_fingerprint(
@@ -1438,6 +1413,10 @@ namespace vix::commands::BuildCommand
       if (opt.linkStatic)
         return false;
 
+      // Binaries of an unidentified compiler must not be shared.
+      if (detect_compiler_identity().empty())
+        return false;
+
       return true;
     }
 
@@ -106,7 +106,9 @@ namespace vix::commands::DevCommand
     out << "  --watch                     Enabled by default in vix dev\n";
     out << "  --reload                    Alias for --watch\n";
     out << "  --force-server              Treat the program as a long-running server\n";
-    out << "  --force-script              Treat the program as a short-lived script\n\n";
+    out << "  --force-script              Treat the program as a short-lived script\n";
+    out << "  --listen <[host:]port>      Keep this port open across restarts (LISTEN_FDS)\n";
+    out << "  --listen=<[host:]port>      Same as --listen <[host:]port>\n\n";
 
     out << "Script mode:\n";
     out << "  --auto-deps                 Auto-add includes from .vix/deps/*/include\n";
@@ -160,6 +162,7 @@ namespace vix::commands::DevCommand
     out << "  vix dev api --args --port --args 8080\n";
     out << "  vix dev api --cwd ./runtime\n";
     out << "  vix dev api --env PORT=8080\n";
+    out << "  vix dev api --listen 8080\n";
     out << "  vix dev main.cpp\n";
     out << "  vix dev main.cpp --run hello 123\n";
     out << "  vix dev main.cpp --args hello --args 123\n";
@@ -20,6 +20,7 @@
 #include <vix/cli/commands/ReplayCommand.hpp>
 #include <vix/cli/commands/CheckCommand.hpp>
 #include <vix/cli/commands/TestsCommand.hpp>
+#include <vix/cli/commands/BenchCommand.hpp>
 #include <vix/cli/commands/PackCommand.hpp>
 #include <vix/cli/commands/VerifyCommand.hpp>
 #include <vix/cli/commands/ReplCommand.hpp>
@@ -197,6 +198,14 @@ namespace vix::cli::dispatch
          []()
          { return vix::commands::TestsCommand::help(); }});
 
+    add({"bench",
+         "Project",
+         "Run benchmarks and compare with the baseline",
+         [](const Args &a)
+         { return vix::commands::BenchCommand::run(a); },
+         []()
+         { return vix::commands::BenchCommand::help(); }});
+
     add({"repl",
          "Project",
          "Start interactive Vix REPL",
@@ -12,6 +12,7 @@
  *
  */
 #include <vix/cli/commands/DoctorCommand.hpp>
+#include <vix/cli/util/CompilerIdentity.hpp>
 #include <vix/cli/util/Ui.hpp>
 #include <vix/cli/Style.hpp>
 #include <vix/utils/Env.hpp>
@@ -1768,6 +1769,28 @@ namespace vix::commands
       vix::cli::util::warn_line(std::cerr, "minisign: missing (optional; sha256 still secures upgrades)");
 #endif
 
+    const std::string cxx = vix::cli::util::default_cxx_compiler();
+    const auto compiler = vix::cli::util::compiler_identity(cxx);
+
+    vix::cli::util::section(std::cout, "Compiler");
+    if (compiler)
+    {
+      vix::cli::util::kv(std::cout, "cxx", cxx);
+      vix::cli::util::kv(std::cout, "path", compiler->path);
+      vix::cli::util::kv(std::cout, "identity", vix::cli::util::compiler_identity_tag(*compiler));
+      vix::cli::util::kv(std::cout, "target", compiler->target);
+      vix::cli::util::kv(std::cout, "default_std", compiler->defaultStandard);
+      vix::cli::util::kv(std::cout, "include_dirs", std::to_string(compiler->builtinIncludeDirs.size()));
+      vix::cli::util::kv(std::cout, "identity_cache",
+                         vix::cli::util::compiler_identity_cache_file().string() +
+                             (compiler->fromCache ? " (hit)" : " (probed)"));
+    }
+    else
+    {
+      vix::cli::util::warn_line(std::cerr, "compiler: " + cxx + " not found or not answering");
+      vix::cli::util::warn_line(std::cerr, "Tip: install g++ or clang++, or set CXX");
+    }
+
     if (const char *lvl = vix::utils::vix_getenv("VIX_LOG_LEVEL"))
       vix::cli::util::kv(std::cout, "VIX_LOG_LEVEL", std::string(lvl));
 
@@ -1824,6 +1847,24 @@ namespace vix::commands
       out["latest"] = latestTag.has_value() ? *latestTag : "";
       out["update_available"] = updateAvailable;
 
+      if (compiler)
+      {
+        out["compiler"] = {
+            {"cxx", cxx},
+            {"path", compiler->path},
+            {"family", compiler->family},
+            {"version", compiler->version},
+            {"target", compiler->target},
+            {"default_std", compiler->defaultStandard},
+            {"include_dirs", compiler->builtinIncludeDirs},
+            {"from_cache", compiler->fromCache},
+        };
+      }
+      else
+      {
+        out["compiler"] = nullptr;
+      }
+
 #ifndef _WIN32
       out["have_curl"] = have_cmd("curl");
       out["have_wget"] = have_cmd("wget");
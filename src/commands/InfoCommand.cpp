@@ -12,6 +12,7 @@
  *
  */
 #include <vix/cli/commands/InfoCommand.hpp>
+#include <vix/cli/registry/RegistryIndex.hpp>
 #include <vix/cli/util/Ui.hpp>
 #include <vix/cli/Style.hpp>
 #include <vix/utils/Env.hpp>
@@ -381,6 +382,20 @@ namespace vix::commands
       return nullptr;
     }
 
+    static std::string registry_latest_version(const std::string &id)
+    {
+      const auto slash = id.find('/');
+      if (slash == std::string::npos)
+        return {};
+
+      const auto index = vix::cli::registry::open_registry_index(registry_index_dir());
+      if (!index)
+        return {};
+
+      const auto entry = index->find(id.substr(0, slash), id.substr(slash + 1));
+      return entry ? std::string(entry->latest) : std::string();
+    }
+
     static void print_package_info(const json &pkg, bool globalMode)
     {
       const std::string id = pkg.value("id", "");
@@ -405,6 +420,10 @@ namespace vix::commands
       if (!repo.empty())
         vix::cli::util::kv(std::cout, "repo", repo);
 
+      const std::string latest = registry_latest_version(id);
+      if (!latest.empty())
+        vix::cli::util::kv(std::cout, "registry latest", latest);
+
       if (!type.empty())
         vix::cli::util::kv(std::cout, "type", type);
 
@@ -501,6 +520,9 @@ namespace vix::commands
     const std::size_t storePackageDirs = count_directories(store);
     const std::size_t storeCommitCount = count_store_commits(store);
 
+    const auto registryIndex = vix::cli::registry::open_registry_index(registry);
+    const std::size_t registryPackageCount = registryIndex ? registryIndex->size() : 0;
+
     const std::uintmax_t storeBytes = dir_size_bytes(store);
     const std::uintmax_t artifactBytes = dir_size_bytes(artifacts);
 
@@ -523,6 +545,7 @@ namespace vix::commands
 
     vix::cli::util::section(std::cout, "Caches");
     print_path_line("artifact cache", artifacts);
+    vix::cli::util::kv(std::cout, "registry packages", std::to_string(registryPackageCount));
     vix::cli::util::kv(std::cout, "store packages", std::to_string(storePackageDirs));
     vix::cli::util::kv(std::cout, "store commits", std::to_string(storeCommitCount));
     vix::cli::util::kv(std::cout, "global packages", std::to_string(globalPackageCount));
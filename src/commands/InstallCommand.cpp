@@ -14,6 +14,8 @@
 #include <vix/cli/commands/InstallCommand.hpp>
 #include <vix/cli/commands/RegistryCommand.hpp>
 #include <vix/cli/commands/run/detail/RunnableExecutableResolver.hpp>
+#include <vix/cli/cmake/DepArtifacts.hpp>
+#include <vix/cli/cmake/GlobalPackages.hpp>
 #include <vix/cli/app/AppManifest.hpp>
 #include <vix/cli/modules/ModuleGraph.hpp>
 #include <vix/cli/modules/ModuleManifest.hpp>
@@ -27,6 +29,9 @@
 #include <vix/utils/Env.hpp>
 #include <vix/cli/util/Semver.hpp>
 #include <vix/cli/util/GitProgress.hpp>
+#include <vix/cli/util/ContentStore.hpp>
+#include <vix/cli/util/FetchPool.hpp>
+#include <vix/cli/util/GitMirror.hpp>
 #include <vix/cli/util/ProjectMutation.hpp>
 
 #include <nlohmann/json.hpp>
@@ -36,9 +41,11 @@
 #include <ctime>
 #include <cctype>
 #include <cstdlib>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <optional>
 #include <set>
 #include <sstream>
@@ -88,6 +95,7 @@ namespace vix::commands
       bool gitHeaderOnly{false};
       bool allowPrerelease{false};
       bool yes{false};
+      std::size_t fetchJobs{vix::cli::util::DEFAULT_FETCH_JOBS};
     };
 
     struct PkgSpec
@@ -351,7 +359,9 @@ namespace vix::commands
     }
 
     static fs::path git_cache_checkout_path(const std::string &url, const std::string &commit);
-    static int install_project_dependencies(bool lockAlreadyHeld = false);
+    static int install_project_dependencies(
+        bool lockAlreadyHeld = false,
+        std::size_t fetchJobs = vix::cli::util::DEFAULT_FETCH_JOBS);
 
     static fs::path entry_path(const std::string &ns, const std::string &name)
     {
@@ -479,9 +489,16 @@ namespace vix::commands
     class GitInstallProgress
     {
     public:
-      GitInstallProgress(std::string dependency, std::size_t packageIndex, std::size_t packageCount)
-          : dependency_(std::move(dependency)), packageIndex_(packageIndex), packageCount_(packageCount), started_(std::chrono::steady_clock::now()), tty_(install_progress_is_tty()), parser_([this](const auto &event)
-                                                                                                                                                                                               { render(event); }) {}
+      GitInstallProgress(std::string dependency, std::size_t packageIndex, std::size_t packageCount,
+                         vix::cli::util::LiveProgressBoard *board = nullptr)
+          : dependency_(std::move(dependency)), packageIndex_(packageIndex), packageCount_(packageCount), started_(std::chrono::steady_clock::now()), tty_(install_progress_is_tty()), board_(board), parser_([this](const auto &event)
+                                                                                                                                                                                                               { render(event); })
+      {
+        // Parallel fetches share one multi-line view instead of each
+        // rewriting the current terminal line.
+        if (board_)
+          row_ = board_->add_row(dependency_);
+      }
 
       void push(std::string_view chunk) { parser_.push(chunk); }
       // A clone can spend a long time establishing the transport before Git
@@ -496,6 +513,11 @@ namespace vix::commands
       void finish()
       {
         parser_.finish();
+        if (board_)
+        {
+          board_->remove_row(row_);
+          return;
+        }
         if (visible_)
         {
           std::cout << "\r\033[2K" << std::flush;
@@ -524,7 +546,9 @@ namespace vix::commands
         if (!event.speed.empty())
           line << "  " << event.speed;
         line << RESET;
-        if (tty_)
+        if (board_)
+          board_->update(row_, event.phase, line.str());
+        else if (tty_)
           std::cout << "\r\033[2K" << line.str() << std::flush;
         else
           std::cout << dependency_ << ": " << event.phase
@@ -540,14 +564,17 @@ namespace vix::commands
       std::chrono::steady_clock::time_point started_, lastRender_{};
       bool tty_{false}, visible_{false};
       std::string lastPhase_;
+      vix::cli::util::LiveProgressBoard *board_{nullptr};
+      std::size_t row_{0};
       vix::cli::util::GitProgressParser parser_;
     };
 
     static vix::process::ProcessOutput run_git_clone_streamed(
         std::vector<std::string> args, const fs::path &cwd, const std::string &dependency,
-        std::size_t packageIndex = 0, std::size_t packageCount = 1)
+        std::size_t packageIndex = 0, std::size_t packageCount = 1,
+        vix::cli::util::LiveProgressBoard *board = nullptr)
     {
-      GitInstallProgress progress(dependency, packageIndex, packageCount);
+      GitInstallProgress progress(dependency, packageIndex, packageCount, board);
       progress.phase("connecting");
       vix::process::Command command("git");
       command.args(std::move(args));
@@ -569,7 +596,8 @@ namespace vix::commands
         const std::string &repoUrl,
         const std::string &idDot,
         const std::string &commit,
-        std::string &outDir)
+        std::string &outDir,
+        vix::cli::util::LiveProgressBoard *board = nullptr)
     {
       fs::create_directories(store_git_dir());
 
@@ -579,20 +607,17 @@ namespace vix::commands
       if (fs::exists(dst))
         return 0;
 
-      fs::create_directories(dst.parent_path());
-
-      const auto clone = run_git_clone_streamed(
-          {"clone", "--progress", "-q", repoUrl, dst.string()},
-          {}, idDot);
-      if (!clone.success())
-        return clone.exit_code == 0 ? 1 : clone.exit_code;
-
-      const auto checkout = run_process(
-          "git",
-          {"-c", "advice.detachedHead=false", "checkout", "-q", commit},
-          dst);
-      if (!checkout.success())
-        return checkout.exit_code == 0 ? 1 : checkout.exit_code;
+      try
+      {
+        const vix::cli::util::GitMirror mirror(vix_root(), repoUrl);
+        mirror.ensure_commit(commit, [&](std::vector<std::string> args)
+                             { return run_git_clone_streamed(std::move(args), {}, idDot, 0, 1, board).success(); });
+        mirror.checkout(commit, dst);
+      }
+      catch (const std::exception &)
+      {
+        return 1;
+      }
 
       return 0;
     }
@@ -615,36 +640,24 @@ namespace vix::commands
     {
       std::error_code ec;
       remove_all_if_exists(dst);
-
-#ifdef _WIN32
-      fs::create_directories(dst, ec);
-      fs::copy(
-          src,
-          dst,
-          fs::copy_options::recursive |
-              fs::copy_options::copy_symlinks |
-              fs::copy_options::overwrite_existing,
-          ec);
-      if (ec)
-        throw std::runtime_error("failed to copy dependency: " + dst.string());
-#else
       fs::create_directories(dst.parent_path(), ec);
+
+#ifndef _WIN32
       fs::create_directory_symlink(src, dst, ec);
-      if (ec)
+      if (!ec)
+        return;
+#endif
+
+      // A real directory is needed: hardlink it from the content store
+      // instead of copying the tree into every project.
+      try
       {
-        ec.clear();
-        fs::create_directories(dst, ec);
-        fs::copy(
-            src,
-            dst,
-            fs::copy_options::recursive |
-                fs::copy_options::copy_symlinks |
-                fs::copy_options::overwrite_existing,
-            ec);
-        if (ec)
-          throw std::runtime_error("failed to link/copy dependency: " + dst.string());
+        vix::cli::util::ContentStore(vix_root()).materialize(src, dst);
+      }
+      catch (const std::exception &ex)
+      {
+        throw std::runtime_error("failed to link/copy dependency: " + dst.string() + ": " + ex.what());
       }
-#endif
     }
 
     static std::string next_arg_value(const std::vector<std::string> &args, std::size_t &i, const std::string &flag)
@@ -655,6 +668,27 @@ namespace vix::commands
       return args[i];
     }
 
+    static std::size_t parse_fetch_jobs(const std::string &value)
+    {
+      std::size_t jobs = 0;
+      try
+      {
+        std::size_t used = 0;
+        jobs = static_cast<std::size_t>(std::stoul(value, &used));
+        if (used != value.size())
+          jobs = 0;
+      }
+      catch (const std::exception &)
+      {
+        jobs = 0;
+      }
+
+      if (jobs == 0 || jobs > vix::cli::util::MAX_FETCH_JOBS)
+        throw std::runtime_error("invalid value for --fetch-jobs: " + value +
+                                 " (expected 1-" + std::to_string(vix::cli::util::MAX_FETCH_JOBS) + ")");
+      return jobs;
+    }
+
     static ParsedArgs parse_args(const std::vector<std::string> &args)
     {
       ParsedArgs parsed;
@@ -697,6 +731,10 @@ namespace vix::commands
           parsed.gitHeaderOnly = true;
         else if (arg == "--pre" || arg == "--prerelease")
           parsed.allowPrerelease = true;
+        else if (arg == "--fetch-jobs" || arg == "-J")
+          parsed.fetchJobs = parse_fetch_jobs(next_arg_value(args, i, arg));
+        else if (starts_with_local(arg, "--fetch-jobs="))
+          parsed.fetchJobs = parse_fetch_jobs(arg.substr(std::string("--fetch-jobs=").size()));
         else if (starts_with_local(arg, "--name="))
           parsed.gitName = arg.substr(std::string("--name=").size());
         else if (starts_with_local(arg, "--tag="))
@@ -1757,44 +1795,20 @@ namespace vix::commands
 
     static fs::path clone_git_to_cache_or_throw(
         const std::string &url, const std::string &commit,
-        const std::string &dependency = "dependency", std::size_t packageIndex = 0, std::size_t packageCount = 1)
+        const std::string &dependency = "dependency", std::size_t packageIndex = 0, std::size_t packageCount = 1,
+        vix::cli::util::LiveProgressBoard *board = nullptr)
     {
       fs::create_directories(git_cache_dir());
       const fs::path dst = git_cache_checkout_path(url, commit);
       if (fs::exists(dst / ".git") || fs::exists(dst / "CMakeLists.txt") || fs::exists(dst / "include"))
         return dst;
 
-      const fs::path parent = dst.parent_path();
-      const fs::path tmp = parent / (dst.filename().string() + ".tmp");
-      std::error_code ec;
-      fs::create_directories(parent, ec);
-      fs::remove_all(tmp, ec);
-
-      auto output = run_git_clone_streamed(
-          {"clone", "--progress", "-q", url, tmp.string()}, {}, dependency, packageIndex, packageCount);
-      if (!output.success())
-        throw std::runtime_error("git clone failed for: " + url);
-
-      output = run_process(
-          "git",
-          {"-c", "advice.detachedHead=false", "checkout", "-q", commit},
-          tmp);
-      if (!output.success())
-      {
-        fs::remove_all(tmp, ec);
-        throw std::runtime_error("git checkout failed for: " + commit);
-      }
-
-      fs::rename(tmp, dst, ec);
-      if (ec)
-      {
-        fs::remove_all(dst, ec);
-        ec.clear();
-        fs::rename(tmp, dst, ec);
-        if (ec)
-          throw std::runtime_error("cannot move git cache checkout: " + ec.message());
-      }
-
+      // Only the objects the per-remote mirror lacks are downloaded; the
+      // checkout itself borrows them from the mirror.
+      const vix::cli::util::GitMirror mirror(vix_root(), url);
+      mirror.ensure_commit(commit, [&](std::vector<std::string> args)
+                           { return run_git_clone_streamed(std::move(args), {}, dependency, packageIndex, packageCount, board).success(); });
+      mirror.checkout(commit, dst);
       return dst;
     }
 
@@ -1991,6 +2005,160 @@ namespace vix::commands
       return out;
     }
 
+    static std::vector<std::string> dep_artifact_cmake_args(const DepResolved &dep)
+    {
+      std::vector<std::string> args = {
+          "-DBUILD_SHARED_LIBS=OFF",
+          "-DCMAKE_POSITION_INDEPENDENT_CODE=ON",
+          "-DBUILD_TESTING=OFF",
+          "-DBUILD_TESTS=OFF",
+          "-DBUILD_EXAMPLES=OFF",
+          "-DBUILD_BENCHMARKS=OFF",
+          "-DBUILD_DOCS=OFF"};
+
+      for (const auto &option : dep.cmakeOptions)
+        args.push_back("-D" + option.first + "=" + option.second);
+
+      return args;
+    }
+
+    /**
+     * Registry dependencies that can be linked from a prebuilt prefix:
+     * compiled, pinned to a commit and self-contained. A package with Vix
+     * dependencies of its own keeps building inside the project, where
+     * those dependencies exist as targets.
+     */
+    static bool dep_artifact_eligible(const DepResolved &dep)
+    {
+      if (!vix::cli::build::dep_artifacts_enabled())
+        return false;
+
+      // An unidentified compiler cannot key a shared binary.
+      if (vix::cli::build::compiler_identity_component().empty())
+        return false;
+
+      if (dep.source == "git" || dep.commit.empty() || !dep.dependencies.empty())
+        return false;
+
+      if (dep.type == "header-only" || dep.type == "header_only" || dep.type == "headers")
+        return false;
+
+      return !dep.checkout.empty() && fs::exists(dep.checkout / "CMakeLists.txt");
+    }
+
+    static vix::cli::build::DepArtifactKey dep_artifact_key(const DepResolved &dep, const std::string &buildType)
+    {
+      return vix::cli::build::make_dep_artifact_key(
+          dep.id, dep.version, dep.commit, buildType, dep_artifact_cmake_args(dep));
+    }
+
+    /**
+     * Builds the compiled registry dependencies missing from the artifact
+     * cache, once per build type. A failure is reported and remembered; the
+     * dependency then keeps building from source in the project.
+     */
+    static bool prebuild_dependency_artifacts(const std::vector<DepResolved> &deps, bool &printedHeader)
+    {
+      const fs::path cacheRoot = vix::cli::build::artifact_cache_root();
+      bool built = false;
+
+      for (const auto &dep : deps)
+      {
+        if (!dep_artifact_eligible(dep))
+          continue;
+
+        for (const std::string &buildType : vix::cli::build::dep_artifact_build_types())
+        {
+          const auto key = dep_artifact_key(dep, buildType);
+          const auto cached = vix::cli::build::describe_dep_artifact(cacheRoot, key);
+          if (cached.ready || cached.failed)
+            continue;
+
+          if (!printedHeader)
+          {
+            vix::cli::util::section(std::cout, "Installing dependencies");
+            printedHeader = true;
+          }
+
+          std::cout << "  " << CYAN << "•" << RESET << " "
+                    << CYAN << BOLD << dep.id << RESET
+                    << GRAY << "@" << RESET
+                    << YELLOW << BOLD << dep.version << RESET
+                    << "  "
+                    << GRAY << "building " << buildType << " artifact" << RESET
+                    << "\n";
+          std::cout.flush();
+
+          std::string error;
+          const auto artifact = vix::cli::build::ensure_dep_artifact(cacheRoot, key, dep.checkout, error);
+          if (!artifact.ready)
+          {
+            vix::cli::util::warn_line(std::cerr, error);
+            vix::cli::util::warn_line(std::cerr, dep.id + " will be built from source in the project");
+            continue;
+          }
+
+          built = true;
+        }
+      }
+
+      return built;
+    }
+
+    /**
+     * Emits the prebuilt branch of a dependency for every build type whose
+     * artifact is ready: the installed package config when it has one,
+     * imported static libraries otherwise. Returns false when no artifact
+     * is ready and the caller must emit only the source build.
+     */
+    static bool emit_prebuilt_dep_branches(
+        std::ostringstream &out,
+        const DepResolved &dep,
+        const std::string &depNs,
+        const std::string &depName,
+        const std::string &alias,
+        const std::string &safe,
+        const fs::path &depIncludeDir)
+    {
+      if (!dep_artifact_eligible(dep))
+        return false;
+
+      const fs::path cacheRoot = vix::cli::build::artifact_cache_root();
+      bool first = true;
+
+      for (const std::string &buildType : vix::cli::build::dep_artifact_build_types())
+      {
+        const auto artifact = vix::cli::build::describe_dep_artifact(cacheRoot, dep_artifact_key(dep, buildType));
+        if (!artifact.ready)
+          continue;
+
+        const std::string prefix = cmake_quote(artifact.prefix.generic_string());
+        out << (first ? "if" : "elseif")
+            << "(CMAKE_BUILD_TYPE STREQUAL \"" << buildType << "\" AND EXISTS "
+            << cmake_quote((artifact.prefix / "manifest.json").generic_string()) << ")\n";
+        first = false;
+
+        for (const std::string &configName : artifact.configPackages)
+          out << "  find_package(" << configName << " CONFIG QUIET PATHS " << prefix << " NO_DEFAULT_PATH)\n";
+
+        if (!artifact.configPackages.empty())
+        {
+          out << "  _vix_try_bridge_for_dep(" << depNs << " " << depName;
+          for (const auto &target : dep.cmakeTargets)
+            out << " " << target;
+          out << ")\n";
+        }
+
+        out << "  _vix_import_prebuilt_dep(" << alias << " " << safe << " " << prefix << " "
+            << cmake_quote(depIncludeDir.generic_string());
+        for (const std::string &lib : artifact.libs)
+          out << " " << cmake_quote(lib);
+        out << ")\n";
+      }
+
+      return !first;
+    }
+
     static void generate_cmake(const std::vector<DepResolved> &deps)
     {
       fs::create_directories(project_vix_dir());
@@ -2131,6 +2299,31 @@ namespace vix::commands
       out << "  endforeach()\n";
       out << "endfunction()\n\n";
 
+      out << "function(_vix_import_prebuilt_dep canonical safe prefix include_dir)\n";
+      out << "  if(TARGET ${canonical})\n";
+      out << "    return()\n";
+      out << "  endif()\n";
+      out << "\n";
+      out << "  add_library(${safe} INTERFACE)\n";
+      out << "  if(EXISTS \"${prefix}/include\")\n";
+      out << "    target_include_directories(${safe} INTERFACE \"${prefix}/include\")\n";
+      out << "  endif()\n";
+      out << "  if(EXISTS \"${include_dir}\")\n";
+      out << "    target_include_directories(${safe} INTERFACE \"${include_dir}\")\n";
+      out << "  endif()\n";
+      out << "\n";
+      out << "  set(_VIX_PREBUILT_INDEX 0)\n";
+      out << "  foreach(_VIX_PREBUILT_LIB IN LISTS ARGN)\n";
+      out << "    set(_VIX_PREBUILT_TARGET \"${safe}__prebuilt_${_VIX_PREBUILT_INDEX}\")\n";
+      out << "    add_library(${_VIX_PREBUILT_TARGET} STATIC IMPORTED GLOBAL)\n";
+      out << "    set_target_properties(${_VIX_PREBUILT_TARGET} PROPERTIES IMPORTED_LOCATION \"${prefix}/${_VIX_PREBUILT_LIB}\")\n";
+      out << "    target_link_libraries(${safe} INTERFACE ${_VIX_PREBUILT_TARGET})\n";
+      out << "    math(EXPR _VIX_PREBUILT_INDEX \"${_VIX_PREBUILT_INDEX} + 1\")\n";
+      out << "  endforeach()\n";
+      out << "\n";
+      out << "  add_library(${canonical} ALIAS ${safe})\n";
+      out << "endfunction()\n\n";
+
       out << "function(_vix_ensure_interface_dep canonical safe include_dir)\n";
       out << "  if(TARGET ${canonical})\n";
       out << "    return()\n";
@@ -2231,7 +2424,8 @@ namespace vix::commands
         else if (hasCMake)
         {
           out << "_vix_disable_dep_extras(" << depNs << " " << depName << ")\n";
-          out << "if(EXISTS " << cmake_quote(depCMake.string()) << ")\n";
+          const bool prebuilt = emit_prebuilt_dep_branches(out, dep, depNs, depName, alias, safe, depIncludeDir);
+          out << (prebuilt ? "elseif" : "if") << "(EXISTS " << cmake_quote(depCMake.string()) << ")\n";
           out << "  add_subdirectory("
               << cmake_quote(depSourceDir.string()) << " "
               << cmake_quote((project_vix_dir() / buildDirName).string())
@@ -3930,6 +4124,9 @@ namespace vix::commands
       }
 #endif
 
+      if (fs::is_directory(status))
+        return !vix::cli::util::ContentStore(vix_root()).is_materialized(expectedTarget, link);
+
       return true;
     }
 
@@ -4350,7 +4547,7 @@ namespace vix::commands
         vix::cli::util::err_line(std::cerr, ex.what());
         return 1;
       }
-      const int rc = install_project_dependencies(true);
+      const int rc = install_project_dependencies(true, parsed.fetchJobs);
       if (rc != 0)
         return rc;
       vix::cli::util::ok_line(std::cout, desired.name + " installed");
@@ -4408,7 +4605,7 @@ namespace vix::commands
         return 1;
       }
 
-      const int rc = install_project_dependencies(true);
+      const int rc = install_project_dependencies(true, parsed.fetchJobs);
       if (rc != 0)
       {
         try
@@ -4432,7 +4629,111 @@ namespace vix::commands
 
     // vix.lock is both input and authoritative output. Hold the common lock
     // through resolution and publication to prevent lost-update races.
-    static int install_project_dependencies(bool lockAlreadyHeld)
+    static fs::path install_stamp_path()
+    {
+      return project_vix_dir() / "install-stamp.json";
+    }
+
+    static std::string file_fingerprint(const fs::path &p)
+    {
+      return vix::cli::util::read_file_hash_hex(p).value_or("missing");
+    }
+
+    // HEAD plus the size and mtime of every file outside .git: catches a
+    // moved HEAD or an edited dependency without spawning git or hashing
+    // contents.
+    static std::string checkout_signature(const fs::path &checkout)
+    {
+      std::error_code ec;
+      const fs::path dotGit = checkout / ".git";
+      const std::string head = fs::is_directory(dotGit, ec) ? file_fingerprint(dotGit / "HEAD") : file_fingerprint(dotGit);
+      return head + ":" + vix::cli::util::tree_signature(checkout);
+    }
+
+    static std::string link_signature(const fs::path &link)
+    {
+      std::error_code ec;
+      const auto status = fs::symlink_status(link, ec);
+      if (ec || status.type() == fs::file_type::not_found)
+        return "missing";
+      if (status.type() == fs::file_type::symlink)
+        return "symlink:" + fs::read_symlink(link, ec).generic_string();
+      return "copy:" + checkout_signature(link);
+    }
+
+    static json current_install_inputs()
+    {
+      return json{
+          {"stampVersion", 2},
+          {"vixRoot", vix_root().generic_string()},
+          {"compiler", vix::cli::build::compiler_identity_component()},
+          {"prebuilt", vix::cli::build::dep_artifacts_enabled()},
+          {"lock", file_fingerprint(lock_path())},
+          {"app", file_fingerprint(fs::current_path() / "vix.app")},
+          {"depsCmake", file_fingerprint(project_deps_cmake())}};
+    }
+
+    // Recorded after a successful install. When vix.lock, vix.app, the
+    // generated CMake file and every checkout and link still match it, the
+    // install has nothing to do and none of the checks need to run again.
+    static void write_install_stamp(const std::vector<DepResolved> &resolved)
+    {
+      json stamp = current_install_inputs();
+      stamp["deps"] = json::array();
+      for (const DepResolved &dep : resolved)
+      {
+        stamp["deps"].push_back({{"checkout", dep.checkout.generic_string()},
+                                 {"checkoutSig", checkout_signature(dep.checkout)},
+                                 {"link", dep.linkDir.generic_string()},
+                                 {"linkSig", link_signature(dep.linkDir)}});
+      }
+
+      std::error_code ec;
+      const fs::path tmp = install_stamp_path().string() + ".tmp";
+      {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out || !(out << stamp.dump(2) << "\n"))
+          return;
+      }
+      fs::rename(tmp, install_stamp_path(), ec);
+      if (ec)
+        fs::remove(tmp, ec);
+    }
+
+    static bool install_stamp_is_current()
+    {
+      try
+      {
+        if (!fs::exists(install_stamp_path()) || !fs::exists(lock_path()))
+          return false;
+
+        const json stamp = read_json_or_throw(install_stamp_path());
+        const json inputs = current_install_inputs();
+        for (const auto &[key, value] : inputs.items())
+        {
+          if (!stamp.contains(key) || stamp[key] != value)
+            return false;
+        }
+
+        // No deps is a valid state: vix.lock and vix.app already matched.
+        if (!stamp.contains("deps") || !stamp["deps"].is_array())
+          return false;
+
+        for (const json &dep : stamp["deps"])
+        {
+          if (checkout_signature(dep.at("checkout").get<std::string>()) != dep.at("checkoutSig").get<std::string>() ||
+              link_signature(dep.at("link").get<std::string>()) != dep.at("linkSig").get<std::string>())
+            return false;
+        }
+        return true;
+      }
+      catch (const std::exception &)
+      {
+        return false;
+      }
+    }
+
+    static int install_project_dependencies(bool lockAlreadyHeld, std::size_t fetchJobs)
     {
       std::optional<vix::cli::util::ProjectMutationLock> mutationLock;
       if (!lockAlreadyHeld)
@@ -4444,6 +4745,13 @@ namespace vix::commands
           return 1;
         }
       }
+
+      if (install_stamp_is_current())
+      {
+        vix::cli::util::ok_line(std::cout, "Dependencies already up to date");
+        return 0;
+      }
+
       bool didWork = false;
       bool printedHeader = false;
       bool printedRefreshLine = false;
@@ -4516,71 +4824,121 @@ namespace vix::commands
           vix::cli::util::err_line(std::cerr, std::string("failed to generate CMake integration: ") + ex.what());
           return 1;
         }
+        write_install_stamp({});
         vix::cli::util::warn_line(std::cout, "No dependencies to install");
         return 0;
       }
 
       fs::create_directories(project_deps_dir());
 
-      std::vector<DepResolved> resolved;
-      resolved.reserve(depsArr.size());
+      std::vector<DepResolved> pending;
+      pending.reserve(depsArr.size());
 
       for (auto &d : depsArr)
       {
-        DepResolved dep;
         try
         {
-          dep = resolve_dep_from_lock_entry(d);
+          pending.push_back(resolve_dep_from_lock_entry(d));
         }
         catch (const std::exception &ex)
         {
           vix::cli::util::err_line(std::cerr, ex.what());
           return 1;
         }
+      }
 
-        const fs::path link = project_deps_dir() / sanitize_id_dot(dep.id);
+      // Fetches run on the pool; hash checks, links and lockfile edits stay
+      // on this thread, in lockfile order, each one starting as soon as its
+      // own fetch is done. Entries sharing a checkout share one fetch.
+      // Everything the jobs write to is declared before the pool: on an
+      // early return ~FetchPool joins fetches still running, and their
+      // results must outlive it.
+      constexpr std::size_t noFetch = static_cast<std::size_t>(-1);
+      vix::cli::util::LiveProgressBoard board(std::cout, install_progress_is_tty());
+      std::vector<std::size_t> fetchOf(pending.size(), noFetch);
+      std::deque<fs::path> fetched;
+      std::map<std::string, std::size_t> fetchByCheckout;
+      vix::cli::util::FetchPool pool(fetchJobs);
 
-        const bool checkoutExistedBefore = fs::exists(dep.checkout);
-        const bool linkExistedBefore = fs::exists(link);
-        const bool linkNeedsUpdate = dependency_link_needs_update(link, dep.checkout);
+      for (std::size_t i = 0; i < pending.size(); ++i)
+      {
+        const DepResolved &dep = pending[i];
+        if (fs::exists(dep.checkout))
+          continue;
+
+        if (!printedHeader)
+        {
+          vix::cli::util::section(std::cout, "Installing dependencies");
+          printedHeader = true;
+        }
+
+        const auto known = fetchByCheckout.find(dep.checkout.string());
+        if (known != fetchByCheckout.end())
+        {
+          fetchOf[i] = known->second;
+          continue;
+        }
+
+        fetched.emplace_back();
+        fs::path &out = fetched.back();
+        const std::size_t count = pending.size();
+
+        // Jobs are numbered in submission order, like the slots of `fetched`.
+        std::size_t slot = 0;
+        if (dep.source == "git")
+        {
+          slot = pool.submit([&out, &board, dep, i, count]()
+                             { out = clone_git_to_cache_or_throw(dep.repo, dep.commit, dep.id, i, count, &board); });
+        }
+        else
+        {
+          slot = pool.submit([&out, &board, dep]()
+                             {
+                               std::string outDir;
+                               if (clone_checkout(dep.repo, sanitize_id_dot(dep.id), dep.commit, outDir, &board) != 0)
+                                 throw std::runtime_error("Check git access, network, or re-add with a valid version.");
+                               out = fs::path(outDir); });
+        }
+
+        fetchOf[i] = slot;
+        fetchByCheckout.emplace(dep.checkout.string(), slot);
+      }
+
+      std::vector<DepResolved> resolved;
+      resolved.reserve(pending.size());
+
+      for (std::size_t i = 0; i < pending.size(); ++i)
+      {
+        auto &d = depsArr[i];
+        DepResolved dep = std::move(pending[i]);
 
+        const bool checkoutExistedBefore = fetchOf[i] == noFetch;
         if (!checkoutExistedBefore)
         {
-          if (!printedHeader)
+          try
           {
-            vix::cli::util::section(std::cout, "Installing dependencies");
-            printedHeader = true;
+            pool.wait(fetchOf[i]);
           }
-
-          if (dep.source == "git")
+          catch (const std::exception &ex)
           {
-            try
-            {
-              dep.checkout = clone_git_to_cache_or_throw(dep.repo, dep.commit, dep.id, resolved.size(), depsArr.size());
-            }
-            catch (const std::exception &ex)
-            {
-              vix::cli::util::err_line(std::cerr, std::string("fetch failed: ") + dep.id);
-              vix::cli::util::warn_line(std::cerr, ex.what());
-              return 1;
-            }
+            pool.cancel_pending();
+            vix::cli::util::LiveProgressBoard::Pause quiet(&board);
+            vix::cli::util::err_line(std::cerr, std::string("fetch failed: ") + dep.id);
+            vix::cli::util::warn_line(std::cerr, ex.what());
+            return 1;
           }
-          else
-          {
-            std::string outDir;
-            const int rc = clone_checkout(dep.repo, sanitize_id_dot(dep.id), dep.commit, outDir);
-            if (rc != 0)
-            {
-              vix::cli::util::err_line(std::cerr, "fetch failed: " + dep.id);
-              vix::cli::util::warn_line(std::cerr, "Check git access, network, or re-add with a valid version.");
-              return rc;
-            }
 
-            dep.checkout = fs::path(outDir);
-          }
+          dep.checkout = fetched[fetchOf[i]];
           didWork = true;
         }
 
+        vix::cli::util::LiveProgressBoard::Pause quiet(&board);
+
+        const fs::path link = project_deps_dir() / sanitize_id_dot(dep.id);
+
+        const bool linkExistedBefore = fs::exists(link);
+        const bool linkNeedsUpdate = dependency_link_needs_update(link, dep.checkout);
+
         if (!verify_dependency_hash_or_refresh(
                 dep,
                 d,
@@ -4588,6 +4946,7 @@ namespace vix::commands
                 printedHeader,
                 printedRefreshLine))
         {
+          pool.cancel_pending();
           return 1;
         }
 
@@ -4602,6 +4961,7 @@ namespace vix::commands
           }
           catch (const std::exception &ex)
           {
+            pool.cancel_pending();
             vix::cli::util::err_line(std::cerr, std::string("install failed: ") + ex.what());
             return 1;
           }
@@ -4648,6 +5008,9 @@ namespace vix::commands
         didWork = true;
       }
 
+      if (prebuild_dependency_artifacts(resolved, printedHeader))
+        didWork = true;
+
       const bool cmakeExistedBefore = fs::exists(project_deps_cmake());
 
       try
@@ -4664,6 +5027,8 @@ namespace vix::commands
       if (!cmakeExistedBefore)
         didWork = true;
 
+      write_install_stamp(resolved);
+
       if (!didWork)
       {
         vix::cli::util::ok_line(std::cout, "Dependencies already up to date");
@@ -4714,7 +5079,7 @@ namespace vix::commands
       return 1;
     }
 
-    return install_project_dependencies();
+    return install_project_dependencies(false, parsed.fetchJobs);
   }
 
   int InstallCommand::help()
@@ -4740,6 +5105,11 @@ namespace vix::commands
     out << "  --header-only, --headers   Treat the dependency as header-only\n";
     out << "  --include <dir>            Include directory for header-only dependencies\n\n";
 
+    out << "Project:\n";
+    out << "  -J, --fetch-jobs <n>       Dependencies fetched in parallel (default: 8)\n";
+    out << "  Compiled registry dependencies are built once per compiler and build type\n";
+    out << "  into ~/.vix/cache/build and linked prebuilt; VIX_PREBUILT_DEPS=0 disables it.\n\n";
+
     out << "Global:\n";
     out << "  -g, --global <package>     Install a package globally\n\n";
 
@@ -12,6 +12,8 @@
  *
  */
 #include <vix/cli/commands/RegistryCommand.hpp>
+#include <vix/cli/registry/RegistryIndex.hpp>
+#include <vix/cli/registry/SearchIndex.hpp>
 #include <vix/cli/util/Shell.hpp>
 #include <vix/cli/util/Ui.hpp>
 #include <vix/cli/Style.hpp>
@@ -116,6 +118,36 @@ namespace vix::commands
       return 0;
     }
 
+    static void compile_synced_index(const fs::path &dir, bool quiet)
+    {
+      if (!quiet)
+        step("compiling index...");
+
+      std::string error;
+      const auto packages = vix::cli::registry::compile_registry_index(dir, &error);
+      if (!packages)
+      {
+        if (!quiet)
+          vix::cli::util::warn_line(std::cerr, "index not compiled: " + error);
+        return;
+      }
+
+      if (!quiet)
+        vix::cli::util::kv(std::cout, "packages", std::to_string(*packages));
+
+      const auto index = vix::cli::registry::open_registry_index(dir, &error);
+      const auto search = index ? vix::cli::registry::open_search_index(dir, *index, &error) : std::nullopt;
+      if (!search)
+      {
+        if (!quiet)
+          vix::cli::util::warn_line(std::cerr, "search index not built: " + error);
+        return;
+      }
+
+      if (!quiet)
+        vix::cli::util::kv(std::cout, "search terms", std::to_string(search->terms()));
+    }
+
     static int init_registry_manifest(bool force)
     {
       const fs::path path = manifest_path();
@@ -206,6 +238,8 @@ namespace vix::commands
           return nrc;
         }
 
+        compile_synced_index(dir, quiet);
+
         if (!quiet)
           vix::cli::util::ok_line(std::cout, "registry synced: " + dir.string());
         return 0;
@@ -220,6 +254,8 @@ namespace vix::commands
         return nrc;
       }
 
+      compile_synced_index(dir, quiet);
+
       if (!quiet)
         vix::cli::util::ok_line(std::cout, "registry synced: " + dir.string());
       return 0;
@@ -287,7 +323,7 @@ namespace vix::commands
 
         << "Subcommands:\n"
         << "  init        Create a local vix.json manifest for a package\n"
-        << "  sync        Update the local registry index\n"
+        << "  sync        Update the local registry index and compile it for lookups\n"
         << "  path        Print the local registry index path\n\n"
 
         << "Init options:\n"
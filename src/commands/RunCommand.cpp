@@ -21,6 +21,9 @@
 #include <vix/cli/manifest/VixManifest.hpp>
 #include <vix/cli/app/AppProjectResolver.hpp>
 #include <vix/cli/commands/run/detail/RunnableExecutableResolver.hpp>
+#include <vix/cli/commands/run/detail/RunProfiler.hpp>
+#include <vix/cli/commands/run/detail/RunTimings.hpp>
+#include <vix/cli/commands/run/detail/ScriptHotReload.hpp>
 #include <vix/engine/SanitizerMode.hpp>
 #include <vix/cli/Style.hpp>
 #include <vix/utils/Env.hpp>
@@ -375,6 +378,15 @@ namespace
     if (opt.withMySql)
       cmd << " --with-mysql";
 
+    if (detail::RunProfiler::instance().enabled())
+    {
+      std::string flags;
+      for (const std::string &f : detail::profile_compile_flags())
+        flags += (flags.empty() ? "" : " ") + f;
+
+      cmd << " -- " << detail::quote("-DCMAKE_CXX_FLAGS=" + flags);
+    }
+
 #ifdef _WIN32
     cmd << "\"";
 #endif
@@ -641,6 +653,9 @@ namespace
 
   int run_script_mode(Options &opt)
   {
+    if (opt.singleCpp && opt.hotReload)
+      return vix::commands::RunCommand::detail::run_single_cpp_hot_reload(opt);
+
     if (opt.singleCpp && opt.watch)
       return vix::commands::RunCommand::detail::run_single_cpp_watch(opt);
 
@@ -832,6 +847,7 @@ namespace
             opt.enableUbsanOnly,
             opt.enableThreadSanitizer);
 
+    vix::commands::RunCommand::detail::ProfileScope profile(exePath.stem().string());
     const LiveRunResult rr =
         vix::commands::RunCommand::detail::run_cmd_live_filtered_capture(
             runCmd,
@@ -841,6 +857,7 @@ namespace
             useSanRuntime,
             false,
             replayEnabled ? &replayCapture : nullptr);
+    profile.finish();
 
     if (replayEnabled)
     {
@@ -1577,6 +1594,38 @@ namespace
     return 1;
 #endif
   }
+
+  std::string run_timings_target(const Options &opt)
+  {
+    if (opt.singleCpp)
+      return opt.cppFile.filename().string();
+    if (opt.manifestMode)
+      return opt.manifestFile.filename().string();
+    return opt.appName;
+  }
+
+  // Writes the --timings report when run() returns, with its exit code.
+  class RunTimingsReport
+  {
+  public:
+    RunTimingsReport() = default;
+    RunTimingsReport(const RunTimingsReport &) = delete;
+    RunTimingsReport &operator=(const RunTimingsReport &) = delete;
+
+    ~RunTimingsReport()
+    {
+      vix::commands::RunCommand::detail::RunTimings::instance().report(std::cerr, exitCode_);
+    }
+
+    int exit_with(int exitCode) noexcept
+    {
+      exitCode_ = exitCode;
+      return exitCode;
+    }
+
+  private:
+    int exitCode_ = 1;
+  };
 } // namespace
 
 namespace vix::commands::RunCommand
@@ -1585,12 +1634,42 @@ namespace vix::commands::RunCommand
 
   int run(const std::vector<std::string> &args)
   {
+    const auto parseStart = RunTimings::Clock::now();
     Options opt = parse(args);
     const bool showUi = opt.ui;
 
     if (opt.parseFailed)
       return opt.parseExitCode;
 
+    // Reported whichever way run() returns.
+    RunTimingsReport report;
+
+    if (opt.timings != TimingsFormat::Off)
+    {
+      if (opt.watch)
+      {
+        hint("--timings is ignored in watch mode.");
+      }
+      else
+      {
+        RunTimings &timings = RunTimings::instance();
+        timings.enable(opt.timings, run_timings_target(opt));
+        timings.record("cli_startup", RunTimings::origin(), parseStart);
+        timings.record("args", parseStart, RunTimings::Clock::now());
+      }
+    }
+
+    if (opt.profileHz > 0)
+    {
+      if (opt.watch)
+        hint("--profile is ignored in watch mode.");
+      else
+        RunProfiler::instance().enable(opt.profileHz);
+    }
+
+    if (!opt.listenAddresses.empty() && !opt.devMode)
+      hint("--listen only applies to vix dev projects; ignoring it.");
+
     if (opt.manifestMode)
     {
       vix::cli::manifest::Manifest mf{};
@@ -1599,7 +1678,7 @@ namespace vix::commands::RunCommand
       {
         error("Invalid .vix manifest: " + err->message);
         hint("File: " + opt.manifestFile.string());
-        return 1;
+        return report.exit_with(1);
       }
 
       opt = vix::cli::manifest::merge_options(mf, opt);
@@ -1631,6 +1710,15 @@ namespace vix::commands::RunCommand
       opt.doubleDashArgs.clear();
     }
 
+    // Profiled scripts are compiled with frame pointers; projects are
+    // rebuilt with them in run_project_with_presets().
+    const bool profiling = RunProfiler::instance().enabled();
+    if (profiling)
+    {
+      for (const std::string &f : profile_compile_flags())
+        opt.scriptFlags.push_back(f);
+    }
+
     if (opt.manifestMode && opt.singleCpp)
       apply_manifest_auto_deps_includes(opt, opt.manifestFile);
 
@@ -1639,8 +1727,8 @@ namespace vix::commands::RunCommand
     if (opt.singleCpp)
     {
       if (!opt.tempDeps.empty())
-        return run_with_temporary_deps(opt);
-      return run_script_mode(opt);
+        return report.exit_with(run_with_temporary_deps(opt));
+      return report.exit_with(run_script_mode(opt));
     }
 
     const RunTarget target = resolve_target(opt);
@@ -1648,19 +1736,19 @@ namespace vix::commands::RunCommand
     switch (target.kind)
     {
     case RunTargetKind::Binary:
-      return run_executable_direct(
+      return report.exit_with(run_executable_direct(
           target.path,
           opt,
           "Execution failed",
-          detail::effective_timeout_sec(opt));
+          detail::effective_timeout_sec(opt)));
 
     case RunTargetKind::Script:
       opt.singleCpp = true;
       opt.cppFile = target.path;
-      return run_script_mode(opt);
+      return report.exit_with(run_script_mode(opt));
 
     case RunTargetKind::Container:
-      return run_container_target(target.path.string(), opt);
+      return report.exit_with(run_container_target(target.path.string(), opt));
 
     case RunTargetKind::Project:
     {
@@ -1675,7 +1763,7 @@ namespace vix::commands::RunCommand
       {
         error("Unable to resolve project.");
         hint(resolved.error);
-        return 1;
+        return report.exit_with(1);
       }
 
       warn_if_env_file_missing(resolved.userProjectDir, opt);
@@ -1688,16 +1776,16 @@ namespace vix::commands::RunCommand
       if (opt.watch)
       {
 #ifndef _WIN32
-        return run_project_watch(opt, resolved.userProjectDir);
+        return report.exit_with(run_project_watch(opt, resolved.userProjectDir));
 #else
         hint("Project watch mode is not yet implemented on Windows; running once without auto-reload.");
 #endif
       }
 
-      if (opt.checkOnly)
-        return run_project_with_presets(resolved.userProjectDir, opt, showUi);
+      if (opt.checkOnly || profiling)
+        return report.exit_with(run_project_with_presets(resolved.userProjectDir, opt, showUi));
 
-      return run_last_built_project(resolved.userProjectDir, opt);
+      return report.exit_with(run_last_built_project(resolved.userProjectDir, opt));
     }
 
     default:
@@ -1715,7 +1803,7 @@ namespace vix::commands::RunCommand
       hint("No run target provided.");
       hint("Use `vix run <target>` to run an executable target.");
       hint("Use `vix run --check` to check/build the current project without running it.");
-      return 0;
+      return report.exit_with(0);
     }
 
     const fs::path cwd = fs::current_path();
@@ -1724,7 +1812,7 @@ namespace vix::commands::RunCommand
     {
       error("Unable to determine the project folder.");
       hint("Try: vix run --dir <path> or run the command from a Vix project directory.");
-      return 1;
+      return report.exit_with(1);
     }
 
     const fs::path projectDir = *projectDirOpt;
@@ -1740,7 +1828,7 @@ namespace vix::commands::RunCommand
     if (!opt.singleCpp && opt.watch)
     {
 #ifndef _WIN32
-      return run_project_watch(opt, projectDir);
+      return report.exit_with(run_project_watch(opt, projectDir));
 #else
       hint("Project watch mode is not yet implemented on Windows; running once without auto-reload.");
 #endif
@@ -1753,7 +1841,7 @@ namespace vix::commands::RunCommand
     {
       error("Unable to resolve project.");
       hint(resolved.error);
-      return 1;
+      return report.exit_with(1);
     }
 
     if (!opt.devMode && !opt.watch && project_has_vue_frontend(resolved.userProjectDir))
@@ -1761,10 +1849,10 @@ namespace vix::commands::RunCommand
       print_vue_fullstack_banner();
     }
 
-    if (opt.checkOnly)
-      return run_project_with_presets(resolved.userProjectDir, opt, showUi);
+    if (opt.checkOnly || profiling)
+      return report.exit_with(run_project_with_presets(resolved.userProjectDir, opt, showUi));
 
-    return run_last_built_project(resolved.userProjectDir, opt);
+    return report.exit_with(run_last_built_project(resolved.userProjectDir, opt));
   }
 
   int help()
@@ -1803,6 +1891,7 @@ namespace vix::commands::RunCommand
     out << "Watch:\n";
     out << "  --watch                    Rebuild and restart on file changes\n";
     out << "  --reload                   Alias for --watch\n";
+    out << "  --hot-reload               Swap the code of a running script in place (vix_reload)\n";
     out << "  --force-server             Treat the program as a long-running server\n";
     out << "  --force-script             Treat the program as a short-lived script\n\n";
     out << "  --dev-mode                 Use the build-ninja project watch layout\n\n";
@@ -1814,6 +1903,9 @@ namespace vix::commands::RunCommand
     out << "  --no-env-hint              Disable the .env hint\n";
     out << "  --trace-cache              Trace script cache strategy and decisions\n";
     out << "  --no-trace-cache           Disable script cache tracing\n";
+    out << "  --timings[=json]           Report startup stage timings on stderr\n";
+    out << "  --profile[=hz]             Sample the program (Linux, default 999 Hz) and write a\n";
+    out << "                             flamegraph to .vix/profiles/\n";
     out << "  --compiler-fingerprint <mode>\n";
     out << "                             Compiler cache fingerprint: fast, strict\n\n";
 
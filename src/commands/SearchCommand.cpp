@@ -12,9 +12,10 @@
  *
  */
 #include <vix/cli/commands/SearchCommand.hpp>
+#include <vix/cli/registry/RegistryIndex.hpp>
+#include <vix/cli/registry/SearchIndex.hpp>
 #include <vix/cli/util/Ui.hpp>
 #include <vix/cli/Style.hpp>
-#include <vix/cli/util/Semver.hpp>
 #include <vix/utils/Env.hpp>
 #include <nlohmann/json.hpp>
 
@@ -22,8 +23,8 @@
 #include <cctype>
 #include <cstdlib>
 #include <filesystem>
-#include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -32,6 +33,8 @@ using json = nlohmann::json;
 namespace vix::commands
 {
   using namespace vix::cli::style;
+  using vix::cli::registry::CompiledRegistryIndex;
+  using vix::cli::registry::IndexedPackage;
 
   namespace
   {
@@ -43,13 +46,6 @@ namespace vix::commands
       return s;
     }
 
-    bool contains_icase(const std::string &hay, const std::string &needleLower)
-    {
-      if (needleLower.empty())
-        return true;
-      return to_lower(hay).find(needleLower) != std::string::npos;
-    }
-
     std::string home_dir()
     {
 #ifdef _WIN32
@@ -73,60 +69,14 @@ namespace vix::commands
       return vix_root() / "registry" / "index";
     }
 
-    fs::path registry_index_dir()
-    {
-      return registry_repo_dir() / "index";
-    }
-
-    bool registry_ready(const fs::path &repoDir, const fs::path &idxDir)
-    {
-      return fs::exists(repoDir) && fs::exists(idxDir);
-    }
-
-    json read_json_or_throw(const fs::path &p)
+    std::vector<std::string> list_strings(std::string_view list)
     {
-      std::ifstream in(p);
-      if (!in)
-        throw std::runtime_error("cannot open: " + p.string());
-      json j;
-      in >> j;
-      return j;
-    }
-
-    std::string join_keywords(const json &entry)
-    {
-      if (!entry.contains("keywords") || !entry["keywords"].is_array())
-        return {};
-
-      std::string out;
-      for (const auto &k : entry["keywords"])
-      {
-        if (!k.is_string())
-          continue;
-        if (!out.empty())
-          out += ", ";
-        out += k.get<std::string>();
-      }
+      std::vector<std::string> out;
+      for (const auto item : vix::cli::registry::split_index_list(list))
+        out.emplace_back(item);
       return out;
     }
 
-    static std::string latest_version(const json &entry)
-    {
-      if (entry.contains("latest") && entry["latest"].is_string())
-        return entry["latest"].get<std::string>();
-
-      if (!entry.contains("versions") || !entry["versions"].is_object())
-        return {};
-
-      std::vector<std::string> versions;
-      versions.reserve(entry["versions"].size());
-
-      for (auto it = entry["versions"].begin(); it != entry["versions"].end(); ++it)
-        versions.push_back(it.key());
-
-      return vix::cli::util::semver::findLatest(versions);
-    }
-
     struct Hit
     {
       std::string id;
@@ -137,7 +87,6 @@ namespace vix::commands
       std::string extension;
       std::vector<std::string> capabilities;
       std::vector<std::string> cellTypes;
-      int score{};
     };
 
     struct SearchOptions
@@ -269,94 +218,39 @@ namespace vix::commands
       return !opt.query.empty() || has_filters(opt);
     }
 
-    std::vector<std::string> json_string_array(const json &j)
+    bool matches_filters(const CompiledRegistryIndex &index, const IndexedPackage &p, const SearchOptions &opt)
     {
-      std::vector<std::string> out;
-      if (!j.is_array())
-        return out;
-      for (const auto &item : j)
-        if (item.is_string())
-          out.push_back(item.get<std::string>());
-      return out;
-    }
-
-    const json *extension_json(const json &entry, const std::string &host)
-    {
-      if (host.empty())
-        return nullptr;
-      if (!entry.contains("extensions") || !entry["extensions"].is_object())
-        return nullptr;
-      if (!entry["extensions"].contains(host) || !entry["extensions"][host].is_object())
-        return nullptr;
-      return &entry["extensions"][host];
-    }
-
-    bool matches_filters(const json &entry, const SearchOptions &opt)
-    {
-      if (!opt.packageType.empty() && to_lower(entry.value("type", "")) != opt.packageType)
+      if (!opt.packageType.empty() && to_lower(std::string(p.type)) != opt.packageType)
         return false;
-      const json *ext = extension_json(entry, opt.extensionHost);
-      if (!opt.extensionHost.empty() && ext == nullptr)
+      const auto ext = opt.extensionHost.empty() ? std::nullopt : index.extension(p, opt.extensionHost);
+      if (!opt.extensionHost.empty() && !ext)
         return false;
       if (!opt.capability.empty())
       {
-        if (ext == nullptr)
+        if (!ext)
           return false;
-        const auto caps = json_string_array(ext->value("capabilities", json::array()));
+        const auto caps = vix::cli::registry::split_index_list(ext->capabilities);
         if (std::find(caps.begin(), caps.end(), opt.capability) == caps.end())
           return false;
       }
       return true;
     }
 
-    int score_entry(const json &e, const std::string &qLower)
-    {
-      if (qLower.empty())
-        return 1;
-      const std::string ns = e.value("namespace", "");
-      const std::string name = e.value("name", "");
-      const std::string id = ns + "/" + name;
-      int s = 0;
-      if (contains_icase(id, qLower))
-        s += 100;
-      if (contains_icase(name, qLower))
-        s += 60;
-      if (contains_icase(ns, qLower))
-        s += 40;
-      if (contains_icase(e.value("displayName", ""), qLower))
-        s += 25;
-      if (contains_icase(e.value("description", ""), qLower))
-        s += 20;
-      const std::string kw = join_keywords(e);
-      if (contains_icase(kw, qLower))
-        s += 15;
-      return s;
-    }
-
-    Hit make_hit(const json &e, const SearchOptions &opt, int score)
+    Hit make_hit(const CompiledRegistryIndex &index, const IndexedPackage &p, const SearchOptions &opt)
     {
       Hit h;
-      const std::string ns = e.value("namespace", "");
-      const std::string name = e.value("name", "");
-      h.id = ns + "/" + name;
-      h.desc = e.value("description", "");
-      h.type = e.value("type", "");
-      if (e.contains("repo") && e["repo"].is_object())
-        h.repo = e["repo"].value("url", "");
-      h.latest = latest_version(e);
-      h.score = score;
+      h.id = std::string(p.namespaceName) + "/" + std::string(p.name);
+      h.desc = p.description;
+      h.type = p.type;
+      h.repo = p.repository;
+      h.latest = p.latest;
       if (!opt.extensionHost.empty())
       {
-        if (const json *ext = extension_json(e, opt.extensionHost))
+        if (const auto ext = index.extension(p, opt.extensionHost))
         {
           h.extension = opt.extensionHost;
-          h.capabilities = json_string_array(ext->value("capabilities", json::array()));
-          if (ext->contains("cellTypes") && (*ext)["cellTypes"].is_array())
-          {
-            for (const auto &cell : (*ext)["cellTypes"])
-              if (cell.is_object() && cell.contains("id") && cell["id"].is_string())
-                h.cellTypes.push_back(cell["id"].get<std::string>());
-          }
+          h.capabilities = list_strings(ext->capabilities);
+          h.cellTypes = list_strings(ext->cellTypes);
         }
       }
       return h;
@@ -396,47 +290,50 @@ namespace vix::commands
       vix::cli::util::kv(std::cout, "limit", std::to_string(options.limit));
     }
 
-    const fs::path repoDir = registry_repo_dir();
-    const fs::path idxDir = registry_index_dir();
-    if (!registry_ready(repoDir, idxDir))
+    std::string indexError;
+    const auto index = vix::cli::registry::open_registry_index(registry_repo_dir(), &indexError);
+    if (!index)
     {
       if (options.jsonOutput)
-        std::cout << json({{"ok", false}, {"error", "registry not synced"}}).dump(2) << "\n";
+        std::cout << json({{"ok", false}, {"error", indexError}}).dump(2) << "\n";
       else
       {
-        error("registry not synced");
+        error(indexError);
         hint("Run: vix registry sync");
       }
       return 1;
     }
 
-    std::vector<Hit> hits;
-    const std::string qLower = to_lower(options.query);
-    for (const auto &it : fs::directory_iterator(idxDir))
+    // Query hits come ranked from the search index; a filter-only listing
+    // keeps index order.
+    std::vector<vix::cli::registry::SearchHit> matches;
+    if (options.query.empty())
     {
-      if (!it.is_regular_file() || it.path().extension() != ".json")
-        continue;
-      try
-      {
-        const json e = read_json_or_throw(it.path());
-        if (!matches_filters(e, options))
-          continue;
-        const int s = score_entry(e, qLower);
-        if (s <= 0)
-          continue;
-        hits.push_back(make_hit(e, options, s));
-      }
-      catch (...)
+      for (std::size_t i = 0; i < index->size(); ++i)
+        matches.push_back({static_cast<std::uint32_t>(i), 1.0});
+    }
+    else
+    {
+      const auto search = vix::cli::registry::open_search_index(registry_repo_dir(), *index, &indexError);
+      if (!search)
       {
+        if (options.jsonOutput)
+          std::cout << json({{"ok", false}, {"error", indexError}}).dump(2) << "\n";
+        else
+          error(indexError);
+        return 1;
       }
+      matches = search->search(options.query, 0);
     }
 
-    std::sort(hits.begin(), hits.end(), [](const Hit &a, const Hit &b)
-              {
-      if (a.score != b.score) return a.score > b.score;
-      return a.id < b.id; });
+    if (has_filters(options))
+    {
+      matches.erase(std::remove_if(matches.begin(), matches.end(), [&](const auto &match)
+                                   { return !matches_filters(*index, index->package(match.package), options); }),
+                    matches.end());
+    }
 
-    const std::size_t total = hits.size();
+    const std::size_t total = matches.size();
     const std::size_t totalPages = total == 0 ? 1 : (total + options.limit - 1) / options.limit;
     if (options.page > totalPages)
     {
@@ -452,13 +349,16 @@ namespace vix::commands
 
     const std::size_t start = total == 0 ? 0 : (options.page - 1) * options.limit;
     const std::size_t end = std::min(start + options.limit, total);
+    vix::cli::registry::rank_search_hits(matches, end);
+    std::vector<Hit> hits;
+    for (std::size_t i = start; i < end; ++i)
+      hits.push_back(make_hit(*index, index->package(matches[i].package), options));
 
     if (options.jsonOutput)
     {
       json out = {{"query", options.query}, {"page", options.page}, {"limit", options.limit}, {"total", total}, {"items", json::array()}};
-      for (std::size_t i = start; i < end; ++i)
+      for (const auto &h : hits)
       {
-        const auto &h = hits[i];
         out["items"].push_back({{"id", h.id}, {"version", h.latest}, {"type", h.type}, {"description", h.desc}, {"extension", h.extension}, {"capabilities", h.capabilities}, {"cellTypes", h.cellTypes}});
       }
       std::cout << out.dump(2) << "\n";
@@ -473,9 +373,8 @@ namespace vix::commands
     }
 
     vix::cli::util::one_line_spacer(std::cout);
-    for (std::size_t i = start; i < end; ++i)
+    for (const auto &h : hits)
     {
-      const auto &h = hits[i];
       std::cout << h.id << "  " << h.latest << "\n";
       if (!h.desc.empty())
         std::cout << h.desc << "\n";
@@ -500,7 +399,8 @@ namespace vix::commands
         << "  vix search <query> [--page N] [--limit N]\n"
         << "  vix search --extension note [--capability kernel] [--type executable] [--json]\n\n"
         << "Description:\n"
-        << "  Search packages in the local registry index (offline).\n\n"
+        << "  Search packages in the local registry index (offline), ranked by\n"
+        << "  relevance. Matches parts of words and tolerates small typos.\n\n"
         << "Examples:\n"
         << "  vix registry sync\n"
         << "  vix search json\n"
@@ -12,6 +12,7 @@
  *
  */
 #include <vix/cli/commands/StoreCommand.hpp>
+#include <vix/cli/util/ContentStore.hpp>
 #include <vix/cli/util/Ui.hpp>
 #include <vix/cli/Style.hpp>
 #include <vix/utils/Env.hpp>
@@ -166,6 +167,29 @@ namespace vix::commands
     {
       vix::cli::util::section(std::cout, "Store");
       vix::cli::util::kv(std::cout, "root", store_root_git().string());
+      vix::cli::util::kv(std::cout, "content", vix::cli::util::ContentStore(vix_root()).root().string());
+      return 0;
+    }
+
+    int store_gc_content(bool dryRun)
+    {
+      const vix::cli::util::ContentStore store(vix_root());
+
+      vix::cli::util::section(std::cout, "Store GC");
+      vix::cli::util::kv(std::cout, "scope", "content");
+      vix::cli::util::kv(std::cout, "root", store.root().string());
+
+      if (dryRun)
+        vix::cli::util::kv(std::cout, "mode", "dry-run");
+
+      // Safe for every project: only files no project links to are removed.
+      const auto collected = store.gc(dryRun);
+
+      vix::cli::util::one_line_spacer(std::cout);
+      vix::cli::util::ok_line(std::cout, dryRun ? "GC dry-run finished." : "GC finished.");
+      vix::cli::util::kv(std::cout, dryRun ? "would remove files" : "removed files", std::to_string(collected.objects));
+      vix::cli::util::kv(std::cout, dryRun ? "would remove manifests" : "removed manifests", std::to_string(collected.manifests));
+      vix::cli::util::kv(std::cout, dryRun ? "would free" : "freed", human_bytes(collected.bytes));
       return 0;
     }
 
@@ -330,11 +354,7 @@ namespace vix::commands
       }
 
       if (!projectScope)
-      {
-        vix::cli::util::err_line(std::cerr, "GC requires --project scope in this version.");
-        vix::cli::util::warn_line(std::cerr, "Use: vix store gc --project");
-        return 1;
-      }
+        return store_gc_content(dryRun);
 
       return store_gc_project(dryRun);
     }
@@ -354,9 +374,11 @@ namespace vix::commands
         << "  path        Print local store root path\n"
         << "  gc          Garbage collect the store\n\n"
         << "GC Options:\n"
+        << "  (none)      Remove content-store files no project links to\n"
         << "  --project   Scope GC to the current project (uses vix.lock)\n"
         << "  --dry-run   List files that would be removed without deleting them\n\n"
         << "Notes:\n"
+        << "  - GC without --project only reclaims unreferenced content and is safe for all projects\n"
         << "  - GC --project keeps commits referenced by ./vix.lock\n"
         << "  - WARNING: GC --project is destructive for other projects sharing the same store.\n";
     return 0;
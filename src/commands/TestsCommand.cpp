@@ -13,12 +13,20 @@
  */
 #include <vix/cli/commands/TestsCommand.hpp>
 #include <vix/cli/commands/CheckCommand.hpp>
+#include <vix/cli/commands/run/dev/DevFileIndex.hpp>
 #include <vix/cli/commands/tests/TestsDetail.hpp>
+#include <vix/cli/commands/tests/TestsCache.hpp>
+#include <vix/cli/commands/tests/TestsImpact.hpp>
+#include <vix/cli/commands/tests/TestsOutput.hpp>
+#include <vix/cli/commands/tests/TestsScheduler.hpp>
+#include <vix/cli/commands/tests/TestsShard.hpp>
+#include <vix/cli/commands/helpers/ProcessHelpers.hpp>
 #include <vix/cli/Style.hpp>
 
 #include <vix/cli/process/Process.hpp>
 #include <vix/cli/build/BuildStyle.hpp>
 #include <vix/cli/errors/build/BuildErrorDetectors.hpp>
+#include <vix/cli/util/Fs.hpp>
 
 #include <filesystem>
 #include <unordered_map>
@@ -37,6 +45,8 @@
 #include <regex>
 #include <cctype>
 #include <mutex>
+#include <unordered_set>
+#include <set>
 
 #include <nlohmann/json.hpp>
 
@@ -96,7 +106,11 @@ namespace
   {
     int code{0};
     bool interrupted{false};
+
+    // Status lines in full, the rest as head and tail excerpts.
     std::string output;
+    fs::path outputFile; // complete output, when spooled
+    bool truncated{false};
   };
 
   struct CTestItem
@@ -140,24 +154,6 @@ namespace
     return presetName;
   }
 
-  static bool is_ignored_dir(const fs::path &p)
-  {
-    const std::string name = p.filename().string();
-    if (name.empty())
-      return true;
-
-    if (name == ".git" || name == ".idea" || name == ".vscode")
-      return true;
-
-    if (name.rfind("build", 0) == 0)
-      return true;
-
-    if (name == "dist")
-      return true;
-
-    return false;
-  }
-
   struct ScopedSilenceStdStreams
   {
     bool active{false};
@@ -276,82 +272,6 @@ namespace
     }
   };
 
-  static bool is_watched_file(const fs::path &p)
-  {
-    const auto ext = p.extension().string();
-    return ext == ".cpp" || ext == ".cc" || ext == ".cxx" ||
-           ext == ".hpp" || ext == ".hh" || ext == ".hxx" ||
-           ext == ".h" || ext == ".cmake" ||
-           p.filename() == "CMakeLists.txt" ||
-           p.filename() == "CMakePresets.json";
-  }
-
-  using StampMap = std::unordered_map<std::string, std::uintmax_t>;
-
-  static std::uintmax_t file_stamp(const fs::path &p)
-  {
-    std::error_code ec;
-    const auto t = fs::last_write_time(p, ec);
-    if (ec)
-      return 0;
-
-    return static_cast<std::uintmax_t>(t.time_since_epoch().count());
-  }
-
-  static StampMap snapshot_tree(const fs::path &root)
-  {
-    StampMap m;
-    std::error_code ec;
-
-    if (!fs::exists(root, ec))
-      return m;
-
-    fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec);
-    fs::recursive_directory_iterator end;
-
-    for (; it != end; it.increment(ec))
-    {
-      if (ec)
-        continue;
-
-      const fs::path p = it->path();
-
-      if (it->is_directory(ec))
-      {
-        if (is_ignored_dir(p))
-          it.disable_recursion_pending();
-        continue;
-      }
-
-      if (!it->is_regular_file(ec))
-        continue;
-
-      if (!is_watched_file(p))
-        continue;
-
-      m[p.string()] = file_stamp(p);
-    }
-
-    return m;
-  }
-
-  static bool has_changes(const StampMap &a, const StampMap &b)
-  {
-    if (a.size() != b.size())
-      return true;
-
-    for (const auto &kv : a)
-    {
-      auto it = b.find(kv.first);
-      if (it == b.end())
-        return true;
-      if (it->second != kv.second)
-        return true;
-    }
-
-    return false;
-  }
-
   static std::optional<std::string> value_after_flag(
       const std::vector<std::string> &args,
       const std::string &flag)
@@ -799,14 +719,90 @@ namespace
     std::cout << std::flush;
   }
 
+  static void render_test_progress(
+      const std::string &progressLabel,
+      std::size_t frame,
+      int doneCount,
+      int startedCount,
+      int totalCount,
+      std::chrono::steady_clock::time_point begin,
+      std::string current)
+  {
+    const char frames[] = {'|', '/', '-', '\\'};
+    const int runningCount = (std::max)(0, startedCount - doneCount);
+
+    std::ostringstream plainPrefix;
+
+    plainPrefix << "  "
+                << frames[frame % 4]
+                << " "
+                << progressLabel
+                << " (";
+
+    if (totalCount > 0)
+      plainPrefix << doneCount << "/" << totalCount << " done";
+    else
+      plainPrefix << doneCount << " done";
+
+    if (startedCount > 0)
+      plainPrefix << ", " << runningCount << " running";
+
+    plainPrefix << ", " << format_elapsed_seconds(begin) << ")";
+
+    const std::size_t width = terminal_columns();
+    const std::size_t prefixWidth = plainPrefix.str().size();
+
+    if (!current.empty() && width > prefixWidth + 4)
+    {
+      current = truncate_for_terminal(
+          current,
+          width - prefixWidth - 4);
+    }
+    else if (width <= prefixWidth + 4)
+    {
+      current.clear();
+    }
+
+    std::cout << "\r\033[2K"
+              << "  "
+              << CYAN << frames[frame % 4] << RESET
+              << " "
+              << progressLabel
+              << " "
+              << GRAY
+              << "(";
+
+    if (totalCount > 0)
+      std::cout << doneCount << "/" << totalCount << " done";
+    else
+      std::cout << doneCount << " done";
+
+    if (startedCount > 0)
+      std::cout << ", " << runningCount << " running";
+
+    std::cout << ", " << format_elapsed_seconds(begin) << ")"
+              << RESET;
+
+    if (!current.empty())
+      std::cout << " " << current;
+
+    std::cout << "   " << std::flush;
+  }
+
   static TestExecResult run_in_dir_capture(
       const fs::path &cwd,
       const std::vector<std::string> &argv,
       bool progress = false,
-      std::string progressLabel = "Running tests")
+      std::string progressLabel = "Running tests",
+      const fs::path &spoolFile = {})
   {
     TestExecResult result;
 
+    // Chatty suites can print hundreds of MB: keep the output on disk.
+    vix::commands::TestsCommand::detail::CTestOutputDigest digest;
+    if (!spoolFile.empty())
+      (void)digest.open(spoolFile);
+
     ScopedCwd sc(cwd);
 
     const std::string cmd = shell_join(argv) + " 2>&1";
@@ -836,7 +832,6 @@ namespace
       heartbeat = std::thread(
           [&]()
           {
-            const char frames[] = {'|', '/', '-', '\\'};
             std::size_t frame = 0;
 
             while (!done.load() && !g_stop.load())
@@ -848,67 +843,14 @@ namespace
                 current = currentTest;
               }
 
-              const int doneCount = completed.load();
-              const int startedCount = started.load();
-              const int totalCount = total.load();
-              const int runningCount = (std::max)(0, startedCount - doneCount);
-
-              std::ostringstream plainPrefix;
-
-              plainPrefix << "  "
-                          << frames[frame % 4]
-                          << " "
-                          << progressLabel
-                          << " (";
-
-              if (totalCount > 0)
-                plainPrefix << doneCount << "/" << totalCount << " done";
-              else
-                plainPrefix << doneCount << " done";
-
-              if (startedCount > 0)
-                plainPrefix << ", " << runningCount << " running";
-
-              plainPrefix << ", " << format_elapsed_seconds(begin) << ")";
-
-              const std::size_t width = terminal_columns();
-              const std::size_t prefixWidth = plainPrefix.str().size();
-
-              if (!current.empty() && width > prefixWidth + 4)
-              {
-                current = truncate_for_terminal(
-                    current,
-                    width - prefixWidth - 4);
-              }
-              else if (width <= prefixWidth + 4)
-              {
-                current.clear();
-              }
-
-              std::cout << "\r\033[2K"
-                        << "  "
-                        << CYAN << frames[frame % 4] << RESET
-                        << " "
-                        << progressLabel
-                        << " "
-                        << GRAY
-                        << "(";
-
-              if (totalCount > 0)
-                std::cout << doneCount << "/" << totalCount << " done";
-              else
-                std::cout << doneCount << " done";
-
-              if (startedCount > 0)
-                std::cout << ", " << runningCount << " running";
-
-              std::cout << ", " << format_elapsed_seconds(begin) << ")"
-                        << RESET;
-
-              if (!current.empty())
-                std::cout << " " << current;
-
-              std::cout << "   " << std::flush;
+              render_test_progress(
+                  progressLabel,
+                  frame,
+                  completed.load(),
+                  started.load(),
+                  total.load(),
+                  begin,
+                  current);
 
               ++frame;
               std::this_thread::sleep_for(std::chrono::milliseconds(120));
@@ -921,7 +863,7 @@ namespace
     while (fgets(buffer, sizeof(buffer), pipe) != nullptr)
     {
       const std::string line(buffer);
-      result.output += line;
+      digest.append_line(line);
 
       const std::string trimmed = trim_copy(line);
 
@@ -955,6 +897,11 @@ namespace
 
     done.store(true);
 
+    digest.close();
+    result.output = digest.text();
+    result.outputFile = digest.file();
+    result.truncated = digest.truncated();
+
     if (heartbeat.joinable())
       heartbeat.join();
 
@@ -972,6 +919,22 @@ namespace
     return result;
   }
 
+  /**
+   * @brief Print a captured run in full, from the spool file when only
+   * excerpts were kept in memory.
+   */
+  static void print_captured_output(const TestExecResult &result)
+  {
+    if (result.truncated &&
+        !result.outputFile.empty() &&
+        vix::commands::TestsCommand::detail::stream_output_file(result.outputFile, std::cout))
+    {
+      return;
+    }
+
+    std::cout << result.output;
+  }
+
   static bool file_is_executable(const fs::path &p)
   {
     std::error_code ec;
@@ -1280,9 +1243,25 @@ namespace
     if (!opt.ctestArgs.empty())
       return true;
 
+    // Impact analysis selects CTest test names.
+    if (opt.affected)
+      return true;
+
     return false;
   }
 
+  /**
+   * @brief True when the native scheduler can stand in for CTest: raw
+   * output, listing and arguments after `--` still go to CTest.
+   */
+  static bool use_test_scheduler(const vix::commands::TestsCommand::detail::Options &opt)
+  {
+    if (opt.list || opt.raw || opt.ctestPassthrough)
+      return false;
+
+    return vix::commands::TestsCommand::detail::native_test_scheduler_supported();
+  }
+
   struct ParsedTestFailure
   {
     std::string name;
@@ -1295,6 +1274,8 @@ namespace
     std::string function;
     std::string assertion;
 
+    fs::path outputFile; // complete output of this test, when spooled
+
     bool has_location() const
     {
       return !file.empty() && line > 0;
@@ -1938,12 +1919,11 @@ namespace
     return failures;
   }
 
-  static void print_clean_test_failure_details(
-      const TestExecResult &result,
-      bool verbose)
+  static void print_test_failures(
+      const std::vector<ParsedTestFailure> &failures,
+      bool verbose,
+      const fs::path &fullOutput = {})
   {
-    const auto failures = parse_test_failures(result.output);
-
     if (!failures.empty())
     {
       std::cout << "\n";
@@ -1989,6 +1969,15 @@ namespace
         {
           std::cout << "    " << failure.name << "\n";
 
+          if (!failure.outputFile.empty() &&
+              vix::commands::TestsCommand::detail::stream_output_file(
+                  failure.outputFile,
+                  std::cout,
+                  "      "))
+          {
+            continue;
+          }
+
           if (!failure.message.empty())
           {
             std::istringstream lines(failure.message);
@@ -1998,16 +1987,30 @@ namespace
               std::cout << "      " << line << "\n";
           }
         }
-
-        return;
       }
-
-      hint("No structured failure details were found.");
-      return;
+      else
+      {
+        hint("No structured failure details were found.");
+      }
+    }
+    else
+    {
+      hint("Run `vix tests -v` to show detailed Vix test output.");
+      hint("Run `vix tests --raw` to show raw runner output.");
     }
 
-    hint("Run `vix tests -v` to show detailed Vix test output.");
-    hint("Run `vix tests --raw` to show raw runner output.");
+    if (!fullOutput.empty())
+      hint("Full output: " + fullOutput.string());
+  }
+
+  static void print_clean_test_failure_details(
+      const TestExecResult &result,
+      bool verbose)
+  {
+    print_test_failures(
+        parse_test_failures(result.output),
+        verbose,
+        result.truncated ? result.outputFile : fs::path{});
   }
 
   static int run_native_tests(const vix::commands::TestsCommand::detail::Options &opt)
@@ -2034,7 +2037,8 @@ namespace
         buildDir,
         argv,
         !opt.raw,
-        "Running test runner");
+        "Running test runner",
+        vix::commands::TestsCommand::detail::test_output_dir(buildDir) / "runner.log");
     const auto end = std::chrono::steady_clock::now();
 
     const auto ms =
@@ -2059,7 +2063,7 @@ namespace
     if (opt.raw)
     {
       std::cout << "\n";
-      std::cout << result.output;
+      print_captured_output(result);
     }
     else
     {
@@ -2078,153 +2082,1325 @@ namespace
            output.find("Total Tests: 0") != std::string::npos;
   }
 
-  static int run_ctest(const vix::commands::TestsCommand::detail::Options &opt)
+  struct AffectedSelection
   {
-    const std::string presetName = resolve_preset_name(opt);
-    const fs::path buildDir = resolve_build_dir_from_preset(opt.projectDir, presetName);
+    bool ok{false};
+    std::string message;
+    std::string base;
+    std::size_t changedFiles{0};
+    vix::commands::TestsCommand::detail::AffectedTestsResult impact;
+  };
 
-    std::error_code ec;
-    if (!fs::exists(buildDir, ec) || !fs::is_directory(buildDir, ec))
+  static std::vector<std::string> split_output_lines(const std::string &output)
+  {
+    std::vector<std::string> lines;
+
+    std::istringstream in(output);
+    std::string line;
+
+    while (std::getline(in, line))
     {
-      error("No build directory found for tests.");
-      hint("Run `vix build --build-target all` first.");
-      return 1;
+      line = trim_copy(line);
+      if (!line.empty())
+        lines.push_back(line);
     }
 
-    if (!ctest_file_exists(buildDir))
-      return 2;
+    return lines;
+  }
 
-    std::vector<std::string> argv;
-    argv.push_back("ctest");
+  static std::optional<std::string> git_capture(
+      const fs::path &projectDir,
+      const std::string &args)
+  {
+    namespace helpers = vix::cli::commands::helpers;
 
-    if (opt.list)
-      argv.push_back("-N");
-    else
-      argv.push_back("--output-on-failure");
+    int code = 0;
+    const std::string output = helpers::run_and_capture_with_code(
+        "git -C " + helpers::quote(projectDir.string()) +
+            " -c core.quotepath=off " + args,
+        code);
 
-    if (!has_ctest_parallel_arg(opt.ctestArgs))
+    if (code != 0)
+      return std::nullopt;
+
+    return output;
+  }
+
+  static bool collect_changed_files(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      AffectedSelection &selection,
+      std::vector<std::string> &files)
+  {
+    namespace helpers = vix::cli::commands::helpers;
+
+    const auto topLevel = git_capture(opt.projectDir, "rev-parse --show-toplevel");
+    if (!topLevel)
     {
-      argv.push_back("--parallel");
-      argv.push_back(std::to_string(default_test_jobs()));
+      selection.message = "not a git repository";
+      return false;
     }
 
-    if (!has_ctest_timeout_arg(opt.ctestArgs))
+    const std::vector<std::string> topLines = split_output_lines(*topLevel);
+    if (topLines.empty())
     {
-      argv.push_back("--timeout");
-      argv.push_back("60");
+      selection.message = "cannot locate the git work tree";
+      return false;
     }
 
-    for (const auto &a : opt.ctestArgs)
-      argv.push_back(a);
+    const fs::path root = topLines.front();
 
-    const auto start = std::chrono::steady_clock::now();
-    const TestExecResult result = run_in_dir_capture(
-        buildDir,
-        argv,
-        !opt.raw && !opt.list,
-        "Running CTest");
-    const auto end = std::chrono::steady_clock::now();
+    // Against a branch, compare with the merge base so that commits that
+    // landed upstream meanwhile are not counted as changes.
+    std::string base = opt.affectedRev.empty() ? "HEAD" : opt.affectedRev;
+    if (!opt.affectedRev.empty())
+    {
+      if (const auto mergeBase = git_capture(
+              opt.projectDir,
+              "merge-base " + helpers::quote(opt.affectedRev) + " HEAD"))
+      {
+        const std::vector<std::string> lines = split_output_lines(*mergeBase);
+        if (!lines.empty())
+          base = lines.front();
+      }
+    }
 
-    const auto ms =
-        std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    const auto diff = git_capture(
+        opt.projectDir,
+        "diff --name-only --no-renames " + helpers::quote(base) + " --");
+    if (!diff)
+    {
+      selection.message = "git diff failed for " + base;
+      return false;
+    }
 
-    const bool ok = result.code == 0;
+    const auto untracked = git_capture(
+        opt.projectDir,
+        "ls-files --others --exclude-standard --full-name");
 
-    if (result.interrupted)
+    std::unordered_set<std::string> seen;
+    for (const std::string *output : {&*diff, untracked ? &*untracked : nullptr})
     {
-      print_test_header(opt);
-      hint("Tests interrupted by user.");
-      return 130;
+      if (!output)
+        continue;
+
+      for (const std::string &line : split_output_lines(*output))
+      {
+        std::string key = vix::commands::TestsCommand::detail::impact_path_key(line, root);
+        if (seen.insert(key).second)
+          files.push_back(std::move(key));
+      }
     }
 
-    if (ok && opt.list)
-    {
-      const std::vector<std::string> tests =
-          parse_ctest_list_output(result.output);
+    selection.base = opt.affectedRev.empty() ? "HEAD" : opt.affectedRev;
+    return true;
+  }
 
-      if (tests.empty() && ctest_output_has_no_tests(result.output))
-        return 2;
+  static void collect_ctest_entries(
+      const fs::path &file,
+      std::vector<vix::commands::TestsCommand::detail::CTestEntry> &tests,
+      std::unordered_set<std::string> &visited)
+  {
+    if (!visited.insert(file.lexically_normal().generic_string()).second)
+      return;
 
-      print_test_header(opt);
-      print_listed_tests(tests);
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+      return;
 
-      build::print_task_success_timed(
-          std::cout,
-          "Listed " +
-              std::to_string(tests.size()) +
-              " test" +
-              (tests.size() == 1 ? "" : "s"),
-          ms);
+    std::ostringstream text;
+    text << in.rdbuf();
 
-      return 0;
-    }
+    const vix::commands::TestsCommand::detail::CTestFile parsed =
+        vix::commands::TestsCommand::detail::parse_ctest_testfile(
+            text.str(),
+            file.parent_path());
 
-    if (ok)
-    {
-      const std::vector<CTestItem> tests =
-          parse_ctest_run_output(result.output);
+    tests.insert(tests.end(), parsed.tests.begin(), parsed.tests.end());
 
-      if (tests.empty() && ctest_output_has_no_tests(result.output))
-        return 2;
+    for (const fs::path &include : parsed.includes)
+      collect_ctest_entries(include, tests, visited);
 
-      print_test_header(opt);
+    for (const fs::path &subdir : parsed.subdirs)
+      collect_ctest_entries(subdir / "CTestTestfile.cmake", tests, visited);
+  }
 
-      if (opt.raw)
-      {
-        std::cout << "\n";
-        std::cout << result.output;
-      }
-      else
-      {
-        print_ctest_items(tests);
-      }
+  /**
+   * @brief Follow @p changed (absolute paths) through the Ninja graph to
+   * the registered tests.
+   */
+  static void analyze_impact_of(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      const fs::path &buildDir,
+      const std::vector<std::string> &changed,
+      AffectedSelection &selection)
+  {
+    namespace detail = vix::commands::TestsCommand::detail;
+    namespace helpers = vix::cli::commands::helpers;
 
-      build::print_task_success_timed(
-          std::cout,
-          passed_tests_message(result),
-          ms);
+    selection.changedFiles = changed.size();
+
+    std::ifstream ninjaFile(buildDir / "build.ninja", std::ios::binary);
+    if (!ninjaFile)
+    {
+      selection.message = "impact analysis needs a Ninja build (no build.ninja in " +
+                          buildDir.string() + ")";
+      return;
+    }
+
+    std::ostringstream ninjaText;
+    ninjaText << ninjaFile.rdbuf();
+
+    std::vector<detail::ImpactEdge> edges =
+        detail::parse_ninja_build_edges(ninjaText.str(), buildDir);
+
+    // Header dependencies: Ninja keeps the depfiles it consumed in
+    // .ninja_deps, readable through `ninja -t deps`.
+    int depsCode = 0;
+    const std::string depsOutput = helpers::run_and_capture_with_code(
+        "ninja -C " + helpers::quote(buildDir.string()) + " -t deps",
+        depsCode);
+
+    if (depsCode != 0)
+    {
+      selection.message = "cannot read header dependencies (`ninja -t deps` failed)";
+      return;
+    }
+
+    std::vector<detail::ImpactEdge> deps =
+        detail::parse_ninja_deps_output(depsOutput, buildDir);
+    edges.insert(
+        edges.end(),
+        std::make_move_iterator(deps.begin()),
+        std::make_move_iterator(deps.end()));
+
+    std::vector<detail::CTestEntry> tests;
+    std::unordered_set<std::string> visited;
+    collect_ctest_entries(buildDir / "CTestTestfile.cmake", tests, visited);
+
+    selection.impact = detail::compute_affected_tests(changed, edges, tests);
+
+    if (!opt.testPattern.empty() && !selection.impact.runAll)
+    {
+      try
+      {
+        const std::regex pattern(opt.testPattern);
+        auto &selected = selection.impact.tests;
+        selected.erase(
+            std::remove_if(
+                selected.begin(),
+                selected.end(),
+                [&pattern](const detail::AffectedTest &test)
+                {
+                  return !std::regex_search(test.name, pattern);
+                }),
+            selected.end());
+      }
+      catch (const std::regex_error &)
+      {
+        // Leave the selection alone; CTest reports the bad pattern.
+      }
+    }
+
+    selection.ok = true;
+  }
+
+  static AffectedSelection analyze_affected_tests(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      const fs::path &buildDir)
+  {
+    AffectedSelection selection;
+
+    std::vector<std::string> changed;
+    if (collect_changed_files(opt, selection, changed))
+      analyze_impact_of(opt, buildDir, changed, selection);
+
+    return selection;
+  }
+
+  static std::string affected_display_path(
+      const std::string &path,
+      const fs::path &projectDir,
+      const fs::path &buildDir)
+  {
+    for (const fs::path &root : {buildDir, projectDir})
+    {
+      const std::string prefix = root.lexically_normal().generic_string() + "/";
+      if (path.rfind(prefix, 0) == 0)
+        return path.substr(prefix.size());
+    }
+
+    return path;
+  }
+
+  static void print_affected_explanation(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      const AffectedSelection &selection,
+      const fs::path &buildDir)
+  {
+    print_tests_separator();
+
+    std::cout << "  " << CYAN << "affected" << RESET
+              << GRAY << " (" << selection.changedFiles << " changed file"
+              << (selection.changedFiles == 1 ? "" : "s")
+              << " since " << selection.base << ")" << RESET << "\n";
+
+    for (const auto &test : selection.impact.tests)
+    {
+      std::cout << "    " << GRAY << "• " << RESET << test.name << "\n";
+
+      std::string why;
+      for (std::size_t i = 0; i < test.chain.size(); ++i)
+      {
+        if (i > 0)
+          why += " → ";
+        why += affected_display_path(test.chain[i], opt.projectDir, buildDir);
+      }
+
+      std::cout << "      " << GRAY << why << RESET << "\n";
+    }
+
+    for (const std::string &file : selection.impact.unusedFiles)
+    {
+      std::cout << "    " << GRAY << "- "
+                << affected_display_path(file, opt.projectDir, buildDir)
+                << " (not used by any test)" << RESET << "\n";
+    }
+
+    std::cout << "\n";
+  }
+
+  enum class AffectedOutcome
+  {
+    RunAll,
+    RunSelected,
+    NothingAffected
+  };
+
+  /**
+   * @brief Apply --affected / --explain; fills @p names for RunSelected.
+   */
+  static AffectedOutcome resolve_affected_tests(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      const fs::path &buildDir,
+      std::vector<std::string> &names)
+  {
+    if (!opt.affected)
+    {
+      if (opt.explain)
+        hint("--explain only applies with --affected.");
+      return AffectedOutcome::RunAll;
+    }
+
+    const AffectedSelection selection = analyze_affected_tests(opt, buildDir);
+
+    if (!selection.ok)
+    {
+      hint("--affected: " + selection.message + "; running all tests.");
+      return AffectedOutcome::RunAll;
+    }
+
+    if (selection.impact.runAll)
+    {
+      hint("--affected: " + selection.impact.runAllReason + "; running all tests.");
+      return AffectedOutcome::RunAll;
+    }
+
+    if (opt.explain)
+      print_affected_explanation(opt, selection, buildDir);
+
+    const std::string changed =
+        std::to_string(selection.changedFiles) + " changed file" +
+        (selection.changedFiles == 1 ? "" : "s");
+
+    if (selection.impact.tests.empty())
+    {
+      print_test_header(opt);
+      success("No tests affected by " + changed + ".");
+      return AffectedOutcome::NothingAffected;
+    }
+
+    names.clear();
+    for (const auto &test : selection.impact.tests)
+      names.push_back(test.name);
+
+    if (!opt.explain)
+    {
+      hint("--affected: running " + std::to_string(names.size()) +
+           " test" + (names.size() == 1 ? "" : "s") + " reached by " + changed + ".");
+    }
+
+    return AffectedOutcome::RunSelected;
+  }
+
+  static fs::path test_history_path(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      const fs::path &buildDir)
+  {
+    if (!opt.durationsPath.empty())
+      return opt.durationsPath;
+
+    return vix::commands::TestsCommand::detail::TestDurationHistory::default_path(buildDir);
+  }
+
+  enum class TestSelectionStatus
+  {
+    Ready,
+    NoTests,
+    NothingAffected,
+    Failed
+  };
+
+  /**
+   * @brief Registered tests left after --affected, --test and, with
+   * @p applyShard, --shard; ordered longest expected first.
+   *
+   * The setup and cleanup tests of the fixtures they require are kept.
+   * @p available receives every runnable test, for later narrowing.
+   */
+  static TestSelectionStatus select_test_jobs(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      const fs::path &buildDir,
+      const vix::commands::TestsCommand::detail::TestDurationHistory &history,
+      bool applyShard,
+      std::vector<vix::commands::TestsCommand::detail::TestJob> &jobs,
+      std::vector<vix::commands::TestsCommand::detail::TestJob> *available = nullptr)
+  {
+    namespace detail = vix::commands::TestsCommand::detail;
+
+    jobs.clear();
+
+    if (!ctest_file_exists(buildDir))
+      return TestSelectionStatus::NoTests;
+
+    std::vector<detail::CTestEntry> entries;
+    std::unordered_set<std::string> visited;
+    collect_ctest_entries(buildDir / "CTestTestfile.cmake", entries, visited);
+
+    if (entries.empty())
+      return TestSelectionStatus::NoTests;
+
+    std::vector<std::string> affectedNames;
+    const AffectedOutcome affected = resolve_affected_tests(opt, buildDir, affectedNames);
+
+    if (affected == AffectedOutcome::NothingAffected)
+      return TestSelectionStatus::NothingAffected;
+
+    const std::unordered_set<std::string> selected(affectedNames.begin(), affectedNames.end());
+
+    // Same semantics as `ctest -R`: a regex searched in the test name.
+    std::optional<std::regex> pattern;
+    if (affected != AffectedOutcome::RunSelected && !opt.testPattern.empty())
+    {
+      try
+      {
+        pattern.emplace(opt.testPattern);
+      }
+      catch (const std::regex_error &)
+      {
+        error("Invalid test pattern: " + opt.testPattern);
+        return TestSelectionStatus::Failed;
+      }
+    }
+
+    std::vector<detail::TestJob> runnable;
+
+    for (const detail::CTestEntry &entry : entries)
+    {
+      if (entry.disabled || entry.command.empty())
+        continue;
+
+      // CMake registers tests whose executable is not built as NOT_AVAILABLE.
+      if (entry.command.front() == "NOT_AVAILABLE")
+        continue;
+
+      detail::TestJob job = detail::make_test_job(entry, std::chrono::seconds(60));
+
+      if (const auto expected = history.expected_seconds(job.name))
+        job.expectedSeconds = *expected;
+
+      runnable.push_back(job);
+
+      if (affected == AffectedOutcome::RunSelected && selected.count(entry.name) == 0)
+        continue;
+
+      if (pattern && !std::regex_search(entry.name, *pattern))
+        continue;
+
+      jobs.push_back(std::move(job));
+    }
+
+    detail::add_fixture_jobs(jobs, runnable);
+
+    if (applyShard && opt.shardCount > 0 && !jobs.empty())
+    {
+      std::vector<detail::ShardTest> tests;
+      for (const detail::TestJob &job : jobs)
+        tests.push_back(detail::ShardTest{job.name, job.expectedSeconds});
+
+      const std::size_t total = jobs.size();
+      const detail::ShardPlan plan = detail::plan_test_shards(std::move(tests), opt.shardCount);
+      const detail::TestShard &shard = plan.shards[static_cast<std::size_t>(opt.shardIndex - 1)];
+
+      const std::unordered_set<std::string> inShard(shard.names.begin(), shard.names.end());
+      jobs.erase(
+          std::remove_if(
+              jobs.begin(),
+              jobs.end(),
+              [&inShard](const detail::TestJob &job)
+              {
+                return inShard.count(job.name) == 0;
+              }),
+          jobs.end());
+
+      std::ostringstream expected;
+      expected.setf(std::ios::fixed);
+      expected.precision(1);
+      expected << shard.expectedSeconds;
+
+      hint("Shard " + std::to_string(opt.shardIndex) + "/" + std::to_string(opt.shardCount) +
+           ": " + std::to_string(jobs.size()) + " of " + std::to_string(total) +
+           " tests, ~" + expected.str() + "s expected.");
+
+      // An empty shard is a valid outcome when n exceeds the test count.
+      if (jobs.empty())
+        return TestSelectionStatus::Ready;
+
+      detail::add_fixture_jobs(jobs, runnable);
+    }
+
+    if (available)
+      *available = std::move(runnable);
+
+    if (jobs.empty())
+    {
+      print_test_header(opt);
+      error("No tests matched.");
+
+      if (!opt.testPattern.empty())
+        hint("No registered test name matches `" + opt.testPattern + "`.");
+
+      return TestSelectionStatus::Failed;
+    }
+
+    detail::order_longest_first(jobs);
+    return TestSelectionStatus::Ready;
+  }
+
+  static std::string test_report_status(
+      const vix::commands::TestsCommand::detail::TestJobResult &result)
+  {
+    if (!result.ran || result.skipped)
+      return "skipped";
+    if (result.timedOut)
+      return "timeout";
+    return result.passed ? "passed" : "failed";
+  }
+
+  static bool write_test_report(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      vix::commands::TestsCommand::detail::TestReport report,
+      double wallSeconds)
+  {
+    namespace detail = vix::commands::TestsCommand::detail;
+
+    report.shardCount = opt.shardCount;
+    report.shards = {detail::TestReportShard{opt.shardIndex, wallSeconds}};
+
+    for (detail::TestReportCase &test : report.cases)
+      test.shard = opt.shardIndex;
+
+    if (!vix::cli::util::write_text_file_atomic(opt.reportPath, detail::test_report_json(report)))
+    {
+      error("Cannot write test report: " + opt.reportPath.string());
+      return false;
+    }
+
+    hint("Report written to " + opt.reportPath.string());
+    return true;
+  }
+
+  static int run_ctest(const vix::commands::TestsCommand::detail::Options &opt)
+  {
+    const std::string presetName = resolve_preset_name(opt);
+    const fs::path buildDir = resolve_build_dir_from_preset(opt.projectDir, presetName);
+
+    std::error_code ec;
+    if (!fs::exists(buildDir, ec) || !fs::is_directory(buildDir, ec))
+    {
+      error("No build directory found for tests.");
+      hint("Run `vix build --build-target all` first.");
+      return 1;
+    }
+
+    if (!ctest_file_exists(buildDir))
+      return 2;
+
+    std::vector<std::string> argv;
+    argv.push_back("ctest");
+
+    if (opt.list)
+      argv.push_back("-N");
+    else
+      argv.push_back("--output-on-failure");
+
+    if (!has_ctest_parallel_arg(opt.ctestArgs))
+    {
+      argv.push_back("--parallel");
+      argv.push_back(std::to_string(default_test_jobs()));
+    }
+
+    if (!has_ctest_timeout_arg(opt.ctestArgs))
+    {
+      argv.push_back("--timeout");
+      argv.push_back("60");
+    }
+
+    std::vector<std::string> ctestArgs = opt.ctestArgs;
+
+    if (opt.affected || opt.shardCount > 0)
+    {
+      vix::commands::TestsCommand::detail::TestDurationHistory history;
+      history.load(test_history_path(opt, buildDir));
+
+      std::vector<vix::commands::TestsCommand::detail::TestJob> jobs;
+      switch (select_test_jobs(opt, buildDir, history, true, jobs))
+      {
+      case TestSelectionStatus::Ready:
+        break;
+      case TestSelectionStatus::NoTests:
+        return 2;
+      case TestSelectionStatus::NothingAffected:
+        return 0;
+      case TestSelectionStatus::Failed:
+        return 1;
+      }
+
+      if (jobs.empty())
+      {
+        print_test_header(opt);
+        success("Nothing to run in this shard.");
+        return 0;
+      }
+
+      // The selection already honours --test; replace its -R filter.
+      for (std::size_t i = 0; i + 1 < ctestArgs.size(); ++i)
+      {
+        if (ctestArgs[i] == "-R" && ctestArgs[i + 1] == opt.testPattern)
+        {
+          ctestArgs.erase(ctestArgs.begin() + static_cast<std::ptrdiff_t>(i),
+                          ctestArgs.begin() + static_cast<std::ptrdiff_t>(i + 2));
+          break;
+        }
+      }
+
+      std::vector<std::string> names;
+      for (const auto &job : jobs)
+        names.push_back(job.name);
+
+      ctestArgs.push_back("-R");
+      ctestArgs.push_back(
+          vix::commands::TestsCommand::detail::ctest_exact_names_regex(names));
+    }
+
+    for (const auto &a : ctestArgs)
+      argv.push_back(a);
+
+    const auto start = std::chrono::steady_clock::now();
+    const TestExecResult result = run_in_dir_capture(
+        buildDir,
+        argv,
+        !opt.raw && !opt.list,
+        "Running CTest",
+        vix::commands::TestsCommand::detail::test_output_dir(buildDir) / "ctest.log");
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    const bool ok = result.code == 0;
+
+    if (result.interrupted)
+    {
+      print_test_header(opt);
+      hint("Tests interrupted by user.");
+      return 130;
+    }
+
+    if (ok && opt.list)
+    {
+      const std::vector<std::string> tests =
+          parse_ctest_list_output(result.output);
+
+      if (tests.empty() && ctest_output_has_no_tests(result.output))
+        return 2;
+
+      print_test_header(opt);
+      print_listed_tests(tests);
+
+      build::print_task_success_timed(
+          std::cout,
+          "Listed " +
+              std::to_string(tests.size()) +
+              " test" +
+              (tests.size() == 1 ? "" : "s"),
+          ms);
+
+      return 0;
+    }
+
+    if (!opt.reportPath.empty())
+    {
+      // CTest prints no per-test output here; failures carry their status only.
+      vix::commands::TestsCommand::detail::TestReport report;
+      for (const CTestItem &item : parse_ctest_run_output(result.output))
+      {
+        vix::commands::TestsCommand::detail::TestReportCase test;
+        test.name = item.name;
+        test.status = item.passed ? "passed" : "failed";
+        test.seconds = std::strtod(item.duration.c_str(), nullptr);
+        report.cases.push_back(std::move(test));
+      }
+
+      if (!write_test_report(opt, std::move(report), static_cast<double>(ms) / 1000.0) && ok)
+        return 1;
+    }
+
+    if (ok)
+    {
+      const std::vector<CTestItem> tests =
+          parse_ctest_run_output(result.output);
+
+      if (tests.empty() && ctest_output_has_no_tests(result.output))
+        return 2;
+
+      print_test_header(opt);
+
+      if (opt.raw)
+      {
+        std::cout << "\n";
+        print_captured_output(result);
+      }
+      else
+      {
+        print_ctest_items(tests);
+      }
+
+      build::print_task_success_timed(
+          std::cout,
+          passed_tests_message(result),
+          ms);
 
       if (tests_verbose_enabled(opt))
       {
-        std::cout << "\n";
-        std::cout << result.output;
+        std::cout << "\n";
+        print_captured_output(result);
+      }
+
+      return 0;
+    }
+
+    print_test_header(opt);
+
+    build::print_task_failure_timed(
+        std::cout,
+        failed_tests_message(result),
+        ms);
+
+    if (opt.raw)
+    {
+      std::cout << "\n";
+      print_captured_output(result);
+    }
+    else
+    {
+      print_clean_test_failure_details(
+          result,
+          tests_verbose_enabled(opt));
+    }
+
+    return result.code;
+  }
+
+  static void print_scheduled_test_line(
+      const vix::commands::TestsCommand::detail::TestJobResult &result,
+      bool cached = false)
+  {
+    const char *statusColor = result.passed ? GREEN : RED;
+    const char *mark = result.passed ? "✓" : "✖";
+
+    std::ostringstream seconds;
+    seconds.setf(std::ios::fixed);
+    seconds.precision(2);
+    seconds << result.seconds << " sec";
+
+    std::cout << "  "
+              << statusColor << mark << RESET
+              << " "
+              << statusColor << BOLD << "unit" << RESET
+              << " "
+              << result.name
+              << " " << GRAY << (cached ? "cached" : seconds.str()) << RESET;
+
+    if (result.timedOut)
+      std::cout << " " << RED << "(timeout)" << RESET;
+    else if (result.skipped)
+      std::cout << " " << YELLOW << "(skipped)" << RESET;
+
+    std::cout << "\n";
+  }
+
+  /**
+   * @brief State kept across `vix tests --watch` iterations.
+   */
+  struct TestWatchState
+  {
+    // Failed in an earlier iteration and not passed since; run first.
+    std::unordered_set<std::string> failing;
+  };
+
+  /**
+   * @brief Run the CTest-registered tests with the native scheduler.
+   *
+   * @p onlyTests narrows the selection further (watch mode impact).
+   * Returns 2 when the build directory has no CTest file yet.
+   */
+  static int run_scheduled_tests(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      const std::unordered_set<std::string> *onlyTests = nullptr,
+      TestWatchState *watch = nullptr)
+  {
+    namespace detail = vix::commands::TestsCommand::detail;
+
+    const std::string presetName = resolve_preset_name(opt);
+    const fs::path buildDir = resolve_build_dir_from_preset(opt.projectDir, presetName);
+
+    const fs::path historyPath = test_history_path(opt, buildDir);
+    detail::TestDurationHistory history;
+    history.load(historyPath);
+
+    std::vector<detail::TestJob> jobs;
+    std::vector<detail::TestJob> available;
+    switch (select_test_jobs(opt, buildDir, history, true, jobs, &available))
+    {
+    case TestSelectionStatus::Ready:
+      break;
+    case TestSelectionStatus::NoTests:
+      return 2;
+    case TestSelectionStatus::NothingAffected:
+      return opt.reportPath.empty() || write_test_report(opt, {}, 0.0) ? 0 : 1;
+    case TestSelectionStatus::Failed:
+      return 1;
+    }
+
+    // Results would differ from CTest's; let CTest run this selection.
+    for (const detail::TestJob &job : jobs)
+    {
+      if (!job.unsupportedProperties.empty())
+      {
+        hint("Running through CTest: test `" + job.name + "` uses " +
+             job.unsupportedProperties.front() + ".");
+        return run_ctest(opt);
+      }
+    }
+
+    if (onlyTests)
+    {
+      jobs.erase(
+          std::remove_if(
+              jobs.begin(),
+              jobs.end(),
+              [onlyTests](const detail::TestJob &job)
+              {
+                return onlyTests->count(job.name) == 0;
+              }),
+          jobs.end());
+    }
+
+    detail::add_fixture_jobs(jobs, available);
+
+    if (jobs.empty())
+    {
+      print_test_header(opt);
+      success(onlyTests ? "No registered test is affected." : "Nothing to run in this shard.");
+      return opt.reportPath.empty() || write_test_report(opt, {}, 0.0) ? 0 : 1;
+    }
+
+    // Passing results are reused while the test's inputs are unchanged.
+    const fs::path cachePath = detail::TestResultCache::default_path(buildDir);
+    detail::TestResultCache cache;
+    cache.load(cachePath);
+
+    std::vector<detail::ImpactEdge> edges;
+    {
+      std::ifstream ninjaFile(buildDir / "build.ninja", std::ios::binary);
+      if (ninjaFile)
+      {
+        std::ostringstream ninjaText;
+        ninjaText << ninjaFile.rdbuf();
+        edges = detail::parse_ninja_build_edges(ninjaText.str(), buildDir);
+      }
+    }
+
+    const detail::SharedLibraryIndex libraries(edges);
+    const std::vector<std::string> envAllowlist = detail::test_cache_env_allowlist();
+
+    std::unordered_map<std::string, std::string> cacheKeys;
+    std::vector<detail::TestJobResult> cachedResults;
+    std::vector<detail::TestJob> toRun;
+
+    for (detail::TestJob &job : jobs)
+    {
+      const auto key = cache.key_for(
+          job,
+          libraries.libraries_of(detail::impact_path_key(job.command.front(), buildDir)),
+          envAllowlist);
+
+      if (key)
+      {
+        cacheKeys[job.name] = *key;
+
+        const auto seconds = opt.noTestCache ? std::nullopt : cache.cached_pass(job.name, *key);
+        if (seconds)
+        {
+          detail::TestJobResult result;
+          result.name = job.name;
+          result.ran = true;
+          result.passed = true;
+          result.seconds = *seconds;
+          cachedResults.push_back(std::move(result));
+          continue;
+        }
+      }
+
+      toRun.push_back(std::move(job));
+    }
+
+    jobs = std::move(toRun);
+
+    // A cached setup or cleanup test still runs around the tests needing it.
+    detail::add_fixture_jobs(jobs, available);
+
+    // Watch mode: what failed last time is what the user is working on.
+    if (watch && !watch->failing.empty())
+    {
+      std::stable_partition(
+          jobs.begin(),
+          jobs.end(),
+          [watch](const detail::TestJob &job)
+          {
+            return watch->failing.count(job.name) != 0;
+          });
+    }
+
+    print_test_header(opt);
+    print_tests_separator();
+
+    for (const detail::TestJobResult &result : cachedResults)
+      print_scheduled_test_line(result, true);
+
+    const int workers = default_test_jobs();
+    const bool progress = !tests_verbose_enabled(opt);
+
+    int startedCount = 0;
+    int doneCount = 0;
+    std::size_t frame = 0;
+    std::string current;
+
+    const auto begin = std::chrono::steady_clock::now();
+    auto lastRender = begin - std::chrono::seconds(1);
+
+    detail::TestSchedulerOptions options;
+    options.jobs = workers;
+    options.failFast = opt.failFast;
+    options.outputDir = detail::test_output_dir(buildDir);
+    options.stopRequested = []()
+    {
+      return g_stop.load();
+    };
+    options.onStart = [&](const detail::TestJob &job)
+    {
+      ++startedCount;
+      current = job.name;
+    };
+    options.onFinish = [&](const detail::TestJobResult &result)
+    {
+      ++doneCount;
+
+      if (progress)
+        clear_progress_line(false);
+
+      print_scheduled_test_line(result);
+    };
+    options.onTick = [&]()
+    {
+      if (!progress)
+        return;
+
+      const auto now = std::chrono::steady_clock::now();
+      if (now - lastRender < std::chrono::milliseconds(120))
+        return;
+
+      lastRender = now;
+      render_test_progress(
+          "Running tests",
+          frame++,
+          doneCount,
+          startedCount,
+          static_cast<int>(jobs.size()),
+          begin,
+          current);
+    };
+
+    const std::vector<detail::TestJobResult> results = detail::run_test_jobs(jobs, options);
+    const auto end = std::chrono::steady_clock::now();
+
+    if (progress)
+      clear_progress_line(false);
+
+    std::cout << "\n";
+
+    const auto ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+
+    const bool interrupted = g_stop.load();
+
+    std::vector<double> durations;
+    std::vector<ParsedTestFailure> failures;
+    std::size_t ran = 0;
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      const detail::TestJobResult &result = results[i];
+
+      if (!result.ran)
+        continue;
+
+      ++ran;
+
+      // A timed-out or interrupted run says nothing about the real duration.
+      if (!result.timedOut && !interrupted)
+      {
+        history.record(result.name, result.seconds);
+        durations.push_back(result.seconds);
       }
 
-      return 0;
+      if (!result.passed)
+      {
+        ParsedTestFailure failure;
+        failure.name = result.name;
+        failure.message = trim_copy(result.output);
+        failure.outputFile = result.outputFile;
+
+        if (result.timedOut)
+        {
+          const std::string limit =
+              "Timed out after " + std::to_string(jobs[i].timeout.count() / 1000) + "s";
+          failure.message = failure.message.empty() ? limit : limit + "\n" + failure.message;
+        }
+
+        enrich_failure_from_message(failure);
+        failures.push_back(std::move(failure));
+      }
     }
 
-    print_test_header(opt);
+    // A shared --durations file is only updated by `vix tests merge`.
+    if (!durations.empty() && opt.durationsPath.empty())
+      history.save(historyPath);
+
+    if (watch && !interrupted)
+    {
+      for (const detail::TestJobResult &result : results)
+      {
+        if (!result.ran)
+          continue;
+
+        if (result.passed)
+          watch->failing.erase(result.name);
+        else
+          watch->failing.insert(result.name);
+      }
+    }
+
+    // Tests killed by Ctrl+C did not fail on their own.
+    if (!interrupted && !results.empty())
+    {
+      for (const detail::TestJobResult &result : results)
+      {
+        const auto key = cacheKeys.find(result.name);
+        if (key != cacheKeys.end())
+          cache.record(result.name, key->second, result);
+      }
+
+      cache.save(cachePath);
+    }
+
+    if (interrupted)
+    {
+      hint("Tests interrupted by user.");
+      return 130;
+    }
+
+    if (!durations.empty() && ms > 0)
+    {
+      const double ideal = detail::ideal_makespan_seconds(durations, workers);
+      const double actual = static_cast<double>(ms) / 1000.0;
+
+      std::ostringstream line;
+      line.setf(std::ios::fixed);
+      line.precision(2);
+      line << "wall " << actual << "s, ideal " << ideal << "s on "
+           << workers << " worker" << (workers == 1 ? "" : "s");
+
+      if (actual > 0.0)
+      {
+        line.precision(0);
+        line << " (" << (std::min)(100.0, ideal / actual * 100.0) << "% efficient)";
+      }
+
+      std::cout << "  " << GRAY << line.str() << RESET << "\n\n";
+    }
+
+    bool reportOk = true;
+    if (!opt.reportPath.empty())
+    {
+      detail::TestReport report;
+      for (const detail::TestJobResult &result : cachedResults)
+        report.cases.push_back(detail::TestReportCase{result.name, "passed", result.seconds, {}, 0});
+
+      for (const detail::TestJobResult &result : results)
+      {
+        detail::TestReportCase test;
+        test.name = result.name;
+        test.status = test_report_status(result);
+        test.seconds = result.seconds;
+
+        if (result.ran && !result.passed)
+          test.output = result.output;
+
+        report.cases.push_back(std::move(test));
+      }
+
+      reportOk = write_test_report(opt, std::move(report), static_cast<double>(ms) / 1000.0);
+    }
+
+    ran += cachedResults.size();
+
+    const std::string total =
+        std::to_string(ran) + " test" + (ran == 1 ? "" : "s");
+
+    if (failures.empty())
+    {
+      const std::string cachedNote =
+          cachedResults.empty() ? "" : " (" + std::to_string(cachedResults.size()) + " cached)";
+
+      build::print_task_success_timed(std::cout, "Passed " + total + cachedNote, ms);
+      return reportOk ? 0 : 1;
+    }
 
     build::print_task_failure_timed(
         std::cout,
-        failed_tests_message(result),
+        "Failed " + std::to_string(failures.size()) + " of " + total,
         ms);
 
-    if (opt.raw)
+    const std::size_t planned = jobs.size() + cachedResults.size();
+    if (opt.failFast && ran < planned)
+      hint("--fail-fast: " + std::to_string(planned - ran) + " test(s) not run.");
+
+    print_test_failures(
+        failures,
+        tests_verbose_enabled(opt),
+        failures.size() == 1 ? failures.front().outputFile : options.outputDir);
+    return 1;
+  }
+
+  /**
+   * @brief --shard-report: print the shard plan as JSON on stdout.
+   */
+  static int print_shard_report(const vix::commands::TestsCommand::detail::Options &opt)
+  {
+    namespace detail = vix::commands::TestsCommand::detail;
+
+    const std::string presetName = resolve_preset_name(opt);
+    const fs::path buildDir = resolve_build_dir_from_preset(opt.projectDir, presetName);
+
+    detail::TestDurationHistory history;
+    history.load(test_history_path(opt, buildDir));
+
+    // The fan-out is sized for the whole suite, not for one diff.
+    detail::Options planOpt = opt;
+    planOpt.affected = false;
+    planOpt.explain = false;
+
+    std::vector<detail::TestJob> jobs;
+    switch (select_test_jobs(planOpt, buildDir, history, false, jobs))
     {
-      std::cout << "\n";
-      std::cout << result.output;
+    case TestSelectionStatus::Ready:
+    case TestSelectionStatus::NothingAffected:
+      break;
+    case TestSelectionStatus::NoTests:
+      error("No registered tests found in " + buildDir.string());
+      hint("Build the tests first, for example with `vix tests --list`.");
+      return 1;
+    case TestSelectionStatus::Failed:
+      return 1;
     }
-    else
+
+    std::vector<detail::ShardTest> tests;
+    for (const detail::TestJob &job : jobs)
+      tests.push_back(detail::ShardTest{job.name, job.expectedSeconds});
+
+    std::cout << detail::shard_plan_json(
+        detail::plan_test_shards(std::move(tests), opt.shardReportCount));
+
+    return 0;
+  }
+
+  static std::string join_shard_indexes(const std::vector<int> &indexes)
+  {
+    std::string out;
+    for (const int index : indexes)
     {
-      print_clean_test_failure_details(
-          result,
-          tests_verbose_enabled(opt));
+      if (!out.empty())
+        out += ", ";
+      out += std::to_string(index);
     }
+    return out;
+  }
 
-    return result.code;
+  /**
+   * @brief `vix tests merge`: combine the --report files of several shards.
+   */
+  static int run_merge(const std::vector<std::string> &args)
+  {
+    namespace detail = vix::commands::TestsCommand::detail;
+
+    for (const std::string &a : args)
+    {
+      if (a == "-h" || a == "--help")
+        return vix::commands::TestsCommand::help();
+    }
+
+    detail::MergeOptions opt;
+    try
+    {
+      opt = detail::parse_merge(args);
+    }
+    catch (const std::exception &ex)
+    {
+      error(std::string("tests merge: ") + ex.what());
+      hint("Usage: vix tests merge <report.json...> [--junit <file>] [--json <file>] [--durations <file>]");
+      return 1;
+    }
+
+    std::vector<detail::TestReport> reports;
+    for (const fs::path &input : opt.inputs)
+    {
+      const std::string text = vix::cli::util::read_text_file_or_empty(input);
+      if (text.empty())
+      {
+        error("Cannot read test report: " + input.string());
+        return 1;
+      }
+
+      auto report = detail::parse_test_report_json(text);
+      if (!report)
+      {
+        error("Not a vix tests report: " + input.string());
+        return 1;
+      }
+
+      reports.push_back(std::move(*report));
+    }
+
+    const detail::MergedTestReport merged = detail::merge_test_reports(reports);
+
+    if (merged.mixedShardCounts)
+    {
+      error("Reports come from different shard counts; they cannot be merged.");
+      return 1;
+    }
+
+    if (!merged.repeatedShards.empty())
+      hint("Shard reported more than once: " + join_shard_indexes(merged.repeatedShards));
+
+    if (!merged.repeatedTests.empty())
+    {
+      hint(std::to_string(merged.repeatedTests.size()) +
+           " test result(s) appear in more than one report; keeping the failing one.");
+    }
+
+    if (!opt.junitPath.empty() &&
+        !vix::cli::util::write_text_file_atomic(opt.junitPath, detail::test_report_junit_xml(merged.report)))
+    {
+      error("Cannot write " + opt.junitPath.string());
+      return 1;
+    }
+
+    if (!opt.jsonPath.empty() &&
+        !vix::cli::util::write_text_file_atomic(opt.jsonPath, detail::test_report_json(merged.report)))
+    {
+      error("Cannot write " + opt.jsonPath.string());
+      return 1;
+    }
+
+    if (!opt.durationsPath.empty())
+    {
+      detail::TestDurationHistory history;
+      history.load(opt.durationsPath);
+
+      for (const detail::TestReportCase &test : merged.report.cases)
+      {
+        if (test.status == "passed" || test.status == "failed")
+          history.record(test.name, test.seconds);
+      }
+
+      if (!history.save(opt.durationsPath))
+      {
+        error("Cannot write " + opt.durationsPath.string());
+        return 1;
+      }
+    }
+
+    std::size_t failed = 0;
+    for (const detail::TestReportCase &test : merged.report.cases)
+    {
+      if (test.status == "failed" || test.status == "timeout")
+        ++failed;
+    }
+
+    success("Merged " + std::to_string(reports.size()) + " report" +
+            (reports.size() == 1 ? "" : "s") + ": " +
+            std::to_string(merged.report.cases.size()) + " tests, " +
+            std::to_string(failed) + " failed.");
+
+    if (!merged.missingShards.empty())
+    {
+      error("Missing shard report(s): " + join_shard_indexes(merged.missingShards));
+      return 1;
+    }
+
+    return 0;
   }
-  static int run_tests_once(const vix::commands::TestsCommand::detail::Options &opt)
+
+  static int run_tests_once(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      TestWatchState *watch = nullptr)
   {
+    if (opt.shardReportCount > 0)
+      return print_shard_report(opt);
+
     auto run_available_tests = [&]() -> int
     {
-      if (should_force_ctest(opt))
-        return run_ctest(opt);
-
       const std::string presetName = resolve_preset_name(opt);
       const fs::path buildDir =
           resolve_build_dir_from_preset(opt.projectDir, presetName);
 
+      if (use_test_scheduler(opt) && ctest_file_exists(buildDir))
+        return run_scheduled_tests(opt, nullptr, watch);
+
+      if (should_force_ctest(opt))
+        return run_ctest(opt);
+
       if (ctest_file_exists(buildDir))
         return run_ctest(opt);
 
@@ -2268,13 +3444,143 @@ namespace
 
     return 1;
   }
+
+  /**
+   * @brief Incrementally build @p targets (paths relative to @p buildDir).
+   */
+  static int build_test_targets(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      const fs::path &buildDir,
+      const std::vector<std::string> &targets)
+  {
+    std::vector<std::string> argv = {"ninja", "-C", buildDir.string()};
+    argv.insert(argv.end(), targets.begin(), targets.end());
+
+    const std::string label =
+        targets.size() == 1 ? fs::path(targets.front()).filename().string()
+                            : std::to_string(targets.size()) + " test targets";
+
+    build::print_task_header_full(
+        std::cout,
+        "Rebuilding tests",
+        label,
+        display_preset_name(resolve_preset_name(opt)),
+        {});
+    std::cout << std::flush;
+
+    const auto start = std::chrono::steady_clock::now();
+    const TestExecResult result = run_in_dir_capture(opt.projectDir, argv);
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+    if (result.code == 0)
+    {
+      build::print_task_success_timed(std::cout, "Tests rebuilt", ms);
+      return 0;
+    }
+
+    build::print_task_failure_timed(std::cout, "Failed to rebuild tests", ms);
+    std::cout << std::flush;
+
+    print_build_failure_details(opt, result.output);
+    return result.code;
+  }
+
+  /**
+   * @brief One watch iteration: rebuild and rerun the tests reached by
+   * @p changed, or everything when the graph cannot tell.
+   */
+  static int run_watch_iteration(
+      const vix::commands::TestsCommand::detail::Options &opt,
+      const std::vector<std::string> &changed,
+      bool reconfigure,
+      TestWatchState &state)
+  {
+    if (!use_test_scheduler(opt))
+      return run_tests_once(opt);
+
+    const fs::path buildDir =
+        resolve_build_dir_from_preset(opt.projectDir, resolve_preset_name(opt));
+
+    bool full = reconfigure || !ctest_file_exists(buildDir);
+
+    std::unordered_set<std::string> names;
+    std::vector<std::string> targets;
+
+    if (!full)
+    {
+      AffectedSelection selection;
+      analyze_impact_of(opt, buildDir, changed, selection);
+
+      if (!selection.ok || selection.impact.runAll)
+      {
+        hint(std::string("Watch: ") +
+             (selection.ok ? selection.impact.runAllReason : selection.message) +
+             "; rebuilding everything.");
+        full = true;
+      }
+      else if (selection.impact.tests.empty())
+      {
+        hint("Watch: no test is affected by this change.");
+        return 0;
+      }
+      else
+      {
+        const std::string buildPrefix = buildDir.lexically_normal().generic_string() + "/";
+        std::unordered_set<std::string> seenTargets;
+
+        for (const auto &test : selection.impact.tests)
+        {
+          names.insert(test.name);
+
+          // The last link of the chain is the file the test runs.
+          const std::string &runs = test.chain.back();
+          if (runs.rfind(buildPrefix, 0) == 0 && seenTargets.insert(runs).second)
+            targets.push_back(runs.substr(buildPrefix.size()));
+        }
+      }
+    }
+
+    if (full)
+    {
+      const int buildCode = build_project_tests(opt);
+      if (buildCode != 0)
+        return buildCode;
+
+      return run_tests_once(opt, &state);
+    }
+
+    if (!targets.empty())
+    {
+      const int buildCode = build_test_targets(opt, buildDir, targets);
+      if (buildCode != 0)
+        return buildCode;
+    }
+
+    return run_scheduled_tests(opt, &names, &state);
+  }
 } // namespace
 
 namespace vix::commands::TestsCommand
 {
   int run(const std::vector<std::string> &args)
   {
-    const auto opt = vix::commands::TestsCommand::detail::parse(args);
+    if (!args.empty() && args.front() == "merge")
+      return run_merge(std::vector<std::string>(args.begin() + 1, args.end()));
+
+    vix::commands::TestsCommand::detail::Options opt;
+    try
+    {
+      opt = vix::commands::TestsCommand::detail::parse(args);
+    }
+    catch (const std::exception &ex)
+    {
+      error(std::string("tests: ") + ex.what());
+      hint("Try: vix tests --help");
+      return 1;
+    }
+
     g_stop.store(false);
     std::signal(SIGINT, on_sigint);
 
@@ -2297,10 +3603,12 @@ namespace vix::commands::TestsCommand
       return code;
     }
 
-    info("Watching project files and re-running tests on changes...");
+    info("Watching project files and re-running impacted tests on changes...");
     hint("Press Ctrl+C to stop.");
 
-    if (should_force_ctest(opt))
+    if (use_test_scheduler(opt))
+      hint("Mode: rebuild and rerun the tests reached by each change, failures first.");
+    else if (should_force_ctest(opt))
       hint("Mode: CTest forced by passthrough args.");
     else
       hint("Mode: native runner first, CTest fallback.");
@@ -2308,55 +3616,60 @@ namespace vix::commands::TestsCommand
     g_stop.store(false);
     std::signal(SIGINT, on_sigint);
 
-    const fs::path projectDir = opt.projectDir;
+    // Same file index as `vix dev`: kernel events, polling as a fallback.
+    vix::commands::RunCommand::dev::DevFileIndex index(opt.projectDir);
+    index.refresh();
+
+    const bool eventDriven = index.event_driven();
+    hint("Watcher: " + index.watch_backend());
 
-    StampMap prev = snapshot_tree(projectDir);
-    int lastCode = run_tests_once(opt);
+    TestWatchState state;
+    int lastCode = run_tests_once(opt, &state);
 
-    const auto pollEvery = std::chrono::milliseconds(250);
-    const auto debounce = std::chrono::milliseconds(450);
+    const auto pollEvery = std::chrono::milliseconds(eventDriven ? 25 : 250);
+    const auto quietFor = std::chrono::milliseconds(eventDriven ? 60 : 450);
+
+    std::set<std::string> pending;
+    bool reconfigure = false;
     auto lastChange = std::chrono::steady_clock::now();
 
     while (!g_stop.load())
     {
       std::this_thread::sleep_for(pollEvery);
 
-      StampMap now = snapshot_tree(projectDir);
-      if (has_changes(prev, now))
+      for (const auto &change : index.poll_changes())
       {
-        prev = std::move(now);
-        lastChange = std::chrono::steady_clock::now();
-
-        while (!g_stop.load())
+        if (!change.valid() ||
+            change.kind == vix::commands::RunCommand::dev::DevChangeKind::Ignore)
         {
-          std::this_thread::sleep_for(std::chrono::milliseconds(80));
+          continue;
+        }
 
-          StampMap later = snapshot_tree(projectDir);
-          if (has_changes(prev, later))
-          {
-            prev = std::move(later);
-            lastChange = std::chrono::steady_clock::now();
-            continue;
-          }
+        pending.insert(vix::commands::TestsCommand::detail::impact_path_key(change.path, {}));
+        reconfigure = reconfigure ||
+                      change.kind == vix::commands::RunCommand::dev::DevChangeKind::ReconfigureAndRebuild;
+        lastChange = std::chrono::steady_clock::now();
+      }
 
-          const auto elapsed = std::chrono::steady_clock::now() - lastChange;
-          if (elapsed >= debounce)
-            break;
-        }
+      if (pending.empty() || std::chrono::steady_clock::now() - lastChange < quietFor)
+        continue;
 
-        if (g_stop.load())
-          break;
+      const std::vector<std::string> changed(pending.begin(), pending.end());
+      pending.clear();
 
-        std::cout << "\n";
-        section_title(std::cout, "Tests re-run");
+      std::cout << "\n";
+      section_title(std::cout, "Tests re-run");
+      hint(std::to_string(changed.size()) + " file" + (changed.size() == 1 ? "" : "s") +
+           " changed: " + fs::path(changed.front()).filename().string() +
+           (changed.size() > 1 ? ", ..." : ""));
 
-        lastCode = run_tests_once(opt);
+      lastCode = run_watch_iteration(opt, changed, reconfigure, state);
+      reconfigure = false;
 
-        if (opt.runAfter && lastCode == 0)
-        {
-          info("Runtime checks after tests (--run).");
-          lastCode = vix::commands::CheckCommand::run(opt.forwarded);
-        }
+      if (opt.runAfter && lastCode == 0)
+      {
+        info("Runtime checks after tests (--run).");
+        lastCode = vix::commands::CheckCommand::run(opt.forwarded);
       }
     }
 
@@ -2382,14 +3695,28 @@ namespace vix::commands::TestsCommand
     out << "  [path]                    Project directory, default: current directory\n\n";
 
     out << "Test options:\n";
-    out << "  --watch                   Watch files and re-run tests on changes\n";
+    out << "  --watch                   Rebuild and rerun the tests each change reaches\n";
     out << "  --list                    List discovered tests without running them\n";
     out << "  --test <name|regex>       Run tests matching a name or regex\n";
     out << "  --test=<name|regex>       Same as --test <name|regex>\n";
     out << "  -R <name|regex>           Alias for --test <name|regex>\n";
     out << "  --fail-fast               Stop on first failing test\n";
+    out << "  --no-test-cache           Run tests even when a cached pass is valid\n";
     out << "  --raw                     Show raw test runner or CTest output\n\n";
 
+    out << "Impact analysis:\n";
+    out << "  --affected                Run only tests reached by uncommitted changes\n";
+    out << "  --affected=<git-rev>      Run only tests reached by changes since <git-rev>\n";
+    out << "  --explain                 With --affected, show why each test was selected\n\n";
+
+    out << "Sharding:\n";
+    out << "  --shard <i/n>             Run shard i of n, balanced by recorded durations\n";
+    out << "  --shard-report[=<n>]      Print the shard plan as JSON and exit\n";
+    out << "  --report <file>           Write results as JSON for `vix tests merge`\n";
+    out << "  --durations <file>        Read durations from a shared file (CI cache)\n";
+    out << "  merge <report.json...>    Combine shard reports:\n";
+    out << "                            --junit <file>, --json <file>, --durations <file>\n\n";
+
     out << "Runtime check:\n";
     out << "  --run                     Run runtime checks after tests pass\n\n";
 
@@ -2413,16 +3740,32 @@ namespace vix::commands::TestsCommand
     out << "  vix tests --test tree.basic\n";
     out << "  vix tests --test=tree.basic\n";
     out << "  vix tests -R tree.basic\n";
+    out << "  vix tests --affected\n";
+    out << "  vix tests --affected=origin/main --explain\n";
+    out << "  vix tests --shard 3/8 --report shard-3.json\n";
+    out << "  vix tests --shard-report=8\n";
+    out << "  vix tests merge shard-*.json --junit report.xml\n";
     out << "  vix tests --fail-fast\n";
     out << "  vix tests --raw\n";
     out << "  vix tests -- --output-on-failure\n";
     out << "  vix tests -- --output-on-failure -R MySuite\n\n";
 
     out << "Behavior:\n";
-    out << "  native runner             Preferred when a test executable is found\n";
-    out << "  CTest                     Used as fallback or when CTest args are passed\n";
+    out << "  scheduler                 Runs CTest-registered tests in parallel, slowest\n";
+    out << "                            first, from durations kept in build/.vix/\n";
+    out << "  test cache                Unchanged passing tests report a cached pass;\n";
+    out << "                            key: binary, linked libraries, args, ENVIRONMENT,\n";
+    out << "                            REQUIRED_FILES and VIX_TEST_CACHE_ENV variables\n";
+    out << "  test output               Spooled to build/.vix/test-output/; memory keeps\n";
+    out << "                            status lines and the head and tail of each test\n";
+    out << "  --watch                   Follows file events; failing tests rerun first,\n";
+    out << "                            build file changes rebuild and rerun everything\n";
+    out << "  native runner             Used when no CTest file is generated\n";
+    out << "  CTest                     Used for --raw, --list, CTest args, or on Windows\n";
     out << "  tests/ directory          Used to detect whether tests should be prepared\n";
-    out << "  --list                    Shows clean test names instead of raw CTest paths\n\n";
+    out << "  --list                    Shows clean test names instead of raw CTest paths\n";
+    out << "  --affected                Follows changed files through Ninja deps and link\n";
+    out << "                            edges; build files or new sources run everything\n\n";
 
     out << "See also:\n";
     out << "  vix build --build-target all\n";
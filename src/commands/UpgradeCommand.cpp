@@ -15,6 +15,8 @@
 #include <vix/cli/util/Ui.hpp>
 #include <vix/cli/util/Shell.hpp>
 #include <vix/cli/util/Hash.hpp>
+#include <vix/cli/util/ContentStore.hpp>
+#include <vix/cli/util/GitMirror.hpp>
 #include <vix/cli/Style.hpp>
 #include <vix/cli/sdk/SdkProfiles.hpp>
 #include <vix/utils/Env.hpp>
@@ -1686,23 +1688,29 @@ namespace vix::commands
       if (fs::exists(dst))
         return 0;
 
-      fs::create_directories(dst.parent_path());
-
+      vix::cli::util::GitNetworkRunner network;
+      if (verbose)
       {
-        const std::string cmd =
-            "git clone -q " + shell_quote(repoUrl) + " " + shell_quote(dst.string());
-        const int rc = verbose ? vix::cli::util::run_cmd_retry_debug(cmd) : run_quiet_or_verbose(cmd, false);
-        if (rc != 0)
-          return rc;
+        network = [](std::vector<std::string> args)
+        {
+          std::string cmd = "git";
+          for (const std::string &arg : args)
+            cmd += " " + shell_quote(arg);
+          return vix::cli::util::run_cmd_retry_debug(cmd) == 0;
+        };
       }
 
+      try
       {
-        const std::string cmd =
-            "git -C " + shell_quote(dst.string()) +
-            " -c advice.detachedHead=false checkout -q " + shell_quote(commit);
-        const int rc = verbose ? vix::cli::util::run_cmd_retry_debug(cmd) : run_quiet_or_verbose(cmd, false);
-        if (rc != 0)
-          return rc;
+        const vix::cli::util::GitMirror mirror(vix_root(), repoUrl);
+        mirror.ensure_commit(commit, network);
+        mirror.checkout(commit, dst);
+      }
+      catch (const std::exception &ex)
+      {
+        if (verbose)
+          std::cerr << ex.what() << "\n";
+        return 1;
       }
 
       return 0;
@@ -1735,17 +1743,14 @@ namespace vix::commands
       std::error_code ec;
       remove_all_if_exists(dst);
 
-#ifdef _WIN32
-      copy_dir_or_throw(src, dst);
-#else
       fs::create_directories(dst.parent_path(), ec);
+#ifndef _WIN32
       fs::create_directory_symlink(src, dst, ec);
-      if (ec)
-      {
-        ec.clear();
-        copy_dir_or_throw(src, dst);
-      }
+      if (!ec)
+        return;
 #endif
+
+      vix::cli::util::ContentStore(vix_root()).materialize(src, dst);
     }
 
     bool verify_dependency_hash(const DepResolved &dep)
@@ -0,0 +1,1021 @@
+/**
+ *
+ *  @file BenchCommand.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/BenchCommand.hpp>
+#include <vix/cli/commands/bench/BenchResults.hpp>
+#include <vix/cli/commands/helpers/ProcessHelpers.hpp>
+#include <vix/cli/commands/tests/TestsImpact.hpp>
+#include <vix/cli/build/BuildStyle.hpp>
+#include <vix/cli/process/Process.hpp>
+#include <vix/cli/util/Fs.hpp>
+#include <vix/cli/Style.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_set>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+namespace build = vix::cli::build;
+using namespace vix::cli::style;
+
+namespace
+{
+  namespace detail = vix::commands::BenchCommand::detail;
+
+  struct Options
+  {
+    fs::path projectDir;
+    std::string preset{"release"};
+    fs::path buildDir;
+
+    std::string filter;
+    int repetitions{10};
+    int warmup{1};
+
+    std::optional<int> cpu;
+    bool pin{true};
+
+    std::string baseline;
+    bool saveBaseline{false};
+    detail::BenchCompareOptions compare{};
+
+    bool list{false};
+    bool build{true};
+  };
+
+  struct BenchTarget
+  {
+    std::string name;
+    fs::path executable;
+    std::vector<std::string> args;
+    fs::path workingDirectory;
+    bool googleBenchmark{false};
+  };
+
+  struct ProcessRun
+  {
+    int exitCode{0};
+    double seconds{0.0};
+  };
+
+  static std::string flag_value(
+      const std::vector<std::string> &args,
+      std::size_t &i,
+      const std::string &flag)
+  {
+    const std::string &arg = args[i];
+
+    if (arg.size() > flag.size() && arg.compare(0, flag.size() + 1, flag + "=") == 0)
+      return arg.substr(flag.size() + 1);
+
+    if (i + 1 >= args.size())
+      throw std::invalid_argument(flag + " needs a value");
+
+    return args[++i];
+  }
+
+  static bool is_flag(const std::string &arg, const std::string &flag)
+  {
+    return arg == flag || arg.rfind(flag + "=", 0) == 0;
+  }
+
+  static int parse_count(const std::string &flag, const std::string &value, int min)
+  {
+    try
+    {
+      std::size_t used = 0;
+      const int n = std::stoi(value, &used);
+      if (used == value.size() && n >= min)
+        return n;
+    }
+    catch (const std::exception &)
+    {
+    }
+
+    throw std::invalid_argument(flag + " expects an integer >= " + std::to_string(min));
+  }
+
+  static double parse_fraction(const std::string &flag, const std::string &value, double scale)
+  {
+    try
+    {
+      std::size_t used = 0;
+      const double v = std::stod(value, &used);
+      if (used == value.size() && v > 0.0)
+        return v / scale;
+    }
+    catch (const std::exception &)
+    {
+    }
+
+    throw std::invalid_argument(flag + " expects a positive number");
+  }
+
+  static Options parse_options(const std::vector<std::string> &args)
+  {
+    Options opt;
+
+    for (std::size_t i = 0; i < args.size(); ++i)
+    {
+      const std::string &arg = args[i];
+
+      if (arg == "--list")
+        opt.list = true;
+      else if (arg == "--no-build")
+        opt.build = false;
+      else if (arg == "--no-pin")
+        opt.pin = false;
+      else if (arg == "--save-baseline")
+        opt.saveBaseline = true;
+      else if (is_flag(arg, "--filter"))
+        opt.filter = flag_value(args, i, "--filter");
+      else if (is_flag(arg, "--repetitions") || arg == "-r")
+        opt.repetitions = parse_count("--repetitions", flag_value(args, i, arg == "-r" ? "-r" : "--repetitions"), 2);
+      else if (is_flag(arg, "--warmup"))
+        opt.warmup = parse_count("--warmup", flag_value(args, i, "--warmup"), 0);
+      else if (is_flag(arg, "--cpu"))
+        opt.cpu = parse_count("--cpu", flag_value(args, i, "--cpu"), 0);
+      else if (is_flag(arg, "--baseline"))
+        opt.baseline = flag_value(args, i, "--baseline");
+      else if (is_flag(arg, "--threshold"))
+        opt.compare.threshold = parse_fraction("--threshold", flag_value(args, i, "--threshold"), 100.0);
+      else if (is_flag(arg, "--alpha"))
+        opt.compare.alpha = parse_fraction("--alpha", flag_value(args, i, "--alpha"), 1.0);
+      else if (is_flag(arg, "--preset"))
+        opt.preset = flag_value(args, i, "--preset");
+      else if (is_flag(arg, "--build-dir"))
+        opt.buildDir = flag_value(args, i, "--build-dir");
+      else if (!arg.empty() && arg.front() == '-')
+        throw std::invalid_argument("unknown option: " + arg);
+      else if (opt.projectDir.empty())
+        opt.projectDir = arg;
+      else
+        throw std::invalid_argument("unexpected argument: " + arg);
+    }
+
+    if (opt.compare.alpha >= 1.0)
+      throw std::invalid_argument("--alpha must be below 1");
+
+    std::error_code ec;
+    if (opt.projectDir.empty())
+      opt.projectDir = fs::current_path(ec);
+
+    opt.projectDir = fs::weakly_canonical(opt.projectDir, ec);
+
+    if (opt.buildDir.empty())
+    {
+      std::string dirName = "build";
+      if (opt.preset == "dev")
+        dirName = "build-dev";
+      else if (opt.preset == "dev-ninja")
+        dirName = "build-ninja";
+      else if (opt.preset == "release")
+        dirName = "build-release";
+
+      opt.buildDir = opt.projectDir / dirName;
+    }
+    else if (opt.buildDir.is_relative())
+    {
+      opt.buildDir = opt.projectDir / opt.buildDir;
+    }
+
+    opt.buildDir = fs::weakly_canonical(opt.buildDir, ec);
+    return opt;
+  }
+
+  static std::string read_file(const fs::path &path)
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+  }
+
+  static std::string file_safe_name(const std::string &name)
+  {
+    std::string safe;
+    for (const char c : name)
+    {
+      const bool keep = std::isalnum(static_cast<unsigned char>(c)) ||
+                        c == '-' || c == '_' || c == '.';
+      safe += keep ? c : '_';
+    }
+    return safe;
+  }
+
+  // ---------------------------------------------------------------
+  // Discovery
+  // ---------------------------------------------------------------
+
+  static void collect_ctest_entries(
+      const fs::path &file,
+      std::vector<vix::commands::TestsCommand::detail::CTestEntry> &tests,
+      std::unordered_set<std::string> &visited)
+  {
+    if (!visited.insert(file.lexically_normal().string()).second)
+      return;
+
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+      return;
+
+    std::ostringstream text;
+    text << in.rdbuf();
+
+    const auto parsed = vix::commands::TestsCommand::detail::parse_ctest_testfile(
+        text.str(),
+        file.parent_path());
+
+    tests.insert(tests.end(), parsed.tests.begin(), parsed.tests.end());
+
+    for (const fs::path &include : parsed.includes)
+      collect_ctest_entries(include, tests, visited);
+
+    for (const fs::path &subdir : parsed.subdirs)
+      collect_ctest_entries(subdir / "CTestTestfile.cmake", tests, visited);
+  }
+
+  static bool is_bench_label(const std::string &label)
+  {
+    return label == "bench" || label == "benchmark" || label == "benchmarks";
+  }
+
+  static bool is_bench_executable_name(std::string stem)
+  {
+    std::transform(stem.begin(), stem.end(), stem.begin(), [](unsigned char c)
+                   { return static_cast<char>(std::tolower(c)); });
+
+    const auto ends_with = [&stem](const std::string &suffix)
+    {
+      return stem.size() > suffix.size() &&
+             stem.compare(stem.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+
+    return stem.rfind("bench_", 0) == 0 || stem.rfind("benchmark_", 0) == 0 ||
+           ends_with("_bench") || ends_with("_benchmark") || ends_with("_benchmarks") ||
+           ends_with("-bench") || ends_with("-benchmark") ||
+           stem == "bench" || stem == "benchmark" || stem == "benchmarks";
+  }
+
+  static bool is_linked_executable(const vix::commands::TestsCommand::detail::ImpactEdge &edge)
+  {
+    return std::any_of(
+        edge.inputs.begin(),
+        edge.inputs.end(),
+        [](const std::string &input)
+        {
+          const std::string ext = fs::path(input).extension().string();
+          return ext == ".o" || ext == ".obj";
+        });
+  }
+
+  /**
+   * @brief True for binaries linked with Google Benchmark: they carry its
+   * flag names.
+   */
+  static bool is_google_benchmark_binary(const fs::path &executable)
+  {
+    static const std::string marker = "benchmark_out_format";
+
+    std::ifstream in(executable, std::ios::binary);
+    if (!in)
+      return false;
+
+    std::string window;
+    char buffer[64 * 1024];
+
+    while (in)
+    {
+      in.read(buffer, sizeof(buffer));
+      const std::streamsize n = in.gcount();
+      if (n <= 0)
+        break;
+
+      // Keep the end of the previous chunk: the marker may straddle two.
+      window.erase(0, window.size() > marker.size() ? window.size() - marker.size() : 0);
+      window.append(buffer, static_cast<std::size_t>(n));
+
+      if (window.find(marker) != std::string::npos)
+        return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief CTest tests labelled bench, then executables of the Ninja graph
+   * named like benchmarks (bench_*, *_bench, *_benchmark).
+   */
+  static std::vector<BenchTarget> discover_benchmarks(const Options &opt)
+  {
+    namespace tests = vix::commands::TestsCommand::detail;
+
+    std::vector<BenchTarget> targets;
+    std::set<std::string> seenExecutables;
+
+    std::vector<tests::CTestEntry> entries;
+    std::unordered_set<std::string> visited;
+    collect_ctest_entries(opt.buildDir / "CTestTestfile.cmake", entries, visited);
+
+    for (const tests::CTestEntry &entry : entries)
+    {
+      if (entry.disabled || entry.command.empty())
+        continue;
+
+      if (std::none_of(entry.labels.begin(), entry.labels.end(), is_bench_label))
+        continue;
+
+      BenchTarget target;
+      target.name = entry.name;
+      target.executable = entry.command.front();
+      target.args.assign(entry.command.begin() + 1, entry.command.end());
+      target.workingDirectory = entry.workingDirectory.empty() ? opt.buildDir : entry.workingDirectory;
+
+      seenExecutables.insert(tests::impact_path_key(target.executable, opt.buildDir));
+      targets.push_back(std::move(target));
+    }
+
+    const std::string ninja = read_file(opt.buildDir / "build.ninja");
+    if (!ninja.empty())
+    {
+      for (const tests::ImpactEdge &edge : tests::parse_ninja_build_edges(ninja, opt.buildDir))
+      {
+        if (!is_linked_executable(edge))
+          continue;
+
+        for (const std::string &output : edge.outputs)
+        {
+          const fs::path path(output);
+          const std::string ext = path.extension().string();
+
+          if ((!ext.empty() && ext != ".exe") || !is_bench_executable_name(path.stem().string()))
+            continue;
+
+          if (!seenExecutables.insert(output).second)
+            continue;
+
+          BenchTarget target;
+          target.name = path.stem().string();
+          target.executable = path;
+          target.workingDirectory = opt.buildDir;
+          targets.push_back(std::move(target));
+        }
+      }
+    }
+
+    if (!opt.filter.empty())
+    {
+      const std::regex filter(opt.filter);
+      targets.erase(
+          std::remove_if(
+              targets.begin(),
+              targets.end(),
+              [&filter](const BenchTarget &target)
+              {
+                return !std::regex_search(target.name, filter);
+              }),
+          targets.end());
+    }
+
+    std::sort(
+        targets.begin(),
+        targets.end(),
+        [](const BenchTarget &a, const BenchTarget &b)
+        {
+          return a.name < b.name;
+        });
+
+    return targets;
+  }
+
+  // ---------------------------------------------------------------
+  // Running
+  // ---------------------------------------------------------------
+
+  /**
+   * @brief Highest CPU this process may run on: CPU 0 usually takes most
+   * interrupts and housekeeping.
+   */
+  static std::optional<int> default_bench_cpu()
+  {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if (::sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+      for (int cpu = CPU_SETSIZE - 1; cpu >= 0; --cpu)
+      {
+        if (CPU_ISSET(cpu, &set))
+          return cpu;
+      }
+    }
+#endif
+    return std::nullopt;
+  }
+
+  static bool pinning_supported()
+  {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  static ProcessRun run_benchmark_process(
+      const std::vector<std::string> &argv,
+      const fs::path &cwd,
+      std::optional<int> cpu,
+      const fs::path &log)
+  {
+    ProcessRun run;
+
+    std::error_code ec;
+    fs::create_directories(log.parent_path(), ec);
+
+#ifndef _WIN32
+    const int logFd = ::open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    std::vector<char *> args;
+    for (const std::string &arg : argv)
+      args.push_back(const_cast<char *>(arg.c_str()));
+    args.push_back(nullptr);
+
+    const std::string dir = cwd.string();
+    const auto start = std::chrono::steady_clock::now();
+
+    const pid_t pid = ::fork();
+    if (pid < 0)
+    {
+      if (logFd >= 0)
+        ::close(logFd);
+      run.exitCode = 127;
+      return run;
+    }
+
+    if (pid == 0)
+    {
+#ifdef __linux__
+      if (cpu)
+      {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(*cpu, &set);
+        (void)::sched_setaffinity(0, sizeof(set), &set);
+      }
+#else
+      (void)cpu;
+#endif
+
+      if (logFd >= 0)
+      {
+        ::dup2(logFd, STDOUT_FILENO);
+        ::dup2(logFd, STDERR_FILENO);
+      }
+
+      if (!dir.empty() && ::chdir(dir.c_str()) != 0)
+        _exit(127);
+
+      ::execvp(args[0], args.data());
+      _exit(127);
+    }
+
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0 && errno == EINTR)
+    {
+    }
+
+    run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (logFd >= 0)
+      ::close(logFd);
+
+    if (WIFEXITED(status))
+      run.exitCode = WEXITSTATUS(status);
+    else if (WIFSIGNALED(status))
+      run.exitCode = 128 + WTERMSIG(status);
+    else
+      run.exitCode = 1;
+#else
+    (void)cpu;
+
+    std::string cmd = "cd /d " + vix::cli::commands::helpers::quote(cwd.string()) + " &&";
+    for (const std::string &arg : argv)
+      cmd += " " + vix::cli::commands::helpers::quote(arg);
+    cmd += " > " + vix::cli::commands::helpers::quote(log.string()) + " 2>&1";
+
+    const auto start = std::chrono::steady_clock::now();
+    const int raw = std::system(cmd.c_str());
+    run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    run.exitCode = vix::cli::process::normalize_exit_code(raw);
+#endif
+
+    return run;
+  }
+
+  struct TargetOutcome
+  {
+    std::vector<detail::BenchSeries> series;
+    int exitCode{0};
+    fs::path log;
+  };
+
+  static TargetOutcome run_target(
+      const Options &opt,
+      const BenchTarget &target,
+      std::optional<int> cpu)
+  {
+    TargetOutcome outcome;
+
+    const fs::path outputDir = opt.buildDir / ".vix" / "bench";
+    const std::string safe = file_safe_name(target.name);
+    outcome.log = outputDir / (safe + ".log");
+
+    std::vector<std::string> base = {target.executable.string()};
+    base.insert(base.end(), target.args.begin(), target.args.end());
+
+    for (int i = 0; i < opt.warmup; ++i)
+    {
+      std::vector<std::string> argv = base;
+      if (target.googleBenchmark)
+        argv.push_back("--benchmark_repetitions=1");
+
+      const ProcessRun run = run_benchmark_process(argv, target.workingDirectory, cpu, outcome.log);
+      if (run.exitCode != 0)
+      {
+        outcome.exitCode = run.exitCode;
+        return outcome;
+      }
+    }
+
+    if (target.googleBenchmark)
+    {
+      const fs::path json = outputDir / (safe + ".json");
+
+      std::vector<std::string> argv = base;
+      argv.push_back("--benchmark_repetitions=" + std::to_string(opt.repetitions));
+      argv.push_back("--benchmark_out=" + json.string());
+      argv.push_back("--benchmark_out_format=json");
+
+      const ProcessRun run = run_benchmark_process(argv, target.workingDirectory, cpu, outcome.log);
+      outcome.exitCode = run.exitCode;
+
+      if (run.exitCode == 0)
+        outcome.series = detail::parse_google_benchmark_json(read_file(json), target.name);
+
+      return outcome;
+    }
+
+    // Not a Google Benchmark binary: each run is one sample of wall time.
+    detail::BenchSeries series;
+    series.name = target.name;
+
+    for (int i = 0; i < opt.repetitions; ++i)
+    {
+      const ProcessRun run = run_benchmark_process(base, target.workingDirectory, cpu, outcome.log);
+      if (run.exitCode != 0)
+      {
+        outcome.exitCode = run.exitCode;
+        return outcome;
+      }
+
+      series.samples.push_back(run.seconds);
+    }
+
+    outcome.series.push_back(std::move(series));
+    return outcome;
+  }
+
+  // ---------------------------------------------------------------
+  // Results
+  // ---------------------------------------------------------------
+
+  static std::string git_output(const fs::path &projectDir, const std::string &args)
+  {
+    int code = 0;
+    const std::string out = vix::cli::commands::helpers::run_and_capture_with_code(
+        "git -C " + vix::cli::commands::helpers::quote(projectDir.string()) + " " + args,
+        code);
+
+    if (code != 0)
+      return {};
+
+    std::string trimmed = out;
+    while (!trimmed.empty() && std::isspace(static_cast<unsigned char>(trimmed.back())))
+      trimmed.pop_back();
+    return trimmed;
+  }
+
+  static std::string current_commit(const fs::path &projectDir)
+  {
+    const std::string sha = git_output(projectDir, "rev-parse HEAD");
+    if (sha.empty())
+      return "nogit";
+
+    // Tracked changes only: build outputs and .vix/ are usually untracked.
+    const std::string changes = git_output(projectDir, "status --porcelain --untracked-files=no");
+    return changes.empty() ? sha : sha + "-dirty";
+  }
+
+  /**
+   * @brief The baseline named by --baseline: a results file, a stored
+   * commit, or a git revision; by default the saved baseline, if any.
+   */
+  static std::optional<detail::BenchRun> load_baseline(
+      const Options &opt,
+      std::string &label,
+      std::string &problem)
+  {
+    std::vector<fs::path> candidates;
+
+    if (opt.baseline.empty())
+    {
+      candidates.push_back(detail::bench_baseline_path(opt.projectDir));
+    }
+    else
+    {
+      candidates.push_back(fs::path(opt.baseline));
+      candidates.push_back(detail::bench_run_path(opt.projectDir, opt.baseline));
+
+      const std::string sha = git_output(opt.projectDir, "rev-parse --verify --quiet " +
+                                                             vix::cli::commands::helpers::quote(opt.baseline + "^{commit}"));
+      if (!sha.empty())
+        candidates.push_back(detail::bench_run_path(opt.projectDir, sha));
+    }
+
+    for (const fs::path &path : candidates)
+    {
+      std::error_code ec;
+      if (!fs::is_regular_file(path, ec))
+        continue;
+
+      const auto run = detail::parse_bench_run_json(vix::cli::util::read_text_file_or_empty(path));
+      if (!run)
+      {
+        problem = "unreadable benchmark results: " + path.string();
+        return std::nullopt;
+      }
+
+      label = run->commit.empty() ? path.filename().string() : run->commit.substr(0, 12);
+      return run;
+    }
+
+    if (!opt.baseline.empty())
+      problem = "no stored benchmark results for '" + opt.baseline + "'";
+
+    return std::nullopt;
+  }
+
+  static std::string format_duration(double seconds)
+  {
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+
+    if (seconds < 1e-6)
+    {
+      out.precision(1);
+      out << seconds * 1e9 << " ns";
+    }
+    else if (seconds < 1e-3)
+    {
+      out.precision(2);
+      out << seconds * 1e6 << " us";
+    }
+    else if (seconds < 1.0)
+    {
+      out.precision(2);
+      out << seconds * 1e3 << " ms";
+    }
+    else
+    {
+      out.precision(3);
+      out << seconds << " s";
+    }
+
+    return out.str();
+  }
+
+  static void print_comparison(const detail::BenchComparison &c)
+  {
+    const char *color = GREEN;
+    const char *mark = "✓";
+
+    if (c.verdict == detail::BenchVerdict::Regressed)
+    {
+      color = RED;
+      mark = "✖";
+    }
+    else if (c.verdict == detail::BenchVerdict::New)
+    {
+      color = GRAY;
+      mark = "•";
+    }
+
+    std::cout << "  " << color << mark << RESET << " " << c.name
+              << " " << BOLD << format_duration(c.median) << RESET;
+
+    if (c.verdict == detail::BenchVerdict::New)
+    {
+      std::cout << " " << GRAY << "(new)" << RESET << "\n";
+      return;
+    }
+
+    std::ostringstream change;
+    change.setf(std::ios::fixed);
+    change.precision(1);
+    change << (c.change >= 0.0 ? "+" : "") << c.change * 100.0 << "%";
+
+    std::ostringstream p;
+    p.setf(std::ios::fixed);
+    p.precision(3);
+    p << c.pValue;
+
+    const char *changeColor = GRAY;
+    if (c.verdict == detail::BenchVerdict::Regressed)
+      changeColor = RED;
+    else if (c.verdict == detail::BenchVerdict::Improved)
+      changeColor = GREEN;
+
+    std::cout << " " << changeColor << change.str() << RESET
+              << GRAY << " (was " << format_duration(c.baselineMedian)
+              << ", p=" << p.str() << ")" << RESET << "\n";
+  }
+
+  static int build_bench_targets(const Options &opt, const std::vector<BenchTarget> &targets)
+  {
+    std::error_code ec;
+    if (!fs::exists(opt.buildDir / "build.ninja", ec))
+      return 0;
+
+    std::string cmd = "ninja -C " + vix::cli::commands::helpers::quote(opt.buildDir.string());
+    for (const BenchTarget &target : targets)
+      cmd += " " + vix::cli::commands::helpers::quote(target.executable.string());
+
+    build::print_task_header_full(std::cout, "Building benchmarks", std::to_string(targets.size()) + " targets", opt.preset, {});
+    std::cout << std::flush;
+
+    const auto start = std::chrono::steady_clock::now();
+    int code = 0;
+    const std::string output = vix::cli::commands::helpers::run_and_capture_with_code(cmd, code);
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+    if (code == 0)
+    {
+      build::print_task_success_timed(std::cout, "Benchmarks built", ms);
+      return 0;
+    }
+
+    build::print_task_failure_timed(std::cout, "Failed to build benchmarks", ms);
+    std::cout << "\n"
+              << output << "\n";
+    return code;
+  }
+
+  static int run_bench(const Options &opt)
+  {
+    std::error_code ec;
+    if (!fs::is_directory(opt.buildDir, ec))
+    {
+      error("bench: no build directory at " + opt.buildDir.string());
+      hint("Configure it first: vix build --preset " + opt.preset);
+      return 2;
+    }
+
+    std::vector<BenchTarget> targets = discover_benchmarks(opt);
+
+    if (targets.empty())
+    {
+      error("bench: no benchmarks found in " + opt.buildDir.string());
+      hint("Label a CTest test `bench`, or name an executable bench_* or *_bench.");
+      return 2;
+    }
+
+    if (opt.list)
+    {
+      std::cout << "  " << CYAN << "benchmarks" << RESET << "\n";
+      for (const BenchTarget &target : targets)
+        std::cout << "    " << GRAY << "• " << RESET << target.name << "\n";
+      return 0;
+    }
+
+    if (opt.build)
+    {
+      const int code = build_bench_targets(opt, targets);
+      if (code != 0)
+        return code;
+    }
+
+    for (BenchTarget &target : targets)
+      target.googleBenchmark = is_google_benchmark_binary(target.executable);
+
+    std::optional<int> cpu;
+    if (opt.pin && pinning_supported())
+      cpu = opt.cpu ? opt.cpu : default_bench_cpu();
+
+    std::string baselineLabel;
+    std::string problem;
+    const std::optional<detail::BenchRun> baseline = load_baseline(opt, baselineLabel, problem);
+
+    if (!problem.empty())
+    {
+      error("bench: " + problem);
+      return 1;
+    }
+
+    std::vector<std::pair<std::string, std::string>> meta;
+    meta.emplace_back("repetitions", std::to_string(opt.repetitions));
+    meta.emplace_back("cpu", cpu ? std::to_string(*cpu) : std::string("unpinned"));
+    meta.emplace_back("baseline", baseline ? baselineLabel : std::string("none"));
+
+    build::print_task_header_full(
+        std::cout,
+        "Running benchmarks",
+        std::to_string(targets.size()) + " executable" + (targets.size() == 1 ? "" : "s"),
+        opt.preset,
+        meta);
+    std::cout << "\n";
+
+    detail::BenchRun run;
+    run.commit = current_commit(opt.projectDir);
+    run.cpu = cpu ? std::to_string(*cpu) : std::string{};
+
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t failed = 0;
+    std::size_t regressed = 0;
+
+    for (const BenchTarget &target : targets)
+    {
+      const TargetOutcome outcome = run_target(opt, target, cpu);
+
+      if (outcome.exitCode != 0 || outcome.series.empty())
+      {
+        ++failed;
+        std::cout << "  " << RED << "✖" << RESET << " " << target.name << " "
+                  << RED << (outcome.exitCode != 0 ? "exit " + std::to_string(outcome.exitCode)
+                                                   : std::string("no results"))
+                  << RESET << GRAY << " (" << outcome.log.string() << ")" << RESET << "\n";
+        continue;
+      }
+
+      detail::BenchRun single;
+      single.series = outcome.series;
+
+      for (const detail::BenchComparison &c :
+           detail::compare_bench_runs(single, baseline ? &*baseline : nullptr, opt.compare))
+      {
+        if (c.verdict == detail::BenchVerdict::Regressed)
+          ++regressed;
+        print_comparison(c);
+      }
+
+      run.series.insert(run.series.end(), outcome.series.begin(), outcome.series.end());
+    }
+
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+    std::cout << "\n";
+
+    const std::string json = detail::bench_run_json(run);
+    const fs::path runPath = detail::bench_run_path(opt.projectDir, run.commit);
+
+    if (!run.series.empty() && vix::cli::util::write_text_file_atomic(runPath, json))
+      hint("Results: " + runPath.string());
+
+    if (opt.saveBaseline)
+    {
+      if (failed == 0 && vix::cli::util::write_text_file_atomic(detail::bench_baseline_path(opt.projectDir), json))
+        hint("Saved as baseline.");
+      else
+        hint("Baseline not saved: some benchmarks did not complete.");
+    }
+
+    const std::string total = std::to_string(run.series.size()) + " benchmark" +
+                              (run.series.size() == 1 ? "" : "s");
+
+    if (failed > 0 || regressed > 0)
+    {
+      std::string message;
+      if (regressed > 0)
+        message = std::to_string(regressed) + " of " + total + " regressed";
+      if (failed > 0)
+        message += (message.empty() ? "" : ", ") + std::to_string(failed) + " failed to run";
+
+      build::print_task_failure_timed(std::cout, message, ms);
+      return 1;
+    }
+
+    build::print_task_success_timed(
+        std::cout,
+        baseline ? "No regressions in " + total : "Measured " + total,
+        ms);
+
+    if (!baseline && !opt.saveBaseline)
+      hint("No baseline yet: run `vix bench --save-baseline` to record one.");
+
+    return 0;
+  }
+} // namespace
+
+namespace vix::commands::BenchCommand
+{
+  int run(const std::vector<std::string> &args)
+  {
+    Options opt;
+    try
+    {
+      opt = parse_options(args);
+      return run_bench(opt);
+    }
+    catch (const std::regex_error &ex)
+    {
+      error(std::string("bench: invalid --filter: ") + ex.what());
+    }
+    catch (const std::exception &ex)
+    {
+      error(std::string("bench: ") + ex.what());
+    }
+
+    hint("Try: vix bench --help");
+    return 1;
+  }
+
+  int help()
+  {
+    std::ostream &out = std::cout;
+
+    out << "Usage:\n";
+    out << "  vix bench [path] [options]\n\n";
+
+    out << "Description:\n";
+    out << "  Build and run the project benchmarks, store the results under\n";
+    out << "  .vix/bench/<commit>.json and compare them with the saved baseline.\n";
+    out << "  Exits with 1 when a benchmark fails or regresses.\n\n";
+
+    out << "Options:\n";
+    out << "  --list                    List discovered benchmarks\n";
+    out << "  --filter <regex>          Only benchmarks whose name matches\n";
+    out << "  -r, --repetitions <n>     Measured runs (default: 10)\n";
+    out << "  --warmup <n>              Unmeasured runs first (default: 1)\n";
+    out << "  --cpu <n>                 Pin benchmarks to CPU n (default: last CPU)\n";
+    out << "  --no-pin                  Do not pin benchmarks to a CPU\n";
+    out << "  --baseline <ref>          Compare with a results file, commit or git ref\n";
+    out << "  --save-baseline           Store this run as .vix/bench/baseline.json\n";
+    out << "  --threshold <percent>     Slowdown that counts as a regression (default: 5)\n";
+    out << "  --alpha <p>               Significance level (default: 0.05)\n";
+    out << "  --preset <name>           Build preset (default: release)\n";
+    out << "  --build-dir <dir>         Build directory (default: from the preset)\n";
+    out << "  --no-build                Do not rebuild benchmark executables first\n\n";
+
+    out << "Behavior:\n";
+    out << "  discovery                 CTest tests labelled bench, and executables\n";
+    out << "                            named bench_*, *_bench or *_benchmark\n";
+    out << "  Google Benchmark          One sample per repetition (real time);\n";
+    out << "                            other executables: one sample per run\n";
+    out << "  comparison                Mann-Whitney U test on the samples; a change\n";
+    out << "                            counts when significant and over the threshold\n\n";
+
+    out << "Examples:\n";
+    out << "  vix bench --save-baseline\n";
+    out << "  vix bench\n";
+    out << "  vix bench --baseline main --threshold 3\n";
+    out << "  vix bench --filter parser -r 20\n";
+
+    return 0;
+  }
+}
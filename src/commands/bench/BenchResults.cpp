@@ -0,0 +1,218 @@
+/**
+ *
+ *  @file BenchResults.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/bench/BenchResults.hpp>
+#include <vix/cli/commands/bench/BenchStats.hpp>
+
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+
+namespace vix::commands::BenchCommand::detail
+{
+  namespace
+  {
+    using json = nlohmann::json;
+
+    constexpr int BENCH_FORMAT_VERSION = 1;
+
+    std::optional<double> seconds_per_unit(const std::string &unit)
+    {
+      if (unit == "ns")
+        return 1e-9;
+      if (unit == "us")
+        return 1e-6;
+      if (unit == "ms")
+        return 1e-3;
+      if (unit == "s")
+        return 1.0;
+      return std::nullopt;
+    }
+
+    bool ends_with(const std::string &text, const std::string &suffix)
+    {
+      return text.size() >= suffix.size() &&
+             text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // Output of Google Benchmark versions without run_type.
+    bool is_legacy_aggregate(const std::string &name)
+    {
+      return ends_with(name, "_mean") || ends_with(name, "_median") ||
+             ends_with(name, "_stddev") || ends_with(name, "_cv");
+    }
+  } // namespace
+
+  const BenchSeries *BenchRun::find(const std::string &name) const
+  {
+    for (const BenchSeries &s : series)
+    {
+      if (s.name == name)
+        return &s;
+    }
+
+    return nullptr;
+  }
+
+  fs::path bench_dir(const fs::path &projectDir)
+  {
+    return projectDir / ".vix" / "bench";
+  }
+
+  fs::path bench_run_path(const fs::path &projectDir, const std::string &commit)
+  {
+    return bench_dir(projectDir) / (commit + ".json");
+  }
+
+  fs::path bench_baseline_path(const fs::path &projectDir)
+  {
+    return bench_dir(projectDir) / "baseline.json";
+  }
+
+  std::string bench_run_json(const BenchRun &run)
+  {
+    json benchmarks = json::array();
+    for (const BenchSeries &s : run.series)
+      benchmarks.push_back(json{{"name", s.name}, {"samples", s.samples}});
+
+    const json doc{
+        {"version", BENCH_FORMAT_VERSION},
+        {"commit", run.commit},
+        {"cpu", run.cpu},
+        {"benchmarks", std::move(benchmarks)}};
+
+    return doc.dump(2) + "\n";
+  }
+
+  std::optional<BenchRun> parse_bench_run_json(const std::string &text)
+  {
+    const json doc = json::parse(text, nullptr, false);
+    if (!doc.is_object() || doc.value("version", 0) != BENCH_FORMAT_VERSION)
+      return std::nullopt;
+
+    if (!doc.contains("benchmarks") || !doc["benchmarks"].is_array())
+      return std::nullopt;
+
+    BenchRun run;
+    run.commit = doc.value("commit", std::string{});
+    run.cpu = doc.value("cpu", std::string{});
+
+    for (const json &item : doc["benchmarks"])
+    {
+      if (!item.is_object() || !item.contains("samples") || !item["samples"].is_array())
+        continue;
+
+      BenchSeries s;
+      s.name = item.value("name", std::string{});
+
+      for (const json &sample : item["samples"])
+      {
+        if (sample.is_number())
+          s.samples.push_back(sample.get<double>());
+      }
+
+      if (!s.name.empty() && !s.samples.empty())
+        run.series.push_back(std::move(s));
+    }
+
+    return run;
+  }
+
+  std::vector<BenchSeries> parse_google_benchmark_json(
+      const std::string &text,
+      const std::string &prefix)
+  {
+    std::vector<BenchSeries> series;
+
+    const json doc = json::parse(text, nullptr, false);
+    if (!doc.is_object() || !doc.contains("benchmarks") || !doc["benchmarks"].is_array())
+      return series;
+
+    std::unordered_map<std::string, std::size_t> index;
+
+    for (const json &item : doc["benchmarks"])
+    {
+      if (!item.is_object())
+        continue;
+
+      if (item.value("error_occurred", false))
+        continue;
+
+      const std::string name = item.value("name", std::string{});
+      const std::string runType = item.value("run_type", std::string{});
+
+      if (runType == "aggregate" || (runType.empty() && is_legacy_aggregate(name)))
+        continue;
+
+      const auto unit = seconds_per_unit(item.value("time_unit", std::string("ns")));
+      if (!unit || !item.contains("real_time") || !item["real_time"].is_number())
+        continue;
+
+      const std::string runName = item.value("run_name", name);
+      if (runName.empty())
+        continue;
+
+      const std::string key = prefix.empty() ? runName : prefix + "/" + runName;
+
+      auto it = index.find(key);
+      if (it == index.end())
+      {
+        it = index.emplace(key, series.size()).first;
+        series.push_back(BenchSeries{key, {}});
+      }
+
+      series[it->second].samples.push_back(item["real_time"].get<double>() * *unit);
+    }
+
+    return series;
+  }
+
+  std::vector<BenchComparison> compare_bench_runs(
+      const BenchRun &current,
+      const BenchRun *baseline,
+      const BenchCompareOptions &options)
+  {
+    std::vector<BenchComparison> comparisons;
+
+    for (const BenchSeries &s : current.series)
+    {
+      BenchComparison c;
+      c.name = s.name;
+      c.median = median(s.samples);
+
+      const BenchSeries *before = baseline ? baseline->find(s.name) : nullptr;
+      if (!before || before->samples.empty())
+      {
+        comparisons.push_back(std::move(c));
+        continue;
+      }
+
+      c.baselineMedian = median(before->samples);
+      c.change = c.baselineMedian > 0.0 ? c.median / c.baselineMedian - 1.0 : 0.0;
+      c.pValue = mann_whitney_u(s.samples, before->samples).pValue;
+
+      const bool significant = c.pValue < options.alpha;
+
+      if (significant && c.change > options.threshold)
+        c.verdict = BenchVerdict::Regressed;
+      else if (significant && c.change < -options.threshold)
+        c.verdict = BenchVerdict::Improved;
+      else
+        c.verdict = BenchVerdict::Unchanged;
+
+      comparisons.push_back(std::move(c));
+    }
+
+    return comparisons;
+  }
+}
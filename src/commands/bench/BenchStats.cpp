@@ -0,0 +1,176 @@
+/**
+ *
+ *  @file BenchStats.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/bench/BenchStats.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace vix::commands::BenchCommand::detail
+{
+  namespace
+  {
+    // Exact distribution up to 20 samples per side (at most 400 + 1 values
+    // of U per table entry).
+    constexpr std::size_t EXACT_MAX_SAMPLES = 20;
+
+    /**
+     * @brief P(U <= u) for sample sizes m and n under the null hypothesis.
+     *
+     * count(i, j, u) = count(i - 1, j, u - j) + count(i, j - 1, u): the
+     * largest value comes from the first sample (and beats all j values of
+     * the second) or from the second.
+     */
+    double exact_cdf(std::size_t m, std::size_t n, double u)
+    {
+      const std::size_t maxU = m * n;
+      std::vector<std::vector<std::vector<double>>> count(
+          m + 1,
+          std::vector<std::vector<double>>(n + 1));
+
+      for (std::size_t i = 0; i <= m; ++i)
+      {
+        for (std::size_t j = 0; j <= n; ++j)
+        {
+          std::vector<double> &cell = count[i][j];
+          cell.assign(i * j + 1, 0.0);
+
+          if (i == 0 || j == 0)
+          {
+            cell[0] = 1.0;
+            continue;
+          }
+
+          const std::vector<double> &left = count[i - 1][j];
+          const std::vector<double> &down = count[i][j - 1];
+
+          for (std::size_t k = 0; k < cell.size(); ++k)
+          {
+            if (k >= j && k - j < left.size())
+              cell[k] += left[k - j];
+            if (k < down.size())
+              cell[k] += down[k];
+          }
+        }
+      }
+
+      const std::vector<double> &dist = count[m][n];
+
+      double total = 0.0;
+      double below = 0.0;
+      for (std::size_t k = 0; k <= maxU; ++k)
+      {
+        total += dist[k];
+        if (static_cast<double>(k) <= u + 1e-9)
+          below += dist[k];
+      }
+
+      return total > 0.0 ? below / total : 1.0;
+    }
+  } // namespace
+
+  double median(std::vector<double> values)
+  {
+    if (values.empty())
+      return 0.0;
+
+    const std::size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(mid), values.end());
+    const double upper = values[mid];
+
+    if (values.size() % 2 == 1)
+      return upper;
+
+    const double lower = *std::max_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(mid));
+    return (lower + upper) / 2.0;
+  }
+
+  MannWhitneyResult mann_whitney_u(
+      const std::vector<double> &a,
+      const std::vector<double> &b)
+  {
+    MannWhitneyResult result;
+
+    const std::size_t m = a.size();
+    const std::size_t n = b.size();
+    if (m == 0 || n == 0)
+      return result;
+
+    std::vector<std::pair<double, bool>> all; // value, from a
+    all.reserve(m + n);
+    for (const double v : a)
+      all.emplace_back(v, true);
+    for (const double v : b)
+      all.emplace_back(v, false);
+
+    std::sort(
+        all.begin(),
+        all.end(),
+        [](const auto &x, const auto &y)
+        {
+          return x.first < y.first;
+        });
+
+    // Average ranks over ties, and collect the tie sizes for the variance.
+    double rankSumA = 0.0;
+    double tieTerm = 0.0;
+
+    for (std::size_t i = 0; i < all.size();)
+    {
+      std::size_t j = i;
+      while (j < all.size() && all[j].first == all[i].first)
+        ++j;
+
+      const double rank = (static_cast<double>(i + 1) + static_cast<double>(j)) / 2.0;
+      for (std::size_t k = i; k < j; ++k)
+      {
+        if (all[k].second)
+          rankSumA += rank;
+      }
+
+      const double t = static_cast<double>(j - i);
+      tieTerm += t * t * t - t;
+      i = j;
+    }
+
+    const double dm = static_cast<double>(m);
+    const double dn = static_cast<double>(n);
+
+    result.u = rankSumA - dm * (dm + 1.0) / 2.0;
+
+    if (tieTerm == 0.0 && m <= EXACT_MAX_SAMPLES && n <= EXACT_MAX_SAMPLES)
+    {
+      const double lower = exact_cdf(m, n, result.u);
+      const double upper = 1.0 - exact_cdf(m, n, result.u - 1.0);
+
+      result.pValue = std::min(1.0, 2.0 * std::min(lower, upper));
+      result.exact = true;
+      return result;
+    }
+
+    const double total = dm + dn;
+    const double mean = dm * dn / 2.0;
+    const double variance = dm * dn / 12.0 * ((total + 1.0) - tieTerm / (total * (total - 1.0)));
+
+    if (variance <= 0.0)
+      return result; // every value equal: no evidence either way
+
+    const double deviation = std::max(0.0, std::abs(result.u - mean) - 0.5);
+    const double z = deviation / std::sqrt(variance);
+
+    result.pValue = std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+    return result;
+  }
+}
@@ -12,6 +12,7 @@
  *
  */
 #include <vix/cli/commands/run/RunDetail.hpp>
+#include <vix/cli/commands/run/detail/RunProfiler.hpp>
 #include <vix/cli/Style.hpp>
 #include <vix/utils/Env.hpp>
 
@@ -98,7 +99,7 @@ namespace vix::commands::RunCommand::detail
     bool is_known_vix_flag(const std::string &v)
     {
       return v == "--verbose" || v == "--quiet" || v == "-q" ||
-             v == "--watch" || v == "--reload" ||
+             v == "--watch" || v == "--reload" || v == "--hot-reload" ||
              v == "--dev-mode" ||
              v == "--force-server" || v == "--force-script" ||
              v == "--san" || v == "--no-san" ||
@@ -106,15 +107,18 @@ namespace vix::commands::RunCommand::detail
              v == "--docs" || v == "--no-docs" || v.rfind("--docs=", 0) == 0 ||
              v == "--no-color" ||
              v == "--replay" ||
+             v == "--profile" || v.rfind("--profile=", 0) == 0 ||
              v == "--preset" || v.rfind("--preset=", 0) == 0 ||
              v == "--run-preset" || v.rfind("--run-preset=", 0) == 0 ||
              v == "--cwd" || v.rfind("--cwd=", 0) == 0 ||
              v == "--env" || v.rfind("--env=", 0) == 0 ||
+             v == "--listen" || v.rfind("--listen=", 0) == 0 ||
              v == "--args" || v.rfind("--args=", 0) == 0 ||
              v == "--log-level" || v == "--loglevel" || v.rfind("--log-level=", 0) == 0 ||
              v == "--log-format" || v.rfind("--log-format=", 0) == 0 ||
              v == "--log-color" || v.rfind("--log-color=", 0) == 0 ||
              v == "--clear" || v.rfind("--clear=", 0) == 0 ||
+             v == "--timings" || v.rfind("--timings=", 0) == 0 ||
              v == "--no-clear" ||
              v == "--auto-deps" || v.rfind("--auto-deps=", 0) == 0 ||
              v == "--with-sqlite" ||
@@ -551,6 +555,53 @@ namespace vix::commands::RunCommand::detail
       {
         opt.traceCache = false;
       }
+      else if (a == "--profile")
+      {
+        opt.profileHz = DEFAULT_PROFILE_HZ;
+      }
+      else if (a.rfind("--profile=", 0) == 0)
+      {
+        const std::string v = take_eq_value(a, "--profile=");
+        int hz = 0;
+        try
+        {
+          std::size_t used = 0;
+          hz = std::stoi(v, &used);
+          if (used != v.size())
+            hz = 0;
+        }
+        catch (...)
+        {
+          hz = 0;
+        }
+
+        if (hz <= 0 || hz > MAX_PROFILE_HZ)
+        {
+          error("Invalid value for --profile: " + v);
+          hint("Expected a sampling rate in Hz, for example --profile=999");
+          opt.parseFailed = true;
+          opt.parseExitCode = 2;
+          return opt;
+        }
+
+        opt.profileHz = hz;
+      }
+      else if (a == "--timings")
+      {
+        opt.timings = TimingsFormat::Text;
+      }
+      else if (a.rfind("--timings=", 0) == 0)
+      {
+        const std::string v = lower_copy(take_eq_value(a, "--timings="));
+        if (!parse_timings_format(v, opt.timings))
+        {
+          error("Invalid value for --timings: " + v);
+          hint("Valid values: text, json");
+          opt.parseFailed = true;
+          opt.parseExitCode = 2;
+          return opt;
+        }
+      }
       else if (a == "--compiler-fingerprint")
       {
         opt.compilerFingerprint = take_value(args, i, "--compiler-fingerprint", opt);
@@ -565,6 +616,11 @@ namespace vix::commands::RunCommand::detail
       {
         opt.watch = true;
       }
+      else if (a == "--hot-reload")
+      {
+        opt.watch = true;
+        opt.hotReload = true;
+      }
       else if (a == "--force-server")
       {
         opt.forceServerLike = true;
@@ -629,6 +685,16 @@ namespace vix::commands::RunCommand::detail
       {
         opt.runEnv.push_back(take_eq_value(a, "--env="));
       }
+      else if (a == "--listen")
+      {
+        opt.listenAddresses.push_back(take_value(args, i, "--listen", opt));
+        if (opt.parseFailed)
+          return opt;
+      }
+      else if (a.rfind("--listen=", 0) == 0)
+      {
+        opt.listenAddresses.push_back(take_eq_value(a, "--listen="));
+      }
       else if (a == "--args")
       {
         opt.runArgs.push_back(take_value(args, i, "--args", opt));
@@ -12,6 +12,8 @@
  *
  */
 #include <vix/cli/commands/run/RunDetail.hpp>
+#include <vix/cli/commands/run/detail/OutputFastPath.hpp>
+#include <vix/cli/commands/run/detail/RunProfiler.hpp>
 #include <vix/cli/commands/replay/ReplayCapture.hpp>
 #include <vix/cli/Style.hpp>
 #include <vix/utils/Env.hpp>
@@ -24,6 +26,7 @@
 #include <cstring>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <iomanip>
 #include <sstream>
 
@@ -534,26 +537,8 @@ namespace vix::commands::RunCommand::detail
       if (chunk.find(ninjaNoWork) != std::string::npos)
         return true;
 
-      if (!chunk.empty() && chunk[0] == '[')
-      {
-        const auto rb = chunk.find(']');
-        if (rb != std::string::npos)
-        {
-          bool ok = true;
-          for (std::size_t i = 1; i < rb; ++i)
-          {
-            const char c = chunk[i];
-            if (!(c >= '0' && c <= '9') && c != '/')
-            {
-              ok = false;
-              break;
-            }
-          }
-
-          if (ok)
-            return true;
-        }
-      }
+      if (output_is_build_progress(chunk))
+        return true;
 
       const bool hasInterrupt = (chunk.find("Interrupt") != std::string::npos);
       if (hasInterrupt &&
@@ -647,6 +632,12 @@ namespace vix::commands::RunCommand::detail
         return out;
       }
 
+      /// True once every later chunk is forwarded unchanged.
+      bool passthrough() const noexcept
+      {
+        return passthrough_ && buffer_.empty();
+      }
+
     private:
       static constexpr std::size_t TAIL_BUFFER_SIZE = 1024;
       static constexpr int FORCE_PASSTHROUGH_TIMEOUT_SEC = 10;
@@ -938,6 +929,11 @@ namespace vix::commands::RunCommand::detail
         return false;
       }
 
+      bool idle() const noexcept
+      {
+        return !inReport && carry.empty();
+      }
+
       static bool is_report_end(std::string_view line) noexcept
       {
         if (line.rfind("SUMMARY:", 0) == 0)
@@ -1127,42 +1123,9 @@ namespace vix::commands::RunCommand::detail
       return false;
     }
 
-    bool icontains_sv(std::string_view hay, std::string_view needle)
-    {
-      if (needle.empty())
-        return true;
-      if (hay.size() < needle.size())
-        return false;
-
-      for (std::size_t i = 0; i + needle.size() <= hay.size(); ++i)
-      {
-        bool ok = true;
-        for (std::size_t j = 0; j < needle.size(); ++j)
-        {
-          unsigned char a = static_cast<unsigned char>(hay[i + j]);
-          unsigned char b = static_cast<unsigned char>(needle[j]);
-          a = static_cast<unsigned char>(std::tolower(a));
-          b = static_cast<unsigned char>(std::tolower(b));
-          if (a != b)
-          {
-            ok = false;
-            break;
-          }
-        }
-        if (ok)
-          return true;
-      }
-
-      return false;
-    }
-
     bool is_known_runtime_port_in_use(std::string_view s)
     {
-      return icontains_sv(s, "address already in use") ||
-             icontains_sv(s, "eaddrinuse") ||
-             (icontains_sv(s, "bind") &&
-              icontains_sv(s, "acceptor") &&
-              icontains_sv(s, "address already in use"));
+      return output_reports_port_in_use(s);
     }
 
     void kill_group_or_pid(pid_t pid, int sig)
@@ -1256,6 +1219,11 @@ namespace vix::commands::RunCommand::detail
       if (chunk.empty())
         return;
 
+      // Nothing below prints in capture-only mode, and the filters only keep
+      // per-line state, so skip them instead of running them for nothing.
+      if (captureOnly)
+        return;
+
       if (should_drop_chunk_default(chunk))
         return;
 
@@ -1318,6 +1286,117 @@ namespace vix::commands::RunCommand::detail
       lastPrintedChar = toPrint.back();
     }
 
+    bool output_fast_path_enabled()
+    {
+      const char *value = vix::utils::vix_getenv("VIX_RUN_OUTPUT_FAST_PATH");
+      return !(value && std::strcmp(value, "0") == 0);
+    }
+
+    /**
+     * @brief Forward sustained high-volume runtime output without line filtering.
+     *
+     * The path is entered only while the line filters hold no state: runtime
+     * banner passed, no carried partial line, no open sanitizer report. From
+     * there, complete lines free of filter triggers print exactly as the
+     * filters would print them. The first chunk with a trigger, or the first
+     * quiet window, hands the held partial line back to the full chain.
+     */
+    class HighVolumeOutputPath
+    {
+    public:
+      explicit HighVolumeOutputPath(bool enabled)
+          : enabled_(enabled)
+      {
+      }
+
+      /**
+       * @brief Try to handle chunk on the fast path.
+       *
+       * @return true when handled, with the bytes to print in out. false when
+       *         the full chain must run on held + chunk.
+       */
+      bool process(
+          const std::string &chunk,
+          bool filtersIdle,
+          std::string &out,
+          std::string &held)
+      {
+        out.clear();
+        held.clear();
+
+        if (!enabled_)
+          return false;
+
+        const bool hot = meter_.observe(chunk.size(), std::chrono::steady_clock::now());
+
+        if (!active_)
+        {
+          if (!hot || !filtersIdle)
+            return false;
+
+          active_ = true;
+        }
+
+        // should_drop_chunk_default() drops whole chunks that start with a
+        // build progress counter; other bracketed log lines stay here.
+        if (!hot || output_is_build_progress(chunk))
+          return leave(held);
+
+        std::string joined;
+        std::string_view data = chunk;
+        if (!carry_.empty())
+        {
+          joined = carry_;
+          joined += chunk;
+          data = joined;
+        }
+
+        const std::size_t lastNl = data.rfind('\n');
+        const std::string_view complete =
+            lastNl == std::string_view::npos ? std::string_view{} : data.substr(0, lastNl + 1);
+        const std::string_view rest =
+            lastNl == std::string_view::npos ? data : data.substr(lastNl + 1);
+
+        // Mirror the filters, which print a trailing prompt without waiting for
+        // its newline. Very long unterminated lines are not held forever.
+        const bool flushRest =
+            !rest.empty() &&
+            (rest.size() > MAX_HELD_BYTES || looks_like_prompt_fragment(std::string(rest)));
+        const std::string_view printable = flushRest ? data : complete;
+
+        if (output_has_filter_trigger(printable) || output_has_blank_line(complete))
+          return leave(held);
+
+        out.assign(printable.data(), printable.size());
+        carry_.assign(flushRest ? std::string_view{} : rest);
+        return true;
+      }
+
+      /**
+       * @brief Return the partial line still held when the program exits.
+       */
+      std::string finish()
+      {
+        active_ = false;
+        return std::exchange(carry_, std::string{});
+      }
+
+    private:
+      static constexpr std::size_t MAX_HELD_BYTES = 1024 * 1024;
+
+      bool leave(std::string &held)
+      {
+        active_ = false;
+        held = std::exchange(carry_, std::string{});
+        return false;
+      }
+
+      bool enabled_;
+      bool active_ = false;
+      OutputRateMeter meter_;
+      std::string carry_;
+    };
+
   } // namespace
 
   LiveRunResult run_cmd_live_filtered_capture(
@@ -1342,9 +1421,20 @@ namespace vix::commands::RunCommand::detail
       return result;
     }
 
+    // A profiled child waits for the sampler before it execs: events
+    // opened while execve() is in flight are not inherited by the
+    // processes the shell starts.
+    RunProfiler &profiler = RunProfiler::instance();
+    int profileGate[2] = {-1, -1};
+    if (profiler.armed() && ::pipe(profileGate) != 0)
+      profileGate[0] = profileGate[1] = -1;
+
     pid_t pid = ::fork();
     if (pid < 0)
     {
+      close_safe(profileGate[0]);
+      close_safe(profileGate[1]);
+
       const int st = std::system(cmd.c_str());
       result.rawStatus = st;
       result.exitCode = normalize_exit_code(st);
@@ -1356,16 +1446,35 @@ namespace vix::commands::RunCommand::detail
     bool forwardStdin = passthroughRuntime && stdinIsTty;
 
     if (pid == 0)
+    {
+      if (profileGate[0] >= 0)
+      {
+        char go = 0;
+        close_safe(profileGate[1]);
+        (void)::read(profileGate[0], &go, 1);
+        close_safe(profileGate[0]);
+      }
+
       child_exec_shell(
           cmd,
           pty.masterFd,
           pty.slaveFd,
           useSan,
           inheritParentStdin);
+    }
 
     close_safe(pty.slaveFd);
     ::setpgid(pid, pid);
 
+    bool profiling = false;
+    if (profileGate[0] >= 0)
+    {
+      profiling = profiler.attach(static_cast<int>(pid));
+
+      close_safe(profileGate[0]);
+      close_safe(profileGate[1]);
+    }
+
     bool spinnerActive = false;
     std::size_t frameIndex = 0;
 
@@ -1374,6 +1483,10 @@ namespace vix::commands::RunCommand::detail
     CMakeNoiseFilter cmakeNoise;
     SanitizerSuppressor sanitizer;
     UncaughtExceptionSuppressor uncaught;
+    HighVolumeOutputPath highVolume(output_fast_path_enabled());
+    BoundedOutputCapture capture;
+    std::string fastOut;
+    std::string heldOut;
 
     bool running = true;
     bool printedSomething = false;
@@ -1634,7 +1747,7 @@ namespace vix::commands::RunCommand::detail
                   clear_heartbeat_line();
               }
 
-              result.stdoutText += chunk;
+              capture.append(chunk);
 
               if (outputObserver)
                 outputObserver(chunk);
@@ -1645,10 +1758,27 @@ namespace vix::commands::RunCommand::detail
               if (!suppress_known_failure_output && is_known_runtime_port_in_use(chunk))
                 suppress_known_failure_output = true;
 
-              if (!suppress_known_failure_output)
+              const bool filtersIdle =
+                  !cmakeConfigure && !useSan && !captureOnly &&
+                  (passthroughRuntime || runtimeFilter.passthrough()) &&
+                  sanitizer.idle() && uncaught.carry.empty();
+
+              if (!suppress_known_failure_output &&
+                  highVolume.process(chunk, filtersIdle, fastOut, heldOut))
+              {
+                if (!fastOut.empty())
+                {
+                  write_all(STDOUT_FILENO, fastOut.data(), fastOut.size());
+                  printedSomething = true;
+                  printedRealOutput = true;
+                  result.printed_live = true;
+                  lastPrintedChar = fastOut.back();
+                }
+              }
+              else if (!suppress_known_failure_output)
               {
                 process_printable_chunk(
-                    chunk,
+                    heldOut.empty() ? chunk : heldOut + chunk,
                     cmakeConfigure,
                     passthroughRuntime,
                     captureOnly,
@@ -1711,6 +1841,27 @@ namespace vix::commands::RunCommand::detail
     if (spinnerActive && !captureOnly)
       spinner_clear(printedSomething, lastPrintedChar);
 
+    if (const std::string held = highVolume.finish();
+        !held.empty() && !suppress_known_failure_output)
+    {
+      process_printable_chunk(
+          held,
+          cmakeConfigure,
+          passthroughRuntime,
+          captureOnly,
+          useSan,
+          runtimeFilter,
+          cmakeNoise,
+          sanitizer,
+          uncaught,
+          result,
+          printedSomething,
+          printedRealOutput,
+          lastPrintedChar);
+    }
+
+    result.stdoutText += capture.str();
+
     close_safe(pty.masterFd);
 
     if (!haveStatus)
@@ -1723,6 +1874,9 @@ namespace vix::commands::RunCommand::detail
       }
     }
 
+    if (profiling)
+      profiler.detach();
+
     result.rawStatus = haveStatus ? finalStatus : 0;
 
     if (didTimeout)
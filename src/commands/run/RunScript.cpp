@@ -28,6 +28,8 @@
 #include <vix/utils/Env.hpp>
 #include <vix/cli/commands/run/dev/DevSession.hpp>
 #include <vix/cli/commands/run/detail/RunnableExecutableResolver.hpp>
+#include <vix/cli/commands/run/detail/RunProfiler.hpp>
+#include <vix/cli/commands/run/detail/RunTimings.hpp>
 
 #include <algorithm>
 #include <atomic>
@@ -1468,6 +1470,8 @@ namespace vix::commands::RunCommand::detail
           opt.enableUbsanOnly,
           opt.enableThreadSanitizer);
 
+      ProfileScope profile(opt.cppFile.stem().string());
+      TimingScope execTiming("exec");
       LiveRunResult rr = run_cmd_live_filtered_capture(
           cmdRun,
           "",
@@ -1476,6 +1480,8 @@ namespace vix::commands::RunCommand::detail
           useSanRuntime,
           false,
           replayEnabled ? &replayCapture : nullptr);
+      execTiming.stop();
+      profile.finish();
 
       if (replayEnabled)
       {
@@ -1626,12 +1632,14 @@ namespace vix::commands::RunCommand::detail
           opt.enableUbsanOnly,
           opt.enableThreadSanitizer);
 
+      TimingScope execTiming("exec");
       const LiveRunResult rr = run_cmd_live_filtered_capture(
           cmdRun,
           "",
           true,
           effective_timeout_sec(opt),
           useSanRuntime);
+      execTiming.stop();
 
       int runCode = normalize_exit_code(rr.exitCode);
 
@@ -1678,6 +1686,17 @@ namespace vix::commands::RunCommand::detail
         return 1;
       }
 
+      for (const auto &report : prepare_script_dependency_artifacts(state.script, opt.scriptFlags))
+      {
+        if (opt.quiet)
+          continue;
+
+        if (report.status == ScriptDepArtifactStatus::Built)
+          vix::cli::util::ok_line(std::cout, "Prebuilt dependency " + report.pkgDir);
+        else if (report.status == ScriptDepArtifactStatus::Failed && opt.verbose)
+          hint("Shared artifact unavailable: " + report.error);
+      }
+
       const std::string cmakeText = make_script_cmakelists(
           state.exeName,
           state.script,
@@ -1729,7 +1748,9 @@ namespace vix::commands::RunCommand::detail
 
     int configure_and_build_script(Options &o, ScriptProjectState &state)
     {
+      TimingScope materializeTiming("materialize");
       const int materializeCode = materialize_cmake_script_project(o, state);
+      materializeTiming.stop();
       if (materializeCode != 0)
         return materializeCode;
 
@@ -1749,13 +1770,19 @@ namespace vix::commands::RunCommand::detail
         state.skipBuild = false;
       }
 
+      TimingScope configureTiming("configure");
       const int cfgCode = configure_script_project(o, state);
+      configureTiming.stop();
       if (cfgCode != 0)
         return cfgCode;
 
+      TimingScope cacheValidationTiming("cache_validation");
       state.skipBuild = can_skip_build(o, state);
+      cacheValidationTiming.stop();
 
+      TimingScope buildTiming("build");
       const int buildCode = build_script_project(o, state);
+      buildTiming.stop();
       if (buildCode != 0)
         return buildCode;
 
@@ -1816,11 +1843,15 @@ namespace vix::commands::RunCommand::detail
     {
       Options o = opt;
 
+      TimingScope prepareTiming("prepare");
       const int prepCode = prepare_script_options_common(o);
+      prepareTiming.stop();
       if (prepCode != 0)
         return prepCode;
 
+      TimingScope probeTiming("probe");
       const ScriptProbeResult probe = probe_single_cpp_script(o);
+      probeTiming.stop();
 
       if (script_can_use_direct_compile(probe))
       {
@@ -1866,7 +1897,7 @@ namespace vix::commands::RunCommand::detail
 
         if (cache.needsRebuild)
         {
-          const auto compileStart = std::chrono::steady_clock::now();
+          TimingScope compileTiming("compile_link");
           const LiveRunResult build = run_cmd_live_filtered_capture(
               directPlan.compileCmd,
               "Compiling script...",
@@ -1874,14 +1905,7 @@ namespace vix::commands::RunCommand::detail
               0,
               o.enableSanitizers || o.enableUbsanOnly,
               true);
-          if (const char *trace = vix::utils::vix_getenv("VIX_PERF_TRACE");
-              trace && std::string(trace) == "1")
-          {
-            const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
-                std::chrono::steady_clock::now() - compileStart);
-            std::cerr << "[vix-perf] compiler_and_linker="
-                      << static_cast<double>(elapsed.count()) / 1000.0 << "ms\n";
-          }
+          compileTiming.stop();
 
           if (build.exitCode != 0)
           {
@@ -1915,17 +1939,9 @@ namespace vix::commands::RunCommand::detail
             return build.exitCode != 0 ? build.exitCode : 1;
           }
 
-          const auto persistenceStart = std::chrono::steady_clock::now();
+          TimingScope persistenceTiming("cache_persistence");
           if (!persist_direct_script_cache_metadata(directPlan))
             std::cerr << "warning: unable to persist direct script cache metadata\n";
-          if (const char *trace = vix::utils::vix_getenv("VIX_PERF_TRACE");
-              trace && std::string(trace) == "1")
-          {
-            const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
-                std::chrono::steady_clock::now() - persistenceStart);
-            std::cerr << "[vix-perf] cache_persistence="
-                      << static_cast<double>(elapsed.count()) / 1000.0 << "ms\n";
-          }
         }
 
         exePath = directPlan.binaryPath;
@@ -2075,11 +2091,15 @@ namespace vix::commands::RunCommand::detail
   {
     Options o = opt;
 
+    TimingScope prepareTiming("prepare");
     const int prepCode = prepare_script_options_common(o);
+    prepareTiming.stop();
     if (prepCode != 0)
       return prepCode;
 
+    TimingScope probeTiming("probe");
     const ScriptProbeResult probe = probe_single_cpp_script(o);
+    probeTiming.stop();
 
     if (script_can_use_direct_compile(probe))
     {
@@ -2092,6 +2112,11 @@ namespace vix::commands::RunCommand::detail
     return run_single_cpp_cmake(o, cmakePlan);
   }
 
+  int prepare_single_cpp_options(Options &opt)
+  {
+    return prepare_script_options_common(opt);
+  }
+
   int build_script_executable(
       const Options &opt,
       std::filesystem::path &exePath,
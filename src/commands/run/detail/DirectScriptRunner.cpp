@@ -12,6 +12,9 @@
  *
  */
 #include <vix/cli/commands/run/detail/DirectScriptRunner.hpp>
+#include <vix/cli/commands/run/detail/RunProfiler.hpp>
+#include <vix/cli/commands/run/detail/RunTimings.hpp>
+#include <vix/cli/util/CompilerIdentity.hpp>
 #include <vix/cli/commands/helpers/ProcessHelpers.hpp>
 #include <vix/cli/commands/helpers/TextHelpers.hpp>
 #include <vix/cli/commands/run/RunScriptHelpers.hpp>
@@ -171,24 +174,6 @@ namespace vix::commands::RunCommand::detail
 #endif
     }
 
-    bool direct_perf_trace_enabled()
-    {
-      const char *value = vix::utils::vix_getenv("VIX_PERF_TRACE");
-      return value && std::string(value) == "1";
-    }
-
-    void direct_perf_trace(const char *stage,
-                           std::chrono::steady_clock::time_point started)
-    {
-      if (!direct_perf_trace_enabled())
-        return;
-
-      const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
-          std::chrono::steady_clock::now() - started);
-      std::cerr << "[vix-perf] " << stage << "="
-                << static_cast<double>(elapsed.count()) / 1000.0 << "ms\n";
-    }
-
 #ifndef _WIN32
     bool is_user_interrupt_result(const LiveRunResult &result) noexcept
     {
@@ -416,39 +401,12 @@ namespace vix::commands::RunCommand::detail
     }
 
     /**
-     * @brief Run a compiler query and return a trimmed result.
+     * @brief Return the cached identity of compiler, or nullopt.
      */
-    std::string compiler_query(const std::string &compiler, const std::string &arg)
+    std::optional<vix::cli::util::CompilerIdentity> direct_compiler_identity(
+        const std::string &compiler)
     {
-      static std::unordered_map<std::string, std::string> cache;
-      const std::string key = compiler + "\n" + arg;
-
-      if (const auto it = cache.find(key); it != cache.end())
-        return it->second;
-
-      int code = 0;
-      const std::string out = run_and_capture_with_code(
-          process::quote(compiler) + " " + arg,
-          code);
-
-      if (code != 0)
-      {
-        cache[key] = "unknown";
-        return "unknown";
-      }
-
-      std::string s = out;
-      while (!s.empty() &&
-             (s.back() == '\n' || s.back() == '\r' || s.back() == ' ' || s.back() == '\t'))
-      {
-        s.pop_back();
-      }
-
-      if (s.empty())
-        s = "unknown";
-
-      cache[key] = s;
-      return s;
+      return vix::cli::util::compiler_identity(compiler);
     }
 
     bool direct_compiler_queries_enabled(const Options &opt)
@@ -466,7 +424,8 @@ namespace vix::commands::RunCommand::detail
 #else
       if (!direct_compiler_queries_enabled(opt))
         return "fast";
-      return compiler_query(compiler, "-dumpfullversion -dumpversion");
+      const auto id = direct_compiler_identity(compiler);
+      return id ? id->version : "unknown";
 #endif
     }
 
@@ -480,7 +439,8 @@ namespace vix::commands::RunCommand::detail
 #else
       if (!direct_compiler_queries_enabled(opt))
         return "native";
-      return compiler_query(compiler, "-dumpmachine");
+      const auto id = direct_compiler_identity(compiler);
+      return id ? id->target : "unknown";
 #endif
     }
 
@@ -694,12 +654,12 @@ namespace vix::commands::RunCommand::detail
         for (const auto &lib : find_vix_direct_module_libs(abs))
           fp.depFingerprints.push_back(path_fingerprint(lib));
       }
-      const auto dependencyDiscoveryStart = std::chrono::steady_clock::now();
+      TimingScope dependencyDiscoveryTiming("dependency_discovery");
       fp.headerFingerprints = collect_direct_header_fingerprints(
           abs,
           probe,
           compiler);
-      direct_perf_trace("dependency_discovery", dependencyDiscoveryStart);
+      dependencyDiscoveryTiming.stop();
       const auto dependencyHeaders = collect_header_fingerprints(probe);
       fp.headerFingerprints.insert(
           fp.headerFingerprints.end(),
@@ -1077,10 +1037,45 @@ namespace vix::commands::RunCommand::detail
                 << "\n";
     }
 
+    /**
+     * @brief Link the installed Vix runtime: libvix.a, else its module archives.
+     */
+    void append_vix_runtime_libs(std::ostringstream &cmd, const DirectScriptPlan &plan)
+    {
+      if (const auto vixLib = find_vix_lib())
+      {
+        cmd << " " << process::quote(vixLib->string());
+      }
+      else
+      {
+        const auto libs = find_vix_direct_module_libs(plan.scriptPath);
+        if (!libs.empty())
+        {
+#ifndef __APPLE__
+          cmd << " -Wl,--start-group";
+#endif
+          for (const auto &moduleLib : libs)
+            cmd << " " << process::quote(moduleLib.string());
+#ifndef __APPLE__
+          cmd << " -Wl,--end-group";
+#endif
+        }
+      }
+
+      cmd << " -lspdlog -lfmt -pthread -ldl";
+#ifdef __APPLE__
+      cmd << " -framework CoreFoundation";
+#endif
+    }
+
     /**
      * @brief Build the compile command for the direct path.
      */
-    std::string make_direct_compile_cmd(const Options &opt, const DirectScriptPlan &plan)
+    std::string make_direct_compile_cmd_for(
+        const Options &opt,
+        const DirectScriptPlan &plan,
+        const fs::path &output,
+        bool sharedObject)
     {
       std::ostringstream cmd;
 
@@ -1088,7 +1083,12 @@ namespace vix::commands::RunCommand::detail
 
       append_quoted(cmd, plan.scriptPath.string());
       cmd << " -o";
-      append_quoted(cmd, plan.binaryPath.string());
+      append_quoted(cmd, output.string());
+
+      // Hot reload loads each generation with dlopen(). The Vix PCH is built
+      // without -fPIC, so it is not reused for shared objects.
+      if (sharedObject)
+        cmd << " -shared -fPIC";
 
       bool hasStd = false;
       for (const auto &compileOpt : plan.probe.compileOpts)
@@ -1112,33 +1112,17 @@ namespace vix::commands::RunCommand::detail
         if (const auto incDir = find_vix_include_dir())
           cmd << " -I" << process::quote(incDir->string());
 
-        if (const auto pch = find_vix_pch())
-          cmd << " -include-pch " << process::quote(pch->string());
-
-        if (const auto vixLib = find_vix_lib())
-        {
-          cmd << " " << process::quote(vixLib->string());
-        }
-        else
+        if (!sharedObject)
         {
-          const auto libs = find_vix_direct_module_libs(plan.scriptPath);
-          if (!libs.empty())
-          {
-#ifndef __APPLE__
-            cmd << " -Wl,--start-group";
-#endif
-            for (const auto &moduleLib : libs)
-              cmd << " " << process::quote(moduleLib.string());
-#ifndef __APPLE__
-            cmd << " -Wl,--end-group";
-#endif
-          }
+          if (const auto pch = find_vix_pch())
+            cmd << " -include-pch " << process::quote(pch->string());
         }
 
-        cmd << " -lspdlog -lfmt -pthread -ldl";
-#ifdef __APPLE__
-        cmd << " -framework CoreFoundation";
-#endif
+        // libvix.a and the module archives are not built with -fPIC, and each
+        // generation would get its own copy of the runtime's globals. Hot
+        // reload refuses such scripts, so a shared object never links them.
+        if (!sharedObject)
+          append_vix_runtime_libs(cmd, plan);
       }
 
       for (const auto &inc : plan.probe.includeDirs)
@@ -1192,6 +1176,11 @@ namespace vix::commands::RunCommand::detail
       return cmd.str();
     }
 
+    std::string make_direct_compile_cmd(const Options &opt, const DirectScriptPlan &plan)
+    {
+      return make_direct_compile_cmd_for(opt, plan, plan.binaryPath, false);
+    }
+
     /**
      * @brief Build the runtime command for the direct path.
      */
@@ -1310,9 +1299,9 @@ namespace vix::commands::RunCommand::detail
 
     plan.exeName = stem.empty() ? "script" : stem;
 
-    const auto fingerprintStart = std::chrono::steady_clock::now();
+    TimingScope fingerprintTiming("fingerprint");
     plan.fingerprint = make_direct_build_fingerprint(plan.scriptPath, probe, opt);
-    direct_perf_trace("fingerprint", fingerprintStart);
+    fingerprintTiming.stop();
     plan.cacheKey = direct_build_fingerprint_cache_key(plan.fingerprint);
     plan.cacheDir = get_direct_scripts_cache_root(opt.localCache) / plan.cacheKey;
 
@@ -1326,9 +1315,9 @@ namespace vix::commands::RunCommand::detail
     plan.compileCmd = make_direct_compile_cmd(opt, plan);
     plan.runCmd = make_direct_run_cmd(opt, plan);
 
-    const auto cacheValidationStart = std::chrono::steady_clock::now();
+    TimingScope cacheValidationTiming("cache_validation");
     plan.cacheState = load_direct_script_cache_state(plan);
-    direct_perf_trace("cache_validation", cacheValidationStart);
+    cacheValidationTiming.stop();
     plan.shouldCompile = plan.cacheState.needsRebuild;
     print_direct_cache_trace(opt, plan, plan.cacheState);
 
@@ -1487,7 +1476,7 @@ namespace vix::commands::RunCommand::detail
 
     if (cache.needsRebuild)
     {
-      const auto compileStart = std::chrono::steady_clock::now();
+      TimingScope compileTiming("compile_link");
       const LiveRunResult build = run_cmd_live_filtered_capture(
           plan.compileCmd,
           "",
@@ -1498,7 +1487,7 @@ namespace vix::commands::RunCommand::detail
               opt.enableUbsanOnly,
               opt.enableThreadSanitizer),
           true);
-      direct_perf_trace("compiler_and_linker", compileStart);
+      compileTiming.stop();
 
       if (build.exitCode != 0)
       {
@@ -1536,10 +1525,9 @@ namespace vix::commands::RunCommand::detail
                    : 1;
       }
 
-      const auto persistenceStart = std::chrono::steady_clock::now();
+      TimingScope persistenceTiming("cache_persistence");
       if (!persist_direct_script_cache_metadata(plan))
         std::cerr << "warning: unable to persist direct script cache metadata\n";
-      direct_perf_trace("cache_persistence", persistenceStart);
     }
 
     if (!plan.shouldRun)
@@ -1579,6 +1567,8 @@ namespace vix::commands::RunCommand::detail
         replayCapture.attach(&recorder);
     }
 
+    ProfileScope profile(opt.cppFile.stem().string());
+    TimingScope execTiming("exec");
     const LiveRunResult run = run_cmd_live_filtered_capture(
         plan.runCmd,
         "Running script...",
@@ -1590,6 +1580,8 @@ namespace vix::commands::RunCommand::detail
             opt.enableThreadSanitizer),
         false,
         replayEnabled ? &replayCapture : nullptr);
+    execTiming.stop();
+    profile.finish();
 
     if (replayEnabled)
     {
@@ -1638,4 +1630,24 @@ namespace vix::commands::RunCommand::detail
     return run.exitCode;
   }
 
+  std::string make_direct_shared_object_compile_cmd(
+      const Options &opt,
+      const DirectScriptPlan &plan,
+      const fs::path &output)
+  {
+    return make_direct_compile_cmd_for(opt, plan, output, true);
+  }
+
+  std::string make_direct_abi_fingerprint(const DirectScriptPlan &plan)
+  {
+    // Everything the host and a loaded generation must agree on, but nothing
+    // that changes on an ordinary edit of the script or of its own headers.
+    DirectBuildFingerprint abi = plan.fingerprint;
+    abi.scriptContentHash.clear();
+    abi.scriptMtimeNs = 0;
+    abi.headerFingerprints.clear();
+
+    return direct_build_fingerprint_cache_key(abi);
+  }
+
 } // namespace vix::commands::RunCommand::detail
@@ -0,0 +1,335 @@
+/**
+ *
+ *  @file OutputFastPath.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira. All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by an MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/run/detail/OutputFastPath.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace vix::commands::RunCommand::detail
+{
+  namespace
+  {
+    constexpr unsigned char fold_ascii(unsigned char c) noexcept
+    {
+      return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+    }
+
+    bool equal_at(
+        std::string_view hay,
+        std::size_t pos,
+        std::string_view needle,
+        bool foldCase) noexcept
+    {
+      if (!foldCase)
+        return std::memcmp(hay.data() + pos, needle.data(), needle.size()) == 0;
+
+      for (std::size_t i = 0; i < needle.size(); ++i)
+      {
+        if (fold_ascii(static_cast<unsigned char>(hay[pos + i])) !=
+            fold_ascii(static_cast<unsigned char>(needle[i])))
+          return false;
+      }
+
+      return true;
+    }
+
+    // Markers acted upon by SanitizerSuppressor, UncaughtExceptionSuppressor,
+    // drop_*_lines and should_drop_chunk_default in RunProcess.cpp. Keep this
+    // list a superset of theirs: a missing marker would let a line skip them.
+    constexpr std::string_view FILTER_TRIGGERS[] = {
+        "Sanitizer",
+        "SAN_OPTIONS",
+        "Shadow byte",
+        " of size ",
+        " by thread",
+        "is located",
+        "runtime error:",
+        "==",
+        "terminate",
+        "terminating",
+        "what():",
+        "core dumped",
+        "SIGABRT",
+        "free(",
+        "double free",
+        "malloc(",
+        "munmap_chunk",
+        "error:",
+        "tip:",
+        "ninja:",
+        "Interrupt",
+    };
+
+    bool is_blank(char c) noexcept
+    {
+      return c == ' ' || c == '\t' || c == '\r';
+    }
+  } // namespace
+
+  std::size_t find_output_marker(
+      std::string_view hay,
+      std::string_view needle,
+      bool foldCase) noexcept
+  {
+    const std::size_t n = needle.size();
+    if (n == 0)
+      return 0;
+    if (hay.size() < n)
+      return std::string_view::npos;
+
+    const std::size_t lastStart = hay.size() - n;
+    const unsigned char first = fold_ascii(static_cast<unsigned char>(needle.front()));
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    // Compare the first and last needle bytes against 16 candidate positions
+    // at once and only verify positions where both match. OR-ing 0x20 maps
+    // ASCII upper case onto lower case; the few punctuation bytes it also
+    // folds are rejected by equal_at().
+    const unsigned char last = fold_ascii(static_cast<unsigned char>(needle.back()));
+    const __m128i foldMask = _mm_set1_epi8(static_cast<char>(foldCase ? 0x20 : 0));
+    const __m128i firstBytes = _mm_set1_epi8(
+        static_cast<char>(foldCase ? (first | 0x20) : static_cast<unsigned char>(needle.front())));
+    const __m128i lastBytes = _mm_set1_epi8(
+        static_cast<char>(foldCase ? (last | 0x20) : static_cast<unsigned char>(needle.back())));
+
+    for (; i + 16 <= lastStart + 1; i += 16)
+    {
+      const __m128i a = _mm_or_si128(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay.data() + i)),
+          foldMask);
+      const __m128i b = _mm_or_si128(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay.data() + i + n - 1)),
+          foldMask);
+
+      unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+          _mm_and_si128(_mm_cmpeq_epi8(a, firstBytes), _mm_cmpeq_epi8(b, lastBytes))));
+
+      while (mask != 0)
+      {
+        const std::size_t pos = i + static_cast<std::size_t>(__builtin_ctz(mask));
+        if (equal_at(hay, pos, needle, foldCase))
+          return pos;
+        mask &= mask - 1;
+      }
+    }
+#endif
+
+    if (!foldCase)
+    {
+      const std::size_t pos = hay.find(needle, i);
+      return pos;
+    }
+
+    for (; i <= lastStart; ++i)
+    {
+      if (fold_ascii(static_cast<unsigned char>(hay[i])) == first &&
+          equal_at(hay, i, needle, true))
+        return i;
+    }
+
+    return std::string_view::npos;
+  }
+
+  bool output_reports_port_in_use(std::string_view text) noexcept
+  {
+    return find_output_marker(text, "address already in use", true) != std::string_view::npos ||
+           find_output_marker(text, "eaddrinuse", true) != std::string_view::npos;
+  }
+
+  bool output_is_build_progress(std::string_view chunk) noexcept
+  {
+    if (chunk.empty() || chunk.front() != '[')
+      return false;
+
+    const std::size_t rb = chunk.find(']');
+    if (rb == std::string_view::npos)
+      return false;
+
+    for (std::size_t i = 1; i < rb; ++i)
+    {
+      const char c = chunk[i];
+      if (!(c >= '0' && c <= '9') && c != '/')
+        return false;
+    }
+
+    return true;
+  }
+
+  bool output_has_filter_trigger(std::string_view text) noexcept
+  {
+    for (const std::string_view marker : FILTER_TRIGGERS)
+    {
+      if (find_output_marker(text, marker) != std::string_view::npos)
+        return true;
+    }
+
+    return false;
+  }
+
+  bool output_has_blank_line(std::string_view text) noexcept
+  {
+    std::size_t start = 0;
+    while (start < text.size())
+    {
+      const void *hit = std::memchr(text.data() + start, '\n', text.size() - start);
+      const std::size_t end = hit
+                                  ? static_cast<std::size_t>(static_cast<const char *>(hit) - text.data())
+                                  : text.size();
+
+      // Only complete lines count; a trailing fragment may still grow.
+      if (!hit)
+        return false;
+
+      bool blank = true;
+      for (std::size_t i = start; i < end; ++i)
+      {
+        if (!is_blank(text[i]))
+        {
+          blank = false;
+          break;
+        }
+      }
+
+      if (blank)
+        return true;
+
+      start = end + 1;
+    }
+
+    return false;
+  }
+
+  OutputRateMeter::OutputRateMeter(
+      double enterBytesPerSec,
+      double leaveBytesPerSec,
+      std::chrono::milliseconds window)
+      : enter_(enterBytesPerSec),
+        leave_(leaveBytesPerSec),
+        window_(window)
+  {
+  }
+
+  bool OutputRateMeter::observe(std::size_t bytes, Clock::time_point now) noexcept
+  {
+    if (!started_)
+    {
+      started_ = true;
+      windowStart_ = now;
+    }
+
+    windowBytes_ += bytes;
+
+    const auto elapsed = now - windowStart_;
+    if (elapsed < window_)
+      return hot_;
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    const double rate = static_cast<double>(windowBytes_) / seconds;
+
+    hot_ = hot_ ? rate >= leave_ : rate >= enter_;
+
+    windowStart_ = now;
+    windowBytes_ = 0;
+    return hot_;
+  }
+
+  BoundedOutputCapture::BoundedOutputCapture(std::size_t headBytes, std::size_t tailBytes)
+      : headLimit_(headBytes),
+        tailLimit_(tailBytes)
+  {
+  }
+
+  void BoundedOutputCapture::append(std::string_view data)
+  {
+    total_ += data.size();
+
+    if (head_.size() < headLimit_)
+    {
+      const std::size_t take = std::min(headLimit_ - head_.size(), data.size());
+      head_.append(data.data(), take);
+      data.remove_prefix(take);
+    }
+
+    if (data.empty() || tailLimit_ == 0)
+      return;
+
+    // Only the last tailLimit_ bytes of this append can survive.
+    if (data.size() >= tailLimit_)
+    {
+      data.remove_prefix(data.size() - tailLimit_);
+      ring_.assign(data.begin(), data.end());
+      ringStart_ = 0;
+      ringSize_ = tailLimit_;
+      return;
+    }
+
+    if (ring_.size() < tailLimit_)
+    {
+      // Grow lazily: most runs never leave the head.
+      const std::size_t room = tailLimit_ - ring_.size();
+      const std::size_t grow = std::min(room, data.size());
+      ring_.insert(ring_.end(), data.begin(), data.begin() + static_cast<std::ptrdiff_t>(grow));
+      ringSize_ = ring_.size();
+      data.remove_prefix(grow);
+
+      if (data.empty())
+        return;
+    }
+
+    // Ring is full: overwrite the oldest bytes.
+    for (std::size_t copied = 0; copied < data.size();)
+    {
+      const std::size_t chunk = std::min(tailLimit_ - ringStart_, data.size() - copied);
+      std::memcpy(ring_.data() + ringStart_, data.data() + copied, chunk);
+      ringStart_ = (ringStart_ + chunk) % tailLimit_;
+      copied += chunk;
+    }
+  }
+
+  std::uint64_t BoundedOutputCapture::dropped_bytes() const noexcept
+  {
+    return total_ - head_.size() - ringSize_;
+  }
+
+  std::string BoundedOutputCapture::str() const
+  {
+    std::string out;
+    out.reserve(head_.size() + ringSize_ + 64);
+    out += head_;
+
+    const std::uint64_t dropped = dropped_bytes();
+    if (dropped > 0)
+    {
+      out += "\n[vix] ";
+      out += std::to_string(dropped);
+      out += " bytes of output omitted\n";
+    }
+
+    if (ringSize_ < tailLimit_ || ringStart_ == 0)
+    {
+      out.append(ring_.data(), ringSize_);
+      return out;
+    }
+
+    out.append(ring_.data() + ringStart_, tailLimit_ - ringStart_);
+    out.append(ring_.data(), ringStart_);
+    return out;
+  }
+
+} // namespace vix::commands::RunCommand::detail
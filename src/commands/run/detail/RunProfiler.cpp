@@ -0,0 +1,1061 @@
+/**
+ *
+ *  @file RunProfiler.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira. All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by an MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/run/detail/RunProfiler.hpp>
+#include <vix/cli/Style.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+#include <cxxabi.h>
+
+#ifdef __linux__
+#include <atomic>
+#include <thread>
+
+#include <elf.h>
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace vix::commands::RunCommand::detail
+{
+  using namespace vix::cli::style;
+
+  namespace
+  {
+    struct FlameNode
+    {
+      std::string name;
+      std::uint64_t value = 0;
+      std::vector<FlameNode> children;
+
+      FlameNode &child(const std::string &childName)
+      {
+        for (FlameNode &c : children)
+        {
+          if (c.name == childName)
+            return c;
+        }
+
+        children.push_back(FlameNode{childName, 0, {}});
+        return children.back();
+      }
+    };
+
+    std::vector<std::string> split_frames(const std::string &stack)
+    {
+      std::vector<std::string> frames;
+      std::size_t begin = 0;
+
+      while (begin <= stack.size())
+      {
+        const std::size_t end = stack.find(';', begin);
+        const std::size_t stop = end == std::string::npos ? stack.size() : end;
+
+        if (stop > begin)
+          frames.push_back(stack.substr(begin, stop - begin));
+
+        if (end == std::string::npos)
+          break;
+
+        begin = end + 1;
+      }
+
+      return frames;
+    }
+
+    int tree_depth(const FlameNode &node)
+    {
+      int depth = 0;
+      for (const FlameNode &c : node.children)
+        depth = std::max(depth, tree_depth(c));
+      return depth + 1;
+    }
+
+    std::string xml_escape(const std::string &text)
+    {
+      std::string out;
+      out.reserve(text.size());
+
+      for (const char c : text)
+      {
+        switch (c)
+        {
+        case '&':
+          out += "&amp;";
+          break;
+        case '<':
+          out += "&lt;";
+          break;
+        case '>':
+          out += "&gt;";
+          break;
+        case '"':
+          out += "&quot;";
+          break;
+        default:
+          out += c;
+        }
+      }
+
+      return out;
+    }
+
+    // flamegraph.pl "hot" palette, seeded by the name so colors are stable
+    // between runs.
+    std::string frame_color(const std::string &name)
+    {
+      std::uint32_t h = 2166136261u;
+      for (const char c : name)
+      {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+      }
+
+      const unsigned r = 205 + h % 50;
+      const unsigned g = (h >> 8) % 230;
+      const unsigned b = (h >> 16) % 55;
+
+      char buf[32];
+      std::snprintf(buf, sizeof(buf), "rgb(%u,%u,%u)", r, g, b);
+      return buf;
+    }
+
+    struct SvgLayout
+    {
+      double width = 1200.0;
+      double pad = 10.0;
+      double frameHeight = 16.0;
+      double height = 0.0;
+      double total = 0.0;
+    };
+
+    void render_node(
+        std::ostringstream &out,
+        const FlameNode &node,
+        const SvgLayout &layout,
+        int depth,
+        double offset)
+    {
+      const double scale = (layout.width - 2.0 * layout.pad) / layout.total;
+      const double w = static_cast<double>(node.value) * scale;
+      if (w < 0.1)
+        return;
+
+      const double x = layout.pad + offset * scale;
+      const double y = layout.height - layout.pad - (depth + 1) * layout.frameHeight;
+
+      char pct[32];
+      std::snprintf(pct, sizeof(pct), "%.2f%%", 100.0 * static_cast<double>(node.value) / layout.total);
+
+      const std::string name = xml_escape(node.name);
+
+      out << "<g><title>" << name << " (" << node.value << " samples, " << pct << ")</title>";
+      out << "<rect x=\"" << x << "\" y=\"" << y << "\" width=\"" << w
+          << "\" height=\"" << (layout.frameHeight - 1.0) << "\" rx=\"2\" fill=\""
+          << frame_color(node.name) << "\"/>";
+
+      // About 7px per character at 12px monospace.
+      const std::size_t fit = w > 6.0 ? static_cast<std::size_t>((w - 6.0) / 7.0) : 0;
+      if (fit >= 3)
+      {
+        std::string label = node.name;
+        if (label.size() > fit)
+          label = label.substr(0, fit - 2) + "..";
+
+        out << "<text x=\"" << (x + 3.0) << "\" y=\"" << (y + layout.frameHeight - 4.5) << "\">"
+            << xml_escape(label) << "</text>";
+      }
+
+      out << "</g>\n";
+
+      double childOffset = offset;
+      for (const FlameNode &c : node.children)
+      {
+        render_node(out, c, layout, depth + 1, childOffset);
+        childOffset += static_cast<double>(c.value);
+      }
+    }
+
+    bool parse_hex(const std::string &text, std::uint64_t &out)
+    {
+      if (text.empty())
+        return false;
+
+      out = 0;
+      for (const char c : text)
+      {
+        int digit = 0;
+        if (c >= '0' && c <= '9')
+          digit = c - '0';
+        else if (c >= 'a' && c <= 'f')
+          digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+          digit = c - 'A' + 10;
+        else
+          return false;
+
+        out = (out << 4) | static_cast<std::uint64_t>(digit);
+      }
+
+      return true;
+    }
+
+    std::string demangle(const std::string &name)
+    {
+      int status = 0;
+      char *out = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+      if (status != 0 || !out)
+        return name;
+
+      std::string result(out);
+      std::free(out);
+      return result;
+    }
+
+    // ';' separates frames in the collapsed format.
+    std::string frame_name(std::string name)
+    {
+      std::replace(name.begin(), name.end(), ';', ':');
+      std::replace(name.begin(), name.end(), '\n', ' ');
+      return name;
+    }
+
+    std::string timestamp_now()
+    {
+      const std::time_t now = std::time(nullptr);
+      std::tm tm{};
+#ifdef _WIN32
+      localtime_s(&tm, &now);
+#else
+      localtime_r(&now, &tm);
+#endif
+      char buf[32];
+      std::strftime(buf, sizeof(buf), "%Y%m%d-%H%M%S", &tm);
+      return buf;
+    }
+
+    bool write_file(const fs::path &path, const std::string &text)
+    {
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      out << text;
+      return static_cast<bool>(out);
+    }
+  } // namespace
+
+  std::vector<std::string> profile_compile_flags()
+  {
+    std::vector<std::string> flags{"-g", "-fno-omit-frame-pointer"};
+
+#if defined(__x86_64__) || defined(__aarch64__)
+    // Otherwise the caller of a sampled leaf function drops off the stack.
+    flags.push_back("-mno-omit-leaf-frame-pointer");
+#endif
+
+    return flags;
+  }
+
+  std::string render_folded_stacks(const FoldedStacks &stacks)
+  {
+    std::string out;
+    for (const auto &[stack, count] : stacks)
+    {
+      out += stack;
+      out += ' ';
+      out += std::to_string(count);
+      out += '\n';
+    }
+
+    return out;
+  }
+
+  std::string render_flamegraph_svg(const FoldedStacks &stacks, const std::string &title)
+  {
+    FlameNode root{"all", 0, {}};
+
+    for (const auto &[stack, count] : stacks)
+    {
+      root.value += count;
+
+      FlameNode *node = &root;
+      for (const std::string &frame : split_frames(stack))
+      {
+        node = &node->child(frame);
+        node->value += count;
+      }
+    }
+
+    SvgLayout layout;
+    layout.total = static_cast<double>(std::max<std::uint64_t>(root.value, 1));
+
+    const double titleHeight = 32.0;
+    layout.height = titleHeight + tree_depth(root) * layout.frameHeight + 2.0 * layout.pad;
+
+    std::ostringstream out;
+    out << "<?xml version=\"1.0\" standalone=\"no\"?>\n";
+    out << "<svg version=\"1.1\" xmlns=\"http://www.w3.org/2000/svg\" width=\"" << layout.width
+        << "\" height=\"" << layout.height << "\" viewBox=\"0 0 " << layout.width << " "
+        << layout.height << "\">\n";
+    out << "<style>text{font-family:monospace;font-size:12px;fill:#000}"
+           "g:hover rect{stroke:#000;stroke-width:0.5}</style>\n";
+    out << "<rect width=\"100%\" height=\"100%\" fill=\"#f8f8f8\"/>\n";
+    out << "<text x=\"" << layout.width / 2.0 << "\" y=\"22\" text-anchor=\"middle\" "
+           "style=\"font-size:16px\">"
+        << xml_escape(title) << "</text>\n";
+
+    if (root.value > 0)
+      render_node(out, root, layout, 0, 0.0);
+
+    out << "</svg>\n";
+    return out.str();
+  }
+
+  std::vector<ProcMapping> parse_proc_maps(const std::string &text)
+  {
+    std::vector<ProcMapping> out;
+    std::istringstream in(text);
+    std::string line;
+
+    // 55d0c7a00000-55d0c7a21000 r-xp 00002000 08:02 1311 /usr/bin/app
+    while (std::getline(in, line))
+    {
+      std::istringstream fields(line);
+      std::string range;
+      std::string perms;
+      std::string offset;
+      std::string dev;
+      std::string inode;
+
+      if (!(fields >> range >> perms >> offset >> dev >> inode))
+        continue;
+
+      if (perms.size() < 3 || perms[2] != 'x')
+        continue;
+
+      std::string path;
+      std::getline(fields, path);
+      path.erase(0, path.find_first_not_of(' '));
+
+      if (path.empty() || path[0] != '/')
+        continue;
+
+      const std::size_t dash = range.find('-');
+      if (dash == std::string::npos)
+        continue;
+
+      ProcMapping m;
+      if (!parse_hex(range.substr(0, dash), m.start) ||
+          !parse_hex(range.substr(dash + 1), m.end) ||
+          !parse_hex(offset, m.offset))
+      {
+        continue;
+      }
+
+      m.path = std::move(path);
+      out.push_back(std::move(m));
+    }
+
+    return out;
+  }
+
+  bool ElfSymbolTable::load(const fs::path &path)
+  {
+    segments_.clear();
+    symbols_.clear();
+
+#ifdef __linux__
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+      return false;
+
+    auto read_at = [&](std::uint64_t offset, void *dst, std::size_t size) -> bool
+    {
+      in.clear();
+      in.seekg(static_cast<std::streamoff>(offset));
+      in.read(static_cast<char *>(dst), static_cast<std::streamsize>(size));
+      return static_cast<std::size_t>(in.gcount()) == size;
+    };
+
+    Elf64_Ehdr eh{};
+    if (!read_at(0, &eh, sizeof(eh)) ||
+        std::memcmp(eh.e_ident, ELFMAG, SELFMAG) != 0 ||
+        eh.e_ident[EI_CLASS] != ELFCLASS64 ||
+        eh.e_ident[EI_DATA] != ELFDATA2LSB)
+    {
+      return false;
+    }
+
+    for (std::uint16_t i = 0; i < eh.e_phnum; ++i)
+    {
+      Elf64_Phdr ph{};
+      if (!read_at(eh.e_phoff + static_cast<std::uint64_t>(i) * eh.e_phentsize, &ph, sizeof(ph)))
+        return false;
+
+      if (ph.p_type == PT_LOAD && (ph.p_flags & PF_X))
+        segments_.push_back(Segment{ph.p_offset, ph.p_vaddr, ph.p_filesz});
+    }
+
+    std::vector<Elf64_Shdr> sections(eh.e_shnum);
+    for (std::uint16_t i = 0; i < eh.e_shnum; ++i)
+    {
+      if (!read_at(eh.e_shoff + static_cast<std::uint64_t>(i) * eh.e_shentsize, &sections[i], sizeof(Elf64_Shdr)))
+        return false;
+    }
+
+    // .symtab when the image was not stripped, .dynsym always.
+    for (const Elf64_Shdr &sh : sections)
+    {
+      if (sh.sh_type != SHT_SYMTAB && sh.sh_type != SHT_DYNSYM)
+        continue;
+
+      if (sh.sh_link >= sections.size() || sh.sh_entsize != sizeof(Elf64_Sym))
+        continue;
+
+      const Elf64_Shdr &strtab = sections[sh.sh_link];
+      std::string strings(strtab.sh_size, '\0');
+      if (!read_at(strtab.sh_offset, strings.data(), strings.size()))
+        continue;
+
+      std::vector<Elf64_Sym> syms(sh.sh_size / sizeof(Elf64_Sym));
+      if (!read_at(sh.sh_offset, syms.data(), syms.size() * sizeof(Elf64_Sym)))
+        continue;
+
+      for (const Elf64_Sym &sym : syms)
+      {
+        const unsigned type = ELF64_ST_TYPE(sym.st_info);
+        if ((type != STT_FUNC && type != STT_GNU_IFUNC) ||
+            sym.st_shndx == SHN_UNDEF || sym.st_value == 0 ||
+            sym.st_name >= strings.size())
+        {
+          continue;
+        }
+
+        symbols_.push_back(Symbol{sym.st_value, sym.st_size, std::string(strings.c_str() + sym.st_name)});
+      }
+    }
+
+    std::sort(
+        symbols_.begin(),
+        symbols_.end(),
+        [](const Symbol &a, const Symbol &b)
+        {
+          if (a.addr != b.addr)
+            return a.addr < b.addr;
+          return a.size > b.size;
+        });
+
+    symbols_.erase(
+        std::unique(
+            symbols_.begin(),
+            symbols_.end(),
+            [](const Symbol &a, const Symbol &b)
+            { return a.addr == b.addr; }),
+        symbols_.end());
+
+    return !segments_.empty();
+#else
+    (void)path;
+    return false;
+#endif
+  }
+
+  std::optional<std::string> ElfSymbolTable::lookup(std::uint64_t fileOffset) const
+  {
+    std::optional<std::uint64_t> vaddr;
+    for (const Segment &s : segments_)
+    {
+      if (fileOffset >= s.offset && fileOffset < s.offset + s.size)
+      {
+        vaddr = fileOffset - s.offset + s.vaddr;
+        break;
+      }
+    }
+
+    if (!vaddr)
+      return std::nullopt;
+
+    auto it = std::upper_bound(
+        symbols_.begin(),
+        symbols_.end(),
+        *vaddr,
+        [](std::uint64_t addr, const Symbol &sym)
+        { return addr < sym.addr; });
+
+    if (it == symbols_.begin())
+      return std::nullopt;
+
+    --it;
+    if (it->size != 0 && *vaddr >= it->addr + it->size)
+      return std::nullopt;
+
+    return demangle(it->name);
+  }
+
+  fs::path profiles_dir(const fs::path &baseDir)
+  {
+    return baseDir / ".vix" / "profiles";
+  }
+
+  // ---------------------------------------------------------------------------
+  // Sampling session
+  // ---------------------------------------------------------------------------
+
+  struct RunProfiler::Session
+  {
+    // Frames are (module + 1) << 48 | file offset; module 0 keeps the raw
+    // address of code outside any known mapping.
+    static constexpr int MODULE_SHIFT = 48;
+    static constexpr std::uint64_t OFFSET_MASK = (std::uint64_t{1} << MODULE_SHIFT) - 1;
+
+    struct Mapping
+    {
+      std::uint64_t end = 0;
+      std::uint64_t offset = 0;
+      std::uint32_t module = 0;
+    };
+
+    std::vector<std::string> modules;
+    std::unordered_map<std::string, std::uint32_t> moduleIndex;
+    std::unordered_map<std::uint32_t, std::map<std::uint64_t, Mapping>> maps;
+
+    std::map<std::vector<std::uint64_t>, std::uint64_t> stacks; // leaf first
+    std::uint64_t samples = 0;
+    std::uint64_t lost = 0;
+
+    std::uint32_t module_id(const std::string &path)
+    {
+      auto it = moduleIndex.find(path);
+      if (it != moduleIndex.end())
+        return it->second;
+
+      const auto id = static_cast<std::uint32_t>(modules.size());
+      modules.push_back(path);
+      moduleIndex.emplace(path, id);
+      return id;
+    }
+
+    void add_mapping(std::uint32_t pid, std::uint64_t start, std::uint64_t end, std::uint64_t offset, const std::string &path)
+    {
+      auto &m = maps[pid];
+
+      // A new mapping replaces whatever it overlaps.
+      auto it = m.lower_bound(start);
+      if (it != m.begin())
+      {
+        auto prev = std::prev(it);
+        if (prev->second.end > start)
+          it = prev;
+      }
+
+      while (it != m.end() && it->first < end)
+        it = m.erase(it);
+
+      m.emplace(start, Mapping{end, offset, module_id(path)});
+    }
+
+    std::uint64_t resolve(std::uint32_t pid, std::uint64_t ip) const
+    {
+      const auto pm = maps.find(pid);
+      if (pm == maps.end())
+        return ip & OFFSET_MASK;
+
+      auto it = pm->second.upper_bound(ip);
+      if (it == pm->second.begin())
+        return ip & OFFSET_MASK;
+
+      --it;
+      if (ip >= it->second.end)
+        return ip & OFFSET_MASK;
+
+      const std::uint64_t offset = ip - it->first + it->second.offset;
+      return (static_cast<std::uint64_t>(it->second.module + 1) << MODULE_SHIFT) | (offset & OFFSET_MASK);
+    }
+
+#ifdef __linux__
+    struct Buffer
+    {
+      int fd = -1;
+      void *base = nullptr;
+      std::size_t length = 0;
+    };
+
+    std::vector<Buffer> buffers;
+    std::size_t pageSize = 0;
+    std::size_t dataSize = 0;
+    std::thread reader;
+    std::atomic<bool> stop{false};
+    std::vector<char> record;
+
+    void handle(const perf_event_header &header, const char *body)
+    {
+      auto u32_at = [&](std::size_t off)
+      {
+        std::uint32_t v = 0;
+        std::memcpy(&v, body + off, sizeof(v));
+        return v;
+      };
+
+      auto u64_at = [&](std::size_t off)
+      {
+        std::uint64_t v = 0;
+        std::memcpy(&v, body + off, sizeof(v));
+        return v;
+      };
+
+      const std::size_t size = header.size - sizeof(perf_event_header);
+
+      switch (header.type)
+      {
+      case PERF_RECORD_SAMPLE:
+      {
+        // PERF_SAMPLE_TID | PERF_SAMPLE_CALLCHAIN: pid, tid, nr, ips[nr]
+        if (size < 16)
+          return;
+
+        const std::uint32_t pid = u32_at(0);
+        const std::uint64_t nr = std::min<std::uint64_t>(u64_at(8), (size - 16) / 8);
+
+        std::vector<std::uint64_t> frames;
+        frames.reserve(nr);
+        for (std::uint64_t i = 0; i < nr; ++i)
+        {
+          const std::uint64_t ip = u64_at(16 + i * 8);
+          if (ip >= static_cast<std::uint64_t>(PERF_CONTEXT_MAX))
+            continue;
+
+          frames.push_back(resolve(pid, ip));
+        }
+
+        if (!frames.empty())
+        {
+          ++stacks[frames];
+          ++samples;
+        }
+        return;
+      }
+
+      case PERF_RECORD_MMAP:
+      {
+        // pid, tid, addr, len, pgoff, filename
+        if (size < 32)
+          return;
+
+        const std::string path(body + 32, strnlen(body + 32, size - 32));
+        if (!path.empty() && path[0] == '/')
+          add_mapping(u32_at(0), u64_at(8), u64_at(8) + u64_at(16), u64_at(24), path);
+        return;
+      }
+
+      case PERF_RECORD_COMM:
+        // exec() replaces the whole address space.
+        if (size >= 8 && (header.misc & PERF_RECORD_MISC_COMM_EXEC))
+          maps.erase(u32_at(0));
+        return;
+
+      case PERF_RECORD_FORK:
+      {
+        // pid, ppid, tid, ptid: threads share their process' mappings.
+        if (size < 16)
+          return;
+
+        const std::uint32_t pid = u32_at(0);
+        const std::uint32_t ppid = u32_at(4);
+        if (pid != ppid)
+        {
+          const auto parent = maps.find(ppid);
+          if (parent != maps.end())
+            maps[pid] = parent->second;
+        }
+        return;
+      }
+
+      case PERF_RECORD_LOST:
+        if (size >= 16)
+          lost += u64_at(8);
+        return;
+
+      default:
+        return;
+      }
+    }
+
+    void drain(Buffer &b)
+    {
+      auto *meta = static_cast<perf_event_mmap_page *>(b.base);
+      const char *data = static_cast<const char *>(b.base) + pageSize;
+
+      const std::uint64_t head = __atomic_load_n(&meta->data_head, __ATOMIC_ACQUIRE);
+      std::uint64_t tail = meta->data_tail;
+
+      auto copy_out = [&](std::uint64_t pos, char *dst, std::size_t n)
+      {
+        const std::size_t start = static_cast<std::size_t>(pos % dataSize);
+        const std::size_t first = std::min(n, dataSize - start);
+        std::memcpy(dst, data + start, first);
+        std::memcpy(dst + first, data, n - first);
+      };
+
+      while (tail + sizeof(perf_event_header) <= head)
+      {
+        perf_event_header header{};
+        copy_out(tail, reinterpret_cast<char *>(&header), sizeof(header));
+
+        if (header.size < sizeof(header) || tail + header.size > head)
+          break;
+
+        record.resize(header.size);
+        copy_out(tail, record.data(), header.size);
+        handle(header, record.data() + sizeof(header));
+
+        tail += header.size;
+      }
+
+      __atomic_store_n(&meta->data_tail, tail, __ATOMIC_RELEASE);
+    }
+
+    void drain_all()
+    {
+      for (Buffer &b : buffers)
+        drain(b);
+    }
+
+    void close_all()
+    {
+      for (Buffer &b : buffers)
+      {
+        if (b.base)
+          ::munmap(b.base, b.length);
+        if (b.fd >= 0)
+          ::close(b.fd);
+      }
+
+      buffers.clear();
+    }
+#endif
+  };
+
+  RunProfiler &RunProfiler::instance()
+  {
+    static RunProfiler profiler;
+    return profiler;
+  }
+
+  RunProfiler::RunProfiler() = default;
+
+  RunProfiler::~RunProfiler()
+  {
+    detach();
+  }
+
+  void RunProfiler::enable(int hz)
+  {
+    hz_ = std::clamp(hz, 1, MAX_PROFILE_HZ);
+  }
+
+  std::uint64_t RunProfiler::samples() const noexcept
+  {
+    return session_ ? session_->samples : 0;
+  }
+
+  std::uint64_t RunProfiler::lost() const noexcept
+  {
+    return session_ ? session_->lost : 0;
+  }
+
+  bool RunProfiler::attach(int pid)
+  {
+    error_.clear();
+    session_ = std::make_unique<Session>();
+
+#ifdef __linux__
+    Session &s = *session_;
+
+    // Mappings that exist before the first MMAP record arrives.
+    {
+      std::ifstream in("/proc/" + std::to_string(pid) + "/maps");
+      std::stringstream text;
+      text << in.rdbuf();
+
+      for (const ProcMapping &m : parse_proc_maps(text.str()))
+        s.add_mapping(static_cast<std::uint32_t>(pid), m.start, m.end, m.offset, m.path);
+    }
+
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_SOFTWARE;
+    attr.config = PERF_COUNT_SW_CPU_CLOCK;
+    attr.freq = 1;
+    attr.sample_freq = static_cast<std::uint64_t>(hz_);
+    attr.sample_type = PERF_SAMPLE_TID | PERF_SAMPLE_CALLCHAIN;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.exclude_callchain_kernel = 1;
+    attr.mmap = 1;
+    attr.comm = 1;
+    attr.comm_exec = 1;
+    attr.task = 1;
+
+    s.pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    s.dataSize = 64 * s.pageSize;
+
+    attr.watermark = 1;
+    attr.wakeup_watermark = static_cast<std::uint32_t>(s.dataSize / 4);
+
+    // Inherited events cannot be mapped per task, so open one per CPU.
+    const long cpus = ::sysconf(_SC_NPROCESSORS_CONF);
+    int lastErrno = 0;
+
+    for (long cpu = 0; cpu < std::max(cpus, 1L); ++cpu)
+    {
+      const int fd = static_cast<int>(::syscall(
+          __NR_perf_event_open, &attr, pid, static_cast<int>(cpu), -1, PERF_FLAG_FD_CLOEXEC));
+
+      if (fd < 0)
+      {
+        // Offline CPUs report ENODEV; anything else is a real refusal.
+        if (errno != ENODEV)
+          lastErrno = errno;
+        continue;
+      }
+
+      Session::Buffer b;
+      b.fd = fd;
+      b.length = s.pageSize + s.dataSize;
+      b.base = ::mmap(nullptr, b.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+      if (b.base == MAP_FAILED)
+      {
+        lastErrno = errno;
+        ::close(fd);
+        continue;
+      }
+
+      s.buffers.push_back(b);
+    }
+
+    if (s.buffers.empty())
+    {
+      error_ = "perf_event_open failed: " + std::string(std::strerror(lastErrno ? lastErrno : ENODEV));
+      if (lastErrno == EACCES || lastErrno == EPERM)
+        error_ += " (allow it with: sudo sysctl kernel.perf_event_paranoid=1)";
+      return false;
+    }
+
+    for (const Session::Buffer &b : s.buffers)
+      ::ioctl(b.fd, PERF_EVENT_IOC_ENABLE, 0);
+
+    s.reader = std::thread(
+        [&s]()
+        {
+          std::vector<pollfd> fds;
+          for (const Session::Buffer &b : s.buffers)
+            fds.push_back(pollfd{b.fd, POLLIN, 0});
+
+          while (!s.stop.load(std::memory_order_relaxed))
+          {
+            ::poll(fds.data(), fds.size(), 100);
+            s.drain_all();
+          }
+        });
+
+    return true;
+#else
+    (void)pid;
+    error_ = "profiling is only supported on Linux";
+    return false;
+#endif
+  }
+
+  void RunProfiler::detach()
+  {
+#ifdef __linux__
+    if (!session_ || !session_->reader.joinable())
+      return;
+
+    Session &s = *session_;
+
+    for (const Session::Buffer &b : s.buffers)
+      ::ioctl(b.fd, PERF_EVENT_IOC_DISABLE, 0);
+
+    s.stop.store(true, std::memory_order_relaxed);
+    s.reader.join();
+
+    s.drain_all();
+    s.close_all();
+#endif
+  }
+
+  FoldedStacks RunProfiler::folded() const
+  {
+    FoldedStacks out;
+    if (!session_)
+      return out;
+
+    const Session &s = *session_;
+
+    std::vector<std::optional<ElfSymbolTable>> tables(s.modules.size());
+    std::unordered_map<std::uint64_t, std::string> names;
+
+    auto module_name = [&](std::uint32_t module)
+    {
+      return fs::path(s.modules[module]).filename().string();
+    };
+
+    auto symbolize = [&](std::uint64_t frame) -> std::string
+    {
+      auto cached = names.find(frame);
+      if (cached != names.end())
+        return cached->second;
+
+      const std::uint64_t module = frame >> Session::MODULE_SHIFT;
+      const std::uint64_t offset = frame & Session::OFFSET_MASK;
+
+      std::string name;
+      char hex[32];
+      std::snprintf(hex, sizeof(hex), "0x%llx", static_cast<unsigned long long>(offset));
+
+      if (module == 0 || module > s.modules.size())
+      {
+        name = std::string("[unknown ") + hex + "]";
+      }
+      else
+      {
+        const auto index = static_cast<std::uint32_t>(module - 1);
+        if (!tables[index])
+        {
+          tables[index].emplace();
+          tables[index]->load(s.modules[index]);
+        }
+
+        const auto sym = tables[index]->lookup(offset);
+        name = sym ? frame_name(*sym) : "[" + module_name(index) + "+" + hex + "]";
+      }
+
+      names.emplace(frame, name);
+      return name;
+    };
+
+    for (const auto &[frames, count] : s.stacks)
+    {
+      std::string stack;
+
+      // Leaf first; callers' frames hold return addresses, which point just
+      // past the call instruction.
+      for (std::size_t i = frames.size(); i-- > 0;)
+      {
+        std::uint64_t frame = frames[i];
+        if (i > 0 && (frame & Session::OFFSET_MASK) > 0)
+          frame -= 1;
+
+        if (!stack.empty())
+          stack += ';';
+        stack += symbolize(frame);
+      }
+
+      out[stack] += count;
+    }
+
+    return out;
+  }
+
+  // ---------------------------------------------------------------------------
+  // ProfileScope
+  // ---------------------------------------------------------------------------
+
+  ProfileScope::ProfileScope(std::string label)
+      : label_(std::move(label))
+  {
+    RunProfiler &profiler = RunProfiler::instance();
+    if (!profiler.enabled())
+      return;
+
+    active_ = true;
+    profiler.armed_ = true;
+    profiler.error_.clear();
+    profiler.session_.reset();
+  }
+
+  ProfileScope::~ProfileScope()
+  {
+    finish();
+  }
+
+  void ProfileScope::finish()
+  {
+    if (!active_)
+      return;
+
+    active_ = false;
+
+    RunProfiler &profiler = RunProfiler::instance();
+    profiler.armed_ = false;
+    profiler.detach();
+
+    if (!profiler.last_error().empty())
+    {
+      hint("Profiling unavailable: " + profiler.last_error());
+      return;
+    }
+
+    if (profiler.samples() == 0)
+    {
+      hint("Profiling collected no samples; the program may have exited too quickly.");
+      return;
+    }
+
+    const fs::path dir = profiles_dir(fs::current_path());
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+
+    const std::string stem = (label_.empty() ? std::string("run") : label_) + "-" + timestamp_now();
+    const fs::path foldedPath = dir / (stem + ".folded");
+    const fs::path svgPath = dir / (stem + ".svg");
+
+    const FoldedStacks stacks = profiler.folded();
+
+    std::string title = label_ + " (" + std::to_string(profiler.samples()) + " samples at " +
+                        std::to_string(profiler.hz()) + " Hz)";
+
+    if (!write_file(foldedPath, render_folded_stacks(stacks)) ||
+        !write_file(svgPath, render_flamegraph_svg(stacks, title)))
+    {
+      hint("Unable to write the profile to " + dir.string());
+      return;
+    }
+
+    info("Profile: " + std::to_string(profiler.samples()) + " samples at " +
+         std::to_string(profiler.hz()) + " Hz");
+    step(svgPath.string());
+    step(foldedPath.string());
+
+    if (profiler.lost() > 0)
+      hint(std::to_string(profiler.lost()) + " samples were lost; try a lower --profile rate.");
+  }
+
+} // namespace vix::commands::RunCommand::detail
@@ -0,0 +1,222 @@
+/**
+ *
+ *  @file RunTimings.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira. All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by an MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/run/detail/RunTimings.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <utility>
+
+namespace vix::commands::RunCommand::detail
+{
+  namespace
+  {
+    // Initialized with the other statics, before main() runs.
+    const RunTimings::Clock::time_point g_processOrigin = RunTimings::Clock::now();
+
+    double ms_since_origin(RunTimings::Clock::time_point t)
+    {
+      return std::chrono::duration<double, std::milli>(t - g_processOrigin).count();
+    }
+
+    std::vector<TimingStage> sorted_stages(const std::vector<TimingStage> &stages)
+    {
+      // Scopes record on exit, so inner stages arrive before their parents.
+      std::vector<TimingStage> out = stages;
+      std::stable_sort(
+          out.begin(),
+          out.end(),
+          [](const TimingStage &a, const TimingStage &b)
+          {
+            if (a.startMs != b.startMs)
+              return a.startMs < b.startMs;
+            return a.depth < b.depth;
+          });
+      return out;
+    }
+
+    std::string format_ms(double ms)
+    {
+      char buf[32];
+      std::snprintf(buf, sizeof(buf), "%9.2f ms", ms);
+      return buf;
+    }
+
+    double round_us(double ms)
+    {
+      return static_cast<double>(static_cast<long long>(ms * 1000.0 + 0.5)) / 1000.0;
+    }
+  } // namespace
+
+  bool parse_timings_format(const std::string &value, TimingsFormat &out)
+  {
+    if (value == "text")
+    {
+      out = TimingsFormat::Text;
+      return true;
+    }
+
+    if (value == "json")
+    {
+      out = TimingsFormat::Json;
+      return true;
+    }
+
+    return false;
+  }
+
+  RunTimings &RunTimings::instance()
+  {
+    static RunTimings timings;
+    return timings;
+  }
+
+  RunTimings::Clock::time_point RunTimings::origin() noexcept
+  {
+    return g_processOrigin;
+  }
+
+  void RunTimings::enable(TimingsFormat format, std::string target)
+  {
+    format_ = format;
+    target_ = std::move(target);
+  }
+
+  void RunTimings::record(const std::string &name, Clock::time_point start, Clock::time_point end)
+  {
+    if (!enabled())
+      return;
+
+    TimingStage stage;
+    stage.name = name;
+    stage.startMs = ms_since_origin(start);
+    stage.durationMs = std::chrono::duration<double, std::milli>(end - start).count();
+    stage.depth = depth_;
+    stages_.push_back(std::move(stage));
+  }
+
+  double RunTimings::time_to_exec_ms() const noexcept
+  {
+    double best = -1.0;
+    for (const TimingStage &stage : stages_)
+    {
+      if (stage.name == "exec" && (best < 0.0 || stage.startMs < best))
+        best = stage.startMs;
+    }
+    return best;
+  }
+
+  std::string RunTimings::render_text(double totalMs) const
+  {
+    std::ostringstream out;
+    out << "vix run timings";
+    if (!target_.empty())
+      out << ": " << target_;
+    out << "\n";
+
+    out << "  " << std::string("stage").append(21, ' ') << "       start    duration\n";
+    for (const TimingStage &stage : sorted_stages(stages_))
+    {
+      std::string label(static_cast<std::size_t>(stage.depth) * 2, ' ');
+      label += stage.name;
+      if (label.size() < 26)
+        label.resize(26, ' ');
+
+      out << "  " << label << format_ms(stage.startMs) << format_ms(stage.durationMs) << "\n";
+    }
+
+    const double toExec = time_to_exec_ms();
+    if (toExec >= 0.0)
+      out << "  time to exec              " << format_ms(toExec) << "\n";
+    out << "  total                     " << format_ms(totalMs) << "\n";
+
+    return out.str();
+  }
+
+  std::string RunTimings::render_json(double totalMs, int exitCode) const
+  {
+    nlohmann::json stages = nlohmann::json::array();
+    for (const TimingStage &stage : sorted_stages(stages_))
+    {
+      stages.push_back({
+          {"name", stage.name},
+          {"start_ms", round_us(stage.startMs)},
+          {"duration_ms", round_us(stage.durationMs)},
+          {"depth", stage.depth},
+      });
+    }
+
+    const double toExec = time_to_exec_ms();
+
+    nlohmann::json doc = {
+        {"vix_run_timings", 1},
+        {"clock", "steady"},
+        {"origin", "process_start"},
+        {"target", target_},
+        {"exit_code", exitCode},
+        {"time_to_exec_ms", toExec >= 0.0 ? nlohmann::json(round_us(toExec)) : nlohmann::json(nullptr)},
+        {"total_ms", round_us(totalMs)},
+        {"stages", stages},
+    };
+
+    return doc.dump();
+  }
+
+  void RunTimings::report(std::ostream &out, int exitCode) const
+  {
+    if (!enabled())
+      return;
+
+    const double totalMs = ms_since_origin(Clock::now());
+
+    if (format_ == TimingsFormat::Json)
+      out << render_json(totalMs, exitCode) << "\n";
+    else
+      out << render_text(totalMs);
+
+    out.flush();
+  }
+
+  TimingScope::TimingScope(const char *name)
+      : name_(name)
+  {
+    RunTimings &timings = RunTimings::instance();
+    if (!timings.enabled())
+      return;
+
+    active_ = true;
+    start_ = RunTimings::Clock::now();
+    ++timings.depth_;
+  }
+
+  TimingScope::~TimingScope()
+  {
+    stop();
+  }
+
+  void TimingScope::stop()
+  {
+    if (!active_)
+      return;
+
+    active_ = false;
+
+    RunTimings &timings = RunTimings::instance();
+    --timings.depth_;
+    timings.record(name_, start_, RunTimings::Clock::now());
+  }
+
+} // namespace vix::commands::RunCommand::detail
@@ -12,6 +12,7 @@
  *
  */
 #include <vix/cli/commands/run/detail/ScriptCMake.hpp>
+#include <vix/cli/commands/run/detail/ScriptDepArtifacts.hpp>
 #include <vix/cli/commands/run/detail/ScriptProbe.hpp>
 #include <vix/utils/Env.hpp>
 
@@ -422,6 +423,55 @@ namespace vix::commands::RunCommand::detail
       return ordered;
     }
 
+    std::unordered_map<std::string, std::string> load_locked_commits_by_dir(const fs::path &lockPath)
+    {
+      std::unordered_map<std::string, std::string> commits;
+
+      if (!fs::exists(lockPath))
+        return commits;
+
+      std::ifstream ifs(lockPath);
+      if (!ifs)
+        return commits;
+
+      nlohmann::json j;
+      try
+      {
+        ifs >> j;
+      }
+      catch (...)
+      {
+        return commits;
+      }
+
+      const nlohmann::json *entries = nullptr;
+      if (j.is_array())
+        entries = &j;
+      else if (j.is_object() && j.contains("packages") && j["packages"].is_array())
+        entries = &j["packages"];
+      else if (j.is_object() && j.contains("dependencies") && j["dependencies"].is_array())
+        entries = &j["dependencies"];
+
+      if (!entries)
+        return commits;
+
+      for (const auto &dep : *entries)
+      {
+        if (!dep.is_object())
+          continue;
+
+        if (!dep.contains("id") || !dep["id"].is_string())
+          continue;
+
+        if (!dep.contains("commit") || !dep["commit"].is_string())
+          continue;
+
+        commits[dep_id_to_dir(dep["id"].get<std::string>())] = dep["commit"].get<std::string>();
+      }
+
+      return commits;
+    }
+
     std::vector<std::string> lock_package_ids_to_aliases(
         const std::vector<std::string> &packageIds)
     {
@@ -902,6 +952,27 @@ namespace vix::commands::RunCommand::detail
       append_line(s, "  endforeach()");
       append_line(s, "endfunction()");
       append_line(s);
+
+      append_line(s, "function(_vix_import_prebuilt_dep dep_ns dep_name prefix)");
+      append_line(s, "  set(_VIX_CANONICAL \"${dep_ns}::${dep_name}\")");
+      append_line(s, "  if(TARGET ${_VIX_CANONICAL})");
+      append_line(s, "    return()");
+      append_line(s, "  endif()");
+      append_line(s, "  file(GLOB _VIX_PREBUILT_LIBS");
+      append_line(s, "    \"${prefix}/lib/*${CMAKE_STATIC_LIBRARY_SUFFIX}\"");
+      append_line(s, "    \"${prefix}/lib64/*${CMAKE_STATIC_LIBRARY_SUFFIX}\"");
+      append_line(s, "    \"${prefix}/lib/*${CMAKE_SHARED_LIBRARY_SUFFIX}\"");
+      append_line(s, "    \"${prefix}/lib64/*${CMAKE_SHARED_LIBRARY_SUFFIX}\"");
+      append_line(s, "  )");
+      append_line(s, "  add_library(${_VIX_CANONICAL} INTERFACE IMPORTED GLOBAL)");
+      append_line(s, "  if(EXISTS \"${prefix}/include\")");
+      append_line(s, "    set_property(TARGET ${_VIX_CANONICAL} APPEND PROPERTY INTERFACE_INCLUDE_DIRECTORIES \"${prefix}/include\")");
+      append_line(s, "  endif()");
+      append_line(s, "  if(_VIX_PREBUILT_LIBS)");
+      append_line(s, "    set_property(TARGET ${_VIX_CANONICAL} APPEND PROPERTY INTERFACE_LINK_LIBRARIES ${_VIX_PREBUILT_LIBS})");
+      append_line(s, "  endif()");
+      append_line(s, "endfunction()");
+      append_line(s);
     }
 
     void append_global_cmake_defaults(std::string &s)
@@ -986,6 +1057,148 @@ namespace vix::commands::RunCommand::detail
       append_line(s);
     }
 
+    /**
+     * @brief Map a -std= value to CMAKE_CXX_STANDARD (c++2b -> 23).
+     */
+    std::string cxx_standard_of(const std::string &stdOpt)
+    {
+      const auto plus = stdOpt.find("++");
+      if (plus == std::string::npos)
+        return {};
+
+      const std::string version = stdOpt.substr(plus + 2);
+      if (version == "0x")
+        return "11";
+      if (version == "1y")
+        return "14";
+      if (version == "1z")
+        return "17";
+      if (version == "2a")
+        return "20";
+      if (version == "2b")
+        return "23";
+      if (version == "2c")
+        return "26";
+
+      return version;
+    }
+
+    /**
+     * @brief Describe one dependency build with the script's flags.
+     *
+     * The language standard, the defines and the code generation options
+     * are part of the artifact key, so a script built with -std=c++23 or
+     * -D_GLIBCXX_DEBUG never links a prefix built without them. Warnings and
+     * debug info options are left out.
+     */
+    ScriptDepArtifactRequest make_dep_artifact_request(
+        const std::string &pkgDir,
+        const fs::path &pkgPath,
+        const std::unordered_map<std::string, std::string> &lockedCommits,
+        const ScriptCompileFlags &cf)
+    {
+      ScriptDepArtifactRequest request;
+      request.pkgDir = pkgDir;
+      request.sourceDir = pkgPath;
+
+      if (const auto it = lockedCommits.find(pkgDir); it != lockedCommits.end())
+        request.commit = it->second;
+
+      // Same build type as the generated script project.
+      request.buildType = "Debug";
+
+      std::string cxxFlags;
+      auto addFlag = [&cxxFlags](const std::string &flag)
+      {
+        if (!cxxFlags.empty())
+          cxxFlags += " ";
+        cxxFlags += flag;
+      };
+
+      for (const auto &define : cf.defines)
+        addFlag("-D" + define);
+
+      for (const auto &opt : cf.compileOpts)
+      {
+        if (opt.rfind("-std=", 0) == 0)
+        {
+          if (const std::string standard = cxx_standard_of(opt); !standard.empty())
+            request.cxxStandard = standard;
+          continue;
+        }
+
+        if (opt.rfind("-W", 0) == 0 || opt.rfind("-g", 0) == 0)
+          continue;
+
+        addFlag(opt);
+      }
+
+      if (!cxxFlags.empty())
+        request.cmakeArgs.push_back("-DCMAKE_CXX_FLAGS=" + cxxFlags);
+
+      return request;
+    }
+
+    /**
+     * @brief Emit dependencies, preferring shared prebuilt prefixes.
+     *
+     * A dependency whose artifact is ready in the global cache is consumed via
+     * find_package (when it installs a package config) or an imported target.
+     * Anything else keeps the historical add_subdirectory path.
+     */
+    void append_dependencies_prefer_prebuilt(
+        std::string &s,
+        const fs::path &cppPath,
+        const std::vector<std::pair<std::string, fs::path>> &deps,
+        const ScriptCompileFlags &cf)
+    {
+      if (!script_dep_artifacts_enabled())
+      {
+        append_dependency_subdirectories(s, deps);
+        return;
+      }
+
+      const fs::path lockPath = find_script_project_root(cppPath) / "vix.lock";
+      const auto lockedCommits = load_locked_commits_by_dir(lockPath);
+
+      std::vector<std::pair<std::string, fs::path>> sourceDeps;
+
+      for (const auto &[pkgDir, pkgPath] : deps)
+      {
+        const ScriptDepArtifact artifact = describe_script_dep_artifact(
+            make_dep_artifact_request(pkgDir, pkgPath, lockedCommits, cf));
+
+        if (!artifact.ready)
+        {
+          sourceDeps.emplace_back(pkgDir, pkgPath);
+          continue;
+        }
+
+        const std::string depId = dep_dir_to_id(pkgDir);
+        const auto slash = depId.find('/');
+        const std::string depNs = (slash == std::string::npos) ? depId : depId.substr(0, slash);
+        const std::string depName = (slash == std::string::npos) ? depId : depId.substr(slash + 1);
+        const std::string prefix = cmake_quote(artifact.prefix.string());
+
+        append_line(s, "# Prebuilt dependency " + depId + " (shared artifact " + artifact.fingerprint + ")");
+        append_line(s, "list(PREPEND CMAKE_PREFIX_PATH " + prefix + ")");
+
+        for (const auto &configName : artifact.configPackages)
+        {
+          append_line(s, "find_package(" + configName + " CONFIG QUIET PATHS " + prefix +
+                             " NO_DEFAULT_PATH)");
+        }
+
+        append_line(s, "_vix_try_bridge_for_dep(" + depNs + " " + depName + ")");
+        append_line(s, "_vix_import_prebuilt_dep(" + depNs + " " + depName + " " + prefix + ")");
+      }
+
+      append_line(s);
+
+      if (!sourceDeps.empty())
+        append_dependency_subdirectories(s, sourceDeps);
+    }
+
     void append_target_include_directories(
         std::string &s,
         const std::string &targetName,
@@ -1279,6 +1492,41 @@ namespace vix::commands::RunCommand::detail
     return fs::temp_directory_path() / "vix" / "cache" / "scripts";
   }
 
+  std::vector<ScriptDepArtifactReport> prepare_script_dependency_artifacts(
+      const fs::path &cppPath,
+      const std::vector<std::string> &scriptFlags)
+  {
+    std::vector<ScriptDepArtifactReport> reports;
+
+    if (!script_dep_artifacts_enabled() || has_local_vix_deps_cmake(cppPath))
+      return reports;
+
+    ScriptCompileFlags cf = parse_compile_flags(scriptFlags);
+    const ResolvedScriptDeps deps = resolve_script_deps(cppPath, cf);
+
+    if (deps.uniqueCmakeDeps.empty())
+      return reports;
+
+    const fs::path lockPath = find_script_project_root(cppPath) / "vix.lock";
+    const auto lockedCommits = load_locked_commits_by_dir(lockPath);
+
+    for (const auto &[pkgDir, pkgPath] : deps.uniqueCmakeDeps)
+    {
+      ScriptDepArtifactReport report;
+      report.pkgDir = pkgDir;
+
+      ScriptDepArtifact artifact;
+      report.status = ensure_script_dep_artifact(
+          make_dep_artifact_request(pkgDir, pkgPath, lockedCommits, cf),
+          artifact,
+          report.error);
+
+      reports.push_back(std::move(report));
+    }
+
+    return reports;
+  }
+
   std::string make_script_cmakelists(
       const std::string &exeName,
       const fs::path &cppPath,
@@ -1319,7 +1567,7 @@ namespace vix::commands::RunCommand::detail
     }
     else
     {
-      append_dependency_subdirectories(s, deps.uniqueCmakeDeps);
+      append_dependencies_prefer_prebuilt(s, cppPath, deps.uniqueCmakeDeps, cf);
     }
 
     append_line(s, "add_executable(" + targetName + " " + cmake_quote(cppPath.string()) + ")");
@@ -0,0 +1,341 @@
+/**
+ *
+ *  @file ScriptDepArtifacts.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/run/detail/ScriptDepArtifacts.hpp>
+#include <vix/cli/cache/ArtifactCache.hpp>
+#include <vix/cli/cmake/DepArtifacts.hpp>
+#include <vix/cli/commands/helpers/ProcessHelpers.hpp>
+#include <vix/cli/util/Fs.hpp>
+#include <vix/cli/util/Hash.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace vix::commands::RunCommand::detail
+{
+  namespace artifact_cache = vix::cli::cache;
+  namespace build = vix::cli::build;
+  namespace process = vix::cli::commands::helpers;
+  namespace util = vix::cli::util;
+
+  namespace
+  {
+    constexpr std::uint64_t SCRIPT_DEP_FNV_OFFSET = 14695981039346656037ULL;
+    constexpr const char *SCRIPT_DEP_FORMAT = "1";
+    constexpr const char *CONSUME_FILE = "vix-script-dep.txt";
+    constexpr const char *FAILED_FILE = "vix-script-dep.failed";
+
+    /**
+     * @brief Read the checked-out commit of a git dependency without running git.
+     */
+    std::string read_git_head_commit(const fs::path &sourceDir)
+    {
+      const fs::path gitDir = sourceDir / ".git";
+      std::error_code ec;
+      if (!fs::is_directory(gitDir, ec) || ec)
+        return {};
+
+      std::ifstream headIn(gitDir / "HEAD");
+      std::string head;
+      if (!headIn || !std::getline(headIn, head))
+        return {};
+
+      const std::string refPrefix = "ref: ";
+      if (head.rfind(refPrefix, 0) != 0)
+        return head;
+
+      const std::string ref = head.substr(refPrefix.size());
+
+      std::ifstream refIn(gitDir / ref);
+      std::string commit;
+      if (refIn && std::getline(refIn, commit) && !commit.empty())
+        return commit;
+
+      std::ifstream packed(gitDir / "packed-refs");
+      std::string line;
+      while (packed && std::getline(packed, line))
+      {
+        if (line.empty() || line.front() == '#' || line.front() == '^')
+          continue;
+
+        const auto space = line.find(' ');
+        if (space != std::string::npos && line.substr(space + 1) == ref)
+          return line.substr(0, space);
+      }
+
+      return {};
+    }
+
+    artifact_cache::Artifact make_artifact(
+        const ScriptDepArtifactRequest &request,
+        const std::string &commit,
+        const std::string &compiler)
+    {
+      std::ostringstream oss;
+      oss << "format=" << SCRIPT_DEP_FORMAT << "\n";
+      oss << "package=" << request.pkgDir << "\n";
+      oss << "commit=" << commit << "\n";
+      oss << "compiler=" << compiler << "\n";
+      oss << "buildType=" << request.buildType << "\n";
+      oss << "cxxStandard=" << request.cxxStandard << "\n";
+      oss << "cmakeArgs:\n";
+      for (const auto &arg : request.cmakeArgs)
+        oss << arg << "\n";
+
+      artifact_cache::Artifact a;
+      a.package = build::cache_component(request.pkgDir);
+      a.version = build::cache_component(commit.substr(0, 12));
+      a.target = build::native_target_triple();
+      a.compiler = compiler;
+      a.buildType = build::cache_component(request.buildType);
+      a.fingerprint = util::hex64(util::fnv1a64_str(oss.str(), SCRIPT_DEP_FNV_OFFSET));
+
+      const fs::path root = artifact_cache::ArtifactCache::artifact_path(a);
+      a.root = root;
+      a.include = root / "include";
+      a.lib = root / "lib";
+
+      return a;
+    }
+
+    std::vector<std::string> read_consume_file(const fs::path &prefix)
+    {
+      std::vector<std::string> names;
+      std::istringstream in(util::read_text_file_or_empty(prefix / CONSUME_FILE));
+      std::string line;
+
+      const std::string key = "config=";
+      while (std::getline(in, line))
+      {
+        if (line.rfind(key, 0) == 0 && line.size() > key.size())
+          names.push_back(line.substr(key.size()));
+      }
+
+      return names;
+    }
+
+    int run_logged(const std::string &cmd, std::string &log)
+    {
+      int code = 0;
+      log += "$ " + cmd + "\n";
+      log += process::run_and_capture_with_code(cmd + " 2>&1", code);
+      return code;
+    }
+
+    /**
+     * @brief Ninja, like the generated script projects, when it is installed.
+     */
+    std::string artifact_generator_arg()
+    {
+      return util::executable_on_path("ninja") ? " -G Ninja" : "";
+    }
+
+    /**
+     * @brief True when configure failed for lack of a build tool, not because
+     * of the dependency: installing the tool fixes it, so it is not remembered.
+     */
+    bool missing_build_tool(const std::string &log)
+    {
+      return log.find("unable to find a build program") != std::string::npos ||
+             log.find("Could not create named generator") != std::string::npos ||
+             log.find("CMAKE_MAKE_PROGRAM is not set") != std::string::npos;
+    }
+
+    bool build_and_install(
+        const ScriptDepArtifactRequest &request,
+        const artifact_cache::Artifact &a,
+        std::string &error)
+    {
+      std::error_code ec;
+      const fs::path buildDir = a.root.parent_path() / (a.fingerprint + ".build");
+
+      fs::remove_all(a.root, ec);
+      fs::remove_all(buildDir, ec);
+      fs::create_directories(a.root, ec);
+      if (ec)
+      {
+        error = "cannot create artifact prefix: " + ec.message();
+        return false;
+      }
+
+      std::ostringstream configure;
+      configure << "cmake"
+                << " -S " << process::quote(request.sourceDir.string())
+                << " -B " << process::quote(buildDir.string())
+                << artifact_generator_arg()
+                << " -DCMAKE_BUILD_TYPE=" << request.buildType
+                << " -DCMAKE_INSTALL_PREFIX=" << process::quote(a.root.string())
+                << " -DCMAKE_CXX_STANDARD=" << request.cxxStandard
+                << " -DCMAKE_CXX_STANDARD_REQUIRED=ON"
+                << " -DCMAKE_CXX_EXTENSIONS=OFF"
+                << " -DCMAKE_POSITION_INDEPENDENT_CODE=ON"
+                << " -DBUILD_TESTING=OFF"
+                << " -DBUILD_TESTS=OFF"
+                << " -DBUILD_EXAMPLES=OFF"
+                << " -DBUILD_BENCHMARKS=OFF"
+                << " -DBUILD_DOCS=OFF";
+
+      for (const auto &arg : request.cmakeArgs)
+        configure << " " << process::quote(arg);
+
+      std::string log;
+      int code = run_logged(configure.str(), log);
+      const bool configureFailed = code != 0;
+
+      if (code == 0)
+        code = run_logged("cmake --build " + process::quote(buildDir.string()), log);
+
+      if (code == 0)
+        code = run_logged("cmake --install " + process::quote(buildDir.string()), log);
+
+      (void)util::write_text_file_atomic(a.root.parent_path() / (a.fingerprint + ".log"), log);
+
+      if (code != 0)
+      {
+        error = "dependency build failed for " + request.pkgDir +
+                " (log: " + (a.root.parent_path() / (a.fingerprint + ".log")).string() + ")";
+        if (!(configureFailed && missing_build_tool(log)))
+          (void)util::write_text_file_atomic(a.root / FAILED_FILE, log);
+        fs::remove_all(buildDir, ec);
+        return false;
+      }
+
+      std::ostringstream consume;
+      consume << "format=" << SCRIPT_DEP_FORMAT << "\n";
+      consume << "package=" << request.pkgDir << "\n";
+      consume << "commit=" << request.commit << "\n";
+      for (const auto &name : build::find_installed_config_packages(a.root))
+        consume << "config=" << name << "\n";
+
+      if (!util::write_text_file_atomic(a.root / CONSUME_FILE, consume.str()) ||
+          !artifact_cache::ArtifactCache::ensure_layout(a) ||
+          !artifact_cache::ArtifactCache::write_manifest(a))
+      {
+        error = "cannot finalize artifact prefix " + a.root.string();
+        return false;
+      }
+
+      fs::remove_all(buildDir, ec);
+      return true;
+    }
+
+    std::string effective_commit(const ScriptDepArtifactRequest &request)
+    {
+      if (!request.commit.empty())
+        return request.commit;
+
+      return read_git_head_commit(request.sourceDir);
+    }
+
+    void load_artifact_state(const artifact_cache::Artifact &a, ScriptDepArtifact &out)
+    {
+      std::error_code ec;
+      out.ready =
+          artifact_cache::ArtifactCache::exists(a) &&
+          fs::exists(a.root / CONSUME_FILE, ec);
+
+      out.failed = !out.ready && build::dep_build_failed_recently(a.root / FAILED_FILE);
+
+      if (out.ready)
+        out.configPackages = read_consume_file(a.root);
+    }
+  } // namespace
+
+  bool script_dep_artifacts_enabled()
+  {
+    return build::dep_artifacts_enabled() &&
+           build::prebuilt_switch_enabled("VIX_SCRIPT_PREBUILT_DEPS");
+  }
+
+  ScriptDepArtifact describe_script_dep_artifact(const ScriptDepArtifactRequest &request)
+  {
+    ScriptDepArtifact out;
+    out.pkgDir = request.pkgDir;
+
+    if (!script_dep_artifacts_enabled())
+      return out;
+
+    const std::string commit = effective_commit(request);
+    if (commit.empty())
+      return out;
+
+    const std::string compiler = build::compiler_identity_component();
+    if (compiler.empty())
+      return out;
+
+    const artifact_cache::Artifact a = make_artifact(request, commit, compiler);
+
+    out.eligible = true;
+    out.fingerprint = a.fingerprint;
+    out.prefix = a.root;
+    out.lockPath = a.root.parent_path() / (a.fingerprint + ".lock");
+
+    load_artifact_state(a, out);
+    return out;
+  }
+
+  ScriptDepArtifactStatus ensure_script_dep_artifact(
+      const ScriptDepArtifactRequest &request,
+      ScriptDepArtifact &artifact,
+      std::string &error)
+  {
+    artifact = describe_script_dep_artifact(request);
+
+    if (!artifact.eligible)
+      return ScriptDepArtifactStatus::Unavailable;
+
+    if (artifact.ready)
+      return ScriptDepArtifactStatus::Reused;
+
+    if (artifact.failed)
+    {
+      error = "a build of " + request.pkgDir + " failed less than a day ago; using sources";
+      return ScriptDepArtifactStatus::Failed;
+    }
+
+#ifdef _WIN32
+    return ScriptDepArtifactStatus::Unavailable;
+#else
+    build::DepArtifactBuildLock lock(artifact.lockPath);
+    if (!lock.acquired())
+    {
+      error = "cannot lock " + artifact.lockPath.string();
+      return ScriptDepArtifactStatus::Unavailable;
+    }
+
+    const artifact_cache::Artifact a = make_artifact(
+        request,
+        effective_commit(request),
+        build::compiler_identity_component());
+
+    // Another process may have produced the prefix while we waited.
+    load_artifact_state(a, artifact);
+    if (artifact.ready)
+      return ScriptDepArtifactStatus::Reused;
+
+    if (!build_and_install(request, a, error))
+    {
+      artifact.failed = true;
+      return ScriptDepArtifactStatus::Failed;
+    }
+
+    load_artifact_state(a, artifact);
+    return artifact.ready ? ScriptDepArtifactStatus::Built
+                          : ScriptDepArtifactStatus::Failed;
+#endif
+  }
+
+} // namespace vix::commands::RunCommand::detail
@@ -0,0 +1,1013 @@
+/**
+ *
+ *  @file ScriptHotReload.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira. All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by an MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/run/detail/ScriptHotReload.hpp>
+#include <vix/cli/commands/run/detail/DirectScriptRunner.hpp>
+#include <vix/cli/ErrorHandler.hpp>
+#include <vix/cli/Style.hpp>
+#include <vix/cli/util/Hash.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace vix::cli::style;
+
+namespace vix::commands::RunCommand::detail
+{
+  namespace fs = std::filesystem;
+
+#ifndef _WIN32
+  namespace
+  {
+    using Clock = std::chrono::steady_clock;
+    using namespace std::chrono_literals;
+
+    /// Exit code of a host whose shared object does not export vix_reload.
+    constexpr int RELOAD_NO_HOOK_EXIT = 76;
+
+    /// Time allowed for the first generation to finish its load hook.
+    constexpr auto RELOAD_START_TIMEOUT = 30s;
+
+    /// Time allowed for the running generation to reach its next step.
+    constexpr auto RELOAD_SWAP_TIMEOUT = 10s;
+
+    constexpr std::uint64_t RELOAD_FNV_OFFSET = 14695981039346656037ULL;
+
+    /// Layout documented in ScriptHotReload.hpp. Scripts declare it themselves.
+    struct ReloadContext
+    {
+      int version;
+      int generation;
+      int argc;
+      char **argv;
+      void *state;
+      int exit_code;
+    };
+
+    using ReloadHook = int (*)(ReloadContext *, int);
+    using ReloadAbiHook = const char *(*)();
+
+    volatile sig_atomic_t g_hot_reload_interrupted = 0;
+
+    void on_hot_reload_signal(int)
+    {
+      g_hot_reload_interrupted = 1;
+    }
+
+    /**
+     * @brief Install SIGINT handling for the reload loop.
+     *
+     * SIGPIPE is ignored as well: a host that dies between two checks must
+     * surface as a failed write, not terminate vix.
+     */
+    struct HotReloadSignalGuard
+    {
+      struct sigaction previousInt {};
+      struct sigaction previousPipe {};
+      bool installed = false;
+
+      HotReloadSignalGuard()
+      {
+        g_hot_reload_interrupted = 0;
+
+        struct sigaction action {};
+        action.sa_handler = on_hot_reload_signal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = 0;
+
+        struct sigaction ignore {};
+        ignore.sa_handler = SIG_IGN;
+        sigemptyset(&ignore.sa_mask);
+        ignore.sa_flags = 0;
+
+        installed = ::sigaction(SIGINT, &action, &previousInt) == 0 &&
+                    ::sigaction(SIGPIPE, &ignore, &previousPipe) == 0;
+      }
+
+      ~HotReloadSignalGuard()
+      {
+        if (!installed)
+          return;
+
+        ::sigaction(SIGINT, &previousInt, nullptr);
+        ::sigaction(SIGPIPE, &previousPipe, nullptr);
+      }
+    };
+
+    struct InputSnapshot
+    {
+      bool exists = false;
+      fs::file_time_type write{};
+      std::uintmax_t size = 0;
+    };
+
+    InputSnapshot snapshot_input(const fs::path &path)
+    {
+      InputSnapshot snapshot{};
+      std::error_code ec;
+
+      if (!fs::is_regular_file(path, ec) || ec)
+        return snapshot;
+
+      snapshot.write = fs::last_write_time(path, ec);
+      if (ec)
+        return snapshot;
+
+      snapshot.size = fs::file_size(path, ec);
+      snapshot.exists = !ec;
+      return snapshot;
+    }
+
+    bool same_snapshot(const InputSnapshot &a, const InputSnapshot &b)
+    {
+      if (a.exists != b.exists)
+        return false;
+
+      return !a.exists || (a.write == b.write && a.size == b.size);
+    }
+
+    /**
+     * @brief Stat-based snapshot of the inputs of the running generation.
+     *
+     * Same acceptance rules as the restart watch loop: a change is consumed
+     * when it is accepted, and inputs that stay in the graph keep their
+     * accepted baseline across a build so a write made during compilation
+     * triggers the next cycle.
+     */
+    class WatchedInputs
+    {
+    public:
+      void reset(const std::vector<fs::path> &inputs)
+      {
+        inputs_.clear();
+
+        for (const fs::path &input : inputs)
+        {
+          std::error_code ec;
+          const fs::path path = fs::absolute(input, ec).lexically_normal();
+          if (ec)
+            continue;
+
+          inputs_[path.generic_string()] = snapshot_input(path);
+        }
+      }
+
+      void accept()
+      {
+        for (auto &[key, snapshot] : inputs_)
+          snapshot = snapshot_input(fs::path(key));
+      }
+
+      void update_after_build(const std::vector<fs::path> &inputs)
+      {
+        const auto previous = inputs_;
+        reset(inputs);
+
+        for (auto &[key, snapshot] : inputs_)
+        {
+          const auto it = previous.find(key);
+          if (it != previous.end())
+            snapshot = it->second;
+        }
+      }
+
+      bool changed() const
+      {
+        for (const auto &[key, before] : inputs_)
+        {
+          if (!same_snapshot(before, snapshot_input(fs::path(key))))
+            return true;
+        }
+
+        return false;
+      }
+
+    private:
+      std::unordered_map<std::string, InputSnapshot> inputs_;
+    };
+
+    long long elapsed_ms(Clock::time_point start)
+    {
+      return static_cast<long long>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              Clock::now() - start)
+              .count());
+    }
+
+    /**
+     * @brief One compiled generation of the script.
+     */
+    struct ReloadGeneration
+    {
+      int code = 0;
+      bool eligible = true;
+      std::string ineligibleReason; // why the script must restart instead
+
+      fs::path library;
+      std::string abi;
+      std::vector<fs::path> inputs;
+
+      long long buildMs = 0;
+    };
+
+    ReloadGeneration build_reload_generation(
+        const Options &opt,
+        const fs::path &reloadDir,
+        int number)
+    {
+      ReloadGeneration gen{};
+      const auto start = Clock::now();
+
+      Options o = opt;
+      const int prepCode = prepare_single_cpp_options(o);
+      if (prepCode != 0)
+      {
+        gen.code = prepCode;
+        return gen;
+      }
+
+      const ScriptProbeResult probe = probe_single_cpp_script(o);
+      if (!script_can_use_direct_compile(probe))
+      {
+        gen.eligible = false;
+        gen.ineligibleReason = "needs the CMake fallback";
+        return gen;
+      }
+
+      // The runtime is a static, non-PIC archive with process-wide state
+      // (loggers, thread pools, signal handlers): it cannot live in a
+      // library that is unloaded and loaded again.
+      if (probe.usesVixRuntime)
+      {
+        gen.eligible = false;
+        gen.ineligibleReason = "uses the Vix runtime";
+        return gen;
+      }
+
+      const DirectScriptPlan plan = make_direct_script_plan(o, probe);
+
+      gen.inputs.push_back(plan.scriptPath);
+      for (const std::string &fingerprint : plan.fingerprint.headerFingerprints)
+      {
+        const std::size_t separator = fingerprint.find('|');
+        if (separator != std::string::npos)
+          gen.inputs.emplace_back(fingerprint.substr(0, separator));
+      }
+
+      gen.abi = make_direct_abi_fingerprint(plan);
+      gen.library = reloadDir / ("gen-" + std::to_string(number) + ".so");
+
+      std::error_code ec;
+      fs::remove(gen.library, ec);
+
+      const LiveRunResult build = run_cmd_live_filtered_capture(
+          make_direct_shared_object_compile_cmd(o, plan, gen.library),
+          "",
+          false,
+          0,
+          false,
+          true);
+
+      gen.buildMs = elapsed_ms(start);
+
+      if (build.exitCode != 0)
+      {
+        bool handled = false;
+        const std::string compileLog = build.stdoutText + build.stderrText;
+
+        if (!compileLog.empty())
+        {
+          handled = vix::cli::ErrorHandler::printBuildErrors(
+              compileLog,
+              plan.scriptPath,
+              "Script compile failed");
+        }
+
+        if (!handled)
+          error("Script compile failed.");
+
+        gen.code = build.exitCode;
+        fs::remove(gen.library, ec);
+      }
+
+      return gen;
+    }
+
+    fs::path make_reload_dir(const Options &opt)
+    {
+      std::error_code ec;
+      const fs::path script = fs::absolute(opt.cppFile, ec).lexically_normal();
+
+      // One directory per watching process: two terminals running the same
+      // script must not overwrite each other's loaded generations.
+      const std::string key =
+          vix::cli::util::hex64(
+              vix::cli::util::fnv1a64_str(script.string(), RELOAD_FNV_OFFSET)) +
+          "-" + std::to_string(static_cast<long long>(::getpid()));
+
+      return get_direct_scripts_cache_root(opt.localCache) / "reload" / key;
+    }
+
+    struct ReloadDirGuard
+    {
+      fs::path dir;
+
+      ~ReloadDirGuard()
+      {
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+      }
+    };
+
+    bool write_line(int fd, const std::string &line)
+    {
+      const std::string data = line + "\n";
+      std::size_t offset = 0;
+
+      while (offset < data.size())
+      {
+        const ssize_t n = ::write(fd, data.data() + offset, data.size() - offset);
+        if (n < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          return false;
+        }
+
+        offset += static_cast<std::size_t>(n);
+      }
+
+      return true;
+    }
+
+    /**
+     * @brief Read one line from fd, waiting at most timeoutMs.
+     *
+     * @return 1 when a line is available, 0 on timeout, -1 on EOF or error.
+     */
+    int read_line(int fd, std::string &buffer, std::string &line, int timeoutMs)
+    {
+      const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+
+      for (;;)
+      {
+        const std::size_t eol = buffer.find('\n');
+        if (eol != std::string::npos)
+        {
+          line = buffer.substr(0, eol);
+          buffer.erase(0, eol + 1);
+          return 1;
+        }
+
+        const long long remaining =
+            static_cast<long long>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - Clock::now())
+                    .count());
+
+        struct pollfd pfd {};
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+
+        const int ready = ::poll(&pfd, 1, remaining > 0 ? static_cast<int>(remaining) : 0);
+        if (ready < 0)
+        {
+          if (errno == EINTR && !g_hot_reload_interrupted)
+            continue;
+          return -1;
+        }
+
+        if (ready == 0)
+          return 0;
+
+        char chunk[512];
+        const ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n <= 0)
+          return -1;
+
+        buffer.append(chunk, static_cast<std::size_t>(n));
+      }
+    }
+
+    [[noreturn]] void host_exit(int code)
+    {
+      std::cout.flush();
+      std::cerr.flush();
+      std::fflush(nullptr);
+      ::_exit(code);
+    }
+
+    ReloadHook resolve_reload_hook(void *handle)
+    {
+      return reinterpret_cast<ReloadHook>(::dlsym(handle, "vix_reload"));
+    }
+
+    std::string read_reload_abi(void *handle)
+    {
+      const auto abi = reinterpret_cast<ReloadAbiHook>(::dlsym(handle, "vix_reload_abi"));
+      if (!abi)
+        return {};
+
+      const char *value = abi();
+      return value ? std::string(value) : std::string{};
+    }
+
+    std::string last_dl_error()
+    {
+      const char *message = ::dlerror();
+      return message ? std::string(message) : std::string("unknown dlopen error");
+    }
+
+    /**
+     * @brief Body of the forked host process.
+     *
+     * Generations are swapped only between two step calls, which is the safe
+     * point where the script holds no stack frame inside the old code.
+     */
+    [[noreturn]] void run_reload_host(
+        const Options &opt,
+        const fs::path &library,
+        int controlFd,
+        int statusFd)
+    {
+      ::setenv("VIX_STDOUT_MODE", "line", 1);
+      ::setenv("VIX_MODE", "dev", 1);
+
+      if (!opt.cwd.empty())
+      {
+        const std::string cwd = normalize_cwd_if_needed(opt.cwd);
+        if (::chdir(cwd.c_str()) != 0)
+        {
+          write_line(statusFd, "fail cannot enter " + cwd);
+          host_exit(127);
+        }
+      }
+
+      std::vector<std::string> argvStr;
+      argvStr.push_back(fs::path(opt.cppFile).stem().string());
+      for (const auto &a : opt.runArgs)
+      {
+        if (!a.empty())
+          argvStr.push_back(a);
+      }
+
+      std::vector<char *> argv;
+      argv.reserve(argvStr.size() + 1);
+      for (auto &s : argvStr)
+        argv.push_back(s.data());
+      argv.push_back(nullptr);
+
+      void *handle = ::dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+      if (!handle)
+      {
+        write_line(statusFd, "fail " + last_dl_error());
+        host_exit(127);
+      }
+
+      ReloadHook hook = resolve_reload_hook(handle);
+      if (!hook)
+      {
+        write_line(statusFd, "nohook");
+        host_exit(RELOAD_NO_HOOK_EXIT);
+      }
+
+      const std::string abi = read_reload_abi(handle);
+
+      ReloadContext ctx{};
+      ctx.version = VIX_RELOAD_ABI_VERSION;
+      ctx.generation = 1;
+      ctx.argc = static_cast<int>(argvStr.size());
+      ctx.argv = argv.data();
+      ctx.state = nullptr;
+      ctx.exit_code = 0;
+
+      if (hook(&ctx, static_cast<int>(ReloadOp::Load)) != 0)
+      {
+        write_line(statusFd, "fail load hook returned an error");
+        host_exit(1);
+      }
+
+      write_line(statusFd, "ready");
+
+      std::string pending;
+      for (;;)
+      {
+        if (hook(&ctx, static_cast<int>(ReloadOp::Step)) != 0)
+        {
+          (void)hook(&ctx, static_cast<int>(ReloadOp::Unload));
+          host_exit(ctx.exit_code);
+        }
+
+        std::string command;
+        const int got = read_line(controlFd, pending, command, 0);
+
+        // vix closed the control pipe: stop cleanly.
+        if (got < 0)
+        {
+          (void)hook(&ctx, static_cast<int>(ReloadOp::Unload));
+          host_exit(0);
+        }
+
+        if (got == 0 || command.rfind("load ", 0) != 0)
+          continue;
+
+        const std::string nextPath = command.substr(5);
+        void *nextHandle = ::dlopen(nextPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!nextHandle)
+        {
+          write_line(statusFd, "fail " + last_dl_error());
+          continue;
+        }
+
+        const ReloadHook nextHook = resolve_reload_hook(nextHandle);
+        if (!nextHook || read_reload_abi(nextHandle) != abi)
+        {
+          ::dlclose(nextHandle);
+          write_line(statusFd, nextHook ? "restart abi" : "restart nohook");
+          continue;
+        }
+
+        if (hook(&ctx, static_cast<int>(ReloadOp::Unload)) != 0)
+        {
+          ::dlclose(nextHandle);
+          write_line(statusFd, "restart unload");
+          continue;
+        }
+
+        ++ctx.generation;
+        if (nextHook(&ctx, static_cast<int>(ReloadOp::Load)) != 0)
+        {
+          write_line(statusFd, "restart load");
+          host_exit(1);
+        }
+
+        ::dlclose(handle);
+        handle = nextHandle;
+        hook = nextHook;
+
+        write_line(statusFd, "ok");
+      }
+    }
+
+    struct ReloadHost
+    {
+      pid_t pid = -1;
+      int controlFd = -1;
+      int statusFd = -1;
+      std::string statusBuffer;
+    };
+
+    void close_host_fds(ReloadHost &host)
+    {
+      if (host.controlFd >= 0)
+        ::close(host.controlFd);
+      if (host.statusFd >= 0)
+        ::close(host.statusFd);
+
+      host.controlFd = -1;
+      host.statusFd = -1;
+      host.statusBuffer.clear();
+    }
+
+    int decode_wait_status(int status)
+    {
+      if (WIFEXITED(status))
+        return WEXITSTATUS(status);
+      if (WIFSIGNALED(status))
+        return 128 + WTERMSIG(status);
+      return 1;
+    }
+
+    bool start_reload_host(const Options &opt, const fs::path &library, ReloadHost &host)
+    {
+      int control[2] = {-1, -1};
+      int status[2] = {-1, -1};
+
+      if (::pipe(control) != 0)
+        return false;
+
+      if (::pipe(status) != 0)
+      {
+        ::close(control[0]);
+        ::close(control[1]);
+        return false;
+      }
+
+      std::cout << std::flush;
+      std::cerr << std::flush;
+
+      const pid_t pid = ::fork();
+      if (pid < 0)
+      {
+        ::close(control[0]);
+        ::close(control[1]);
+        ::close(status[0]);
+        ::close(status[1]);
+        return false;
+      }
+
+      if (pid == 0)
+      {
+        ::signal(SIGINT, SIG_DFL);
+        ::signal(SIGPIPE, SIG_DFL);
+
+        ::close(control[1]);
+        ::close(status[0]);
+
+        run_reload_host(opt, library, control[0], status[1]);
+      }
+
+      ::close(control[0]);
+      ::close(status[1]);
+
+      host.pid = pid;
+      host.controlFd = control[1];
+      host.statusFd = status[0];
+      host.statusBuffer.clear();
+      return true;
+    }
+
+    /**
+     * @brief Reap the host if it has exited.
+     */
+    bool reap_reload_host(ReloadHost &host, int &exitCode, bool block)
+    {
+      if (host.pid <= 0)
+        return true;
+
+      int status = 0;
+      pid_t r = -1;
+      do
+      {
+        r = ::waitpid(host.pid, &status, block ? 0 : WNOHANG);
+      } while (r < 0 && errno == EINTR);
+
+      if (r == 0)
+        return false;
+
+      exitCode = r == host.pid ? decode_wait_status(status) : 1;
+      host.pid = -1;
+      close_host_fds(host);
+      return true;
+    }
+
+    /**
+     * @brief Stop the host: EOF on its control pipe first, then signals.
+     */
+    void stop_reload_host(ReloadHost &host)
+    {
+      if (host.pid <= 0)
+        return;
+
+      if (host.controlFd >= 0)
+      {
+        ::close(host.controlFd);
+        host.controlFd = -1;
+      }
+
+      int exitCode = 0;
+      const auto deadline = Clock::now() + 2s;
+      while (Clock::now() < deadline)
+      {
+        if (reap_reload_host(host, exitCode, false))
+          return;
+        std::this_thread::sleep_for(20ms);
+      }
+
+      (void)::kill(host.pid, SIGINT);
+      const auto killDeadline = Clock::now() + 2s;
+      while (Clock::now() < killDeadline)
+      {
+        if (reap_reload_host(host, exitCode, false))
+          return;
+        std::this_thread::sleep_for(20ms);
+      }
+
+      (void)::kill(host.pid, SIGKILL);
+      (void)reap_reload_host(host, exitCode, true);
+    }
+
+    bool wait_for_change(WatchedInputs &watched)
+    {
+      for (;;)
+      {
+        std::this_thread::sleep_for(200ms);
+
+        if (g_hot_reload_interrupted)
+          return false;
+
+        if (watched.changed())
+        {
+          watched.accept();
+          return true;
+        }
+      }
+    }
+
+    int timeout_ms(std::chrono::seconds timeout)
+    {
+      return static_cast<int>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count());
+    }
+
+    void remove_library(const fs::path &library)
+    {
+      if (library.empty())
+        return;
+
+      std::error_code ec;
+      fs::remove(library, ec);
+    }
+
+  } // namespace
+#endif
+
+  int run_single_cpp_hot_reload(const Options &opt)
+  {
+#ifdef _WIN32
+    hint("Hot reload is not available on Windows yet; restarting on change instead.");
+    return run_single_cpp_watch(opt);
+#else
+    if (want_any_sanitizer(
+            opt.enableSanitizers,
+            opt.enableUbsanOnly,
+            opt.enableThreadSanitizer))
+    {
+      hint("Hot reload cannot load sanitized builds; restarting on change instead.");
+      return run_single_cpp_watch(opt);
+    }
+
+    const fs::path script = opt.cppFile;
+    if (!fs::exists(script))
+    {
+      error("C++ file not found: " + script.string());
+      return 1;
+    }
+
+    const std::string name = script.filename().string();
+
+    ReloadDirGuard reloadDir{make_reload_dir(opt)};
+    std::error_code ec;
+    fs::create_directories(reloadDir.dir, ec);
+    if (ec)
+    {
+      error("Failed to create hot reload directory: " + reloadDir.dir.string());
+      return 1;
+    }
+
+    HotReloadSignalGuard signalGuard;
+
+    WatchedInputs watched;
+    watched.reset({script});
+
+    std::cout << "Watching " << (opt.verbose ? script.string() : name)
+              << " (hot reload)\n"
+              << std::flush;
+
+    auto fall_back_to_restart = [&](const std::string &reason) -> int
+    {
+      hint(reason);
+      hint("Falling back to restart on change.");
+      return run_single_cpp_watch(opt);
+    };
+
+    int generation = 0;
+    ReloadHost host;
+    std::optional<ReloadGeneration> prebuilt;
+    std::optional<Clock::time_point> restartStart;
+
+    for (;;)
+    {
+      if (g_hot_reload_interrupted)
+        return 0;
+
+      ReloadGeneration gen = prebuilt
+                                 ? std::move(*prebuilt)
+                                 : build_reload_generation(opt, reloadDir.dir, ++generation);
+      prebuilt.reset();
+
+      if (!gen.eligible)
+        return fall_back_to_restart(name + " " + gen.ineligibleReason + " and cannot be hot reloaded.");
+
+      if (!gen.inputs.empty())
+        watched.update_after_build(gen.inputs);
+
+      if (gen.code != 0)
+      {
+        restartStart.reset();
+        if (!wait_for_change(watched))
+          return 0;
+        restartStart = Clock::now();
+        continue;
+      }
+
+      if (!start_reload_host(opt, gen.library, host))
+      {
+        error("Failed to start the hot reload host.");
+        return 1;
+      }
+
+      std::string status;
+      const int started = read_line(
+          host.statusFd,
+          host.statusBuffer,
+          status,
+          timeout_ms(RELOAD_START_TIMEOUT));
+
+      if (started <= 0 || status.rfind("fail", 0) == 0)
+      {
+        int exitCode = 0;
+        if (started == 0)
+          stop_reload_host(host);
+        else
+          (void)reap_reload_host(host, exitCode, true);
+
+        if (g_hot_reload_interrupted)
+          return 0;
+
+        if (status.rfind("fail ", 0) == 0)
+          error("Hot reload host failed: " + status.substr(5));
+        else if (started == 0)
+          error("Script did not finish loading within " +
+                std::to_string(RELOAD_START_TIMEOUT.count()) + "s.");
+        else
+          error("script exited with code " + std::to_string(exitCode) + ".");
+
+        restartStart.reset();
+        if (!wait_for_change(watched))
+          return 0;
+        restartStart = Clock::now();
+        continue;
+      }
+
+      if (status == "nohook")
+      {
+        int exitCode = 0;
+        (void)reap_reload_host(host, exitCode, true);
+        return fall_back_to_restart(name + " does not export vix_reload().");
+      }
+
+      if (restartStart)
+      {
+        std::cout << "Restarted " << name << " in "
+                  << elapsed_ms(*restartStart) << " ms\n"
+                  << std::flush;
+        restartStart.reset();
+      }
+      else if (opt.verbose)
+      {
+        info("Hot reload host started (pid=" + std::to_string(host.pid) + ")");
+      }
+
+      const std::string currentAbi = gen.abi;
+      fs::path currentLibrary = gen.library;
+      // ctx->generation of the code the host runs; failed builds and swaps
+      // do not advance it.
+      int loadedGeneration = 1;
+      bool restart = false;
+
+      while (!restart)
+      {
+        std::this_thread::sleep_for(100ms);
+
+        if (g_hot_reload_interrupted)
+        {
+          stop_reload_host(host);
+          return 0;
+        }
+
+        int exitCode = 0;
+        if (reap_reload_host(host, exitCode, false))
+        {
+          if (g_hot_reload_interrupted)
+            return 0;
+
+          if (exitCode != 0)
+            error("script exited with code " + std::to_string(exitCode) + ".");
+
+          remove_library(currentLibrary);
+          if (!wait_for_change(watched))
+            return 0;
+
+          restartStart = Clock::now();
+          restart = true;
+          break;
+        }
+
+        if (!watched.changed())
+          continue;
+
+        const auto saved = Clock::now();
+        watched.accept();
+
+        ReloadGeneration next = build_reload_generation(opt, reloadDir.dir, ++generation);
+        if (!next.eligible)
+        {
+          stop_reload_host(host);
+          return fall_back_to_restart(name + " now " + next.ineligibleReason + " and cannot be hot reloaded.");
+        }
+
+        if (!next.inputs.empty())
+          watched.update_after_build(next.inputs);
+
+        if (next.code != 0)
+        {
+          hint("Generation " + std::to_string(loadedGeneration) +
+               " keeps running. Fix the errors and save again.");
+          continue;
+        }
+
+        if (next.abi != currentAbi)
+        {
+          info("Compiler, flags or dependencies changed; restarting " + name + ".");
+          stop_reload_host(host);
+          remove_library(currentLibrary);
+          prebuilt = std::move(next);
+          restartStart = saved;
+          restart = true;
+          break;
+        }
+
+        const auto swapStart = Clock::now();
+        std::string reply;
+        int replied = write_line(host.controlFd, "load " + next.library.string())
+                          ? read_line(
+                                host.statusFd,
+                                host.statusBuffer,
+                                reply,
+                                timeout_ms(RELOAD_SWAP_TIMEOUT))
+                          : -1;
+
+        if (replied > 0 && reply == "ok")
+        {
+          remove_library(currentLibrary);
+          currentLibrary = next.library;
+          ++loadedGeneration;
+
+          std::cout << "Reloaded " << name << " in " << elapsed_ms(saved)
+                    << " ms (build " << next.buildMs
+                    << " ms, swap " << elapsed_ms(swapStart) << " ms)\n"
+                    << std::flush;
+          continue;
+        }
+
+        if (replied > 0 && reply.rfind("fail ", 0) == 0)
+        {
+          error("Hot reload failed: " + reply.substr(5));
+          hint("Generation " + std::to_string(loadedGeneration) + " keeps running.");
+          remove_library(next.library);
+          continue;
+        }
+
+        if (replied == 0)
+          hint("vix_reload step did not return within " +
+               std::to_string(RELOAD_SWAP_TIMEOUT.count()) +
+               "s; restarting " + name + ".");
+        else if (reply == "restart abi")
+          info("vix_reload_abi() changed; restarting " + name + ".");
+        else if (replied > 0)
+          info("Generation could not be swapped (" + reply +
+               "); restarting " + name + ".");
+
+        stop_reload_host(host);
+        remove_library(currentLibrary);
+        prebuilt = std::move(next);
+        restartStart = saved;
+        restart = true;
+      }
+    }
+#endif
+  }
+
+} // namespace vix::commands::RunCommand::detail
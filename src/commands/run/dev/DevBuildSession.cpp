@@ -0,0 +1,401 @@
+/**
+ *
+ *  @file DevBuildSession.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2026, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Dev mode in-process build session
+ *
+ */
+
+#include <vix/cli/commands/run/dev/DevBuildSession.hpp>
+#include <vix/cli/build/BuildGraphExecutor.hpp>
+#include <vix/cli/build/BuildGraphExecutorAdapter.hpp>
+#include <vix/cli/build/BuildTaskProcessExecutor.hpp>
+#include <vix/engine/Watch.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace vix::commands::RunCommand::dev
+{
+  namespace build = vix::cli::build;
+
+  namespace
+  {
+    std::vector<vix::engine::watch::Event> events_for_paths(
+        const std::vector<fs::path> &paths)
+    {
+      std::vector<vix::engine::watch::Event> events;
+      events.reserve(paths.size());
+
+      for (const fs::path &path : paths)
+      {
+        std::error_code ec;
+        const bool exists = fs::exists(path, ec) && !ec;
+
+        vix::engine::watch::Event event;
+        event.kind = exists
+                         ? vix::engine::watch::EventKind::Modified
+                         : vix::engine::watch::EventKind::Removed;
+        event.path = path;
+        event.directory = false;
+        events.push_back(std::move(event));
+      }
+
+      return events;
+    }
+
+    std::string path_key(const fs::path &path)
+    {
+      return path.lexically_normal().generic_string();
+    }
+
+    build::BuildTaskResult cancelled_task_result(const std::string &taskId)
+    {
+      build::BuildTaskResult result;
+      result.taskId = taskId;
+      result.state = build::BuildTaskState::Failed;
+      result.exitCode = 130;
+      result.output = "Superseded by a newer edit: " + taskId + "\n";
+      return result;
+    }
+
+#ifndef _WIN32
+    /**
+     * @brief Run one task in its own process group so that cancellation can
+     * take the compiler driver and its cc1plus/ld children down together.
+     */
+    pid_t spawn_task(const build::BuildTask &task, int &outputFd)
+    {
+      // Everything the child needs is prepared before fork(): executor
+      // threads may hold the allocator lock at that moment.
+      std::vector<char *> argv;
+      argv.reserve(task.command.size() + 1);
+      for (const std::string &arg : task.command)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+      argv.push_back(nullptr);
+
+      const std::string workingDirectory = fs::path(task.workingDirectory).string();
+
+      // Close-on-exec: compilers forked by other executor threads must not
+      // inherit this pipe, or its EOF waits for them as well. dup2() clears
+      // the flag on the child's stdout and stderr.
+      int pipeFds[2] = {-1, -1};
+#ifdef __linux__
+      if (::pipe2(pipeFds, O_CLOEXEC) != 0)
+        return -1;
+#else
+      if (::pipe(pipeFds) != 0)
+        return -1;
+      (void)::fcntl(pipeFds[0], F_SETFD, FD_CLOEXEC);
+      (void)::fcntl(pipeFds[1], F_SETFD, FD_CLOEXEC);
+#endif
+
+      const pid_t pid = ::fork();
+      if (pid < 0)
+      {
+        ::close(pipeFds[0]);
+        ::close(pipeFds[1]);
+        return -1;
+      }
+
+      if (pid == 0)
+      {
+        ::setpgid(0, 0);
+        ::close(pipeFds[0]);
+        ::dup2(pipeFds[1], STDOUT_FILENO);
+        ::dup2(pipeFds[1], STDERR_FILENO);
+        ::close(pipeFds[1]);
+
+        if (!workingDirectory.empty() && ::chdir(workingDirectory.c_str()) != 0)
+          _exit(127);
+
+        ::execvp(argv[0], argv.data());
+        _exit(127);
+      }
+
+      // Also from the parent, so a kill issued right after fork() still
+      // finds the group.
+      ::setpgid(pid, pid);
+      ::close(pipeFds[1]);
+      outputFd = pipeFds[0];
+      return pid;
+    }
+
+    int wait_task(pid_t pid, int outputFd, std::string &output)
+    {
+      char buffer[4096];
+      while (true)
+      {
+        const ssize_t n = ::read(outputFd, buffer, sizeof(buffer));
+        if (n > 0)
+        {
+          output.append(buffer, static_cast<std::size_t>(n));
+          continue;
+        }
+
+        if (n < 0 && errno == EINTR)
+          continue;
+
+        break;
+      }
+      ::close(outputFd);
+
+      int status = 0;
+      while (::waitpid(pid, &status, 0) < 0)
+      {
+        if (errno != EINTR)
+          return 1;
+      }
+
+      if (WIFEXITED(status))
+        return WEXITSTATUS(status);
+      if (WIFSIGNALED(status))
+        return 128 + WTERMSIG(status);
+      return 1;
+    }
+#endif
+  } // namespace
+
+  DevBuildSession::DevBuildSession(DevBuildSessionOptions options)
+      : options_(std::move(options))
+  {
+  }
+
+  bool DevBuildSession::loaded() const
+  {
+    return graph_.has_value();
+  }
+
+  bool DevBuildSession::reload()
+  {
+    graph_ = build::BuildGraph::load(
+        build::BuildGraph::default_graph_path(options_.buildDir));
+    return graph_.has_value();
+  }
+
+  DevBuildSessionResult DevBuildSession::rebuild(
+      const std::vector<fs::path> &changedPaths)
+  {
+    DevBuildSessionResult result;
+
+    if (!graph_ && !reload())
+      return result;
+
+    if (changedPaths.empty())
+      return result;
+
+    const build::BuildGraphInvalidationResult invalidation =
+        graph_->invalidate_paths(events_for_paths(changedPaths));
+
+    // New or removed sources change the task set: only a configure step
+    // followed by a fresh graph can describe that.
+    if (invalidation.structuralChange)
+    {
+      graph_.reset();
+      return result;
+    }
+
+    if (!invalidation.relevant ||
+        (invalidation.changedNodes == 0 && invalidation.affectedTasks == 0))
+    {
+      result.status = DevBuildSessionStatus::UpToDate;
+      return result;
+    }
+
+    build::BuildGraphExecutorOptions executorOptions;
+    executorOptions.buildDir = options_.buildDir;
+    executorOptions.target = options_.target;
+    executorOptions.jobs = options_.jobs;
+    executorOptions.allowNinjaFallback = true;
+
+    build::BuildGraphExecutorDependencies executorDependencies;
+    executorDependencies.executeCompileTask =
+        [this](build::BuildTask &task)
+    {
+      return execute_task(task);
+    };
+    executorDependencies.executeNinjaTarget =
+        [quiet = !options_.verbose](const build::BuildGraphExecutorNinjaRequest &request)
+    {
+      return build::execute_graph_ninja_target(request, quiet);
+    };
+    executorDependencies.onEvent =
+        [verbose = options_.verbose](const build::BuildGraphExecutorEvent &event)
+    {
+      if (verbose)
+        build::render_graph_debug_event(event, false, true);
+    };
+
+    {
+      // Input paths per task, so that cancel_tasks_reading() never has to
+      // touch the graph while the executor owns it.
+      std::lock_guard<std::mutex> lock(mutex_);
+      taskInputs_.clear();
+      runningPids_.clear();
+      cancelledTasks_.clear();
+      cancelAll_ = false;
+
+      for (const std::string &taskId : invalidation.dirtyTaskIds)
+      {
+        const build::BuildTask *task = graph_->find_task(taskId);
+        if (!task)
+          continue;
+
+        std::vector<std::string> &inputs = taskInputs_[taskId];
+        for (const std::string &inputId : task->inputs)
+        {
+          if (const build::BuildNode *node = graph_->find_node(inputId))
+            inputs.push_back(path_key(node->path));
+        }
+      }
+    }
+
+    build::BuildGraphExecutor executor(
+        executorOptions,
+        std::move(executorDependencies));
+
+    const build::BuildGraphExecutorResult executed = executor.run_target(*graph_);
+
+    result.rebuiltTasks = invalidation.dirtyTaskIds.size();
+    result.output = executed.output;
+
+    bool superseded = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      superseded = cancelAll_ || !cancelledTasks_.empty();
+      taskInputs_.clear();
+      runningPids_.clear();
+      cancelledTasks_.clear();
+      cancelAll_ = false;
+    }
+
+    if (superseded)
+    {
+      // Cancelled tasks failed and stay dirty; their inputs are part of the
+      // next rebuild anyway.
+      result.status = DevBuildSessionStatus::Superseded;
+      return result;
+    }
+
+    if (!executed.ok)
+    {
+      // The graph keeps the failed tasks dirty; the next save retries them.
+      result.status = DevBuildSessionStatus::Failed;
+      result.exitCode = executed.exitCode == 0 ? 1 : executed.exitCode;
+      return result;
+    }
+
+    // Keep the on-disk graph current so a later `vix build` starts from it.
+    (void)graph_->save(build::BuildGraph::default_graph_path(options_.buildDir));
+
+    result.status = DevBuildSessionStatus::Built;
+    return result;
+  }
+
+  void DevBuildSession::cancel_tasks_reading(const std::vector<fs::path> &paths)
+  {
+    if (paths.empty())
+      return;
+
+    std::unordered_set<std::string> keys;
+    for (const fs::path &path : paths)
+      keys.insert(path_key(path));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const auto &[taskId, inputs] : taskInputs_)
+    {
+      const bool stale = std::any_of(
+          inputs.begin(),
+          inputs.end(),
+          [&keys](const std::string &input)
+          {
+            return keys.count(input) != 0;
+          });
+
+      if (!stale || !cancelledTasks_.insert(taskId).second)
+        continue;
+
+#ifndef _WIN32
+      if (const auto it = runningPids_.find(taskId); it != runningPids_.end())
+        ::kill(-static_cast<pid_t>(it->second), SIGKILL);
+#endif
+    }
+  }
+
+  void DevBuildSession::cancel_all()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelAll_ = true;
+
+#ifndef _WIN32
+    for (const auto &[taskId, pid] : runningPids_)
+      ::kill(-static_cast<pid_t>(pid), SIGKILL);
+#endif
+  }
+
+  build::BuildTaskResult DevBuildSession::execute_task(build::BuildTask &task)
+  {
+#ifdef _WIN32
+    // No process groups to kill: cancellation only skips queued tasks.
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (cancelAll_ || cancelledTasks_.count(task.id) != 0)
+        return cancelled_task_result(task.id);
+    }
+    return build::execute_build_task_process(task);
+#else
+    if (task.command.empty())
+      return build::execute_build_task_process(task);
+
+    int outputFd = -1;
+    pid_t pid = -1;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (cancelAll_ || cancelledTasks_.count(task.id) != 0)
+        return cancelled_task_result(task.id);
+
+      pid = spawn_task(task, outputFd);
+      if (pid < 0)
+        return build::execute_build_task_process(task);
+
+      runningPids_[task.id] = static_cast<int>(pid);
+    }
+
+    build::BuildTaskResult result;
+    result.taskId = task.id;
+    result.exitCode = wait_task(pid, outputFd, result.output);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      runningPids_.erase(task.id);
+      if (cancelAll_ || cancelledTasks_.count(task.id) != 0)
+        return cancelled_task_result(task.id);
+    }
+
+    result.state = result.exitCode == 0
+                       ? build::BuildTaskState::Done
+                       : build::BuildTaskState::Failed;
+    return result;
+#endif
+  }
+
+} // namespace vix::commands::RunCommand::dev
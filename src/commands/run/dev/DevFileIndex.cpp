@@ -15,6 +15,7 @@
  */
 
 #include <vix/cli/commands/run/dev/DevFileIndex.hpp>
+#include <vix/utils/Env.hpp>
 
 #include <algorithm>
 #include <chrono>
@@ -66,12 +67,16 @@ namespace vix::commands::RunCommand::dev
 
   void DevFileIndex::reset(fs::path projectDir)
   {
+    stop_watcher();
     projectDir_ = std::move(projectDir);
     files_.clear();
   }
 
   void DevFileIndex::refresh()
   {
+    // Start watching before the seed scan so that a save landing during the
+    // scan is still reported; at worst it is reported twice.
+    start_watcher();
     files_ = scan_project();
   }
 
@@ -80,7 +85,217 @@ namespace vix::commands::RunCommand::dev
     return files_.empty();
   }
 
+  bool DevFileIndex::event_driven() const
+  {
+    return watcher_ != nullptr;
+  }
+
+  std::string DevFileIndex::watch_backend() const
+  {
+    return watcher_ ? watcher_->backend() : std::string("polling");
+  }
+
+  void DevFileIndex::start_watcher()
+  {
+    stop_watcher();
+
+    std::error_code ec;
+    if (projectDir_.empty() || !fs::is_directory(projectDir_, ec) || ec)
+      return;
+
+    if (const char *env = vix::utils::vix_getenv("VIX_DEV_WATCH"); env && std::string(env) == "poll")
+      return;
+
+    vix::engine::watch::Options options;
+    options.root = projectDir_;
+    options.debounce = std::chrono::milliseconds(25);
+    options.maxBatchWindow = std::chrono::milliseconds(100);
+
+    for (const fs::directory_entry &entry :
+         fs::directory_iterator(projectDir_, fs::directory_options::skip_permission_denied, ec))
+    {
+      std::error_code entryEc;
+      if (entry.is_directory(entryEc) && !entryEc && should_skip_directory(entry.path()))
+        options.ignoredRoots.push_back(entry.path());
+    }
+
+    auto watcher = std::make_unique<vix::engine::watch::FileWatcher>(std::move(options));
+    if (!watcher->start().ok)
+      return; // keep polling
+
+    watcher_ = std::move(watcher);
+  }
+
+  void DevFileIndex::stop_watcher()
+  {
+    if (!watcher_)
+      return;
+
+    watcher_->stop();
+    watcher_.reset();
+  }
+
   std::vector<DevIndexedChange> DevFileIndex::poll_changes()
+  {
+    if (!watcher_)
+      return poll_by_rescan();
+
+    vix::engine::watch::Batch drained;
+    for (;;)
+    {
+      auto next = watcher_->wait_for_batch(std::chrono::milliseconds(0));
+      if (!next || next->empty())
+        break;
+
+      drained.overflowed = drained.overflowed || next->overflowed;
+      drained.events.insert(drained.events.end(), next->events.begin(), next->events.end());
+    }
+
+    // The kernel dropped events: nothing short of a rescan is reliable.
+    if (drained.overflowed)
+      return poll_by_rescan();
+
+    std::vector<DevIndexedChange> changes;
+    if (!drained.empty())
+      apply_event_batch(drained, changes);
+
+    return changes;
+  }
+
+  void DevFileIndex::apply_event_batch(
+      const vix::engine::watch::Batch &batch,
+      std::vector<DevIndexedChange> &changes)
+  {
+    using vix::engine::watch::EventKind;
+
+    std::unordered_map<std::string, bool> seen;
+
+    auto visit = [&](const fs::path &raw, bool directory)
+    {
+      if (raw.empty())
+        return;
+
+      const fs::path path = raw.is_absolute() ? raw : projectDir_ / raw;
+      const std::string key = path_key(path);
+      if (seen.find(key) != seen.end())
+        return;
+      seen.emplace(key, true);
+
+      if (should_skip_path(path))
+        return;
+
+      std::error_code ec;
+      if (directory || fs::is_directory(path, ec))
+        apply_directory(path, changes);
+      else
+        apply_path(path, changes);
+    };
+
+    for (const vix::engine::watch::Event &event : batch.events)
+    {
+      if (event.kind == EventKind::Overflow)
+        continue;
+
+      if (event.kind == EventKind::Renamed)
+        visit(event.oldPath, event.directory);
+
+      visit(event.path, event.directory);
+    }
+  }
+
+  void DevFileIndex::apply_path(const fs::path &path, std::vector<DevIndexedChange> &changes)
+  {
+    const std::string key = path_key(path);
+    const auto oldIt = files_.find(key);
+
+    std::optional<DevIndexedFile> next;
+    if (should_consider_file(path))
+      next = read_file_state(path);
+
+    if (!next)
+    {
+      if (oldIt == files_.end())
+        return;
+
+      changes.push_back(DevIndexedChange{
+          oldIt->second.path,
+          oldIt->second.kind,
+          fs::file_time_type::clock::now()});
+      files_.erase(oldIt);
+      return;
+    }
+
+    if (oldIt == files_.end())
+    {
+      changes.push_back(DevIndexedChange{next->path, next->kind, next->mtime});
+      files_.emplace(key, std::move(*next));
+      return;
+    }
+
+    DevIndexedFile &oldFile = oldIt->second;
+    const fs::file_time_type savedAt = next->mtime;
+
+    const bool contentChanged = oldFile.contentHash != next->contentHash;
+    if (oldFile.mtime == next->mtime && oldFile.size == next->size && !contentChanged)
+      return;
+
+    // Same reasoning as in poll_by_rescan(): make the edit visible to Ninja.
+    if (contentChanged && oldFile.mtime == next->mtime && oldFile.size == next->size)
+    {
+      std::error_code touchEc;
+      const fs::file_time_type refreshed =
+          fs::file_time_type::clock::now() + std::chrono::seconds(2);
+      fs::last_write_time(next->path, refreshed, touchEc);
+      if (!touchEc)
+        next->mtime = refreshed;
+    }
+
+    changes.push_back(DevIndexedChange{next->path, next->kind, savedAt});
+    oldFile = std::move(*next);
+  }
+
+  void DevFileIndex::apply_directory(const fs::path &dir, std::vector<DevIndexedChange> &changes)
+  {
+    // Files we knew about under this directory: covers removed and
+    // renamed-away directories, which can no longer be walked.
+    const std::string prefix = path_key(dir) + "/";
+    std::vector<fs::path> known;
+    for (const auto &[key, file] : files_)
+    {
+      if (key.compare(0, prefix.size(), prefix) == 0)
+        known.push_back(file.path);
+    }
+
+    for (const fs::path &path : known)
+      apply_path(path, changes);
+
+    std::error_code ec;
+    if (!fs::is_directory(dir, ec) || ec)
+      return;
+
+    // A directory that appeared (created or moved in) brings files that
+    // produced no events of their own.
+    for (auto it = fs::recursive_directory_iterator(
+             dir,
+             fs::directory_options::skip_permission_denied,
+             ec);
+         !ec && it != fs::recursive_directory_iterator();
+         ++it)
+    {
+      std::error_code entryEc;
+      if (it->is_directory(entryEc))
+      {
+        if (should_skip_directory(it->path()))
+          it.disable_recursion_pending();
+        continue;
+      }
+
+      if (it->is_regular_file(entryEc) && files_.find(path_key(it->path())) == files_.end())
+        apply_path(it->path(), changes);
+    }
+  }
+
+  std::vector<DevIndexedChange> DevFileIndex::poll_by_rescan()
   {
     std::vector<DevIndexedChange> changes;
 
@@ -94,7 +309,8 @@ namespace vix::commands::RunCommand::dev
       {
         changes.push_back(DevIndexedChange{
             nextFile.path,
-            nextFile.kind});
+            nextFile.kind,
+            nextFile.mtime});
         continue;
       }
 
@@ -104,6 +320,8 @@ namespace vix::commands::RunCommand::dev
       if (oldFile.mtime != nextFile.mtime || oldFile.size != nextFile.size ||
           contentChanged)
       {
+        const fs::file_time_type savedAt = nextFile.mtime;
+
         // Ninja uses timestamps to decide whether an included header requires
         // recompilation. A same-size write within a coarse timestamp tick can
         // therefore be detected by us but still be ignored by Ninja. Advance
@@ -120,7 +338,8 @@ namespace vix::commands::RunCommand::dev
         }
         changes.push_back(DevIndexedChange{
             nextFile.path,
-            nextFile.kind});
+            nextFile.kind,
+            savedAt});
       }
     }
 
@@ -130,7 +349,8 @@ namespace vix::commands::RunCommand::dev
       {
         changes.push_back(DevIndexedChange{
             oldFile.path,
-            oldFile.kind});
+            oldFile.kind,
+            fs::file_time_type::clock::now()});
       }
     }
 
@@ -205,6 +425,23 @@ namespace vix::commands::RunCommand::dev
            name == "coverage";
   }
 
+  bool DevFileIndex::should_skip_path(const fs::path &path) const
+  {
+    const fs::path relative = path.lexically_relative(projectDir_);
+    if (relative.empty() || *relative.begin() == "..")
+      return true;
+
+    // The watcher already ignores top-level build and VCS directories; nested
+    // ones (e.g. src/build) are filtered here.
+    for (const fs::path &part : relative)
+    {
+      if (should_skip_directory(part))
+        return true;
+    }
+
+    return false;
+  }
+
   bool DevFileIndex::should_consider_file(const fs::path &path) const
   {
     const std::string name = path.filename().string();
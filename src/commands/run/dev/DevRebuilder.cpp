@@ -101,7 +101,13 @@ namespace vix::commands::RunCommand::dev
   } // namespace
 
   DevRebuilder::DevRebuilder(DevRebuilderOptions options)
-      : options_(std::move(options))
+      : options_(std::move(options)),
+        buildSession_(DevBuildSessionOptions{
+            options_.projectDir,
+            options_.buildDir,
+            "all",
+            options_.runOptions.jobs,
+            options_.runOptions.verbose})
   {
   }
 
@@ -251,6 +257,80 @@ namespace vix::commands::RunCommand::dev
     return result;
   }
 
+  DevRebuilderResult DevRebuilder::rebuild_changed(
+      const std::vector<fs::path> &changedPaths)
+  {
+    const DevBuildSessionResult session = buildSession_.rebuild(changedPaths);
+
+    DevRebuilderResult result;
+    result.inProcess = true;
+
+    switch (session.status)
+    {
+    case DevBuildSessionStatus::Built:
+      result.ok = true;
+      result.built = true;
+      result.message = "Rebuilt " + std::to_string(session.rebuiltTasks) + " task(s) in-process.";
+      return result;
+
+    case DevBuildSessionStatus::UpToDate:
+      result.ok = true;
+      result.message = "Build graph unaffected.";
+      return result;
+
+    case DevBuildSessionStatus::Failed:
+    {
+      result.built = true;
+      result.exitCode = session.exitCode;
+
+      bool handled = false;
+      if (!session.output.empty())
+      {
+        handled = vix::cli::ErrorHandler::printBuildErrors(
+            session.output,
+            options_.buildDir,
+            "Build failed in dev mode");
+      }
+
+      if (!handled)
+        error("Build failed in dev mode.");
+
+      result.message = "Build failed.";
+      return result;
+    }
+
+    case DevBuildSessionStatus::Superseded:
+      result.superseded = true;
+      result.message = "Rebuild superseded by newer edits.";
+      return result;
+
+    case DevBuildSessionStatus::Unavailable:
+      break;
+    }
+
+    // Full build, with the clean that follows a watcher-confirmed change
+    // (see make_vix_dev_build_command).
+    DevRebuilderResult full = rebuild(true);
+    if (full.ok)
+      buildSession_.reload();
+    return full;
+  }
+
+  void DevRebuilder::reload_build_graph()
+  {
+    buildSession_.reload();
+  }
+
+  void DevRebuilder::cancel_stale_tasks(const std::vector<fs::path> &changedPaths)
+  {
+    buildSession_.cancel_tasks_reading(changedPaths);
+  }
+
+  void DevRebuilder::cancel_all_tasks()
+  {
+    buildSession_.cancel_all();
+  }
+
   bool DevRebuilder::has_cmake_cache() const
   {
     std::error_code ec;
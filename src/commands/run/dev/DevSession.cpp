@@ -35,6 +35,9 @@
 #include <optional>
 #include <algorithm>
 #include <fstream>
+#include <atomic>
+#include <exception>
+#include <memory>
 
 #ifndef _WIN32
 #include <fcntl.h>
@@ -64,6 +67,47 @@ namespace vix::commands::RunCommand::dev
       std::cout << "\033[2J\033[H" << std::flush;
     }
 
+#ifndef _WIN32
+    // How long a restarted app may take to send READY=1 on NOTIFY_SOCKET
+    // before the previous generation is stopped anyway.
+    constexpr std::chrono::milliseconds HANDOFF_READY_TIMEOUT{3000};
+#endif
+
+    // A rebuild running on the cpu pool, polled by the dev loop between
+    // two index polls.
+    struct PendingRebuild
+    {
+      std::atomic<bool> done{false};
+      DevRebuilderResult result;
+      std::exception_ptr error;
+    };
+
+    vix::async::core::task<void> rebuild_changed_on_pool(
+        vix::async::core::io_context &ctx,
+        DevRebuilder &rebuilder,
+        std::vector<fs::path> paths,
+        std::shared_ptr<PendingRebuild> pending)
+    {
+      // Not cancellable: a cancelled rebuild is stopped through its tasks
+      // and must still report, so the loop knows the pool is idle again.
+      try
+      {
+        pending->result = co_await ctx.cpu_pool().submit(
+            [&rebuilder, &paths]()
+            {
+              return rebuilder.rebuild_changed(paths);
+            },
+            vix::async::core::cancel_token{});
+      }
+      catch (...)
+      {
+        pending->error = std::current_exception();
+      }
+
+      pending->done.store(true, std::memory_order_release);
+      co_return;
+    }
+
     bool dev_verbose_ui(const DevSessionOptions &options)
     {
       if (options.runOptions.verbose)
@@ -113,6 +157,28 @@ namespace vix::commands::RunCommand::dev
                 << "\n\n";
     }
 
+    void print_change_latency(
+        const DevSessionOptions &options,
+        fs::file_time_type savedAt)
+    {
+      if (options.quiet || !dev_verbose_ui(options))
+        return;
+
+      const long long latencyMs =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              fs::file_time_type::clock::now() - savedAt)
+              .count();
+
+      // Files restored with an old mtime (or clock skew) say nothing useful.
+      if (latencyMs < 0 || latencyMs > 60000)
+        return;
+
+      std::cout << "  "
+                << GRAY << "latency : " << RESET
+                << latencyMs << " ms from save to rebuild start"
+                << "\n";
+    }
+
     void print_dev_started(
         int pid,
         std::optional<long long> rebuildDurationMs)
@@ -171,6 +237,46 @@ namespace vix::commands::RunCommand::dev
       return ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
     }
 
+    int dev_child_exit_code(int status)
+    {
+      if (WIFEXITED(status))
+        return WEXITSTATUS(status);
+      if (WIFSIGNALED(status))
+        return 128 + WTERMSIG(status);
+      return 0;
+    }
+
+    void report_dev_child_exit(
+        const fs::path &exePath,
+        int exitCode,
+        const std::string &runtimeLog,
+        long long lifetimeMs)
+    {
+      if (exitCode == 0)
+      {
+        success("Dev server stopped cleanly (lifetime ~" +
+                std::to_string(lifetimeMs) + "ms).");
+        return;
+      }
+
+      bool handled = false;
+
+      if (!runtimeLog.empty())
+      {
+        handled = vix::cli::errors::RawLogDetectors::handleRuntimeCrash(
+            runtimeLog,
+            exePath,
+            "Dev server exited with code " + std::to_string(exitCode));
+      }
+
+      if (!handled)
+      {
+        error("Dev server exited with code " +
+              std::to_string(exitCode) +
+              " (lifetime ~" + std::to_string(lifetimeMs) + "ms).");
+      }
+    }
+
     void drain_fd_live(int fd, std::string &out)
     {
       char buffer[4096];
@@ -223,20 +329,55 @@ namespace vix::commands::RunCommand::dev
       vix::async::core::io_context &ctx,
       vix::async::core::cancel_token ct) const
   {
-    co_await ctx.timers().sleep_for(options_.pollInterval, std::move(ct));
+    // With a kernel watcher a poll only drains its queue, so it can run
+    // often; the interval is what bounds save-to-rebuild latency.
+    const std::chrono::milliseconds interval =
+        fileIndex_.event_driven()
+            ? std::min(options_.pollInterval, std::chrono::milliseconds(25))
+            : options_.pollInterval;
+
+    co_await ctx.timers().sleep_for(interval, std::move(ct));
   }
 
   vix::async::core::task<void> DevSession::sleep_debounce_delay(
       vix::async::core::io_context &ctx,
       vix::async::core::cancel_token ct) const
   {
-    co_await ctx.timers().sleep_for(options_.debounceDelay, std::move(ct));
+    // The watcher already coalesces bursts (editor temp file + rename).
+    const std::chrono::milliseconds delay =
+        fileIndex_.event_driven()
+            ? std::min(options_.debounceDelay, std::chrono::milliseconds(50))
+            : options_.debounceDelay;
+
+    co_await ctx.timers().sleep_for(delay, std::move(ct));
+  }
+
+  void DevSession::set_pending_change(const DevIndexedChange &change)
+  {
+    pendingChangeKind_ = change.kind;
+    pendingChangeSavedAt_ = change.savedAt;
+  }
+
+  void DevSession::remember_changed_paths(const std::vector<DevIndexedChange> &changes)
+  {
+    for (const DevIndexedChange &change : changes)
+    {
+      if (!change.valid())
+        continue;
+
+      if (std::find(pendingChangedPaths_.begin(), pendingChangedPaths_.end(), change.path) ==
+          pendingChangedPaths_.end())
+      {
+        pendingChangedPaths_.push_back(change.path);
+      }
+    }
   }
 
   vix::async::core::task<DevRebuilderResult> DevSession::rebuild_async(
       vix::async::core::io_context &ctx,
       DevChangeKind kind,
-      vix::async::core::cancel_token ct) const
+      std::vector<fs::path> changedPaths,
+      vix::async::core::cancel_token ct)
   {
     if (ct.is_cancelled())
     {
@@ -247,19 +388,115 @@ namespace vix::commands::RunCommand::dev
       co_return result;
     }
 
+    if (kind == DevChangeKind::RebuildOnly)
+      co_return co_await rebuild_speculative_async(ctx, std::move(changedPaths), ct);
+
     co_return co_await ctx.cpu_pool().submit(
-        [this, kind]()
+        [this, kind, paths = std::move(changedPaths)]()
         {
           if (kind == DevChangeKind::ReconfigureAndRebuild)
           {
-            return rebuilder_.reconfigure_and_rebuild();
+            DevRebuilderResult result = rebuilder_.reconfigure_and_rebuild();
+            rebuilder_.reload_build_graph();
+            return result;
           }
 
-          return rebuilder_.rebuild(kind != DevChangeKind::Ignore);
+          if (kind == DevChangeKind::Ignore)
+          {
+            DevRebuilderResult result = rebuilder_.rebuild(false);
+            rebuilder_.reload_build_graph();
+            return result;
+          }
+
+          return rebuilder_.rebuild_changed(paths);
         },
         std::move(ct));
   }
 
+  vix::async::core::task<DevRebuilderResult> DevSession::rebuild_speculative_async(
+      vix::async::core::io_context &ctx,
+      std::vector<fs::path> changedPaths,
+      vix::async::core::cancel_token ct)
+  {
+    // Source edits are compiled from the first change event, without the
+    // debounce. The index keeps being polled while the compile runs: a newer
+    // save kills only the tasks reading the re-edited files, and the loop
+    // rebuilds again with everything that changed meanwhile.
+    while (true)
+    {
+      auto pending = std::make_shared<PendingRebuild>();
+      auto build = rebuild_changed_on_pool(ctx, rebuilder_, std::move(changedPaths), pending);
+      std::move(build).start(ctx.get_scheduler());
+
+      bool reconfigure = false;
+
+      while (!pending->done.load(std::memory_order_acquire))
+      {
+        if (ct.is_cancelled())
+        {
+          // Killed tasks end the compile quickly; keep the loop running
+          // until it reports instead of blocking it.
+          rebuilder_.cancel_all_tasks();
+          while (!pending->done.load(std::memory_order_acquire))
+            co_await ctx.timers().sleep_for(std::chrono::milliseconds(10), vix::async::core::cancel_token{});
+          break;
+        }
+
+        co_await ctx.timers().sleep_for(std::chrono::milliseconds(20), ct);
+
+        std::vector<DevIndexedChange> changes = fileIndex_.poll_changes();
+        remember_changed_paths(changes);
+
+        std::vector<fs::path> stalePaths;
+        for (const DevIndexedChange &change : changes)
+        {
+          if (!change.valid())
+            continue;
+
+          stalePaths.push_back(change.path);
+
+          if (change.kind == DevChangeKind::ReconfigureAndRebuild)
+            reconfigure = true;
+        }
+
+        if (reconfigure)
+          rebuilder_.cancel_all_tasks();
+        else if (!stalePaths.empty())
+          rebuilder_.cancel_stale_tasks(stalePaths);
+      }
+
+      if (pending->error)
+        std::rethrow_exception(pending->error);
+
+      DevRebuilderResult result = std::move(pending->result);
+
+      if (ct.is_cancelled())
+        co_return result;
+
+      if (reconfigure)
+      {
+        std::vector<fs::path> paths = std::move(pendingChangedPaths_);
+        pendingChangedPaths_.clear();
+        co_return co_await rebuild_async(
+            ctx,
+            DevChangeKind::ReconfigureAndRebuild,
+            std::move(paths),
+            ct);
+      }
+
+      // Edits that landed mid-build are rebuilt now, whether or not they
+      // cancelled anything.
+      if (pendingChangedPaths_.empty())
+        co_return result;
+
+      if (dev_verbose_ui(options_) && result.superseded)
+        hint("Rebuild superseded by newer edits; compiling again.");
+
+      changedPaths = std::move(pendingChangedPaths_);
+      pendingChangedPaths_.clear();
+    }
+  }
+
   DevIndexedChange DevSession::select_relevant_indexed_change(
       const std::vector<DevIndexedChange> &changes) const
   {
@@ -315,17 +552,24 @@ namespace vix::commands::RunCommand::dev
     while (!ct.is_cancelled())
     {
       std::vector<DevIndexedChange> changes = fileIndex_.poll_changes();
+      remember_changed_paths(changes);
 
       if (!changes.empty())
       {
         DevIndexedChange selected =
             select_relevant_indexed_change(changes);
 
+        // Source edits start compiling right away; later saves cancel
+        // what they make stale (see rebuild_speculative_async).
+        if (selected.valid() && selected.kind == DevChangeKind::RebuildOnly)
+          co_return selected;
+
         if (selected.valid())
         {
           co_await sleep_debounce_delay(ctx, ct);
 
           std::vector<DevIndexedChange> debouncedChanges = fileIndex_.poll_changes();
+          remember_changed_paths(debouncedChanges);
 
           if (!debouncedChanges.empty())
           {
@@ -341,6 +585,15 @@ namespace vix::commands::RunCommand::dev
       }
 
       co_await sleep_poll_interval(ctx, ct);
+
+#ifndef _WIN32
+      // A generation kept serving after its replacement crashed.
+      if (retiringOutputFd_ >= 0)
+      {
+        std::string retiringLog;
+        drain_fd_live(retiringOutputFd_, retiringLog);
+      }
+#endif
     }
 
     co_return DevIndexedChange{};
@@ -368,8 +621,26 @@ namespace vix::commands::RunCommand::dev
 
       ~FrontendGuard()
       {
-        if (session)
-          session->stop_vue_frontend();
+        if (!session)
+          return;
+
+        session->stop_vue_frontend();
+
+        // Normal paths retire the previous generation themselves; this only
+        // covers exceptions.
+        if (session->retiringPid_ > 0)
+        {
+          ::kill(static_cast<pid_t>(session->retiringPid_), SIGTERM);
+          int status = 0;
+          ::waitpid(static_cast<pid_t>(session->retiringPid_), &status, 0);
+          session->retiringPid_ = -1;
+        }
+
+        if (session->retiringOutputFd_ >= 0)
+        {
+          ::close(session->retiringOutputFd_);
+          session->retiringOutputFd_ = -1;
+        }
       }
     };
 
@@ -390,6 +661,31 @@ namespace vix::commands::RunCommand::dev
       }
     }
 
+    if (!options_.runOptions.listenAddresses.empty())
+    {
+      std::string listenError;
+      if (!socketHandoff_.open(options_.runOptions.listenAddresses, listenError))
+      {
+        error("Unable to open dev listening sockets.");
+        hint(listenError);
+        result.exitCode = 1;
+        result.message = listenError;
+        co_return result;
+      }
+
+      if (!options_.quiet)
+      {
+        for (const DevListenAddress &address : socketHandoff_.addresses())
+        {
+          std::cout << "  "
+                    << GRAY << "listening: " << RESET
+                    << address.to_string()
+                    << GRAY << " (kept open across restarts)" << RESET
+                    << "\n";
+        }
+      }
+    }
+
     bool fileIndexReady = false;
 
     while (!ct.is_cancelled())
@@ -397,10 +693,16 @@ namespace vix::commands::RunCommand::dev
       const DevChangeKind rebuildKind = pendingChangeKind_;
       pendingChangeKind_ = DevChangeKind::Ignore;
       const bool isRebuild = rebuildKind != DevChangeKind::Ignore;
+      std::vector<fs::path> changedPaths = std::move(pendingChangedPaths_);
+      pendingChangedPaths_.clear();
       const auto rebuildStart = std::chrono::steady_clock::now();
 
+      if (isRebuild && pendingChangeSavedAt_)
+        print_change_latency(options_, *pendingChangeSavedAt_);
+      pendingChangeSavedAt_.reset();
+
       DevRebuilderResult rebuildResult =
-          co_await rebuild_async(ctx, rebuildKind, ct);
+          co_await rebuild_async(ctx, rebuildKind, std::move(changedPaths), ct);
 
       const std::optional<long long> rebuildDurationMs = isRebuild && rebuildResult.ok
                                                               ? std::optional<long long>(
@@ -411,6 +713,8 @@ namespace vix::commands::RunCommand::dev
 
       if (ct.is_cancelled())
       {
+        co_await retire_previous_child_async(ctx, ct);
+
         result.exitCode = 130;
         result.message = "Dev session cancelled.";
         co_return result;
@@ -418,6 +722,10 @@ namespace vix::commands::RunCommand::dev
 
       if (!rebuildResult.ok)
       {
+        // Nothing new to hand the sockets to: stop the previous generation
+        // as a plain restart would have.
+        co_await retire_previous_child_async(ctx, ct);
+
         hint("Fix the errors, save your files, and Vix will rebuild automatically.");
 
         fileIndex_.refresh();
@@ -433,7 +741,7 @@ namespace vix::commands::RunCommand::dev
           co_return result;
         }
 
-        pendingChangeKind_ = change.kind;
+        set_pending_change(change);
         continue;
       }
 
@@ -441,6 +749,8 @@ namespace vix::commands::RunCommand::dev
 
       if (!exePath)
       {
+        co_await retire_previous_child_async(ctx, ct);
+
         if (!fileIndexReady)
         {
           fileIndex_.refresh();
@@ -464,7 +774,7 @@ namespace vix::commands::RunCommand::dev
           co_return result;
         }
 
-        pendingChangeKind_ = change.kind;
+        set_pending_change(change);
         continue;
       }
 
@@ -875,6 +1185,8 @@ namespace vix::commands::RunCommand::dev
 
     argv.push_back(nullptr);
 
+    socketHandoff_.prepare_child();
+
     ::execv(argv[0], argv.data());
 
     std::cerr << "[vix][run] execv failed: " << std::strerror(errno) << "\n";
@@ -904,12 +1216,16 @@ namespace vix::commands::RunCommand::dev
           DevChildExitReason::Exited};
     }
 
+    socketHandoff_.discard_notifications();
+
     pid_t pid = ::fork();
     if (pid < 0)
     {
       ::close(outputPipe[0]);
       ::close(outputPipe[1]);
 
+      co_await retire_previous_child_async(ctx, ct);
+
       error("Failed to fork() for dev process.");
 
       co_return DevChildRunResult{
@@ -937,6 +1253,39 @@ namespace vix::commands::RunCommand::dev
     if (!options_.quiet)
       print_dev_started(static_cast<int>(pid), rebuildDurationMs);
 
+    if (retiringPid_ > 0 &&
+        !co_await hand_over_to_child_async(ctx, static_cast<int>(pid), outputPipe[0], runtimeLog, ct))
+    {
+      // The new generation died before it was ready: the previous one
+      // keeps the sockets and serves until the next change builds.
+      int status = 0;
+      (void)wait_child_nonblocking(pid, status);
+      drain_fd_live(outputPipe[0], runtimeLog);
+      ::close(outputPipe[0]);
+
+      const long long ms =
+          std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - childStart).count();
+      report_dev_child_exit(exePath, dev_child_exit_code(status), runtimeLog, ms);
+      hint("The previous process (pid " + std::to_string(retiringPid_) +
+           ") keeps serving. Save your files to try again.");
+
+      const DevIndexedChange change = co_await wait_for_indexed_change_async(ctx, ct);
+      if (!change.valid())
+      {
+        co_await retire_previous_child_async(ctx, ct);
+
+        co_return DevChildRunResult{
+            130,
+            DevChildExitReason::Cancelled};
+      }
+
+      set_pending_change(change);
+
+      co_return DevChildRunResult{
+          0,
+          DevChildExitReason::RestartRequested};
+    }
+
     // Do not make the first observable child output wait for a complete file
     // polling period. File indexing remains at pollInterval; this short,
     // one-off drain only removes startup/restart output latency.
@@ -949,24 +1298,47 @@ namespace vix::commands::RunCommand::dev
       drain_fd_live(outputPipe[0], runtimeLog);
 
       std::vector<DevIndexedChange> indexedChanges = fileIndex_.poll_changes();
+      remember_changed_paths(indexedChanges);
 
       if (!indexedChanges.empty())
       {
-        co_await sleep_debounce_delay(ctx, ct);
+        DevIndexedChange selected =
+            select_relevant_indexed_change(indexedChanges);
 
-        std::vector<DevIndexedChange> debouncedChanges = fileIndex_.poll_changes();
+        if (selected.kind != DevChangeKind::RebuildOnly)
+        {
+          co_await sleep_debounce_delay(ctx, ct);
 
-        if (debouncedChanges.empty())
-          debouncedChanges = std::move(indexedChanges);
+          std::vector<DevIndexedChange> debouncedChanges = fileIndex_.poll_changes();
+          remember_changed_paths(debouncedChanges);
 
-        DevIndexedChange selected =
-            select_relevant_indexed_change(debouncedChanges);
+          if (!debouncedChanges.empty())
+          {
+            DevIndexedChange debouncedSelected =
+                select_relevant_indexed_change(debouncedChanges);
+
+            if (debouncedSelected.valid())
+              selected = debouncedSelected;
+          }
+        }
 
         if (!selected.valid())
           continue;
 
         print_reload_for_change(selected);
-        pendingChangeKind_ = selected.kind;
+        set_pending_change(selected);
+
+        if (socketHandoff_.active())
+        {
+          // Keep this generation serving through the rebuild; it is
+          // stopped once the next one is ready.
+          retiringPid_ = static_cast<int>(pid);
+          retiringOutputFd_ = outputPipe[0];
+
+          co_return DevChildRunResult{
+              0,
+              DevChildExitReason::RestartRequested};
+        }
 
         co_await terminate_and_wait_child_async(
             ctx,
@@ -992,40 +1364,12 @@ namespace vix::commands::RunCommand::dev
                 childEnd - childStart)
                 .count();
 
-        int exitCode = 0;
-
-        if (WIFEXITED(status))
-          exitCode = WEXITSTATUS(status);
-        else if (WIFSIGNALED(status))
-          exitCode = 128 + WTERMSIG(status);
+        const int exitCode = dev_child_exit_code(status);
 
         drain_fd_live(outputPipe[0], runtimeLog);
         ::close(outputPipe[0]);
 
-        if (exitCode != 0)
-        {
-          bool handled = false;
-
-          if (!runtimeLog.empty())
-          {
-            handled = vix::cli::errors::RawLogDetectors::handleRuntimeCrash(
-                runtimeLog,
-                exePath,
-                "Dev server exited with code " + std::to_string(exitCode));
-          }
-
-          if (!handled)
-          {
-            error("Dev server exited with code " +
-                  std::to_string(exitCode) +
-                  " (lifetime ~" + std::to_string(ms) + "ms).");
-          }
-        }
-        else
-        {
-          success("Dev server stopped cleanly (lifetime ~" +
-                  std::to_string(ms) + "ms).");
-        }
+        report_dev_child_exit(exePath, exitCode, runtimeLog, ms);
 
         co_return DevChildRunResult{
             exitCode,
@@ -1033,6 +1377,8 @@ namespace vix::commands::RunCommand::dev
       }
     }
 
+    co_await retire_previous_child_async(ctx, ct);
+
     co_await terminate_and_wait_child_async(
         ctx,
         static_cast<int>(pid),
@@ -1043,6 +1389,87 @@ namespace vix::commands::RunCommand::dev
         DevChildExitReason::Cancelled};
   }
 
+  vix::async::core::task<bool> DevSession::hand_over_to_child_async(
+      vix::async::core::io_context &ctx,
+      int pid,
+      int outputFd,
+      std::string &runtimeLog,
+      vix::async::core::cancel_token ct)
+  {
+    using Clock = std::chrono::steady_clock;
+
+    const auto start = Clock::now();
+    const auto deadline = start + HANDOFF_READY_TIMEOUT;
+
+    // Both generations accept on the shared sockets meanwhile, so clients
+    // are served whichever one picks their connection up.
+    std::string retiringLog;
+    bool ready = false;
+    bool exited = false;
+
+    while (!ct.is_cancelled() && Clock::now() < deadline)
+    {
+      drain_fd_live(retiringOutputFd_, retiringLog);
+      drain_fd_live(outputFd, runtimeLog);
+
+      if (socketHandoff_.poll_ready())
+      {
+        ready = true;
+        break;
+      }
+
+      // Peek only: the caller's waitpid() reports the exit.
+      siginfo_t info{};
+      if (::waitid(P_PID, static_cast<id_t>(pid), &info, WEXITED | WNOHANG | WNOWAIT) == 0 &&
+          info.si_pid == static_cast<pid_t>(pid))
+      {
+        exited = true;
+        break;
+      }
+
+      co_await ctx.timers().sleep_for(std::chrono::milliseconds(20), ct);
+    }
+
+    if (!options_.quiet && dev_verbose_ui(options_) && !exited)
+    {
+      const long long ms =
+          std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+
+      std::cout << "  "
+                << GRAY << "handoff : " << RESET
+                << (ready ? "new process ready after " : "no READY=1 from new process after ")
+                << ms << " ms, stopping pid " << retiringPid_
+                << "\n";
+    }
+
+    // A replacement that died is no replacement: keep the previous one.
+    if (exited)
+      co_return false;
+
+    co_await retire_previous_child_async(ctx, ct);
+    co_return true;
+  }
+
+  vix::async::core::task<void> DevSession::retire_previous_child_async(
+      vix::async::core::io_context &ctx,
+      vix::async::core::cancel_token ct)
+  {
+    if (retiringPid_ > 0)
+    {
+      const int pid = retiringPid_;
+      retiringPid_ = -1;
+      co_await terminate_and_wait_child_async(ctx, pid, ct);
+    }
+
+    if (retiringOutputFd_ >= 0)
+    {
+      std::string ignored;
+      drain_fd_live(retiringOutputFd_, ignored);
+      ::close(retiringOutputFd_);
+      retiringOutputFd_ = -1;
+    }
+  }
+
   vix::async::core::task<void> DevSession::terminate_and_wait_child_async(
       vix::async::core::io_context &ctx,
       int pid,
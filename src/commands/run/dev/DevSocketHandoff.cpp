@@ -0,0 +1,423 @@
+/**
+ *
+ *  @file DevSocketHandoff.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2026, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ *  Dev mode listening-socket handoff
+ *
+ */
+
+#include <vix/cli/commands/run/dev/DevSocketHandoff.hpp>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace vix::commands::RunCommand::dev
+{
+  namespace
+  {
+    constexpr int FIRST_LISTEN_FD = 3; // SD_LISTEN_FDS_START
+
+    bool parse_port(const std::string &text, int &port)
+    {
+      if (text.empty() || text.size() > 5)
+        return false;
+
+      int value = 0;
+      for (const char c : text)
+      {
+        if (c < '0' || c > '9')
+          return false;
+        value = value * 10 + (c - '0');
+      }
+
+      if (value <= 0 || value > 65535)
+        return false;
+
+      port = value;
+      return true;
+    }
+
+#ifndef _WIN32
+    void set_cloexec(int fd)
+    {
+      const int flags = ::fcntl(fd, F_GETFD, 0);
+      if (flags >= 0)
+        (void)::fcntl(fd, F_SETFD, flags | FD_CLOEXEC);
+    }
+
+    int bind_listener(const DevListenAddress &address, std::string &err)
+    {
+      addrinfo hints{};
+      hints.ai_family = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+      hints.ai_flags = AI_PASSIVE;
+
+      addrinfo *results = nullptr;
+      const std::string service = std::to_string(address.port);
+      const int rc = ::getaddrinfo(
+          address.host.empty() ? nullptr : address.host.c_str(),
+          service.c_str(),
+          &hints,
+          &results);
+
+      if (rc != 0)
+      {
+        err = std::string("cannot resolve ") + address.to_string() + ": " + ::gai_strerror(rc);
+        return -1;
+      }
+
+      // Prefer IPv6 with dual-stack for the wildcard address so that both
+      // localhost and 127.0.0.1 reach the app.
+      int fd = -1;
+      int lastErrno = 0;
+      for (int pass = 0; pass < 2 && fd < 0; ++pass)
+      {
+        for (addrinfo *ai = results; ai != nullptr; ai = ai->ai_next)
+        {
+          const bool v6 = ai->ai_family == AF_INET6;
+          if ((pass == 0) != v6)
+            continue;
+
+          const int candidate = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+          if (candidate < 0)
+          {
+            lastErrno = errno;
+            continue;
+          }
+
+          set_cloexec(candidate);
+
+          const int on = 1;
+          (void)::setsockopt(candidate, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+          if (v6 && address.host.empty())
+          {
+            const int off = 0;
+            (void)::setsockopt(candidate, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+          }
+
+          if (::bind(candidate, ai->ai_addr, ai->ai_addrlen) == 0 &&
+              ::listen(candidate, SOMAXCONN) == 0)
+          {
+            fd = candidate;
+            break;
+          }
+
+          lastErrno = errno;
+          ::close(candidate);
+        }
+      }
+
+      ::freeaddrinfo(results);
+
+      if (fd < 0)
+        err = "cannot listen on " + address.to_string() + ": " + std::strerror(lastErrno);
+
+      return fd;
+    }
+#endif
+  } // namespace
+
+  std::string DevListenAddress::to_string() const
+  {
+    if (host.empty())
+      return "*:" + std::to_string(port);
+
+    if (host.find(':') != std::string::npos)
+      return "[" + host + "]:" + std::to_string(port);
+
+    return host + ":" + std::to_string(port);
+  }
+
+  bool parse_listen_address(
+      const std::string &spec,
+      DevListenAddress &out,
+      std::string &err)
+  {
+    DevListenAddress address;
+    std::string portText = spec;
+
+    if (!spec.empty() && spec.front() == '[')
+    {
+      const std::size_t close = spec.find(']');
+      if (close == std::string::npos || close + 1 >= spec.size() || spec[close + 1] != ':')
+      {
+        err = "invalid listen address: " + spec;
+        return false;
+      }
+
+      address.host = spec.substr(1, close - 1);
+      portText = spec.substr(close + 2);
+    }
+    else if (const std::size_t colon = spec.rfind(':'); colon != std::string::npos)
+    {
+      if (spec.find(':') != colon)
+      {
+        err = "IPv6 addresses must be bracketed: " + spec;
+        return false;
+      }
+
+      address.host = spec.substr(0, colon);
+      portText = spec.substr(colon + 1);
+    }
+
+    if (!parse_port(portText, address.port))
+    {
+      err = "invalid listen port: " + spec;
+      return false;
+    }
+
+    out = address;
+    return true;
+  }
+
+  DevSocketHandoff::~DevSocketHandoff()
+  {
+    close();
+  }
+
+  bool DevSocketHandoff::active() const
+  {
+    return !fds_.empty();
+  }
+
+  const std::vector<DevListenAddress> &DevSocketHandoff::addresses() const
+  {
+    return addresses_;
+  }
+
+#ifndef _WIN32
+  bool DevSocketHandoff::open(const std::vector<std::string> &specs, std::string &err)
+  {
+    close();
+
+    for (const std::string &spec : specs)
+    {
+      DevListenAddress address;
+      if (!parse_listen_address(spec, address, err))
+      {
+        close();
+        return false;
+      }
+
+      const int fd = bind_listener(address, err);
+      if (fd < 0)
+      {
+        close();
+        return false;
+      }
+
+      addresses_.push_back(address);
+      fds_.push_back(fd);
+    }
+
+    if (!fds_.empty() && !open_notify_socket())
+    {
+      err = std::string("cannot create readiness socket: ") + std::strerror(errno);
+      close();
+      return false;
+    }
+
+    return true;
+  }
+
+  void DevSocketHandoff::close()
+  {
+    for (const int fd : fds_)
+      ::close(fd);
+
+    fds_.clear();
+    addresses_.clear();
+
+    if (notifyFd_ >= 0)
+    {
+      ::close(notifyFd_);
+      notifyFd_ = -1;
+    }
+
+    if (!notifyPath_.empty())
+    {
+      ::unlink(notifyPath_.c_str());
+      notifyPath_.clear();
+    }
+  }
+
+  bool DevSocketHandoff::open_notify_socket()
+  {
+    std::error_code ec;
+    std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+    if (ec)
+      dir = "/tmp";
+
+    const std::string path =
+        (dir / ("vix-dev-" + std::to_string(::getpid()) + ".notify")).string();
+
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path))
+    {
+      errno = ENAMETOOLONG;
+      return false;
+    }
+
+    const int fd = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (fd < 0)
+      return false;
+
+    set_cloexec(fd);
+    (void)::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+      const int saved = errno;
+      ::close(fd);
+      errno = saved;
+      return false;
+    }
+
+    notifyFd_ = fd;
+    notifyPath_ = path;
+    return true;
+  }
+
+  void DevSocketHandoff::prepare_child() const
+  {
+    if (fds_.empty())
+      return;
+
+    const int count = static_cast<int>(fds_.size());
+
+    // Targets 3..3+count-1 may hold other sockets of ours: move everything
+    // above that range first, then down into place. dup2() clears
+    // FD_CLOEXEC on the target, so exactly these fds survive exec().
+    std::vector<int> moved;
+    moved.reserve(fds_.size());
+    for (const int fd : fds_)
+      moved.push_back(::fcntl(fd, F_DUPFD, FIRST_LISTEN_FD + count));
+
+    for (int i = 0; i < count; ++i)
+    {
+      if (moved[static_cast<std::size_t>(i)] < 0)
+        continue;
+
+      ::dup2(moved[static_cast<std::size_t>(i)], FIRST_LISTEN_FD + i);
+      ::close(moved[static_cast<std::size_t>(i)]);
+    }
+
+    std::string names;
+    for (int i = 0; i < count; ++i)
+    {
+      if (i > 0)
+        names += ':';
+      names += "vix-dev";
+    }
+
+    ::setenv("LISTEN_FDS", std::to_string(count).c_str(), 1);
+    ::setenv("LISTEN_PID", std::to_string(::getpid()).c_str(), 1);
+    ::setenv("LISTEN_FDNAMES", names.c_str(), 1);
+
+    if (!notifyPath_.empty())
+      ::setenv("NOTIFY_SOCKET", notifyPath_.c_str(), 1);
+  }
+
+  void DevSocketHandoff::discard_notifications() const
+  {
+    if (notifyFd_ < 0)
+      return;
+
+    char buffer[512];
+    while (::recv(notifyFd_, buffer, sizeof(buffer), 0) > 0)
+    {
+    }
+  }
+
+  bool DevSocketHandoff::poll_ready() const
+  {
+    if (notifyFd_ < 0)
+      return false;
+
+    bool ready = false;
+    char buffer[4096];
+
+    while (true)
+    {
+      const ssize_t n = ::recv(notifyFd_, buffer, sizeof(buffer) - 1, 0);
+      if (n <= 0)
+        break;
+
+      // sd_notify payload: newline-separated assignments.
+      const std::string message(buffer, static_cast<std::size_t>(n));
+      std::size_t pos = 0;
+      while (pos < message.size())
+      {
+        std::size_t end = message.find('\n', pos);
+        if (end == std::string::npos)
+          end = message.size();
+
+        if (message.compare(pos, end - pos, "READY=1") == 0)
+          ready = true;
+
+        pos = end + 1;
+      }
+    }
+
+    return ready;
+  }
+#else
+  bool DevSocketHandoff::open(const std::vector<std::string> &specs, std::string &err)
+  {
+    if (specs.empty())
+      return true;
+
+    err = "--listen is not supported on Windows";
+    return false;
+  }
+
+  void DevSocketHandoff::close()
+  {
+  }
+
+  bool DevSocketHandoff::open_notify_socket()
+  {
+    return false;
+  }
+
+  void DevSocketHandoff::prepare_child() const
+  {
+  }
+
+  void DevSocketHandoff::discard_notifications() const
+  {
+  }
+
+  bool DevSocketHandoff::poll_ready() const
+  {
+    return false;
+  }
+#endif
+
+} // namespace vix::commands::RunCommand::dev
@@ -0,0 +1,378 @@
+/**
+ *
+ *  @file TestsCache.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/tests/TestsCache.hpp>
+#include <vix/cli/util/Fs.hpp>
+#include <vix/cli/util/Hash.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <system_error>
+#include <unordered_set>
+
+#include <nlohmann/json.hpp>
+
+namespace vix::commands::TestsCommand::detail
+{
+  namespace
+  {
+    using json = nlohmann::json;
+
+    constexpr int CACHE_FORMAT_VERSION = 1;
+    constexpr std::uint64_t TEST_CACHE_FNV_OFFSET = 1469598103934665603ull;
+
+    bool is_shared_library(const std::string &path)
+    {
+      const std::string name = fs::path(path).filename().string();
+      const std::string ext = fs::path(path).extension().string();
+
+      return ext == ".so" || ext == ".dylib" || ext == ".dll" ||
+             name.find(".so.") != std::string::npos;
+    }
+
+    std::vector<std::string> split_env_names(const std::string &text)
+    {
+      std::vector<std::string> names;
+      std::string current;
+
+      for (const char c : text)
+      {
+        if (c == ',' || c == ':' || c == ' ')
+        {
+          if (!current.empty())
+            names.push_back(current);
+          current.clear();
+          continue;
+        }
+
+        current += c;
+      }
+
+      if (!current.empty())
+        names.push_back(current);
+
+      return names;
+    }
+  } // namespace
+
+  std::vector<std::string> test_cache_env_allowlist()
+  {
+    std::vector<std::string> names = {"TZ", "LANG", "LC_ALL"};
+
+    if (const char *extra = std::getenv("VIX_TEST_CACHE_ENV"))
+    {
+      for (const std::string &name : split_env_names(extra))
+        names.push_back(name);
+    }
+
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    return names;
+  }
+
+  SharedLibraryIndex::SharedLibraryIndex(const std::vector<ImpactEdge> &edges)
+  {
+    for (const ImpactEdge &edge : edges)
+    {
+      for (const std::string &output : edge.outputs)
+      {
+        std::vector<std::string> &inputs = inputsByOutput_[output];
+        inputs.insert(inputs.end(), edge.inputs.begin(), edge.inputs.end());
+      }
+    }
+  }
+
+  std::vector<fs::path> SharedLibraryIndex::libraries_of(const std::string &binary) const
+  {
+    std::vector<fs::path> libraries;
+    std::unordered_set<std::string> visited{binary};
+    std::vector<std::string> pending{binary};
+
+    while (!pending.empty())
+    {
+      const std::string current = std::move(pending.back());
+      pending.pop_back();
+
+      const auto it = inputsByOutput_.find(current);
+      if (it == inputsByOutput_.end())
+        continue;
+
+      for (const std::string &input : it->second)
+      {
+        if (!visited.insert(input).second)
+          continue;
+
+        if (is_shared_library(input))
+          libraries.push_back(fs::path(input));
+
+        pending.push_back(input);
+      }
+    }
+
+    std::sort(libraries.begin(), libraries.end());
+    return libraries;
+  }
+
+  fs::path TestResultCache::default_path(const fs::path &buildDir)
+  {
+    return buildDir / ".vix" / "test-cache.json";
+  }
+
+  bool TestResultCache::load(const fs::path &path)
+  {
+    entries_.clear();
+    files_.clear();
+    usedFiles_.clear();
+
+    const std::string text = vix::cli::util::read_text_file_or_empty(path);
+    if (text.empty())
+      return false;
+
+    const json doc = json::parse(text, nullptr, false);
+    if (!doc.is_object() || doc.value("version", 0) != CACHE_FORMAT_VERSION)
+      return false;
+
+    if (doc.contains("tests") && doc["tests"].is_object())
+    {
+      for (const auto &[name, value] : doc["tests"].items())
+      {
+        if (!value.is_object())
+          continue;
+
+        Entry entry;
+        entry.key = value.value("key", std::string{});
+        entry.status = value.value("status", std::string{});
+        entry.seconds = value.value("seconds", 0.0);
+
+        if (!entry.key.empty())
+          entries_[name] = entry;
+      }
+    }
+
+    if (doc.contains("files") && doc["files"].is_object())
+    {
+      for (const auto &[file, value] : doc["files"].items())
+      {
+        if (!value.is_object())
+          continue;
+
+        FileStamp stamp;
+        stamp.size = value.value("size", std::uintmax_t{0});
+        stamp.mtime = value.value("mtime", 0LL);
+        stamp.hash = value.value("hash", std::string{});
+
+        if (!stamp.hash.empty())
+          files_[file] = stamp;
+      }
+    }
+
+    return true;
+  }
+
+  bool TestResultCache::save(const fs::path &path) const
+  {
+    json tests = json::object();
+    for (const auto &[name, entry] : entries_)
+    {
+      tests[name] = json{
+          {"key", entry.key},
+          {"status", entry.status},
+          {"seconds", entry.seconds}};
+    }
+
+    // Only files hashed by this run: stamps of removed binaries drop out.
+    json files = json::object();
+    for (const auto &[file, stamp] : files_)
+    {
+      if (usedFiles_.count(file) == 0)
+        continue;
+
+      files[file] = json{
+          {"size", stamp.size},
+          {"mtime", stamp.mtime},
+          {"hash", stamp.hash}};
+    }
+
+    const json doc{
+        {"version", CACHE_FORMAT_VERSION},
+        {"tests", std::move(tests)},
+        {"files", std::move(files)}};
+
+    return vix::cli::util::write_text_file_atomic(path, doc.dump(2) + "\n");
+  }
+
+  std::optional<std::string> TestResultCache::file_hash(const fs::path &path)
+  {
+    std::error_code ec;
+    const std::uintmax_t size = fs::file_size(path, ec);
+    if (ec)
+      return std::nullopt;
+
+    const auto time = fs::last_write_time(path, ec);
+    if (ec)
+      return std::nullopt;
+
+    const long long mtime = static_cast<long long>(time.time_since_epoch().count());
+    const std::string key = path.generic_string();
+    usedFiles_.insert(key);
+
+    const auto it = files_.find(key);
+    if (it != files_.end() && it->second.size == size && it->second.mtime == mtime)
+      return it->second.hash;
+
+    const auto hash = vix::cli::util::read_file_hash_hex(path);
+    if (!hash)
+      return std::nullopt;
+
+    files_[key] = FileStamp{size, mtime, *hash};
+    return hash;
+  }
+
+  std::optional<std::string> TestResultCache::key_for(
+      const TestJob &job,
+      const std::vector<fs::path> &libraries,
+      const std::vector<std::string> &envAllowlist)
+  {
+    if (job.command.empty())
+      return std::nullopt;
+
+    std::string material = "vix-test-cache-v1\n";
+    material += "name=" + job.name + "\n";
+
+    for (const std::string &arg : job.command)
+      material += "arg=" + arg + "\n";
+
+    // The test program and every file it is handed on its command line.
+    for (std::size_t i = 0; i < job.command.size(); ++i)
+    {
+      const fs::path path(job.command[i]);
+      std::error_code ec;
+
+      if (!path.is_absolute() || !fs::is_regular_file(path, ec))
+      {
+        if (i == 0 && job.command[i].find('/') != std::string::npos)
+          return std::nullopt;
+        continue;
+      }
+
+      const auto hash = file_hash(path);
+      if (!hash)
+        return std::nullopt;
+
+      material += "file=" + path.generic_string() + ":" + *hash + "\n";
+    }
+
+    for (const fs::path &library : libraries)
+    {
+      const auto hash = file_hash(library);
+      if (!hash)
+        return std::nullopt;
+
+      material += "lib=" + library.generic_string() + ":" + *hash + "\n";
+    }
+
+    material += "cwd=" + job.workingDirectory.generic_string() + "\n";
+
+    for (const std::string &entry : job.environment)
+      material += "env=" + entry + "\n";
+
+    for (const std::string &name : envAllowlist)
+    {
+      const char *value = std::getenv(name.c_str());
+      material += "host=" + name + (value ? "=" + std::string(value) : std::string{}) + "\n";
+    }
+
+    for (const fs::path &required : job.requiredFiles)
+    {
+      std::error_code ec;
+
+      if (fs::is_regular_file(required, ec))
+      {
+        const auto hash = file_hash(required);
+        if (!hash)
+          return std::nullopt;
+
+        material += "data=" + required.generic_string() + ":" + *hash + "\n";
+        continue;
+      }
+
+      if (!fs::is_directory(required, ec))
+      {
+        material += "data=" + required.generic_string() + ":missing\n";
+        continue;
+      }
+
+      std::vector<fs::path> files;
+      for (fs::recursive_directory_iterator it(required, ec), end; !ec && it != end; it.increment(ec))
+      {
+        if (it->is_regular_file(ec))
+          files.push_back(it->path());
+      }
+
+      if (ec)
+        return std::nullopt;
+
+      std::sort(files.begin(), files.end());
+
+      for (const fs::path &file : files)
+      {
+        const auto hash = file_hash(file);
+        if (!hash)
+          return std::nullopt;
+
+        material += "data=" + file.generic_string() + ":" + *hash + "\n";
+      }
+    }
+
+    return vix::cli::util::hex64(vix::cli::util::fnv1a64_str(material, TEST_CACHE_FNV_OFFSET));
+  }
+
+  std::optional<double> TestResultCache::cached_pass(
+      const std::string &name,
+      const std::string &key) const
+  {
+    const auto it = entries_.find(name);
+    if (it == entries_.end() || it->second.key != key || it->second.status != "passed")
+      return std::nullopt;
+
+    return it->second.seconds;
+  }
+
+  void TestResultCache::record(
+      const std::string &name,
+      const std::string &key,
+      const TestJobResult &result)
+  {
+    // A skip depends on the machine, not on the test's inputs.
+    if (!result.ran || result.skipped)
+      return;
+
+    Entry &entry = entries_[name];
+    const bool sameKey = entry.key == key;
+
+    if (!result.passed)
+    {
+      entry = Entry{key, "failed", result.seconds};
+      return;
+    }
+
+    // Same inputs, different outcome: never trust this key again.
+    if (sameKey && (entry.status == "failed" || entry.status == "flaky"))
+    {
+      entry.status = "flaky";
+      return;
+    }
+
+    entry = Entry{key, "passed", result.seconds};
+  }
+}
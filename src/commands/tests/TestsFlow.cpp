@@ -12,8 +12,11 @@
  *
  */
 #include <vix/cli/commands/tests/TestsDetail.hpp>
+#include <vix/cli/commands/tests/TestsShard.hpp>
 
 #include <filesystem>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <system_error>
@@ -55,6 +58,28 @@ namespace vix::commands::TestsCommand::detail
     return canon;
   }
 
+  // "--flag value" or "--flag=value"; advances @p i past a separate value.
+  static std::optional<std::string> flag_value(
+      const std::vector<std::string> &args,
+      std::size_t &i,
+      const std::string &flag)
+  {
+    const std::string &a = args[i];
+
+    if (a == flag)
+    {
+      if (i + 1 >= args.size())
+        throw std::invalid_argument(flag + " needs a value");
+
+      return args[++i];
+    }
+
+    if (a.rfind(flag + "=", 0) == 0)
+      return a.substr(flag.size() + 1);
+
+    return std::nullopt;
+  }
+
   Options parse(const std::vector<std::string> &args)
   {
     Options opt{};
@@ -74,7 +99,10 @@ namespace vix::commands::TestsCommand::detail
       }
 
       if (afterSep)
+      {
         opt.ctestArgs.push_back(a);
+        opt.ctestPassthrough = true;
+      }
       else
         left.push_back(a);
     }
@@ -110,6 +138,70 @@ namespace vix::commands::TestsCommand::detail
         opt.raw = true;
         continue;
       }
+      if (a == "--affected")
+      {
+        opt.affected = true;
+        continue;
+      }
+
+      constexpr const char affectedPrefix[] = "--affected=";
+      if (a.rfind(affectedPrefix, 0) == 0)
+      {
+        opt.affected = true;
+        opt.affectedRev = a.substr(sizeof(affectedPrefix) - 1);
+        continue;
+      }
+
+      if (a == "--no-test-cache")
+      {
+        opt.noTestCache = true;
+        continue;
+      }
+
+      if (a == "--explain")
+      {
+        opt.explain = true;
+        continue;
+      }
+      if (auto value = flag_value(left, i, "--shard"))
+      {
+        const auto spec = parse_shard_spec(*value);
+        if (!spec)
+          throw std::invalid_argument("--shard expects i/n with 1 <= i <= n, got '" + *value + "'");
+
+        opt.shardIndex = spec->index;
+        opt.shardCount = spec->count;
+        continue;
+      }
+
+      if (a == "--shard-report")
+      {
+        opt.shardReportCount = -1; // count taken from --shard
+        continue;
+      }
+
+      if (auto value = flag_value(left, i, "--shard-report"))
+      {
+        const auto spec = parse_shard_spec("1/" + *value);
+        if (!spec)
+          throw std::invalid_argument("--shard-report expects a shard count, got '" + *value + "'");
+
+        opt.shardReportCount = spec->count;
+        continue;
+      }
+
+      if (auto value = flag_value(left, i, "--report"))
+      {
+        opt.reportPath = fs::absolute(*value);
+        continue;
+      }
+
+      if (auto value = flag_value(left, i, "--durations"))
+      {
+        opt.durationsPath = fs::absolute(*value);
+        continue;
+      }
+
       if (a == "--test" || a == "-R")
       {
         if (i + 1 < left.size())
@@ -157,6 +249,55 @@ namespace vix::commands::TestsCommand::detail
     if (opt.runAfter)
       opt.forwarded.push_back("--run");
 
+    if (opt.shardReportCount < 0)
+    {
+      if (opt.shardCount == 0)
+        throw std::invalid_argument("--shard-report needs a count: --shard-report=<n> or --shard i/n");
+
+      opt.shardReportCount = opt.shardCount;
+    }
+
+    return opt;
+  }
+
+  MergeOptions parse_merge(const std::vector<std::string> &args)
+  {
+    MergeOptions opt{};
+
+    for (std::size_t i = 0; i < args.size(); ++i)
+    {
+      const std::string &a = args[i];
+
+      if (auto value = flag_value(args, i, "--junit"))
+      {
+        opt.junitPath = fs::absolute(*value);
+        continue;
+      }
+
+      if (auto value = flag_value(args, i, "--json"))
+      {
+        opt.jsonPath = fs::absolute(*value);
+        continue;
+      }
+
+      if (auto value = flag_value(args, i, "--durations"))
+      {
+        opt.durationsPath = fs::absolute(*value);
+        continue;
+      }
+
+      if (!a.empty() && a[0] == '-')
+        throw std::invalid_argument("unknown option " + a);
+
+      opt.inputs.push_back(fs::absolute(a));
+    }
+
+    if (opt.inputs.empty())
+      throw std::invalid_argument("no shard reports given");
+
+    if (opt.junitPath.empty() && opt.jsonPath.empty() && opt.durationsPath.empty())
+      throw std::invalid_argument("nothing to write: pass --junit, --json or --durations");
+
     return opt;
   }
 
@@ -0,0 +1,771 @@
+/**
+ *
+ *  @file TestsImpact.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/tests/TestsImpact.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace vix::commands::TestsCommand::detail
+{
+  namespace
+  {
+    enum class NinjaToken
+    {
+      Word,
+      Colon,
+      Pipe,
+      OrderOnly,
+      Validation
+    };
+
+    std::vector<std::string> ninja_logical_lines(const std::string &text)
+    {
+      std::vector<std::string> lines;
+      std::string current;
+
+      std::istringstream in(text);
+      std::string line;
+
+      while (std::getline(in, line))
+      {
+        if (!line.empty() && line.back() == '\r')
+          line.pop_back();
+
+        // A trailing "$" continues the statement; "$$" is a literal dollar.
+        std::size_t dollars = 0;
+        while (dollars < line.size() && line[line.size() - 1 - dollars] == '$')
+          ++dollars;
+
+        if (dollars % 2 == 1)
+        {
+          line.pop_back();
+          current += line;
+
+          // Leading whitespace of the continued line is not significant.
+          while (in.peek() == ' ' || in.peek() == '\t')
+            in.get();
+
+          continue;
+        }
+
+        current += line;
+        lines.push_back(std::move(current));
+        current.clear();
+      }
+
+      if (!current.empty())
+        lines.push_back(std::move(current));
+
+      return lines;
+    }
+
+    std::vector<std::pair<NinjaToken, std::string>> tokenize_ninja_build(
+        const std::string &statement)
+    {
+      std::vector<std::pair<NinjaToken, std::string>> tokens;
+
+      std::size_t i = 0;
+      const std::size_t n = statement.size();
+
+      while (i < n)
+      {
+        const char c = statement[i];
+
+        if (c == ' ' || c == '\t')
+        {
+          ++i;
+          continue;
+        }
+
+        if (c == ':')
+        {
+          tokens.emplace_back(NinjaToken::Colon, std::string{});
+          ++i;
+          continue;
+        }
+
+        if (c == '|')
+        {
+          if (i + 1 < n && statement[i + 1] == '|')
+          {
+            tokens.emplace_back(NinjaToken::OrderOnly, std::string{});
+            i += 2;
+          }
+          else if (i + 1 < n && statement[i + 1] == '@')
+          {
+            tokens.emplace_back(NinjaToken::Validation, std::string{});
+            i += 2;
+          }
+          else
+          {
+            tokens.emplace_back(NinjaToken::Pipe, std::string{});
+            ++i;
+          }
+          continue;
+        }
+
+        std::string word;
+        while (i < n)
+        {
+          const char w = statement[i];
+          if (w == ' ' || w == '\t' || w == ':' || w == '|')
+            break;
+
+          if (w == '$' && i + 1 < n)
+          {
+            const char next = statement[i + 1];
+            if (next == ' ' || next == ':' || next == '$')
+              word.push_back(next);
+            else
+            {
+              word.push_back('$');
+              word.push_back(next);
+            }
+            i += 2;
+            continue;
+          }
+
+          word.push_back(w);
+          ++i;
+        }
+
+        tokens.emplace_back(NinjaToken::Word, std::move(word));
+      }
+
+      return tokens;
+    }
+
+    std::string trim_copy(const std::string &value)
+    {
+      std::size_t begin = 0;
+      std::size_t end = value.size();
+
+      while (begin < end && std::isspace(static_cast<unsigned char>(value[begin])))
+        ++begin;
+
+      while (end > begin && std::isspace(static_cast<unsigned char>(value[end - 1])))
+        --end;
+
+      return value.substr(begin, end - begin);
+    }
+
+    // CMake argument parsing, enough for the files CMake itself generates.
+    class CMakeCallReader
+    {
+    public:
+      explicit CMakeCallReader(const std::string &text) : text_(text) {}
+
+      bool next(std::string &command, std::vector<std::string> &args)
+      {
+        command.clear();
+        args.clear();
+
+        while (pos_ < text_.size())
+        {
+          skip_space_and_comments();
+          if (pos_ >= text_.size())
+            return false;
+
+          const char c = text_[pos_];
+          if (!(std::isalpha(static_cast<unsigned char>(c)) || c == '_'))
+          {
+            ++pos_;
+            continue;
+          }
+
+          while (pos_ < text_.size() &&
+                 (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_'))
+          {
+            command.push_back(static_cast<char>(
+                std::tolower(static_cast<unsigned char>(text_[pos_]))));
+            ++pos_;
+          }
+
+          while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t'))
+            ++pos_;
+
+          if (pos_ >= text_.size() || text_[pos_] != '(')
+          {
+            command.clear();
+            continue;
+          }
+
+          ++pos_;
+          read_arguments(args);
+          return true;
+        }
+
+        return false;
+      }
+
+    private:
+      const std::string &text_;
+      std::size_t pos_{0};
+
+      void skip_space_and_comments()
+      {
+        while (pos_ < text_.size())
+        {
+          const char c = text_[pos_];
+
+          if (std::isspace(static_cast<unsigned char>(c)))
+          {
+            ++pos_;
+            continue;
+          }
+
+          if (c == '#')
+          {
+            while (pos_ < text_.size() && text_[pos_] != '\n')
+              ++pos_;
+            continue;
+          }
+
+          break;
+        }
+      }
+
+      bool read_bracket(std::string &out)
+      {
+        // [=*[ ... ]=*]
+        std::size_t p = pos_ + 1;
+        std::size_t equals = 0;
+        while (p < text_.size() && text_[p] == '=')
+        {
+          ++equals;
+          ++p;
+        }
+
+        if (p >= text_.size() || text_[p] != '[')
+          return false;
+
+        const std::string close = "]" + std::string(equals, '=') + "]";
+        const std::size_t end = text_.find(close, p + 1);
+        if (end == std::string::npos)
+          return false;
+
+        out = text_.substr(p + 1, end - p - 1);
+        pos_ = end + close.size();
+        return true;
+      }
+
+      void read_arguments(std::vector<std::string> &args)
+      {
+        int depth = 0;
+
+        while (pos_ < text_.size())
+        {
+          skip_space_and_comments();
+          if (pos_ >= text_.size())
+            return;
+
+          const char c = text_[pos_];
+
+          if (c == ')')
+          {
+            ++pos_;
+            if (depth == 0)
+              return;
+            --depth;
+            continue;
+          }
+
+          if (c == '(')
+          {
+            ++depth;
+            ++pos_;
+            continue;
+          }
+
+          if (c == '"')
+          {
+            ++pos_;
+            std::string value;
+            while (pos_ < text_.size() && text_[pos_] != '"')
+            {
+              if (text_[pos_] == '\\' && pos_ + 1 < text_.size())
+              {
+                const char e = text_[pos_ + 1];
+                value.push_back(e == 'n' ? '\n' : e == 't' ? '\t' : e == 'r' ? '\r' : e);
+                pos_ += 2;
+                continue;
+              }
+              value.push_back(text_[pos_++]);
+            }
+            ++pos_;
+            args.push_back(std::move(value));
+            continue;
+          }
+
+          if (c == '[')
+          {
+            std::string value;
+            if (read_bracket(value))
+            {
+              args.push_back(std::move(value));
+              continue;
+            }
+          }
+
+          std::string value;
+          while (pos_ < text_.size())
+          {
+            const char u = text_[pos_];
+            if (std::isspace(static_cast<unsigned char>(u)) || u == '(' || u == ')')
+              break;
+
+            if (u == '\\' && pos_ + 1 < text_.size())
+            {
+              value.push_back(text_[pos_ + 1]);
+              pos_ += 2;
+              continue;
+            }
+
+            value.push_back(u);
+            ++pos_;
+          }
+          args.push_back(std::move(value));
+        }
+      }
+    };
+
+    std::vector<std::string> split_cmake_list(const std::string &value)
+    {
+      std::vector<std::string> items;
+      std::string item;
+
+      for (const char c : value)
+      {
+        if (c == ';')
+        {
+          if (!item.empty())
+            items.push_back(std::move(item));
+          item.clear();
+          continue;
+        }
+        item.push_back(c);
+      }
+
+      if (!item.empty())
+        items.push_back(std::move(item));
+
+      return items;
+    }
+
+    bool cmake_is_true(const std::string &value)
+    {
+      return value == "ON" || value == "TRUE" || value == "1" || value == "YES";
+    }
+
+    // Properties that change neither the outcome nor the order of a test.
+    bool is_informational_test_property(const std::string &key)
+    {
+      static const std::unordered_set<std::string> keys = {
+          "_BACKTRACE_TRIPLES", "ATTACHED_FILES", "ATTACHED_FILES_ON_FAIL",
+          "COST", "MEASUREMENT", "PROCESSORS", "PROCESSOR_AFFINITY"};
+
+      return keys.count(key) != 0;
+    }
+
+    void apply_test_property(
+        CTestEntry &entry,
+        const std::string &key,
+        const std::string &value,
+        const fs::path &dir)
+    {
+      if (key == "WORKING_DIRECTORY")
+        entry.workingDirectory = fs::path(impact_path_key(value, dir));
+      else if (key == "TIMEOUT")
+      {
+        try
+        {
+          entry.timeoutSeconds = std::stod(value);
+        }
+        catch (...)
+        {
+        }
+      }
+      else if (key == "RUN_SERIAL")
+        entry.runSerial = cmake_is_true(value);
+      else if (key == "DISABLED")
+        entry.disabled = cmake_is_true(value);
+      else if (key == "RESOURCE_LOCK")
+        entry.resourceLocks = split_cmake_list(value);
+      else if (key == "ENVIRONMENT")
+        entry.environment = split_cmake_list(value);
+      else if (key == "LABELS")
+        entry.labels = split_cmake_list(value);
+      else if (key == "REQUIRED_FILES")
+      {
+        for (const std::string &file : split_cmake_list(value))
+          entry.requiredFiles.push_back(fs::path(impact_path_key(file, dir)));
+      }
+      else if (key == "WILL_FAIL")
+        entry.willFail = cmake_is_true(value);
+      else if (key == "PASS_REGULAR_EXPRESSION")
+        entry.passRegex = split_cmake_list(value);
+      else if (key == "FAIL_REGULAR_EXPRESSION")
+        entry.failRegex = split_cmake_list(value);
+      else if (key == "SKIP_RETURN_CODE")
+      {
+        try
+        {
+          entry.skipReturnCode = std::stoi(value);
+        }
+        catch (...)
+        {
+        }
+      }
+      else if (key == "SKIP_REGULAR_EXPRESSION")
+        entry.skipRegex = split_cmake_list(value);
+      else if (key == "DEPENDS")
+        entry.depends = split_cmake_list(value);
+      else if (key == "FIXTURES_SETUP")
+        entry.fixturesSetup = split_cmake_list(value);
+      else if (key == "FIXTURES_CLEANUP")
+        entry.fixturesCleanup = split_cmake_list(value);
+      else if (key == "FIXTURES_REQUIRED")
+        entry.fixturesRequired = split_cmake_list(value);
+      else if (!is_informational_test_property(key))
+        entry.unsupportedProperties.push_back(key);
+    }
+
+    bool is_build_system_file(const fs::path &path)
+    {
+      const std::string name = path.filename().string();
+
+      return name == "CMakeLists.txt" ||
+             name == "CMakePresets.json" ||
+             name == "CMakeUserPresets.json" ||
+             name == "vix.json" ||
+             name == "vix.lock" ||
+             path.extension() == ".cmake";
+    }
+
+    bool is_translation_unit(const fs::path &path)
+    {
+      static const std::unordered_set<std::string> extensions = {
+          ".c", ".cc", ".cpp", ".cxx", ".c++", ".cppm", ".ixx", ".m", ".mm", ".cu"};
+
+      return extensions.count(path.extension().string()) != 0;
+    }
+  } // namespace
+
+  std::string impact_path_key(const fs::path &path, const fs::path &base)
+  {
+    fs::path full = path;
+    if (full.is_relative() && !base.empty())
+      full = base / full;
+
+    std::string key = full.lexically_normal().generic_string();
+    while (key.size() > 1 && key.back() == '/')
+      key.pop_back();
+
+    return key;
+  }
+
+  std::vector<ImpactEdge> parse_ninja_build_edges(
+      const std::string &text,
+      const fs::path &buildDir)
+  {
+    enum class Section
+    {
+      Outputs,
+      Rule,
+      Inputs,
+      Ignored
+    };
+
+    std::vector<ImpactEdge> edges;
+
+    for (const std::string &line : ninja_logical_lines(text))
+    {
+      if (line.rfind("build ", 0) != 0)
+        continue;
+
+      ImpactEdge edge;
+      Section section = Section::Outputs;
+
+      for (auto &[kind, value] : tokenize_ninja_build(line.substr(6)))
+      {
+        switch (kind)
+        {
+        case NinjaToken::Colon:
+          if (section == Section::Outputs)
+            section = Section::Rule;
+          break;
+
+        case NinjaToken::Pipe:
+          // Implicit outputs and implicit inputs both count.
+          break;
+
+        case NinjaToken::OrderOnly:
+        case NinjaToken::Validation:
+          if (section == Section::Inputs)
+            section = Section::Ignored;
+          break;
+
+        case NinjaToken::Word:
+          if (section == Section::Outputs)
+            edge.outputs.push_back(impact_path_key(value, buildDir));
+          else if (section == Section::Rule)
+            section = Section::Inputs;
+          else if (section == Section::Inputs)
+            edge.inputs.push_back(impact_path_key(value, buildDir));
+          break;
+        }
+      }
+
+      if (!edge.outputs.empty() && !edge.inputs.empty())
+        edges.push_back(std::move(edge));
+    }
+
+    return edges;
+  }
+
+  std::vector<ImpactEdge> parse_ninja_deps_output(
+      const std::string &text,
+      const fs::path &buildDir)
+  {
+    std::vector<ImpactEdge> edges;
+
+    std::istringstream in(text);
+    std::string line;
+
+    while (std::getline(in, line))
+    {
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+
+      if (line.empty())
+        continue;
+
+      if (line[0] != ' ' && line[0] != '\t')
+      {
+        // "CMakeFiles/app.dir/main.cpp.o: #deps 42, deps mtime ... (VALID)"
+        const std::size_t marker = line.find(": #deps");
+        if (marker == std::string::npos)
+          continue;
+
+        ImpactEdge edge;
+        edge.outputs.push_back(impact_path_key(line.substr(0, marker), buildDir));
+        edges.push_back(std::move(edge));
+        continue;
+      }
+
+      if (edges.empty())
+        continue;
+
+      const std::string dependency = trim_copy(line);
+      if (!dependency.empty())
+        edges.back().inputs.push_back(impact_path_key(dependency, buildDir));
+    }
+
+    edges.erase(
+        std::remove_if(
+            edges.begin(),
+            edges.end(),
+            [](const ImpactEdge &edge)
+            {
+              return edge.inputs.empty();
+            }),
+        edges.end());
+
+    return edges;
+  }
+
+  CTestFile parse_ctest_testfile(const std::string &text, const fs::path &dir)
+  {
+    CTestFile file;
+
+    CMakeCallReader reader(text);
+    std::string command;
+    std::vector<std::string> args;
+
+    while (reader.next(command, args))
+    {
+      if (command == "add_test" && args.size() >= 2)
+      {
+        CTestEntry entry;
+        entry.name = args[0];
+        entry.command.assign(args.begin() + 1, args.end());
+        file.tests.push_back(std::move(entry));
+        continue;
+      }
+
+      if (command == "set_tests_properties")
+      {
+        const auto properties = std::find(args.begin(), args.end(), "PROPERTIES");
+        if (properties == args.end())
+          continue;
+
+        for (auto name = args.begin(); name != properties; ++name)
+        {
+          for (CTestEntry &entry : file.tests)
+          {
+            if (entry.name != *name)
+              continue;
+
+            for (auto it = properties + 1; it != args.end() && it + 1 != args.end(); it += 2)
+              apply_test_property(entry, *it, *(it + 1), dir);
+          }
+        }
+        continue;
+      }
+
+      if (command == "subdirs")
+      {
+        for (const std::string &arg : args)
+          file.subdirs.push_back(fs::path(impact_path_key(arg, dir)));
+        continue;
+      }
+
+      // gtest_discover_tests() and friends register their tests through
+      // generated include files.
+      if (command == "include" && !args.empty())
+        file.includes.push_back(fs::path(impact_path_key(args[0], dir)));
+    }
+
+    return file;
+  }
+
+  AffectedTestsResult compute_affected_tests(
+      const std::vector<std::string> &changedFiles,
+      const std::vector<ImpactEdge> &edges,
+      const std::vector<CTestEntry> &tests)
+  {
+    AffectedTestsResult result;
+
+    std::unordered_map<std::string, std::vector<std::string>> dependents;
+    for (const ImpactEdge &edge : edges)
+    {
+      for (const std::string &input : edge.inputs)
+      {
+        std::vector<std::string> &outputs = dependents[input];
+        outputs.insert(outputs.end(), edge.outputs.begin(), edge.outputs.end());
+      }
+    }
+
+    std::unordered_set<std::string> testArguments;
+    for (const CTestEntry &test : tests)
+    {
+      for (const std::string &arg : test.command)
+      {
+        if (fs::path(arg).is_absolute())
+          testArguments.insert(impact_path_key(arg, {}));
+      }
+    }
+
+    // parent[x] is the file whose change made x stale ("" for changed files).
+    std::unordered_map<std::string, std::string> parent;
+    std::deque<std::string> queue;
+
+    for (const std::string &changed : changedFiles)
+    {
+      const std::string key = impact_path_key(changed, {});
+      const fs::path path(key);
+
+      if (is_build_system_file(path))
+      {
+        result.runAll = true;
+        result.runAllReason = key + " changes the build configuration";
+        return result;
+      }
+
+      if (dependents.count(key) == 0 && testArguments.count(key) == 0)
+      {
+        if (is_translation_unit(path))
+        {
+          result.runAll = true;
+          result.runAllReason = key + " is not part of the build graph yet";
+          return result;
+        }
+
+        result.unusedFiles.push_back(key);
+        continue;
+      }
+
+      if (parent.emplace(key, std::string{}).second)
+        queue.push_back(key);
+    }
+
+    while (!queue.empty())
+    {
+      const std::string current = std::move(queue.front());
+      queue.pop_front();
+
+      const auto it = dependents.find(current);
+      if (it == dependents.end())
+        continue;
+
+      for (const std::string &output : it->second)
+      {
+        if (parent.emplace(output, current).second)
+          queue.push_back(output);
+      }
+    }
+
+    for (const CTestEntry &test : tests)
+    {
+      for (const std::string &arg : test.command)
+      {
+        if (!fs::path(arg).is_absolute())
+          continue;
+
+        const std::string key = impact_path_key(arg, {});
+        if (parent.count(key) == 0)
+          continue;
+
+        AffectedTest affected;
+        affected.name = test.name;
+
+        for (std::string step = key; !step.empty(); step = parent[step])
+          affected.chain.push_back(step);
+
+        std::reverse(affected.chain.begin(), affected.chain.end());
+        result.tests.push_back(std::move(affected));
+        break;
+      }
+    }
+
+    return result;
+  }
+
+  std::string ctest_exact_names_regex(const std::vector<std::string> &names)
+  {
+    static const std::string special = "\\^$.|?*+()[]{}";
+
+    std::string regex = "^(";
+
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+      if (i > 0)
+        regex.push_back('|');
+
+      for (const char c : names[i])
+      {
+        if (special.find(c) != std::string::npos)
+          regex.push_back('\\');
+        regex.push_back(c);
+      }
+    }
+
+    regex += ")$";
+    return regex;
+  }
+}
@@ -0,0 +1,285 @@
+/**
+ *
+ *  @file TestsOutput.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/tests/TestsOutput.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <system_error>
+
+namespace vix::commands::TestsCommand::detail
+{
+  namespace
+  {
+    constexpr std::size_t MAX_SPOOL_NAME = 120;
+
+    std::string_view trim_view(std::string_view text)
+    {
+      while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+        text.remove_prefix(1);
+
+      while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+        text.remove_suffix(1);
+
+      return text;
+    }
+
+    bool contains(std::string_view text, std::string_view needle)
+    {
+      return text.find(needle) != std::string_view::npos;
+    }
+
+    bool starts_with(std::string_view text, std::string_view prefix)
+    {
+      return text.substr(0, prefix.size()) == prefix;
+    }
+
+    bool open_spool_file(const fs::path &file, std::ofstream &out)
+    {
+      if (file.empty())
+        return false;
+
+      std::error_code ec;
+      fs::create_directories(file.parent_path(), ec);
+
+      out.open(file, std::ios::binary | std::ios::trunc);
+      return out.is_open();
+    }
+  } // namespace
+
+  fs::path test_output_dir(const fs::path &buildDir)
+  {
+    return buildDir / ".vix" / "test-output";
+  }
+
+  fs::path test_output_file(const fs::path &dir, const std::string &name)
+  {
+    std::string safe;
+    safe.reserve(std::min(name.size(), MAX_SPOOL_NAME));
+
+    for (const char c : name)
+    {
+      if (safe.size() == MAX_SPOOL_NAME)
+        break;
+
+      const bool keep = std::isalnum(static_cast<unsigned char>(c)) ||
+                        c == '-' || c == '_' || c == '.';
+      safe += keep ? c : '_';
+    }
+
+    if (safe.empty() || safe.front() == '.')
+      safe.insert(safe.begin(), '_');
+
+    return dir / (safe + ".log");
+  }
+
+  OutputExcerpt::OutputExcerpt(TestOutputLimits limits)
+      : limits_(limits)
+  {
+  }
+
+  void OutputExcerpt::append(std::string_view data)
+  {
+    bytes_ += data.size();
+
+    if (head_.size() < limits_.headBytes)
+    {
+      const std::size_t take = std::min(limits_.headBytes - head_.size(), data.size());
+      head_.append(data.substr(0, take));
+      data.remove_prefix(take);
+    }
+
+    if (data.empty())
+      return;
+
+    tail_.append(data);
+
+    // Trim in batches so that appending stays linear.
+    if (tail_.size() > 2 * limits_.tailBytes)
+      tail_.erase(0, tail_.size() - limits_.tailBytes);
+  }
+
+  void OutputExcerpt::clear()
+  {
+    head_.clear();
+    tail_.clear();
+    bytes_ = 0;
+  }
+
+  std::uintmax_t OutputExcerpt::omitted_bytes() const
+  {
+    const std::uintmax_t kept = head_.size() + std::min(tail_.size(), limits_.tailBytes);
+    return bytes_ - kept;
+  }
+
+  std::string OutputExcerpt::text() const
+  {
+    if (omitted_bytes() == 0)
+      return head_ + tail_;
+
+    std::string_view tail = tail_;
+    if (tail.size() > limits_.tailBytes)
+      tail.remove_prefix(tail.size() - limits_.tailBytes);
+
+    const std::size_t newline = tail.find('\n');
+    if (newline != std::string_view::npos && newline + 1 < tail.size())
+      tail.remove_prefix(newline + 1);
+
+    const std::uintmax_t omitted = bytes_ - head_.size() - tail.size();
+
+    std::string out = head_;
+    if (!out.empty() && out.back() != '\n')
+      out += '\n';
+
+    out += "... " + std::to_string(omitted) + " bytes omitted ...\n";
+    out.append(tail);
+    return out;
+  }
+
+  TestOutputSpool::TestOutputSpool(TestOutputLimits limits)
+      : excerpt_(limits)
+  {
+  }
+
+  bool TestOutputSpool::open(const fs::path &file)
+  {
+    close();
+    excerpt_.clear();
+    file_.clear();
+
+    if (!open_spool_file(file, out_))
+      return false;
+
+    file_ = file;
+    return true;
+  }
+
+  void TestOutputSpool::close()
+  {
+    if (out_.is_open())
+      out_.close();
+  }
+
+  void TestOutputSpool::append(std::string_view data)
+  {
+    excerpt_.append(data);
+
+    if (out_.is_open())
+      out_.write(data.data(), static_cast<std::streamsize>(data.size()));
+  }
+
+  CTestOutputDigest::CTestOutputDigest(TestOutputLimits limits)
+      : limits_(limits),
+        block_(limits)
+  {
+  }
+
+  bool CTestOutputDigest::open(const fs::path &file)
+  {
+    close();
+    file_.clear();
+
+    if (!open_spool_file(file, out_))
+      return false;
+
+    file_ = file;
+    return true;
+  }
+
+  void CTestOutputDigest::close()
+  {
+    if (out_.is_open())
+      out_.close();
+  }
+
+  void CTestOutputDigest::append_line(std::string_view line)
+  {
+    if (out_.is_open())
+      out_.write(line.data(), static_cast<std::streamsize>(line.size()));
+
+    if (atLineStart_)
+    {
+      const std::string_view trimmed = trim_view(line);
+
+      // Everything after this header is the list of failed tests.
+      if (contains(trimmed, "The following tests FAILED"))
+        inFailedList_ = true;
+
+      inStatusLine_ = inFailedList_ || is_ctest_status_line(trimmed);
+      if (inStatusLine_)
+        flush_block();
+    }
+
+    if (inStatusLine_)
+      text_.append(line);
+    else
+      block_.append(line);
+
+    atLineStart_ = !line.empty() && line.back() == '\n';
+  }
+
+  void CTestOutputDigest::flush_block()
+  {
+    if (block_.empty())
+      return;
+
+    if (block_.omitted_bytes() > 0)
+      truncated_ = true;
+
+    text_ += block_.text();
+    block_.clear();
+  }
+
+  std::string CTestOutputDigest::text() const
+  {
+    return text_ + block_.text();
+  }
+
+  bool is_ctest_status_line(std::string_view trimmed)
+  {
+    if (trimmed.empty())
+      return false;
+
+    if (contains(trimmed, "Test #"))
+      return true;
+
+    if (starts_with(trimmed, "Start ") && contains(trimmed, ":"))
+      return true;
+
+    return starts_with(trimmed, "Test project ") ||
+           contains(trimmed, "% tests passed") ||
+           contains(trimmed, "tests failed out of") ||
+           contains(trimmed, "Total Test time") ||
+           contains(trimmed, "Errors while running CTest") ||
+           contains(trimmed, "No tests were found") ||
+           contains(trimmed, "Total Tests:");
+  }
+
+  bool stream_output_file(const fs::path &file, std::ostream &out, const std::string &indent)
+  {
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+      return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+
+      out << indent << line << "\n";
+    }
+
+    return true;
+  }
+}
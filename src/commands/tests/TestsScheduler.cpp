@@ -0,0 +1,778 @@
+/**
+ *
+ *  @file TestsScheduler.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/tests/TestsScheduler.hpp>
+#include <vix/cli/util/Fs.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <regex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <nlohmann/json.hpp>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+#endif
+
+namespace vix::commands::TestsCommand::detail
+{
+  namespace
+  {
+    using json = nlohmann::json;
+
+    constexpr int HISTORY_FORMAT_VERSION = 1;
+
+    // Weight of the newest run in the duration estimate.
+    constexpr double HISTORY_SMOOTHING = 0.5;
+
+#ifndef _WIN32
+    struct RunningTest
+    {
+      std::size_t index{0};
+      pid_t pid{-1};
+      int fd{-1};
+      std::chrono::steady_clock::time_point start{};
+      bool timedOut{false};
+      TestOutputSpool output;
+    };
+
+    std::string resolve_program(const std::string &program)
+    {
+      if (program.find('/') != std::string::npos)
+        return program;
+
+      const char *path = std::getenv("PATH");
+      if (!path)
+        return program;
+
+      std::string dirs(path);
+      std::size_t begin = 0;
+
+      while (begin <= dirs.size())
+      {
+        std::size_t end = dirs.find(':', begin);
+        if (end == std::string::npos)
+          end = dirs.size();
+
+        const std::string dir = end > begin ? dirs.substr(begin, end - begin) : ".";
+        const std::string candidate = dir + "/" + program;
+
+        if (::access(candidate.c_str(), X_OK) == 0)
+          return candidate;
+
+        begin = end + 1;
+      }
+
+      return program;
+    }
+
+    std::vector<std::string> merged_environment(const std::vector<std::string> &overrides)
+    {
+      std::vector<std::string> env;
+
+      for (char **entry = environ; entry && *entry; ++entry)
+      {
+        const std::string value(*entry);
+        const std::string key = value.substr(0, value.find('='));
+
+        const bool overridden = std::any_of(
+            overrides.begin(),
+            overrides.end(),
+            [&key](const std::string &o)
+            {
+              return o.compare(0, key.size() + 1, key + "=") == 0;
+            });
+
+        if (!overridden)
+          env.push_back(value);
+      }
+
+      env.insert(env.end(), overrides.begin(), overrides.end());
+      return env;
+    }
+
+    pid_t spawn_test(const TestJob &job, int &outputFd, std::string &error)
+    {
+      if (job.command.empty())
+      {
+        error = "empty test command";
+        return -1;
+      }
+
+      // Prepared before fork(): only async-signal-safe calls in the child.
+      const std::string program = resolve_program(job.command.front());
+
+      std::vector<char *> argv;
+      for (const std::string &arg : job.command)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+      argv.push_back(nullptr);
+
+      const std::vector<std::string> envStrings = merged_environment(job.environment);
+      std::vector<char *> envp;
+      for (const std::string &entry : envStrings)
+        envp.push_back(const_cast<char *>(entry.c_str()));
+      envp.push_back(nullptr);
+
+      const std::string cwd = job.workingDirectory.string();
+
+      int pipeFds[2] = {-1, -1};
+      if (::pipe(pipeFds) != 0)
+      {
+        error = std::string("pipe: ") + std::strerror(errno);
+        return -1;
+      }
+
+      // Other tests must not inherit this pipe, or EOF never comes.
+      (void)::fcntl(pipeFds[0], F_SETFD, FD_CLOEXEC);
+      (void)::fcntl(pipeFds[0], F_SETFL, ::fcntl(pipeFds[0], F_GETFL, 0) | O_NONBLOCK);
+
+      const pid_t pid = ::fork();
+      if (pid < 0)
+      {
+        error = std::string("fork: ") + std::strerror(errno);
+        ::close(pipeFds[0]);
+        ::close(pipeFds[1]);
+        return -1;
+      }
+
+      if (pid == 0)
+      {
+        ::setpgid(0, 0);
+
+        const int devNull = ::open("/dev/null", O_RDONLY);
+        if (devNull >= 0)
+        {
+          ::dup2(devNull, STDIN_FILENO);
+          ::close(devNull);
+        }
+
+        ::dup2(pipeFds[1], STDOUT_FILENO);
+        ::dup2(pipeFds[1], STDERR_FILENO);
+        ::close(pipeFds[0]);
+        ::close(pipeFds[1]);
+
+        if (!cwd.empty() && ::chdir(cwd.c_str()) != 0)
+          _exit(127);
+
+        ::execve(program.c_str(), argv.data(), envp.data());
+
+        static constexpr char message[] = "vix tests: cannot execute test command\n";
+        const ssize_t written = ::write(STDERR_FILENO, message, sizeof(message) - 1);
+        (void)written;
+        _exit(127);
+      }
+
+      ::setpgid(pid, pid);
+      ::close(pipeFds[1]);
+      outputFd = pipeFds[0];
+      return pid;
+    }
+
+    void read_available(RunningTest &test)
+    {
+      char buffer[8192];
+
+      while (true)
+      {
+        const ssize_t n = ::read(test.fd, buffer, sizeof(buffer));
+        if (n > 0)
+        {
+          test.output.append(std::string_view(buffer, static_cast<std::size_t>(n)));
+          continue;
+        }
+
+        if (n < 0 && errno == EINTR)
+          continue;
+
+        return;
+      }
+    }
+
+    /**
+     * @brief Jobs each job waits for, and the fixture setup jobs whose
+     * failure cancels it (cleanup tests still run, as with CTest).
+     */
+    void link_job_dependencies(
+        const std::vector<TestJob> &jobs,
+        std::vector<std::vector<std::size_t>> &waitsFor,
+        std::vector<std::vector<std::size_t>> &setupsOf)
+    {
+      std::unordered_map<std::string, std::size_t> byName;
+      std::unordered_map<std::string, std::vector<std::size_t>> setups;
+      std::unordered_map<std::string, std::vector<std::size_t>> cleanups;
+      std::unordered_map<std::string, std::vector<std::size_t>> users;
+
+      for (std::size_t i = 0; i < jobs.size(); ++i)
+      {
+        byName.emplace(jobs[i].name, i);
+
+        for (const std::string &fixture : jobs[i].fixturesSetup)
+          setups[fixture].push_back(i);
+        for (const std::string &fixture : jobs[i].fixturesCleanup)
+          cleanups[fixture].push_back(i);
+        for (const std::string &fixture : jobs[i].fixturesRequired)
+          users[fixture].push_back(i);
+      }
+
+      auto wait = [&waitsFor](std::size_t job, std::size_t on)
+      {
+        std::vector<std::size_t> &list = waitsFor[job];
+        if (job != on && std::find(list.begin(), list.end(), on) == list.end())
+          list.push_back(on);
+      };
+
+      for (std::size_t i = 0; i < jobs.size(); ++i)
+      {
+        // A dependency outside this run is ignored, as CTest does.
+        for (const std::string &name : jobs[i].depends)
+        {
+          const auto it = byName.find(name);
+          if (it != byName.end())
+            wait(i, it->second);
+        }
+
+        for (const std::string &fixture : jobs[i].fixturesRequired)
+        {
+          const bool partOfFixture =
+              std::count(jobs[i].fixturesSetup.begin(), jobs[i].fixturesSetup.end(), fixture) != 0 ||
+              std::count(jobs[i].fixturesCleanup.begin(), jobs[i].fixturesCleanup.end(), fixture) != 0;
+
+          for (const std::size_t setup : setups[fixture])
+          {
+            wait(i, setup);
+            if (!partOfFixture && setup != i)
+              setupsOf[i].push_back(setup);
+          }
+        }
+      }
+
+      for (const auto &[fixture, cleanupJobs] : cleanups)
+      {
+        for (const std::size_t cleanup : cleanupJobs)
+        {
+          for (const std::size_t setup : setups[fixture])
+            wait(cleanup, setup);
+          for (const std::size_t user : users[fixture])
+            wait(cleanup, user);
+        }
+      }
+    }
+
+    bool output_matches(const std::vector<std::string> &patterns, const std::string &output)
+    {
+      for (const std::string &pattern : patterns)
+      {
+        try
+        {
+          if (std::regex_search(output, std::regex(pattern)))
+            return true;
+        }
+        catch (const std::regex_error &)
+        {
+        }
+      }
+
+      return false;
+    }
+
+    /**
+     * @brief Decide pass, fail or skip from the exit code and output.
+     *
+     * Skip rules come first; a PASS_REGULAR_EXPRESSION replaces the exit
+     * code check, a FAIL_REGULAR_EXPRESSION match fails the test, and
+     * WILL_FAIL inverts the result. A timeout always fails.
+     */
+    void apply_outcome_rules(const TestJob &job, TestJobResult &result)
+    {
+      if (result.timedOut)
+      {
+        result.passed = false;
+        return;
+      }
+
+      const bool needsOutput =
+          !job.passRegex.empty() || !job.failRegex.empty() || !job.skipRegex.empty();
+
+      // The excerpt drops the middle of a long output; the spool has it all.
+      std::string output;
+      if (needsOutput)
+      {
+        output = result.outputFile.empty()
+                     ? result.output
+                     : vix::cli::util::read_text_file_or_empty(result.outputFile);
+      }
+
+      if ((job.skipReturnCode >= 0 && result.exitCode == job.skipReturnCode) ||
+          output_matches(job.skipRegex, output))
+      {
+        result.skipped = true;
+        result.passed = true;
+        return;
+      }
+
+      bool passed = result.exitCode == 0;
+      if (!job.passRegex.empty())
+      {
+        passed = output_matches(job.passRegex, output);
+        if (!passed)
+          result.output += "\n*** Required regular expression not found\n";
+      }
+
+      if (passed && output_matches(job.failRegex, output))
+      {
+        passed = false;
+        result.output += "\n*** Failure regular expression found\n";
+      }
+
+      result.passed = job.willFail ? !passed : passed;
+    }
+
+    bool job_can_start(
+        const TestJob &job,
+        const std::vector<std::size_t> &waitsFor,
+        const std::vector<bool> &done,
+        const std::unordered_set<std::string> &heldLocks,
+        bool anyRunning)
+    {
+      if (job.runSerial && anyRunning)
+        return false;
+
+      for (const std::size_t dependency : waitsFor)
+      {
+        if (!done[dependency])
+          return false;
+      }
+
+      for (const std::string &lock : job.resourceLocks)
+      {
+        if (heldLocks.count(lock) != 0)
+          return false;
+      }
+
+      return true;
+    }
+#endif
+  } // namespace
+
+  fs::path TestDurationHistory::default_path(const fs::path &buildDir)
+  {
+    return buildDir / ".vix" / "test-durations.json";
+  }
+
+  bool TestDurationHistory::load(const fs::path &path)
+  {
+    entries_.clear();
+
+    const std::string text = vix::cli::util::read_text_file_or_empty(path);
+    if (text.empty())
+      return false;
+
+    const json doc = json::parse(text, nullptr, false);
+    if (!doc.is_object() || doc.value("version", 0) != HISTORY_FORMAT_VERSION ||
+        !doc.contains("tests") || !doc["tests"].is_object())
+    {
+      return false;
+    }
+
+    for (const auto &[name, value] : doc["tests"].items())
+    {
+      if (!value.is_object())
+        continue;
+
+      Entry entry;
+      entry.seconds = value.value("seconds", 0.0);
+      entry.runs = value.value("runs", std::size_t{0});
+
+      if (entry.runs > 0 && entry.seconds >= 0.0)
+        entries_[name] = entry;
+    }
+
+    return true;
+  }
+
+  bool TestDurationHistory::save(const fs::path &path) const
+  {
+    json tests = json::object();
+    for (const auto &[name, entry] : entries_)
+      tests[name] = json{{"seconds", entry.seconds}, {"runs", entry.runs}};
+
+    const json doc{{"version", HISTORY_FORMAT_VERSION}, {"tests", std::move(tests)}};
+    return vix::cli::util::write_text_file_atomic(path, doc.dump(2) + "\n");
+  }
+
+  std::optional<double> TestDurationHistory::expected_seconds(const std::string &name) const
+  {
+    const auto it = entries_.find(name);
+    if (it == entries_.end())
+      return std::nullopt;
+
+    return it->second.seconds;
+  }
+
+  void TestDurationHistory::record(const std::string &name, double seconds)
+  {
+    Entry &entry = entries_[name];
+
+    if (entry.runs == 0)
+      entry.seconds = seconds;
+    else
+      entry.seconds = HISTORY_SMOOTHING * seconds + (1.0 - HISTORY_SMOOTHING) * entry.seconds;
+
+    ++entry.runs;
+  }
+
+  TestJob make_test_job(
+      const CTestEntry &entry,
+      std::chrono::milliseconds defaultTimeout)
+  {
+    TestJob job;
+    job.name = entry.name;
+    job.command = entry.command;
+    job.workingDirectory = entry.workingDirectory;
+    job.environment = entry.environment;
+    job.resourceLocks = entry.resourceLocks;
+    job.runSerial = entry.runSerial;
+    job.requiredFiles = entry.requiredFiles;
+    job.willFail = entry.willFail;
+    job.passRegex = entry.passRegex;
+    job.failRegex = entry.failRegex;
+    job.skipReturnCode = entry.skipReturnCode;
+    job.skipRegex = entry.skipRegex;
+    job.depends = entry.depends;
+    job.fixturesSetup = entry.fixturesSetup;
+    job.fixturesCleanup = entry.fixturesCleanup;
+    job.fixturesRequired = entry.fixturesRequired;
+    job.unsupportedProperties = entry.unsupportedProperties;
+
+    job.timeout = entry.timeoutSeconds > 0.0
+                      ? std::chrono::milliseconds(
+                            static_cast<long long>(std::llround(entry.timeoutSeconds * 1000.0)))
+                      : defaultTimeout;
+
+    return job;
+  }
+
+  void add_fixture_jobs(std::vector<TestJob> &jobs, const std::vector<TestJob> &available)
+  {
+    std::unordered_set<std::string> names;
+    for (const TestJob &job : jobs)
+      names.insert(job.name);
+
+    // Added setup tests may require fixtures of their own.
+    for (std::size_t i = 0; i < jobs.size(); ++i)
+    {
+      const std::vector<std::string> required = jobs[i].fixturesRequired;
+
+      for (const std::string &fixture : required)
+      {
+        for (const TestJob &candidate : available)
+        {
+          const bool provides =
+              std::count(candidate.fixturesSetup.begin(), candidate.fixturesSetup.end(), fixture) != 0 ||
+              std::count(candidate.fixturesCleanup.begin(), candidate.fixturesCleanup.end(), fixture) != 0;
+
+          if (provides && names.insert(candidate.name).second)
+            jobs.push_back(candidate);
+        }
+      }
+    }
+  }
+
+  void order_longest_first(std::vector<TestJob> &jobs)
+  {
+    double known = 0.0;
+    std::size_t knownCount = 0;
+
+    for (const TestJob &job : jobs)
+    {
+      if (job.expectedSeconds >= 0.0)
+      {
+        known += job.expectedSeconds;
+        ++knownCount;
+      }
+    }
+
+    if (knownCount == 0)
+      return;
+
+    const double fallback = known / static_cast<double>(knownCount);
+
+    std::stable_sort(
+        jobs.begin(),
+        jobs.end(),
+        [fallback](const TestJob &a, const TestJob &b)
+        {
+          const double ea = a.expectedSeconds >= 0.0 ? a.expectedSeconds : fallback;
+          const double eb = b.expectedSeconds >= 0.0 ? b.expectedSeconds : fallback;
+          return ea > eb;
+        });
+  }
+
+  double ideal_makespan_seconds(const std::vector<double> &durations, int workers)
+  {
+    if (durations.empty())
+      return 0.0;
+
+    const double total = std::accumulate(durations.begin(), durations.end(), 0.0);
+    const double longest = *std::max_element(durations.begin(), durations.end());
+
+    return std::max(total / static_cast<double>(std::max(1, workers)), longest);
+  }
+
+#ifndef _WIN32
+  bool native_test_scheduler_supported()
+  {
+    return true;
+  }
+
+  std::vector<TestJobResult> run_test_jobs(
+      const std::vector<TestJob> &jobs,
+      const TestSchedulerOptions &options)
+  {
+    using clock = std::chrono::steady_clock;
+
+    std::vector<TestJobResult> results(jobs.size());
+    for (std::size_t i = 0; i < jobs.size(); ++i)
+      results[i].name = jobs[i].name;
+
+    const std::size_t workers = static_cast<std::size_t>(std::max(1, options.jobs));
+
+    std::vector<bool> started(jobs.size(), false);
+    std::vector<bool> done(jobs.size(), false);
+    std::vector<std::vector<std::size_t>> waitsFor(jobs.size());
+    std::vector<std::vector<std::size_t>> setupsOf(jobs.size());
+    link_job_dependencies(jobs, waitsFor, setupsOf);
+
+    std::vector<RunningTest> running;
+    std::unordered_set<std::string> heldLocks;
+    bool serialRunning = false;
+    bool stopLaunching = false;
+    bool interrupted = false;
+
+    auto finish = [&](RunningTest &test, int status)
+    {
+      const TestJob &job = jobs[test.index];
+      TestJobResult &result = results[test.index];
+
+      result.ran = true;
+      result.timedOut = test.timedOut;
+      result.seconds = std::chrono::duration<double>(clock::now() - test.start).count();
+
+      if (WIFEXITED(status))
+        result.exitCode = WEXITSTATUS(status);
+      else if (WIFSIGNALED(status))
+        result.exitCode = 128 + WTERMSIG(status);
+      else
+        result.exitCode = 1;
+
+      if (test.timedOut)
+      {
+        test.output.append(
+            "\n*** Timeout after " +
+            std::to_string(job.timeout.count() / 1000) + " sec\n");
+      }
+
+      test.output.close();
+      result.output = test.output.excerpt().text();
+      result.outputFile = test.output.file();
+
+      apply_outcome_rules(job, result);
+      done[test.index] = true;
+
+      for (const std::string &lock : job.resourceLocks)
+        heldLocks.erase(lock);
+
+      if (job.runSerial)
+        serialRunning = false;
+
+      if (options.onFinish && !interrupted)
+        options.onFinish(result);
+
+      if (options.failFast && !result.passed)
+        stopLaunching = true;
+    };
+
+    while (true)
+    {
+      if (!interrupted && options.stopRequested && options.stopRequested())
+      {
+        interrupted = true;
+        stopLaunching = true;
+
+        for (const RunningTest &test : running)
+          ::kill(-test.pid, SIGKILL);
+      }
+
+      while (!stopLaunching && !serialRunning && running.size() < workers)
+      {
+        std::size_t next = jobs.size();
+        for (std::size_t i = 0; i < jobs.size() && !stopLaunching; ++i)
+        {
+          if (started[i] || !job_can_start(jobs[i], waitsFor[i], done, heldLocks, !running.empty()))
+            continue;
+
+          const auto failedSetup = std::find_if(
+              setupsOf[i].begin(),
+              setupsOf[i].end(),
+              [&results](std::size_t setup)
+              {
+                return !results[setup].passed;
+              });
+
+          if (failedSetup == setupsOf[i].end())
+          {
+            next = i;
+            break;
+          }
+
+          // CTest does not run a test whose fixture could not be set up.
+          started[i] = true;
+          done[i] = true;
+
+          TestJobResult &result = results[i];
+          result.ran = true;
+          result.output = "Not run: fixture setup test `" + jobs[*failedSetup].name + "` failed\n";
+
+          if (options.onFinish)
+            options.onFinish(result);
+
+          if (options.failFast)
+            stopLaunching = true;
+        }
+
+        if (next == jobs.size())
+          break;
+
+        started[next] = true;
+        const TestJob &job = jobs[next];
+
+        if (options.onStart)
+          options.onStart(job);
+
+        RunningTest test;
+        test.index = next;
+        test.start = clock::now();
+        test.output = TestOutputSpool(options.outputLimits);
+
+        if (!options.outputDir.empty())
+          (void)test.output.open(test_output_file(options.outputDir, job.name));
+
+        std::string error;
+        test.pid = spawn_test(job, test.fd, error);
+
+        if (test.pid < 0)
+        {
+          done[next] = true;
+
+          TestJobResult &result = results[next];
+          result.ran = true;
+          result.exitCode = 127;
+          result.output = "Could not start test: " + error + "\n";
+
+          if (options.onFinish)
+            options.onFinish(result);
+
+          if (options.failFast)
+            stopLaunching = true;
+          continue;
+        }
+
+        for (const std::string &lock : job.resourceLocks)
+          heldLocks.insert(lock);
+
+        if (job.runSerial)
+          serialRunning = true;
+
+        running.push_back(std::move(test));
+      }
+
+      if (running.empty())
+        break;
+
+      std::vector<pollfd> fds;
+      fds.reserve(running.size());
+      for (const RunningTest &test : running)
+        fds.push_back(pollfd{test.fd, POLLIN, 0});
+
+      (void)::poll(fds.data(), static_cast<nfds_t>(fds.size()), 50);
+
+      const auto now = clock::now();
+
+      for (std::size_t i = 0; i < running.size();)
+      {
+        RunningTest &test = running[i];
+        read_available(test);
+
+        const TestJob &job = jobs[test.index];
+        if (!test.timedOut && job.timeout.count() > 0 && now - test.start > job.timeout)
+        {
+          test.timedOut = true;
+          ::kill(-test.pid, SIGKILL);
+        }
+
+        int status = 0;
+        const pid_t waited = ::waitpid(test.pid, &status, WNOHANG);
+        if (waited != test.pid)
+        {
+          ++i;
+          continue;
+        }
+
+        // Leftover background processes of the test would keep the pipe
+        // open; the test is over once its main process is.
+        ::kill(-test.pid, SIGKILL);
+        read_available(test);
+        ::close(test.fd);
+
+        finish(test, status);
+
+        running.erase(running.begin() + static_cast<std::ptrdiff_t>(i));
+      }
+
+      if (options.onTick && !interrupted)
+        options.onTick();
+    }
+
+    return results;
+  }
+#else
+  bool native_test_scheduler_supported()
+  {
+    return false;
+  }
+
+  std::vector<TestJobResult> run_test_jobs(
+      const std::vector<TestJob> &jobs,
+      const TestSchedulerOptions &)
+  {
+    // Not reached: TestsCommand keeps using CTest on Windows.
+    std::vector<TestJobResult> results(jobs.size());
+    for (std::size_t i = 0; i < jobs.size(); ++i)
+      results[i].name = jobs[i].name;
+    return results;
+  }
+#endif
+}
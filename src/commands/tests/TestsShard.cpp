@@ -0,0 +1,464 @@
+/**
+ *
+ *  @file TestsShard.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/cli/commands/tests/TestsShard.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+
+namespace vix::commands::TestsCommand::detail
+{
+  namespace
+  {
+    using json = nlohmann::json;
+
+    constexpr int SHARD_FORMAT_VERSION = 1;
+    constexpr int MAX_SHARDS = 10000;
+
+    // Seconds used for every test when no history exists at all.
+    constexpr double DEFAULT_TEST_SECONDS = 1.0;
+
+    bool parse_positive_int(const std::string &text, int &value)
+    {
+      if (text.empty() || text.size() > 6)
+        return false;
+
+      value = 0;
+      for (const char c : text)
+      {
+        if (c < '0' || c > '9')
+          return false;
+
+        value = value * 10 + (c - '0');
+      }
+
+      return value > 0;
+    }
+
+    double round_two_digits(double seconds)
+    {
+      if (seconds <= 0.0)
+        return 0.0;
+
+      const double scale = std::pow(10.0, std::floor(std::log10(seconds)) - 1.0);
+      return std::round(seconds / scale) * scale;
+    }
+
+    int status_rank(const std::string &status)
+    {
+      if (status == "timeout")
+        return 3;
+      if (status == "failed")
+        return 2;
+      if (status == "passed")
+        return 1;
+      return 0;
+    }
+
+    std::string xml_escape(const std::string &text)
+    {
+      std::string out;
+      out.reserve(text.size());
+
+      for (const char c : text)
+      {
+        const auto u = static_cast<unsigned char>(c);
+
+        switch (c)
+        {
+        case '&':
+          out += "&amp;";
+          break;
+        case '<':
+          out += "&lt;";
+          break;
+        case '>':
+          out += "&gt;";
+          break;
+        case '"':
+          out += "&quot;";
+          break;
+        case '\'':
+          out += "&apos;";
+          break;
+        default:
+          // XML 1.0 has no representation for most control characters
+          // (terminal colors included).
+          if (u < 0x20 && c != '\t' && c != '\n' && c != '\r')
+            break;
+          out += c;
+          break;
+        }
+      }
+
+      return out;
+    }
+
+    std::string seconds_attr(double seconds)
+    {
+      char buffer[32];
+      std::snprintf(buffer, sizeof(buffer), "%.3f", seconds);
+      return buffer;
+    }
+  } // namespace
+
+  std::optional<ShardSpec> parse_shard_spec(const std::string &text)
+  {
+    const std::size_t slash = text.find('/');
+    if (slash == std::string::npos)
+      return std::nullopt;
+
+    ShardSpec spec;
+    if (!parse_positive_int(text.substr(0, slash), spec.index) ||
+        !parse_positive_int(text.substr(slash + 1), spec.count))
+    {
+      return std::nullopt;
+    }
+
+    if (spec.index > spec.count || spec.count > MAX_SHARDS)
+      return std::nullopt;
+
+    return spec;
+  }
+
+  ShardPlan plan_test_shards(std::vector<ShardTest> tests, int count)
+  {
+    ShardPlan plan;
+    if (count <= 0)
+      return plan;
+
+    plan.shards.resize(static_cast<std::size_t>(count));
+
+    double known = 0.0;
+    std::size_t knownCount = 0;
+
+    for (ShardTest &test : tests)
+    {
+      if (test.expectedSeconds < 0.0)
+        continue;
+
+      test.expectedSeconds = round_two_digits(test.expectedSeconds);
+      known += test.expectedSeconds;
+      ++knownCount;
+    }
+
+    const double fallback =
+        knownCount > 0 ? round_two_digits(known / static_cast<double>(knownCount)) : DEFAULT_TEST_SECONDS;
+
+    for (ShardTest &test : tests)
+    {
+      if (test.expectedSeconds < 0.0)
+      {
+        test.expectedSeconds = fallback;
+        ++plan.estimatedTests;
+      }
+    }
+
+    std::sort(
+        tests.begin(),
+        tests.end(),
+        [](const ShardTest &a, const ShardTest &b)
+        {
+          if (a.expectedSeconds != b.expectedSeconds)
+            return a.expectedSeconds > b.expectedSeconds;
+          return a.name < b.name;
+        });
+
+    for (const ShardTest &test : tests)
+    {
+      // Least loaded shard; the lowest index wins ties.
+      TestShard *target = &plan.shards.front();
+      for (TestShard &shard : plan.shards)
+      {
+        if (shard.expectedSeconds < target->expectedSeconds)
+          target = &shard;
+      }
+
+      target->names.push_back(test.name);
+      target->expectedSeconds += test.expectedSeconds;
+    }
+
+    return plan;
+  }
+
+  std::string shard_plan_json(const ShardPlan &plan)
+  {
+    double total = 0.0;
+    json shards = json::array();
+
+    for (std::size_t i = 0; i < plan.shards.size(); ++i)
+    {
+      const TestShard &shard = plan.shards[i];
+      total += shard.expectedSeconds;
+
+      shards.push_back(json{
+          {"index", i + 1},
+          {"expectedSeconds", shard.expectedSeconds},
+          {"tests", shard.names}});
+    }
+
+    const json doc{
+        {"version", SHARD_FORMAT_VERSION},
+        {"count", plan.shards.size()},
+        {"totalSeconds", total},
+        {"estimatedTests", plan.estimatedTests},
+        {"shards", std::move(shards)}};
+
+    return doc.dump(2) + "\n";
+  }
+
+  std::string test_report_json(const TestReport &report)
+  {
+    json shards = json::array();
+    for (const TestReportShard &shard : report.shards)
+      shards.push_back(json{{"index", shard.index}, {"wallSeconds", shard.wallSeconds}});
+
+    json tests = json::array();
+    for (const TestReportCase &test : report.cases)
+    {
+      tests.push_back(json{
+          {"name", test.name},
+          {"status", test.status},
+          {"seconds", test.seconds},
+          {"shard", test.shard},
+          {"output", test.output}});
+    }
+
+    const json doc{
+        {"version", SHARD_FORMAT_VERSION},
+        {"shardCount", report.shardCount},
+        {"shards", std::move(shards)},
+        {"tests", std::move(tests)}};
+
+    // Test output is not always valid UTF-8.
+    return doc.dump(2, ' ', false, json::error_handler_t::replace) + "\n";
+  }
+
+  std::optional<TestReport> parse_test_report_json(const std::string &text)
+  {
+    const json doc = json::parse(text, nullptr, false);
+    if (!doc.is_object() || doc.value("version", 0) != SHARD_FORMAT_VERSION)
+      return std::nullopt;
+
+    if (!doc.contains("tests") || !doc["tests"].is_array())
+      return std::nullopt;
+
+    TestReport report;
+    report.shardCount = doc.value("shardCount", 0);
+
+    if (doc.contains("shards") && doc["shards"].is_array())
+    {
+      for (const json &item : doc["shards"])
+      {
+        if (!item.is_object())
+          continue;
+
+        report.shards.push_back(TestReportShard{
+            item.value("index", 0),
+            item.value("wallSeconds", 0.0)});
+      }
+    }
+
+    for (const json &item : doc["tests"])
+    {
+      if (!item.is_object())
+        continue;
+
+      TestReportCase test;
+      test.name = item.value("name", std::string{});
+      test.status = item.value("status", std::string{});
+      test.seconds = item.value("seconds", 0.0);
+      test.shard = item.value("shard", 0);
+      test.output = item.value("output", std::string{});
+
+      if (!test.name.empty())
+        report.cases.push_back(std::move(test));
+    }
+
+    return report;
+  }
+
+  MergedTestReport merge_test_reports(const std::vector<TestReport> &reports)
+  {
+    MergedTestReport merged;
+
+    std::set<int> seenShards;
+    std::unordered_map<std::string, std::size_t> caseIndex;
+
+    for (const TestReport &report : reports)
+    {
+      if (report.shardCount > 0)
+      {
+        if (merged.report.shardCount == 0)
+          merged.report.shardCount = report.shardCount;
+        else if (merged.report.shardCount != report.shardCount)
+          merged.mixedShardCounts = true;
+      }
+
+      for (const TestReportShard &shard : report.shards)
+      {
+        if (!seenShards.insert(shard.index).second)
+        {
+          merged.repeatedShards.push_back(shard.index);
+          continue;
+        }
+
+        merged.report.shards.push_back(shard);
+      }
+
+      for (const TestReportCase &test : report.cases)
+      {
+        const auto it = caseIndex.find(test.name);
+        if (it == caseIndex.end())
+        {
+          caseIndex.emplace(test.name, merged.report.cases.size());
+          merged.report.cases.push_back(test);
+          continue;
+        }
+
+        merged.repeatedTests.push_back(test.name);
+
+        TestReportCase &kept = merged.report.cases[it->second];
+        if (status_rank(test.status) > status_rank(kept.status))
+          kept = test;
+      }
+    }
+
+    if (merged.report.shardCount > 0)
+    {
+      for (int index = 1; index <= merged.report.shardCount; ++index)
+      {
+        if (seenShards.count(index) == 0)
+          merged.missingShards.push_back(index);
+      }
+    }
+
+    std::sort(
+        merged.report.shards.begin(),
+        merged.report.shards.end(),
+        [](const TestReportShard &a, const TestReportShard &b)
+        {
+          return a.index < b.index;
+        });
+
+    std::stable_sort(
+        merged.report.cases.begin(),
+        merged.report.cases.end(),
+        [](const TestReportCase &a, const TestReportCase &b)
+        {
+          return a.shard < b.shard;
+        });
+
+    return merged;
+  }
+
+  std::string test_report_junit_xml(const TestReport &report)
+  {
+    struct Totals
+    {
+      std::size_t tests{0};
+      std::size_t failures{0};
+      std::size_t skipped{0};
+    };
+
+    std::map<int, Totals> perShard;
+    Totals all;
+
+    for (const TestReportCase &test : report.cases)
+    {
+      Totals &totals = perShard[test.shard];
+
+      for (Totals *t : {&totals, &all})
+      {
+        ++t->tests;
+        if (test.status == "failed" || test.status == "timeout")
+          ++t->failures;
+        else if (test.status == "skipped")
+          ++t->skipped;
+      }
+    }
+
+    std::map<int, double> wall;
+    double longestWall = 0.0;
+    for (const TestReportShard &shard : report.shards)
+    {
+      wall[shard.index] = shard.wallSeconds;
+      longestWall = (std::max)(longestWall, shard.wallSeconds);
+    }
+
+    std::string out;
+    out += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+
+    // Shards run concurrently: the whole run takes as long as the slowest.
+    out += "<testsuites name=\"vix tests\" tests=\"" + std::to_string(all.tests) +
+           "\" failures=\"" + std::to_string(all.failures) +
+           "\" errors=\"0\" skipped=\"" + std::to_string(all.skipped) +
+           "\" time=\"" + seconds_attr(longestWall) + "\">\n";
+
+    for (const auto &[shard, totals] : perShard)
+    {
+      const std::string suiteName =
+          shard > 0 && report.shardCount > 0
+              ? "shard " + std::to_string(shard) + "/" + std::to_string(report.shardCount)
+              : "vix tests";
+
+      out += "  <testsuite name=\"" + xml_escape(suiteName) +
+             "\" tests=\"" + std::to_string(totals.tests) +
+             "\" failures=\"" + std::to_string(totals.failures) +
+             "\" errors=\"0\" skipped=\"" + std::to_string(totals.skipped) +
+             "\" time=\"" + seconds_attr(wall.count(shard) ? wall[shard] : 0.0) + "\">\n";
+
+      for (const TestReportCase &test : report.cases)
+      {
+        if (test.shard != shard)
+          continue;
+
+        out += "    <testcase name=\"" + xml_escape(test.name) +
+               "\" classname=\"" + xml_escape(suiteName) +
+               "\" time=\"" + seconds_attr(test.seconds) + "\"";
+
+        if (test.status == "passed")
+        {
+          out += "/>\n";
+          continue;
+        }
+
+        out += ">\n";
+
+        if (test.status == "skipped")
+        {
+          out += "      <skipped/>\n";
+        }
+        else
+        {
+          const std::string message = test.status == "timeout" ? "Timed out" : "Failed";
+          out += "      <failure message=\"" + message + "\">" +
+                 xml_escape(test.output) + "</failure>\n";
+        }
+
+        out += "    </testcase>\n";
+      }
+
+      out += "  </testsuite>\n";
+    }
+
+    out += "</testsuites>\n";
+    return out;
+  }
+}
@@ -1,5 +1,7 @@
 #include <vix/cli/registry/RegistryCatalog.hpp>
 
+#include <vix/cli/registry/RegistryIndex.hpp>
+#include <vix/cli/registry/SearchIndex.hpp>
 #include <vix/cli/util/Semver.hpp>
 #include <vix/process/Process.hpp>
 
@@ -32,11 +34,6 @@ namespace vix::cli::registry
       return s;
     }
 
-    bool contains_icase(const std::string &hay, const std::string &needleLower)
-    {
-      return needleLower.empty() || to_lower(hay).find(needleLower) != std::string::npos;
-    }
-
     std::string home_dir()
     {
 #ifdef _WIN32
@@ -74,18 +71,6 @@ namespace vix::cli::registry
       return out;
     }
 
-    std::string join_strings(const std::vector<std::string> &items)
-    {
-      std::string out;
-      for (const auto &item : items)
-      {
-        if (!out.empty())
-          out += " ";
-        out += item;
-      }
-      return out;
-    }
-
     std::string latest_version(const json &entry)
     {
       if (entry.contains("latest") && entry["latest"].is_string())
@@ -109,11 +94,6 @@ namespace vix::cli::registry
       return &entry["extensions"]["note"];
     }
 
-    bool note_extension_compatible(const json &note)
-    {
-      return note.value("api", "") == "1";
-    }
-
     bool safe_remote_icon(const std::string &value)
     {
       const std::string lower = to_lower(value);
@@ -196,7 +176,7 @@ namespace vix::cli::registry
       return {};
     }
 
-    PackageSummary make_summary(const json &entry, int score)
+    PackageSummary make_summary(const json &entry, double score)
     {
       PackageSummary out;
       out.namespaceName = entry.value("namespace", "");
@@ -255,81 +235,33 @@ namespace vix::cli::registry
       return out;
     }
 
-    std::string search_text(const json &entry, const PackageSummary &summary)
-    {
-      std::vector<std::string> parts = {
-          summary.id,
-          summary.namespaceName,
-          summary.name,
-          summary.description,
-          summary.publisher,
-          summary.type,
-          join_strings(summary.capabilities),
-          join_strings(summary.cellTypes),
-          join_strings(summary.categories)};
-      if (entry.contains("displayName") && entry["displayName"].is_string())
-        parts.push_back(entry["displayName"].get<std::string>());
-      if (entry.contains("keywords"))
-        parts.push_back(join_strings(json_string_array(entry["keywords"])));
-      return to_lower(join_strings(parts));
-    }
-
-    int score_entry(const json &entry, const SearchFilters &filters)
-    {
-      PackageSummary summary = make_summary(entry, 0);
-      const std::string query = to_lower(filters.query);
-      if (query.empty())
-        return 1;
-      int score = 0;
-      if (contains_icase(summary.id, query))
-        score += 100;
-      if (contains_icase(summary.name, query))
-        score += 60;
-      if (contains_icase(summary.namespaceName, query))
-        score += 40;
-      if (contains_icase(summary.description, query))
-        score += 20;
-      if (contains_icase(join_strings(summary.capabilities), query))
-        score += 15;
-      if (contains_icase(join_strings(summary.cellTypes), query))
-        score += 15;
-      if (contains_icase(search_text(entry, summary), query))
-        score += 5;
-      return score;
-    }
-
-    bool matches_filters(const json &entry, const SearchFilters &filters)
+    // Filters and scores come from the compiled index, so only the entries
+    // of the returned page are parsed.
+    bool matches_filters(const CompiledRegistryIndex &index, const IndexedPackage &package, const SearchFilters &filters)
     {
-      if (!filters.packageType.empty() && to_lower(entry.value("type", "")) != to_lower(filters.packageType))
+      if (!filters.packageType.empty() && to_lower(std::string(package.type)) != to_lower(filters.packageType))
         return false;
       const bool wantsNote = filters.extensionHost.empty() || to_lower(filters.extensionHost) == "note";
-      const json *note = note_extension_json(entry);
-      if (!filters.extensionHost.empty() && (!wantsNote || note == nullptr))
+      const auto note = index.extension(package, "note");
+      if (!filters.extensionHost.empty() && (!wantsNote || !note))
         return false;
-      if (note != nullptr && !note_extension_compatible(*note))
+      if (note && note->api != "1")
         return false;
       if (!filters.capability.empty())
       {
-        if (note == nullptr)
+        if (!note)
           return false;
-        const auto caps = json_string_array(note->value("capabilities", json::array()));
+        const auto caps = split_index_list(note->capabilities);
         if (std::find(caps.begin(), caps.end(), filters.capability) == caps.end())
           return false;
       }
       if (!filters.cellType.empty())
       {
-        if (note == nullptr)
+        if (!note)
           return false;
-        bool found = false;
-        if (note->contains("cellTypes") && (*note)["cellTypes"].is_array())
-        {
-          for (const auto &cell : (*note)["cellTypes"])
-          {
-            if (cell.is_object() && to_lower(cell.value("id", "")) == to_lower(filters.cellType))
-              found = true;
-          }
-        }
-        if (!found)
+        const auto cells = split_index_list(note->cellTypes);
+        if (std::none_of(cells.begin(), cells.end(), [&](std::string_view cell)
+                         { return to_lower(std::string(cell)) == to_lower(filters.cellType); }))
           return false;
       }
       return true;
@@ -457,40 +389,55 @@ namespace vix::cli::registry
       result.error = result.metadata.error;
       return result;
     }
-    const fs::path dir = index_path();
-    std::error_code ec;
-    std::vector<PackageSummary> hits;
-    for (const auto &item : fs::directory_iterator(dir, ec))
+    std::string indexError;
+    const auto index = open_registry_index(repositoryPath_, &indexError);
+    if (!index)
     {
-      if (ec)
-        break;
-      if (!item.is_regular_file() || item.path().extension() != ".json")
-        continue;
-      try
-      {
-        const json entry = read_json_or_throw(item.path());
-        if (!matches_filters(entry, filters))
-          continue;
-        const int score = score_entry(entry, filters);
-        if (score <= 0)
-          continue;
-        hits.push_back(make_summary(entry, score));
-      }
-      catch (...)
+      result.ok = false;
+      result.error = indexError;
+      return result;
+    }
+
+    // Query hits come ranked from the search index; a filter-only listing
+    // keeps index order.
+    std::vector<SearchHit> hits;
+    if (filters.query.empty())
+    {
+      for (std::size_t i = 0; i < index->size(); ++i)
+        hits.push_back({static_cast<std::uint32_t>(i), 1.0});
+    }
+    else
+    {
+      const auto search = open_search_index(repositoryPath_, *index, &indexError);
+      if (!search)
       {
+        result.ok = false;
+        result.error = indexError;
+        return result;
       }
+      hits = search->search(filters.query, 0);
     }
-    std::sort(hits.begin(), hits.end(), [](const auto &a, const auto &b) {
-      if (a.score != b.score)
-        return a.score > b.score;
-      return a.id < b.id;
-    });
+    hits.erase(std::remove_if(hits.begin(), hits.end(), [&](const SearchHit &hit)
+                              { return !matches_filters(*index, index->package(hit.package), filters); }),
+               hits.end());
+
     result.total = hits.size();
     const std::size_t page = std::max<std::size_t>(1, filters.page);
     const std::size_t limit = std::clamp<std::size_t>(filters.limit == 0 ? 20 : filters.limit, 1, 100);
     const std::size_t start = hits.empty() ? 0 : std::min((page - 1) * limit, hits.size());
     const std::size_t end = std::min(start + limit, hits.size());
-    result.items.assign(hits.begin() + static_cast<std::ptrdiff_t>(start), hits.begin() + static_cast<std::ptrdiff_t>(end));
+    rank_search_hits(hits, end);
+    for (std::size_t i = start; i < end; ++i)
+    {
+      try
+      {
+        const std::string file(index->package(hits[i].package).file);
+        result.items.push_back(make_summary(read_json_or_throw(index_path() / (file + ".json")), hits[i].score));
+      }
+      catch (...)
+      {
+      }
+    }
     return result;
   }
 
@@ -0,0 +1,638 @@
+#include <vix/cli/registry/RegistryIndex.hpp>
+
+#include <vix/cli/util/Hash.hpp>
+#include <vix/cli/util/Semver.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace vix::cli::registry
+{
+  namespace
+  {
+    // Layout, all integers native-endian u32:
+    //   Header | PackageRecord[packageCount] (sorted by file) |
+    //   VersionRecord[versionCount] | ExtensionRecord[extensionCount] | strings
+    // A Ref is an (offset, length) slice of the string pool.
+    constexpr char MAGIC[8] = {'V', 'I', 'X', 'R', 'I', 'D', 'X', '\n'};
+    constexpr std::uint32_t FORMAT = 1;
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304u;
+    constexpr std::uint32_t DECLARES_DEPS = 1u;
+
+    struct Ref
+    {
+      std::uint32_t offset{0};
+      std::uint32_t length{0};
+    };
+
+    struct Header
+    {
+      char magic[8];
+      std::uint32_t format;
+      std::uint32_t byteOrder;
+      std::uint32_t packageCount;
+      std::uint32_t versionCount;
+      std::uint32_t extensionCount;
+      std::uint32_t packagesAt;
+      std::uint32_t versionsAt;
+      std::uint32_t extensionsAt;
+      std::uint32_t stringsAt;
+      std::uint32_t stringsSize;
+      Ref revision;
+    };
+
+    struct PackageRecord
+    {
+      Ref file, ns, name, displayName, description, type, publisher, repository, latest, keywords, categories;
+      std::uint32_t firstVersion, versionCount, firstExtension, extensionCount;
+    };
+
+    struct VersionRecord
+    {
+      Ref version, tag, commit, deps;
+      std::uint32_t flags;
+    };
+
+    struct ExtensionRecord
+    {
+      Ref host, api, capabilities, cellTypes;
+    };
+
+    static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 56);
+    static_assert(std::is_trivially_copyable_v<PackageRecord> && sizeof(PackageRecord) == 104);
+    static_assert(std::is_trivially_copyable_v<VersionRecord> && sizeof(VersionRecord) == 36);
+    static_assert(std::is_trivially_copyable_v<ExtensionRecord> && sizeof(ExtensionRecord) == 32);
+
+    template <typename T>
+    T read_at(const char *data, std::size_t offset)
+    {
+      T value;
+      std::memcpy(&value, data + offset, sizeof(T));
+      return value;
+    }
+
+    std::string text(const json &object, const char *key)
+    {
+      const auto it = object.find(key);
+      return it != object.end() && it->is_string() ? it->get<std::string>() : std::string();
+    }
+
+    std::string join_lines(const std::vector<std::string> &items)
+    {
+      std::string out;
+      for (const auto &item : items)
+      {
+        if (item.empty() || item.find('\n') != std::string::npos)
+          continue;
+        if (!out.empty())
+          out += '\n';
+        out += item;
+      }
+      return out;
+    }
+
+    std::vector<std::string> string_array(const json &object, const char *key)
+    {
+      std::vector<std::string> out;
+      const auto it = object.find(key);
+      if (it == object.end() || !it->is_array())
+        return out;
+      for (const auto &item : *it)
+        if (item.is_string())
+          out.push_back(item.get<std::string>());
+      return out;
+    }
+
+    std::string repository_of(const json &entry)
+    {
+      if (const auto it = entry.find("repo"); it != entry.end() && it->is_object())
+        return text(*it, "url");
+      return text(entry, "repository");
+    }
+
+    // One "ns/name@range" line per dependency, as Resolver reads them.
+    std::string dependency_lines(const json &deps)
+    {
+      std::vector<std::string> lines;
+      for (const auto &dep : deps)
+      {
+        if (dep.is_string())
+        {
+          lines.push_back(dep.get<std::string>());
+          continue;
+        }
+        if (!dep.is_object())
+          continue;
+        std::string range = text(dep, "version");
+        if (range.empty())
+          range = text(dep, "requested");
+        if (range.empty())
+          range = text(dep, "range");
+        const std::string id = text(dep, "id");
+        if (!id.empty())
+          lines.push_back(range.empty() ? id : id + "@" + range);
+      }
+      return join_lines(lines);
+    }
+
+    class Builder
+    {
+    public:
+      Ref add(const std::string &s)
+      {
+        if (s.empty())
+          return {};
+        const auto [it, inserted] = pool_.emplace(s, Ref{static_cast<std::uint32_t>(strings_.size()), static_cast<std::uint32_t>(s.size())});
+        if (inserted)
+          strings_ += s;
+        return it->second;
+      }
+
+      void add_package(const std::string &file, const json &entry)
+      {
+        PackageRecord rec{};
+        rec.file = add(file);
+        rec.ns = add(text(entry, "namespace"));
+        rec.name = add(text(entry, "name"));
+        rec.displayName = add(text(entry, "displayName"));
+        rec.description = add(text(entry, "description"));
+        rec.type = add(text(entry, "type"));
+        rec.publisher = add(text(entry, "publisher"));
+        rec.repository = add(repository_of(entry));
+        rec.keywords = add(join_lines(string_array(entry, "keywords")));
+        rec.categories = add(join_lines(string_array(entry, "categories")));
+
+        std::vector<std::string> versions;
+        const auto versionsIt = entry.find("versions");
+        if (versionsIt != entry.end() && versionsIt->is_object())
+          for (auto it = versionsIt->begin(); it != versionsIt->end(); ++it)
+            versions.push_back(it.key());
+        vix::cli::util::semver::sortAscending(versions);
+
+        std::string latest = text(entry, "latest");
+        if (latest.empty())
+          latest = text(entry, "latestVersion");
+        if (latest.empty() && !versions.empty())
+          latest = vix::cli::util::semver::findLatest(versions);
+        rec.latest = add(latest);
+
+        rec.firstVersion = static_cast<std::uint32_t>(versions_.size());
+        for (const auto &version : versions)
+        {
+          const json &node = versionsIt->at(version);
+          VersionRecord v{};
+          v.version = add(version);
+          if (node.is_object())
+          {
+            v.tag = add(text(node, "tag"));
+            v.commit = add(text(node, "commit"));
+            for (const char *key : {"deps", "dependencies"})
+            {
+              if (const auto deps = node.find(key); deps != node.end() && deps->is_array())
+              {
+                v.deps = add(dependency_lines(*deps));
+                v.flags |= DECLARES_DEPS;
+                break;
+              }
+            }
+          }
+          versions_.push_back(v);
+        }
+        rec.versionCount = static_cast<std::uint32_t>(versions.size());
+
+        rec.firstExtension = static_cast<std::uint32_t>(extensions_.size());
+        if (const auto ext = entry.find("extensions"); ext != entry.end() && ext->is_object())
+        {
+          for (auto it = ext->begin(); it != ext->end(); ++it)
+          {
+            if (!it->is_object())
+              continue;
+            std::vector<std::string> cells;
+            if (const auto c = it->find("cellTypes"); c != it->end() && c->is_array())
+              for (const auto &cell : *c)
+                if (cell.is_object())
+                  cells.push_back(text(cell, "id"));
+            extensions_.push_back({add(it.key()), add(text(*it, "api")),
+                                   add(join_lines(string_array(*it, "capabilities"))), add(join_lines(cells))});
+          }
+        }
+        rec.extensionCount = static_cast<std::uint32_t>(extensions_.size()) - rec.firstExtension;
+
+        packages_.push_back(rec);
+      }
+
+      std::string finish(const std::string &revision)
+      {
+        Header h{};
+        std::memcpy(h.magic, MAGIC, sizeof MAGIC);
+        h.format = FORMAT;
+        h.byteOrder = BYTE_ORDER_MARK;
+        h.revision = add(revision);
+        h.packageCount = static_cast<std::uint32_t>(packages_.size());
+        h.versionCount = static_cast<std::uint32_t>(versions_.size());
+        h.extensionCount = static_cast<std::uint32_t>(extensions_.size());
+        h.packagesAt = sizeof(Header);
+        h.versionsAt = h.packagesAt + h.packageCount * static_cast<std::uint32_t>(sizeof(PackageRecord));
+        h.extensionsAt = h.versionsAt + h.versionCount * static_cast<std::uint32_t>(sizeof(VersionRecord));
+        h.stringsAt = h.extensionsAt + h.extensionCount * static_cast<std::uint32_t>(sizeof(ExtensionRecord));
+        h.stringsSize = static_cast<std::uint32_t>(strings_.size());
+
+        std::string out;
+        out.reserve(h.stringsAt + strings_.size());
+        out.append(reinterpret_cast<const char *>(&h), sizeof h);
+        out.append(reinterpret_cast<const char *>(packages_.data()), packages_.size() * sizeof(PackageRecord));
+        out.append(reinterpret_cast<const char *>(versions_.data()), versions_.size() * sizeof(VersionRecord));
+        out.append(reinterpret_cast<const char *>(extensions_.data()), extensions_.size() * sizeof(ExtensionRecord));
+        out += strings_;
+        return out;
+      }
+
+    private:
+      std::string strings_;
+      std::unordered_map<std::string, Ref> pool_;
+      std::vector<PackageRecord> packages_;
+      std::vector<VersionRecord> versions_;
+      std::vector<ExtensionRecord> extensions_;
+    };
+
+    std::optional<std::string> build_index(
+        const fs::path &repositoryPath,
+        const std::string &revision,
+        std::size_t &packages,
+        std::string *error)
+    {
+      const fs::path dir = repositoryPath / "index";
+      std::error_code ec;
+      std::vector<std::pair<std::string, json>> entries;
+      for (const auto &item : fs::directory_iterator(dir, ec))
+      {
+        if (!item.is_regular_file() || item.path().extension() != ".json")
+          continue;
+        try
+        {
+          std::ifstream in(item.path());
+          json entry;
+          in >> entry;
+          if (entry.is_object())
+            entries.emplace_back(item.path().stem().string(), std::move(entry));
+        }
+        catch (...)
+        {
+        }
+      }
+      if (ec)
+      {
+        if (error)
+          *error = "cannot read registry index: " + dir.string();
+        return std::nullopt;
+      }
+
+      std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+      Builder builder;
+      for (const auto &[file, entry] : entries)
+        builder.add_package(file, entry);
+      packages = entries.size();
+      return builder.finish(revision);
+    }
+
+    bool write_atomic(const fs::path &path, const std::string &bytes)
+    {
+      std::error_code ec;
+      const fs::path tmp = path.string() + ".tmp." + std::to_string(std::random_device{}());
+      {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out || !out.write(bytes.data(), static_cast<std::streamsize>(bytes.size())))
+        {
+          out.close();
+          fs::remove(tmp, ec);
+          return false;
+        }
+      }
+      fs::rename(tmp, path, ec);
+      if (ec)
+        fs::remove(tmp, ec);
+      return !ec;
+    }
+
+    std::string first_line(const fs::path &path)
+    {
+      std::ifstream in(path);
+      std::string line;
+      std::getline(in, line);
+      while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back())))
+        line.pop_back();
+      return line;
+    }
+
+    bool is_object_id(const std::string &s)
+    {
+      return s.size() >= 40 && std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isxdigit(c) != 0; });
+    }
+
+    std::optional<std::string> git_head(const fs::path &repositoryPath)
+    {
+      std::error_code ec;
+      fs::path gitDir = repositoryPath / ".git";
+      if (fs::is_regular_file(gitDir, ec))
+      {
+        const std::string line = first_line(gitDir);
+        if (line.rfind("gitdir: ", 0) != 0)
+          return std::nullopt;
+        gitDir = fs::path(line.substr(8));
+        if (gitDir.is_relative())
+          gitDir = repositoryPath / gitDir;
+      }
+      if (!fs::is_directory(gitDir, ec))
+        return std::nullopt;
+
+      const std::string head = first_line(gitDir / "HEAD");
+      if (head.rfind("ref: ", 0) != 0)
+        return is_object_id(head) ? std::optional<std::string>(head) : std::nullopt;
+
+      const std::string ref = head.substr(5);
+      if (const std::string loose = first_line(gitDir / ref); is_object_id(loose))
+        return loose;
+
+      std::ifstream packed(gitDir / "packed-refs");
+      std::string line;
+      while (std::getline(packed, line))
+      {
+        const auto space = line.find(' ');
+        if (space != std::string::npos && line.compare(space + 1, std::string::npos, ref) == 0 && is_object_id(line.substr(0, space)))
+          return line.substr(0, space);
+      }
+      return std::nullopt;
+    }
+  }
+
+  std::optional<CompiledRegistryIndex> CompiledRegistryIndex::open(const fs::path &file)
+  {
+#ifndef _WIN32
+    const int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return std::nullopt;
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header)))
+    {
+      ::close(fd);
+      return std::nullopt;
+    }
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void *map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+      return std::nullopt;
+    std::shared_ptr<const void> storage(map, [size](const void *p) { ::munmap(const_cast<void *>(p), size); });
+    return from_storage(std::move(storage), static_cast<const char *>(map), size);
+#else
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+      return std::nullopt;
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return from_bytes(ss.str());
+#endif
+  }
+
+  std::optional<CompiledRegistryIndex> CompiledRegistryIndex::from_bytes(std::string bytes)
+  {
+    auto holder = std::make_shared<const std::string>(std::move(bytes));
+    const char *data = holder->data();
+    const std::size_t size = holder->size();
+    return from_storage(std::move(holder), data, size);
+  }
+
+  std::optional<CompiledRegistryIndex> CompiledRegistryIndex::from_storage(
+      std::shared_ptr<const void> storage, const char *data, std::size_t size)
+  {
+    if (size < sizeof(Header))
+      return std::nullopt;
+    const Header h = read_at<Header>(data, 0);
+    if (std::memcmp(h.magic, MAGIC, sizeof MAGIC) != 0 || h.format != FORMAT || h.byteOrder != BYTE_ORDER_MARK)
+      return std::nullopt;
+
+    auto table_fits = [&](std::uint64_t at, std::uint64_t count, std::uint64_t each)
+    { return at <= size && count * each <= size - at; };
+    if (!table_fits(h.packagesAt, h.packageCount, sizeof(PackageRecord)) ||
+        !table_fits(h.versionsAt, h.versionCount, sizeof(VersionRecord)) ||
+        !table_fits(h.extensionsAt, h.extensionCount, sizeof(ExtensionRecord)) ||
+        !table_fits(h.stringsAt, h.stringsSize, 1))
+      return std::nullopt;
+
+    CompiledRegistryIndex index;
+    index.storage_ = std::move(storage);
+    index.data_ = data;
+    index.size_ = size;
+    index.packageCount_ = h.packageCount;
+    index.versionCount_ = h.versionCount;
+    index.extensionCount_ = h.extensionCount;
+    index.packages_ = h.packagesAt;
+    index.versionsAt_ = h.versionsAt;
+    index.extensionsAt_ = h.extensionsAt;
+    index.strings_ = h.stringsAt;
+    index.stringsSize_ = h.stringsSize;
+    return index;
+  }
+
+  std::string_view CompiledRegistryIndex::str(std::uint32_t offset, std::uint32_t length) const
+  {
+    if (offset > stringsSize_ || length > stringsSize_ - offset)
+      return {};
+    return std::string_view(data_ + strings_ + offset, length);
+  }
+
+  std::string_view CompiledRegistryIndex::revision() const
+  {
+    const Ref r = read_at<Header>(data_, 0).revision;
+    return str(r.offset, r.length);
+  }
+
+  IndexedPackage CompiledRegistryIndex::package(std::size_t i) const
+  {
+    const PackageRecord rec = read_at<PackageRecord>(data_, packages_ + i * sizeof(PackageRecord));
+    auto s = [&](Ref r) { return str(r.offset, r.length); };
+    IndexedPackage out;
+    out.file = s(rec.file);
+    out.namespaceName = s(rec.ns);
+    out.name = s(rec.name);
+    out.displayName = s(rec.displayName);
+    out.description = s(rec.description);
+    out.type = s(rec.type);
+    out.publisher = s(rec.publisher);
+    out.repository = s(rec.repository);
+    out.latest = s(rec.latest);
+    out.keywords = s(rec.keywords);
+    out.categories = s(rec.categories);
+    out.firstVersion = rec.firstVersion;
+    out.versionCount = rec.versionCount;
+    out.firstExtension = rec.firstExtension;
+    out.extensionCount = rec.extensionCount;
+    return out;
+  }
+
+  std::optional<IndexedPackage> CompiledRegistryIndex::find(std::string_view file) const
+  {
+    std::size_t lo = 0;
+    std::size_t hi = packageCount_;
+    while (lo < hi)
+    {
+      const std::size_t mid = lo + (hi - lo) / 2;
+      // `file` is the first field of a record.
+      const Ref r = read_at<Ref>(data_, packages_ + mid * sizeof(PackageRecord));
+      const int c = str(r.offset, r.length).compare(file);
+      if (c == 0)
+        return package(mid);
+      if (c < 0)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return std::nullopt;
+  }
+
+  std::optional<IndexedPackage> CompiledRegistryIndex::find(std::string_view ns, std::string_view name) const
+  {
+    std::string file;
+    file.reserve(ns.size() + 1 + name.size());
+    file.append(ns).append(".").append(name);
+    return find(std::string_view(file));
+  }
+
+  std::vector<IndexedVersion> CompiledRegistryIndex::versions(const IndexedPackage &package) const
+  {
+    std::vector<IndexedVersion> out;
+    if (package.firstVersion > versionCount_ || package.versionCount > versionCount_ - package.firstVersion)
+      return out;
+    out.reserve(package.versionCount);
+    for (std::size_t i = package.firstVersion; i < package.firstVersion + package.versionCount; ++i)
+    {
+      const VersionRecord rec = read_at<VersionRecord>(data_, versionsAt_ + i * sizeof(VersionRecord));
+      out.push_back({str(rec.version.offset, rec.version.length), str(rec.tag.offset, rec.tag.length),
+                     str(rec.commit.offset, rec.commit.length), str(rec.deps.offset, rec.deps.length),
+                     (rec.flags & DECLARES_DEPS) != 0});
+    }
+    return out;
+  }
+
+  std::vector<IndexedExtension> CompiledRegistryIndex::extensions(const IndexedPackage &package) const
+  {
+    std::vector<IndexedExtension> out;
+    if (package.firstExtension > extensionCount_ || package.extensionCount > extensionCount_ - package.firstExtension)
+      return out;
+    for (std::size_t i = package.firstExtension; i < package.firstExtension + package.extensionCount; ++i)
+    {
+      const ExtensionRecord rec = read_at<ExtensionRecord>(data_, extensionsAt_ + i * sizeof(ExtensionRecord));
+      out.push_back({str(rec.host.offset, rec.host.length), str(rec.api.offset, rec.api.length),
+                     str(rec.capabilities.offset, rec.capabilities.length), str(rec.cellTypes.offset, rec.cellTypes.length)});
+    }
+    return out;
+  }
+
+  std::optional<IndexedExtension> CompiledRegistryIndex::extension(const IndexedPackage &package, std::string_view host) const
+  {
+    for (const auto &ext : extensions(package))
+      if (ext.host == host)
+        return ext;
+    return std::nullopt;
+  }
+
+  std::vector<std::string_view> split_index_list(std::string_view list)
+  {
+    std::vector<std::string_view> out;
+    while (!list.empty())
+    {
+      const auto nl = list.find('\n');
+      out.push_back(list.substr(0, nl));
+      if (nl == std::string_view::npos)
+        break;
+      list.remove_prefix(nl + 1);
+    }
+    return out;
+  }
+
+  fs::path compiled_index_path(const fs::path &repositoryPath)
+  {
+    return fs::path(repositoryPath.string() + ".bin");
+  }
+
+  std::string registry_index_revision(const fs::path &repositoryPath)
+  {
+    if (const auto head = git_head(repositoryPath))
+      return "git:" + *head;
+
+    std::uint64_t sum = 0;
+    std::size_t files = 0;
+    std::error_code ec;
+    for (const auto &item : fs::directory_iterator(repositoryPath / "index", ec))
+    {
+      std::error_code fileEc;
+      if (!item.is_regular_file(fileEc) || item.path().extension() != ".json")
+        continue;
+      const auto size = item.file_size(fileEc);
+      const auto mtime = item.last_write_time(fileEc).time_since_epoch().count();
+      std::uint64_t h = vix::cli::util::fnv1a64_str(item.path().filename().string(), 1469598103934665603ull);
+      h = vix::cli::util::fnv1a64_bytes(&size, sizeof size, h);
+      h = vix::cli::util::fnv1a64_bytes(&mtime, sizeof mtime, h);
+      sum += h;
+      ++files;
+    }
+    return "files:" + std::to_string(files) + ":" + vix::cli::util::hex64(sum);
+  }
+
+  std::optional<std::size_t> compile_registry_index(const fs::path &repositoryPath, std::string *error)
+  {
+    std::size_t packages = 0;
+    const auto bytes = build_index(repositoryPath, registry_index_revision(repositoryPath), packages, error);
+    if (!bytes)
+      return std::nullopt;
+    if (!write_atomic(compiled_index_path(repositoryPath), *bytes))
+    {
+      if (error)
+        *error = "cannot write " + compiled_index_path(repositoryPath).string();
+      return std::nullopt;
+    }
+    return packages;
+  }
+
+  std::optional<CompiledRegistryIndex> open_registry_index(const fs::path &repositoryPath, std::string *error)
+  {
+    std::error_code ec;
+    if (!fs::is_directory(repositoryPath / "index", ec))
+    {
+      if (error)
+        *error = "registry not synced";
+      return std::nullopt;
+    }
+
+    const std::string revision = registry_index_revision(repositoryPath);
+    if (auto index = CompiledRegistryIndex::open(compiled_index_path(repositoryPath)); index && index->revision() == revision)
+      return index;
+
+    std::size_t packages = 0;
+    auto bytes = build_index(repositoryPath, revision, packages, error);
+    if (!bytes)
+      return std::nullopt;
+    write_atomic(compiled_index_path(repositoryPath), *bytes);
+    return CompiledRegistryIndex::from_bytes(std::move(*bytes));
+  }
+}
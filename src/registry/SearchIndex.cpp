@@ -0,0 +1,662 @@
+#include <vix/cli/registry/SearchIndex.hpp>
+
+#include <vix/cli/util/Fs.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace vix::cli::registry
+{
+  namespace
+  {
+    // Layout, all integers native-endian u32:
+    //   Header | DocRecord[docCount] (compiled index order) |
+    //   TermRecord[termCount] (sorted by text) | Posting[postingCount] |
+    //   TrigramRecord[trigramCount] (sorted by key) | u32 term[trigramTermCount] |
+    //   strings
+    constexpr char MAGIC[8] = {'V', 'I', 'X', 'S', 'I', 'D', 'X', '\n'};
+    constexpr std::uint32_t FORMAT = 1;
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+    // BM25 parameters and per-field term weights.
+    constexpr double K1 = 1.2;
+    constexpr double B = 0.75;
+    constexpr std::uint32_t NAME_WEIGHT = 3;
+    constexpr std::uint32_t KEYWORD_WEIGHT = 2;
+    constexpr std::uint32_t TEXT_WEIGHT = 1;
+
+    // Query expansion: a term containing the token, or a typo of it, counts
+    // for less than the token itself.
+    constexpr double PREFIX_WEIGHT = 0.8;
+    constexpr double SUBSTRING_WEIGHT = 0.6;
+    constexpr double TYPO_WEIGHT = 0.5;
+    constexpr std::size_t MAX_EXPANSIONS = 64;
+    constexpr std::size_t MAX_TOKEN = 64;
+
+    constexpr double EXACT_NAME_BOOST = 2.0;
+    constexpr double EXACT_ID_BOOST = 3.0;
+
+    struct Ref
+    {
+      std::uint32_t offset{0};
+      std::uint32_t length{0};
+    };
+
+    struct Header
+    {
+      char magic[8];
+      std::uint32_t format;
+      std::uint32_t byteOrder;
+      Ref revision;
+      std::uint32_t docCount;
+      std::uint32_t termCount;
+      std::uint32_t postingCount;
+      std::uint32_t trigramCount;
+      std::uint32_t trigramTermCount;
+      std::uint32_t totalLength;
+      std::uint32_t docsAt;
+      std::uint32_t termsAt;
+      std::uint32_t postingsAt;
+      std::uint32_t trigramsAt;
+      std::uint32_t trigramTermsAt;
+      std::uint32_t stringsAt;
+      std::uint32_t stringsSize;
+    };
+
+    struct DocRecord
+    {
+      Ref id, name; // lowercased, for the exact-match boosts
+      std::uint32_t length;
+    };
+
+    struct TermRecord
+    {
+      Ref text;
+      std::uint32_t firstPosting, postingCount;
+    };
+
+    struct Posting
+    {
+      std::uint32_t doc, frequency; // field-weighted
+    };
+
+    struct TrigramRecord
+    {
+      std::uint32_t key, firstTerm, termCount;
+    };
+
+    static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 76);
+    static_assert(std::is_trivially_copyable_v<DocRecord> && sizeof(DocRecord) == 20);
+    static_assert(std::is_trivially_copyable_v<TermRecord> && sizeof(TermRecord) == 16);
+    static_assert(std::is_trivially_copyable_v<Posting> && sizeof(Posting) == 8);
+    static_assert(std::is_trivially_copyable_v<TrigramRecord> && sizeof(TrigramRecord) == 12);
+
+    template <typename T>
+    T read_at(const char *data, std::size_t offset)
+    {
+      T value;
+      std::memcpy(&value, data + offset, sizeof(T));
+      return value;
+    }
+
+    template <typename T>
+    void append(std::string &out, const std::vector<T> &items)
+    {
+      out.append(reinterpret_cast<const char *>(items.data()), items.size() * sizeof(T));
+    }
+
+    std::string lower(std::string_view s)
+    {
+      std::string out(s);
+      std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c)
+                     { return static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c); });
+      return out;
+    }
+
+    std::string trimmed_lower(std::string_view s)
+    {
+      const auto first = s.find_first_not_of(" \t");
+      if (first == std::string_view::npos)
+        return {};
+      return lower(s.substr(first, s.find_last_not_of(" \t") - first + 1));
+    }
+
+    std::uint32_t trigram_key(const char *p)
+    {
+      return (static_cast<std::uint32_t>(static_cast<unsigned char>(p[0])) << 16) |
+             (static_cast<std::uint32_t>(static_cast<unsigned char>(p[1])) << 8) |
+             static_cast<std::uint32_t>(static_cast<unsigned char>(p[2]));
+    }
+
+    // Distinct trigrams of `s`, padded with '$' on both sides when asked,
+    // so that "$js" and "on$" also mark the start and end of a term.
+    std::vector<std::uint32_t> trigrams(std::string_view s, bool padded)
+    {
+      const std::string text = padded ? "$" + std::string(s) + "$" : std::string(s);
+      std::vector<std::uint32_t> out;
+      for (std::size_t i = 0; i + 3 <= text.size(); ++i)
+        out.push_back(trigram_key(text.data() + i));
+      std::sort(out.begin(), out.end());
+      out.erase(std::unique(out.begin(), out.end()), out.end());
+      return out;
+    }
+
+    // Optimal string alignment distance, giving up past `limit`.
+    std::size_t edit_distance(std::string_view a, std::string_view b, std::size_t limit)
+    {
+      if ((a.size() > b.size() ? a.size() - b.size() : b.size() - a.size()) > limit)
+        return limit + 1;
+      std::vector<std::size_t> prev2(b.size() + 1), prev(b.size() + 1), cur(b.size() + 1);
+      for (std::size_t j = 0; j <= b.size(); ++j)
+        prev[j] = j;
+      for (std::size_t i = 1; i <= a.size(); ++i)
+      {
+        cur[0] = i;
+        std::size_t rowMin = cur[0];
+        for (std::size_t j = 1; j <= b.size(); ++j)
+        {
+          const std::size_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+          cur[j] = std::min({prev[j] + 1, cur[j - 1] + 1, prev[j - 1] + cost});
+          if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+            cur[j] = std::min(cur[j], prev2[j - 2] + 1);
+          rowMin = std::min(rowMin, cur[j]);
+        }
+        if (rowMin > limit)
+          return limit + 1;
+        std::swap(prev2, prev);
+        std::swap(prev, cur);
+      }
+      return prev[b.size()];
+    }
+
+    class Builder
+    {
+    public:
+      explicit Builder(const CompiledRegistryIndex &index) : index_(index) {}
+
+      std::string build()
+      {
+        for (std::size_t i = 0; i < index_.size(); ++i)
+          add_document(static_cast<std::uint32_t>(i), index_.package(i));
+
+        // Terms in text order, so a token finds its term and its prefixes
+        // by binary search.
+        std::vector<std::uint32_t> order(vocabulary_.size());
+        for (std::uint32_t i = 0; i < order.size(); ++i)
+          order[i] = i;
+        std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b)
+                  { return texts_[a] < texts_[b]; });
+
+        std::vector<TermRecord> terms;
+        std::vector<Posting> postings;
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> grams;
+        terms.reserve(order.size());
+        for (std::uint32_t t = 0; t < order.size(); ++t)
+        {
+          const std::uint32_t source = order[t];
+          terms.push_back({add(texts_[source]), static_cast<std::uint32_t>(postings.size()),
+                           static_cast<std::uint32_t>(postings_[source].size())});
+          postings.insert(postings.end(), postings_[source].begin(), postings_[source].end());
+          for (const auto key : trigrams(texts_[source], true))
+            grams.emplace_back(key, t);
+        }
+        std::sort(grams.begin(), grams.end());
+
+        std::vector<TrigramRecord> trigramRecords;
+        std::vector<std::uint32_t> trigramTerms;
+        trigramTerms.reserve(grams.size());
+        for (const auto &[key, t] : grams)
+        {
+          if (trigramRecords.empty() || trigramRecords.back().key != key)
+            trigramRecords.push_back({key, static_cast<std::uint32_t>(trigramTerms.size()), 0});
+          ++trigramRecords.back().termCount;
+          trigramTerms.push_back(t);
+        }
+
+        Header h{};
+        std::memcpy(h.magic, MAGIC, sizeof MAGIC);
+        h.format = FORMAT;
+        h.byteOrder = BYTE_ORDER_MARK;
+        h.revision = add(std::string(index_.revision()));
+        h.docCount = static_cast<std::uint32_t>(docs_.size());
+        h.termCount = static_cast<std::uint32_t>(terms.size());
+        h.postingCount = static_cast<std::uint32_t>(postings.size());
+        h.trigramCount = static_cast<std::uint32_t>(trigramRecords.size());
+        h.trigramTermCount = static_cast<std::uint32_t>(trigramTerms.size());
+        h.totalLength = static_cast<std::uint32_t>(std::min<std::uint64_t>(totalLength_, UINT32_MAX));
+        h.docsAt = sizeof(Header);
+        h.termsAt = h.docsAt + h.docCount * static_cast<std::uint32_t>(sizeof(DocRecord));
+        h.postingsAt = h.termsAt + h.termCount * static_cast<std::uint32_t>(sizeof(TermRecord));
+        h.trigramsAt = h.postingsAt + h.postingCount * static_cast<std::uint32_t>(sizeof(Posting));
+        h.trigramTermsAt = h.trigramsAt + h.trigramCount * static_cast<std::uint32_t>(sizeof(TrigramRecord));
+        h.stringsAt = h.trigramTermsAt + h.trigramTermCount * static_cast<std::uint32_t>(sizeof(std::uint32_t));
+        h.stringsSize = static_cast<std::uint32_t>(strings_.size());
+
+        std::string out;
+        out.reserve(h.stringsAt + strings_.size());
+        out.append(reinterpret_cast<const char *>(&h), sizeof h);
+        append(out, docs_);
+        append(out, terms);
+        append(out, postings);
+        append(out, trigramRecords);
+        append(out, trigramTerms);
+        out += strings_;
+        return out;
+      }
+
+    private:
+      Ref add(const std::string &s)
+      {
+        if (s.empty())
+          return {};
+        const auto [it, inserted] = pool_.emplace(s, Ref{static_cast<std::uint32_t>(strings_.size()), static_cast<std::uint32_t>(s.size())});
+        if (inserted)
+          strings_ += s;
+        return it->second;
+      }
+
+      void add_document(std::uint32_t doc, const IndexedPackage &package)
+      {
+        std::unordered_map<std::string, std::uint32_t> frequencies;
+        auto index_text = [&](std::string_view text, std::uint32_t weight)
+        {
+          for (auto &token : search_tokens(text))
+            frequencies[std::move(token)] += weight;
+        };
+
+        index_text(package.namespaceName, NAME_WEIGHT);
+        index_text(package.name, NAME_WEIGHT);
+        index_text(package.displayName, NAME_WEIGHT);
+        index_text(package.keywords, KEYWORD_WEIGHT);
+        index_text(package.categories, KEYWORD_WEIGHT);
+        index_text(package.description, TEXT_WEIGHT);
+        index_text(package.publisher, TEXT_WEIGHT);
+        index_text(package.type, TEXT_WEIGHT);
+        for (const auto &ext : index_.extensions(package))
+        {
+          index_text(ext.host, TEXT_WEIGHT);
+          index_text(ext.capabilities, TEXT_WEIGHT);
+          index_text(ext.cellTypes, TEXT_WEIGHT);
+        }
+
+        std::uint32_t length = 0;
+        for (auto &[token, frequency] : frequencies)
+        {
+          auto [it, inserted] = vocabulary_.emplace(token, static_cast<std::uint32_t>(texts_.size()));
+          if (inserted)
+          {
+            texts_.push_back(token);
+            postings_.emplace_back();
+          }
+          postings_[it->second].push_back({doc, frequency});
+          length += frequency;
+        }
+        totalLength_ += length;
+
+        const std::string name = lower(package.name);
+        docs_.push_back({add(lower(package.namespaceName) + "/" + name), add(name), length});
+      }
+
+      const CompiledRegistryIndex &index_;
+      std::string strings_;
+      std::unordered_map<std::string, Ref> pool_;
+      std::vector<DocRecord> docs_;
+      std::unordered_map<std::string, std::uint32_t> vocabulary_;
+      std::vector<std::string> texts_;
+      std::vector<std::vector<Posting>> postings_;
+      std::uint64_t totalLength_{0};
+    };
+  }
+
+  std::vector<std::string> search_tokens(std::string_view text)
+  {
+    std::vector<std::string> out;
+    std::string token;
+    auto flush = [&]()
+    {
+      if (!token.empty() && token.size() <= MAX_TOKEN)
+        out.push_back(token);
+      token.clear();
+    };
+    for (const char ch : text)
+    {
+      const unsigned char c = static_cast<unsigned char>(ch);
+      if (c >= 'A' && c <= 'Z')
+        token += static_cast<char>(c - 'A' + 'a');
+      else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9'))
+        token += static_cast<char>(c);
+      else
+        flush();
+    }
+    flush();
+    return out;
+  }
+
+  std::string build_search_index(const CompiledRegistryIndex &index)
+  {
+    return Builder(index).build();
+  }
+
+  std::optional<RegistrySearchIndex> RegistrySearchIndex::open(const fs::path &file)
+  {
+#ifndef _WIN32
+    const int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return std::nullopt;
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header)))
+    {
+      ::close(fd);
+      return std::nullopt;
+    }
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void *map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+      return std::nullopt;
+    std::shared_ptr<const void> storage(map, [size](const void *p) { ::munmap(const_cast<void *>(p), size); });
+    return from_storage(std::move(storage), static_cast<const char *>(map), size);
+#else
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+      return std::nullopt;
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return from_bytes(ss.str());
+#endif
+  }
+
+  std::optional<RegistrySearchIndex> RegistrySearchIndex::from_bytes(std::string bytes)
+  {
+    auto holder = std::make_shared<const std::string>(std::move(bytes));
+    const char *data = holder->data();
+    const std::size_t size = holder->size();
+    return from_storage(std::move(holder), data, size);
+  }
+
+  std::optional<RegistrySearchIndex> RegistrySearchIndex::from_storage(
+      std::shared_ptr<const void> storage, const char *data, std::size_t size)
+  {
+    if (size < sizeof(Header))
+      return std::nullopt;
+    const Header h = read_at<Header>(data, 0);
+    if (std::memcmp(h.magic, MAGIC, sizeof MAGIC) != 0 || h.format != FORMAT || h.byteOrder != BYTE_ORDER_MARK)
+      return std::nullopt;
+
+    auto table_fits = [&](std::uint64_t at, std::uint64_t count, std::uint64_t each)
+    { return at <= size && count * each <= size - at; };
+    if (!table_fits(h.docsAt, h.docCount, sizeof(DocRecord)) ||
+        !table_fits(h.termsAt, h.termCount, sizeof(TermRecord)) ||
+        !table_fits(h.postingsAt, h.postingCount, sizeof(Posting)) ||
+        !table_fits(h.trigramsAt, h.trigramCount, sizeof(TrigramRecord)) ||
+        !table_fits(h.trigramTermsAt, h.trigramTermCount, sizeof(std::uint32_t)) ||
+        !table_fits(h.stringsAt, h.stringsSize, 1))
+      return std::nullopt;
+
+    RegistrySearchIndex index;
+    index.storage_ = std::move(storage);
+    index.data_ = data;
+    index.docCount_ = h.docCount;
+    index.termCount_ = h.termCount;
+    index.postingCount_ = h.postingCount;
+    index.trigramCount_ = h.trigramCount;
+    index.trigramTermCount_ = h.trigramTermCount;
+    index.averageLength_ = h.docCount == 0 ? 1.0 : std::max(1.0, static_cast<double>(h.totalLength) / h.docCount);
+    index.docsAt_ = h.docsAt;
+    index.termsAt_ = h.termsAt;
+    index.postingsAt_ = h.postingsAt;
+    index.trigramsAt_ = h.trigramsAt;
+    index.trigramTermsAt_ = h.trigramTermsAt;
+    index.strings_ = h.stringsAt;
+    index.stringsSize_ = h.stringsSize;
+    return index;
+  }
+
+  std::string_view RegistrySearchIndex::str(std::uint32_t offset, std::uint32_t length) const
+  {
+    if (offset > stringsSize_ || length > stringsSize_ - offset)
+      return {};
+    return std::string_view(data_ + strings_ + offset, length);
+  }
+
+  std::string_view RegistrySearchIndex::revision() const
+  {
+    const Ref r = read_at<Header>(data_, 0).revision;
+    return str(r.offset, r.length);
+  }
+
+  std::string_view RegistrySearchIndex::term(std::uint32_t i) const
+  {
+    // `text` is the first field of a record.
+    const Ref r = read_at<Ref>(data_, termsAt_ + i * sizeof(TermRecord));
+    return str(r.offset, r.length);
+  }
+
+  std::optional<std::uint32_t> RegistrySearchIndex::find_term(std::string_view token) const
+  {
+    std::size_t lo = 0;
+    std::size_t hi = termCount_;
+    while (lo < hi)
+    {
+      const std::size_t mid = lo + (hi - lo) / 2;
+      if (term(static_cast<std::uint32_t>(mid)) < token)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    if (lo < termCount_ && term(static_cast<std::uint32_t>(lo)) == token)
+      return static_cast<std::uint32_t>(lo);
+    return std::nullopt;
+  }
+
+  std::vector<RegistrySearchIndex::Expansion> RegistrySearchIndex::expand(const std::string &token) const
+  {
+    std::vector<Expansion> out;
+    const auto exact = find_term(token);
+    if (exact)
+      out.push_back({*exact, 1.0});
+
+    if (token.size() < 3)
+    {
+      // Too short for trigrams: terms starting with the token.
+      std::size_t lo = 0;
+      std::size_t hi = termCount_;
+      while (lo < hi)
+      {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (term(static_cast<std::uint32_t>(mid)) < token)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      for (std::size_t t = lo; t < termCount_ && out.size() < MAX_EXPANSIONS; ++t)
+      {
+        const std::string_view text = term(static_cast<std::uint32_t>(t));
+        if (text.substr(0, token.size()) != token)
+          break;
+        if (text != token)
+          out.push_back({static_cast<std::uint32_t>(t), PREFIX_WEIGHT * static_cast<double>(token.size()) / static_cast<double>(text.size())});
+      }
+      return out;
+    }
+
+    // Count, per term, the token's inner trigrams (all present when the
+    // term contains the token) and its padded ones (any shared for a typo).
+    const auto inner = trigrams(token, false);
+    // shared[t] is 1 + the inner trigrams term t has, 0 when it has none.
+    std::vector<std::uint8_t> shared(termCount_, 0);
+    std::vector<std::uint32_t> candidates;
+    for (const auto key : trigrams(token, true))
+    {
+      std::size_t lo = 0;
+      std::size_t hi = trigramCount_;
+      while (lo < hi)
+      {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (read_at<std::uint32_t>(data_, trigramsAt_ + mid * sizeof(TrigramRecord)) < key)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      if (lo == trigramCount_)
+        continue;
+      const TrigramRecord rec = read_at<TrigramRecord>(data_, trigramsAt_ + lo * sizeof(TrigramRecord));
+      if (rec.key != key || rec.firstTerm > trigramTermCount_ || rec.termCount > trigramTermCount_ - rec.firstTerm)
+        continue;
+      const bool isInner = std::binary_search(inner.begin(), inner.end(), key);
+      for (std::uint32_t i = rec.firstTerm; i < rec.firstTerm + rec.termCount; ++i)
+      {
+        const auto t = read_at<std::uint32_t>(data_, trigramTermsAt_ + i * sizeof(std::uint32_t));
+        if (t >= termCount_)
+          continue;
+        if (shared[t] == 0)
+        {
+          candidates.push_back(t);
+          shared[t] = 1;
+        }
+        shared[t] = static_cast<std::uint8_t>(shared[t] + (isInner ? 1 : 0));
+      }
+    }
+
+    const std::size_t maxTypos = token.size() >= 8 ? 2 : 1;
+    for (const auto t : candidates)
+    {
+      if (exact && t == *exact)
+        continue;
+      const std::string_view text = term(t);
+      if (shared[t] - 1u == inner.size() && text.find(token) != std::string_view::npos)
+      {
+        const double ratio = static_cast<double>(token.size()) / static_cast<double>(text.size());
+        out.push_back({t, (text.substr(0, token.size()) == token ? PREFIX_WEIGHT : SUBSTRING_WEIGHT) * ratio});
+        continue;
+      }
+      // Typos only stand in for tokens the registry does not know.
+      if (exact || token.size() < 4)
+        continue;
+      const std::size_t distance = edit_distance(token, text, maxTypos);
+      if (distance <= maxTypos)
+        out.push_back({t, TYPO_WEIGHT * (1.0 - static_cast<double>(distance) / static_cast<double>(token.size()))});
+    }
+
+    if (out.size() > MAX_EXPANSIONS)
+    {
+      std::partial_sort(out.begin(), out.begin() + MAX_EXPANSIONS, out.end(), [](const Expansion &a, const Expansion &b)
+                        { return a.weight != b.weight ? a.weight > b.weight : a.term < b.term; });
+      out.resize(MAX_EXPANSIONS);
+    }
+    return out;
+  }
+
+  std::vector<SearchHit> RegistrySearchIndex::search(std::string_view query, std::size_t ranked) const
+  {
+    std::vector<std::string> tokens = search_tokens(query);
+    std::sort(tokens.begin(), tokens.end());
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+
+    std::vector<SearchHit> hits;
+    if (tokens.empty() || docCount_ == 0)
+      return hits;
+
+    // A document scores each query token once, through its best expansion.
+    std::vector<float> scores(docCount_, 0.0f);
+    std::vector<float> best(docCount_, 0.0f);
+    std::vector<std::uint32_t> matched;
+    std::vector<std::uint32_t> touched;
+    const double n = static_cast<double>(docCount_);
+    for (const auto &token : tokens)
+    {
+      touched.clear();
+      for (const auto &[t, weight] : expand(token))
+      {
+        const TermRecord rec = read_at<TermRecord>(data_, termsAt_ + t * sizeof(TermRecord));
+        if (rec.firstPosting > postingCount_ || rec.postingCount > postingCount_ - rec.firstPosting)
+          continue;
+        const double df = rec.postingCount;
+        const double idf = std::log(1.0 + (n - df + 0.5) / (df + 0.5));
+        for (std::uint32_t i = rec.firstPosting; i < rec.firstPosting + rec.postingCount; ++i)
+        {
+          const Posting p = read_at<Posting>(data_, postingsAt_ + i * sizeof(Posting));
+          if (p.doc >= docCount_)
+            continue;
+          const double length = read_at<std::uint32_t>(data_, docsAt_ + p.doc * sizeof(DocRecord) + offsetof(DocRecord, length));
+          const double tf = p.frequency;
+          const auto s = static_cast<float>(weight * idf * tf * (K1 + 1.0) / (tf + K1 * (1.0 - B + B * length / averageLength_)));
+          if (best[p.doc] == 0.0f)
+            touched.push_back(p.doc);
+          best[p.doc] = std::max(best[p.doc], s);
+        }
+      }
+      for (const auto doc : touched)
+      {
+        if (scores[doc] == 0.0f)
+          matched.push_back(doc);
+        scores[doc] += best[doc];
+        best[doc] = 0.0f;
+      }
+    }
+
+    const std::string exact = trimmed_lower(query);
+    hits.reserve(matched.size());
+    for (const auto doc : matched)
+    {
+      double score = scores[doc];
+      const DocRecord rec = read_at<DocRecord>(data_, docsAt_ + doc * sizeof(DocRecord));
+      if (rec.id.length == exact.size() && str(rec.id.offset, rec.id.length) == exact)
+        score *= EXACT_ID_BOOST;
+      else if (rec.name.length == exact.size() && str(rec.name.offset, rec.name.length) == exact)
+        score *= EXACT_NAME_BOOST;
+      hits.push_back({doc, score});
+    }
+    rank_search_hits(hits, ranked);
+    return hits;
+  }
+
+  void rank_search_hits(std::vector<SearchHit> &hits, std::size_t ranked)
+  {
+    const auto better = [](const SearchHit &a, const SearchHit &b)
+    { return a.score != b.score ? a.score > b.score : a.package < b.package; };
+    if (ranked >= hits.size())
+      std::sort(hits.begin(), hits.end(), better);
+    else
+      std::partial_sort(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(ranked), hits.end(), better);
+  }
+
+  fs::path search_index_path(const fs::path &repositoryPath)
+  {
+    return fs::path(repositoryPath.string() + ".search");
+  }
+
+  std::optional<RegistrySearchIndex> open_search_index(
+      const fs::path &repositoryPath,
+      const CompiledRegistryIndex &index,
+      std::string *error)
+  {
+    const fs::path path = search_index_path(repositoryPath);
+    if (auto search = RegistrySearchIndex::open(path);
+        search && search->revision() == index.revision() && search->documents() == index.size())
+      return search;
+
+    std::string bytes = build_search_index(index);
+    vix::cli::util::write_text_file_atomic(path, bytes);
+    auto search = RegistrySearchIndex::from_bytes(std::move(bytes));
+    if (!search && error)
+      *error = "cannot build registry search index";
+    return search;
+  }
+}
@@ -0,0 +1,452 @@
+/**
+ *
+ *  @file CompilerIdentity.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#include <vix/cli/util/CompilerIdentity.hpp>
+#include <vix/cli/util/Fs.hpp>
+#include <vix/cli/commands/helpers/ProcessHelpers.hpp>
+#include <vix/utils/Env.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <system_error>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace vix::cli::util
+{
+  namespace
+  {
+    using json = nlohmann::json;
+
+    constexpr int CACHE_FORMAT_VERSION = 2;
+
+    std::mutex g_memoMutex;
+    std::map<std::string, CompilerIdentity> g_memo;
+
+    std::string home_dir()
+    {
+#ifdef _WIN32
+      const char *home = vix::utils::vix_getenv("USERPROFILE");
+#else
+      const char *home = vix::utils::vix_getenv("HOME");
+#endif
+      return home ? std::string(home) : std::string();
+    }
+
+    std::string trim_copy(std::string s)
+    {
+      while (!s.empty() && (s.back() == '\n' || s.back() == '\r' || s.back() == ' ' || s.back() == '\t'))
+        s.pop_back();
+
+      std::size_t i = 0;
+      while (i < s.size() && (s[i] == ' ' || s[i] == '\t'))
+        ++i;
+
+      return s.substr(i);
+    }
+
+    bool starts_with(const std::string &s, const std::string &prefix)
+    {
+      return s.rfind(prefix, 0) == 0;
+    }
+
+    std::optional<fs::path> find_on_path(const std::string &exe)
+    {
+      if (exe.find('/') != std::string::npos
+#ifdef _WIN32
+          || exe.find('\\') != std::string::npos
+#endif
+      )
+      {
+        return fs::path(exe);
+      }
+
+      const char *pathEnv = vix::utils::vix_getenv("PATH");
+      if (!pathEnv || !*pathEnv)
+        return std::nullopt;
+
+#ifdef _WIN32
+      const char sep = ';';
+#else
+      const char sep = ':';
+#endif
+
+      std::stringstream ss{std::string(pathEnv)};
+      std::string entry;
+      while (std::getline(ss, entry, sep))
+      {
+        if (entry.empty())
+          continue;
+
+        std::error_code ec;
+        fs::path candidate = fs::path(entry) / exe;
+        if (fs::is_regular_file(candidate, ec))
+          return candidate;
+
+#ifdef _WIN32
+        candidate = fs::path(entry) / (exe + ".exe");
+        if (fs::is_regular_file(candidate, ec))
+          return candidate;
+#endif
+      }
+
+      return std::nullopt;
+    }
+
+    /**
+     * @brief Stat the binary: the only work done on a warm lookup.
+     */
+    bool stat_binary(const fs::path &path, CompilerIdentity &id)
+    {
+#ifndef _WIN32
+      struct stat st{};
+      if (::stat(path.c_str(), &st) != 0)
+        return false;
+
+      id.inode = static_cast<std::uint64_t>(st.st_ino);
+      id.size = static_cast<std::uint64_t>(st.st_size);
+#if defined(__APPLE__)
+      id.mtimeNs = static_cast<std::uint64_t>(st.st_mtimespec.tv_sec) * 1000000000ULL +
+                   static_cast<std::uint64_t>(st.st_mtimespec.tv_nsec);
+#else
+      id.mtimeNs = static_cast<std::uint64_t>(st.st_mtim.tv_sec) * 1000000000ULL +
+                   static_cast<std::uint64_t>(st.st_mtim.tv_nsec);
+#endif
+      return true;
+#else
+      std::error_code ec;
+      const auto size = fs::file_size(path, ec);
+      if (ec)
+        return false;
+
+      const auto mtime = fs::last_write_time(path, ec);
+      if (ec)
+        return false;
+
+      id.inode = 0;
+      id.size = static_cast<std::uint64_t>(size);
+      id.mtimeNs = static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count());
+      return true;
+#endif
+    }
+
+    bool same_binary(const CompilerIdentity &a, const CompilerIdentity &b)
+    {
+      return a.inode == b.inode && a.size == b.size && a.mtimeNs == b.mtimeNs;
+    }
+
+    json to_json(const CompilerIdentity &id)
+    {
+      return json{
+          {"inode", id.inode},
+          {"size", id.size},
+          {"mtime_ns", id.mtimeNs},
+          {"family", id.family},
+          {"version", id.version},
+          {"target", id.target},
+          {"default_std", id.defaultStandard},
+          {"include_dirs", id.builtinIncludeDirs},
+      };
+    }
+
+    std::optional<CompilerIdentity> from_json(const std::string &path, const json &j)
+    {
+      if (!j.is_object())
+        return std::nullopt;
+
+      try
+      {
+        CompilerIdentity id;
+        id.path = path;
+        id.inode = j.at("inode").get<std::uint64_t>();
+        id.size = j.at("size").get<std::uint64_t>();
+        id.mtimeNs = j.at("mtime_ns").get<std::uint64_t>();
+        id.family = j.at("family").get<std::string>();
+        id.version = j.at("version").get<std::string>();
+        id.target = j.at("target").get<std::string>();
+        id.defaultStandard = j.at("default_std").get<std::string>();
+        id.builtinIncludeDirs = j.at("include_dirs").get<std::vector<std::string>>();
+        return id;
+      }
+      catch (const std::exception &)
+      {
+        return std::nullopt;
+      }
+    }
+
+    json read_cache_file()
+    {
+      const std::string text = read_text_file_or_empty(compiler_identity_cache_file());
+      if (text.empty())
+        return json::object();
+
+      json doc = json::parse(text, nullptr, false);
+      if (!doc.is_object() || doc.value("version", 0) != CACHE_FORMAT_VERSION ||
+          !doc.contains("compilers") || !doc["compilers"].is_object())
+      {
+        return json::object();
+      }
+
+      return doc;
+    }
+
+    void store_in_cache_file(const CompilerIdentity &id)
+    {
+      // Read-modify-write: a concurrent writer may win, which only costs the
+      // loser one more probe later.
+      json doc = read_cache_file();
+      if (doc.empty())
+        doc = json{{"version", CACHE_FORMAT_VERSION}, {"compilers", json::object()}};
+
+      doc["compilers"][id.path] = to_json(id);
+      (void)write_text_file_atomic(compiler_identity_cache_file(), doc.dump(2) + "\n");
+    }
+
+    std::string standard_from_cplusplus(long value)
+    {
+      if (value >= 202302L)
+        return "c++23";
+      if (value >= 202002L)
+        return "c++20";
+      if (value >= 201703L)
+        return "c++17";
+      if (value >= 201402L)
+        return "c++14";
+      if (value >= 201103L)
+        return "c++11";
+      return "c++98";
+    }
+
+    std::optional<CompilerIdentity> probe_compiler(const fs::path &binary)
+    {
+      int code = 0;
+      const std::string out = vix::cli::commands::helpers::run_and_capture_with_code(
+          vix::cli::commands::helpers::quote(binary.string()) + " -x c++ -E -dM -v -"
+#ifdef _WIN32
+                                                                  " < NUL",
+#else
+                                                                  " < /dev/null",
+#endif
+          code);
+
+      if (code != 0)
+        return std::nullopt;
+
+      CompilerIdentity id;
+      if (!parse_compiler_probe_output(out, id))
+        return std::nullopt;
+
+      return id;
+    }
+  } // namespace
+
+  std::string default_cxx_compiler()
+  {
+    if (const char *env = vix::utils::vix_getenv("CXX"); env && *env)
+      return std::string(env);
+
+#ifdef _WIN32
+    return "g++";
+#else
+    return "c++";
+#endif
+  }
+
+  fs::path compiler_identity_cache_file()
+  {
+    const std::string home = home_dir();
+    const fs::path root = home.empty() ? fs::path(".vix") : fs::path(home) / ".vix";
+    return root / "cache" / "compilers.json";
+  }
+
+  bool parse_compiler_probe_output(const std::string &output, CompilerIdentity &id)
+  {
+    std::map<std::string, std::string> macros;
+    std::string targetLine;
+    bool inSearchList = false;
+
+    std::istringstream in(output);
+    std::string line;
+    while (std::getline(in, line))
+    {
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+
+      if (starts_with(line, "#define "))
+      {
+        const std::size_t nameEnd = line.find(' ', 8);
+        if (nameEnd != std::string::npos)
+          macros[line.substr(8, nameEnd - 8)] = line.substr(nameEnd + 1);
+        continue;
+      }
+
+      if (starts_with(line, "Target: "))
+      {
+        targetLine = trim_copy(line.substr(8));
+        continue;
+      }
+
+      if (starts_with(line, "#include <...> search starts here:"))
+      {
+        inSearchList = true;
+        continue;
+      }
+
+      if (starts_with(line, "End of search list."))
+      {
+        inSearchList = false;
+        continue;
+      }
+
+      if (inSearchList)
+      {
+        std::string dir = trim_copy(line);
+        // Darwin marks framework directories.
+        const std::string framework = " (framework directory)";
+        if (dir.size() > framework.size() &&
+            dir.compare(dir.size() - framework.size(), framework.size(), framework) == 0)
+        {
+          dir.resize(dir.size() - framework.size());
+        }
+
+        if (!dir.empty())
+        {
+          std::error_code ec;
+          const fs::path normalized = fs::weakly_canonical(fs::path(dir), ec);
+          id.builtinIncludeDirs.push_back(ec ? dir : normalized.string());
+        }
+      }
+    }
+
+    const auto macro = [&macros](const char *name) -> std::string
+    {
+      const auto it = macros.find(name);
+      return it == macros.end() ? std::string() : it->second;
+    };
+
+    if (!macro("__clang__").empty())
+    {
+      id.family = "clang";
+      id.version = macro("__clang_major__") + "." + macro("__clang_minor__") + "." +
+                   macro("__clang_patchlevel__");
+    }
+    else if (!macro("__GNUC__").empty())
+    {
+      id.family = "gcc";
+      id.version = macro("__GNUC__") + "." + macro("__GNUC_MINOR__") + "." +
+                   macro("__GNUC_PATCHLEVEL__");
+    }
+    else
+    {
+      id.family = "unknown";
+      id.version = "unknown";
+    }
+
+    id.target = targetLine.empty() ? "unknown" : targetLine;
+
+    const std::string cplusplus = macro("__cplusplus");
+    if (cplusplus.empty())
+      return false;
+
+    try
+    {
+      id.defaultStandard = standard_from_cplusplus(std::stol(cplusplus));
+    }
+    catch (const std::exception &)
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  std::optional<CompilerIdentity> compiler_identity(const std::string &compiler)
+  {
+    const auto found = find_on_path(compiler);
+    if (!found)
+      return std::nullopt;
+
+    // Entries are keyed on the name the compiler was invoked as, not on the
+    // binary it resolves to: ccache masquerade links and multi-call drivers
+    // (clang/clang++, g++-13) share one binary but not one identity. The
+    // binary only tells whether an entry is still valid.
+    std::error_code ec;
+    const fs::path binary = fs::canonical(*found, ec);
+    if (ec)
+      return std::nullopt;
+
+    CompilerIdentity current;
+    current.path = fs::absolute(*found, ec).lexically_normal().string();
+    if (ec || !stat_binary(binary, current))
+      return std::nullopt;
+
+    std::lock_guard<std::mutex> lock(g_memoMutex);
+
+    if (const auto it = g_memo.find(current.path);
+        it != g_memo.end() && same_binary(it->second, current))
+    {
+      CompilerIdentity hit = it->second;
+      hit.fromCache = true;
+      return hit;
+    }
+
+    const json doc = read_cache_file();
+    if (doc.contains("compilers") && doc["compilers"].contains(current.path))
+    {
+      if (auto cached = from_json(current.path, doc["compilers"][current.path]);
+          cached && same_binary(*cached, current))
+      {
+        cached->fromCache = true;
+        g_memo[current.path] = *cached;
+        return cached;
+      }
+    }
+
+    // Run the compiler through the name it was found under: drivers such as
+    // clang++ pick their mode from argv[0].
+    auto probed = probe_compiler(*found);
+    if (!probed)
+      return std::nullopt;
+
+    probed->path = current.path;
+    probed->inode = current.inode;
+    probed->size = current.size;
+    probed->mtimeNs = current.mtimeNs;
+
+    store_in_cache_file(*probed);
+    g_memo[current.path] = *probed;
+    return probed;
+  }
+
+  std::string compiler_identity_tag(const CompilerIdentity &id)
+  {
+    if (id.family == "clang")
+      return "clang++-" + id.version;
+    if (id.family == "gcc")
+      return "g++-" + id.version;
+    return "unknown-compiler";
+  }
+
+  void reset_compiler_identity_memo_for_test()
+  {
+    std::lock_guard<std::mutex> lock(g_memoMutex);
+    g_memo.clear();
+  }
+
+} // namespace vix::cli::util
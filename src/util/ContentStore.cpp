@@ -0,0 +1,322 @@
+#include <vix/cli/util/ContentStore.hpp>
+#include <vix/cli/util/Hash.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace vix::cli::util
+{
+  namespace fs = std::filesystem;
+  using json = nlohmann::json;
+
+  namespace
+  {
+    constexpr const char *MARKER = ".vix-content";
+    // Staging files younger than this may belong to a running materialize().
+    constexpr auto STAGING_GRACE = std::chrono::hours(1);
+    std::atomic<unsigned long> sequence{0};
+
+    std::string unique_suffix()
+    {
+      const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+      return ".tmp-" + std::to_string(now) + "-" + std::to_string(++sequence);
+    }
+
+    bool is_executable(fs::perms p)
+    {
+      return (p & (fs::perms::owner_exec | fs::perms::group_exec | fs::perms::others_exec)) != fs::perms::none;
+    }
+
+    std::string key_for(const fs::path &tree)
+    {
+      return hex64(fnv1a64_str(fs::absolute(tree).lexically_normal().generic_string(), 1469598103934665603ull));
+    }
+
+    bool write_json_atomic(const fs::path &p, const json &j)
+    {
+      const fs::path tmp = p.string() + unique_suffix();
+      {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out || !(out << j.dump()))
+          return false;
+      }
+      std::error_code ec;
+      fs::rename(tmp, p, ec);
+      if (ec)
+        fs::remove(tmp, ec);
+      return !ec;
+    }
+
+    json read_json(const fs::path &p)
+    {
+      std::ifstream in(p, std::ios::binary);
+      if (!in)
+        return json();
+      return json::parse(in, nullptr, false);
+    }
+
+    bool reflink(const fs::path &from, const fs::path &to)
+    {
+#ifdef __linux__
+      const int in = ::open(from.c_str(), O_RDONLY | O_CLOEXEC);
+      if (in < 0)
+        return false;
+      const int out = ::open(to.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0444);
+      if (out < 0)
+      {
+        ::close(in);
+        return false;
+      }
+      const bool ok = ::ioctl(out, FICLONE, in) == 0;
+      ::close(in);
+      ::close(out);
+      if (!ok)
+        ::unlink(to.c_str());
+      return ok;
+#else
+      (void)from;
+      (void)to;
+      return false;
+#endif
+    }
+
+    enum class Placed { Linked, Cloned, Copied };
+
+    Placed place(const fs::path &object, const fs::path &to)
+    {
+      std::error_code ec;
+      fs::create_hard_link(object, to, ec);
+      if (!ec)
+        return Placed::Linked;
+      if (reflink(object, to))
+        return Placed::Cloned;
+      ec.clear();
+      fs::copy_file(object, to, fs::copy_options::overwrite_existing, ec);
+      if (ec)
+        throw std::runtime_error("cannot materialize " + to.string() + ": " + ec.message());
+      return Placed::Copied;
+    }
+  }
+
+  std::string tree_signature(const fs::path &tree)
+  {
+    std::error_code ec;
+    if (!fs::is_directory(tree, ec))
+      return "missing";
+
+    std::uint64_t sum = 0;
+    std::size_t files = 0;
+    for (fs::recursive_directory_iterator it(tree, fs::directory_options::skip_permission_denied, ec), end;
+         !ec && it != end; it.increment(ec))
+    {
+      if (it->path().filename() == ".git")
+      {
+        it.disable_recursion_pending();
+        continue;
+      }
+
+      std::error_code fileEc;
+      if (!it->is_regular_file(fileEc))
+        continue;
+
+      const std::string rel = it->path().lexically_relative(tree).generic_string();
+      const auto size = it->file_size(fileEc);
+      const auto mtime = it->last_write_time(fileEc).time_since_epoch().count();
+      std::uint64_t h = fnv1a64_str(rel, 1469598103934665603ull);
+      h = fnv1a64_bytes(&size, sizeof size, h);
+      h = fnv1a64_bytes(&mtime, sizeof mtime, h);
+      sum += h;
+      ++files;
+    }
+    if (ec)
+      return "unreadable";
+    return std::to_string(files) + ":" + hex64(sum);
+  }
+
+  ContentStore::ContentStore(const fs::path &vixRoot)
+      : root_(vixRoot / "store" / "cas"), index_(vixRoot / "store" / "cas-index") {}
+
+  ContentStore::Materialized ContentStore::materialize(const fs::path &tree, const fs::path &dst) const
+  {
+    Materialized stats;
+    fs::create_directories(root_);
+    fs::create_directories(index_);
+
+    const std::string signature = tree_signature(tree);
+    if (signature == "missing" || signature == "unreadable")
+      throw std::runtime_error("cannot read dependency tree: " + tree.string());
+
+    // The manifest of an unchanged tree is reused as is: no file is read.
+    const fs::path manifestPath = index_ / (key_for(tree) + ".json");
+    json manifest = read_json(manifestPath);
+    if (!manifest.is_object() || manifest.value("signature", "") != signature)
+    {
+      manifest = json{{"tree", fs::absolute(tree).lexically_normal().generic_string()}, {"signature", signature}, {"entries", json::array()}};
+      std::error_code ec;
+      for (fs::recursive_directory_iterator it(tree, fs::directory_options::skip_permission_denied, ec), end;
+           !ec && it != end; it.increment(ec))
+      {
+        const std::string rel = it->path().lexically_relative(tree).generic_string();
+        if (it->path().filename() == ".git")
+        {
+          it.disable_recursion_pending();
+          continue;
+        }
+
+        std::error_code entryEc;
+        const fs::file_status st = it->symlink_status(entryEc);
+        if (fs::is_symlink(st))
+          manifest["entries"].push_back({{"path", rel}, {"kind", "symlink"}, {"target", fs::read_symlink(it->path(), entryEc).generic_string()}});
+        else if (fs::is_directory(st))
+          manifest["entries"].push_back({{"path", rel}, {"kind", "dir"}});
+        else if (fs::is_regular_file(st))
+        {
+          const auto sha = sha256_file(it->path());
+          if (!sha)
+            throw std::runtime_error("cannot hash " + it->path().string());
+          ++stats.hashed;
+          manifest["entries"].push_back({{"path", rel}, {"kind", "file"}, {"object", *sha + (is_executable(st.permissions()) ? "-x" : "")}});
+        }
+      }
+      if (ec)
+        throw std::runtime_error("cannot read dependency tree: " + tree.string());
+      write_json_atomic(manifestPath, manifest);
+    }
+
+    const fs::path tmp = dst.string() + unique_suffix();
+    std::error_code ec;
+    fs::create_directories(tmp);
+    try
+    {
+      for (const json &e : manifest["entries"])
+      {
+        const std::string kind = e.at("kind").get<std::string>();
+        const fs::path rel = e.at("path").get<std::string>();
+        const fs::path to = tmp / rel;
+        if (kind == "dir")
+        {
+          fs::create_directories(to);
+          continue;
+        }
+
+        fs::create_directories(to.parent_path());
+        if (kind == "symlink")
+        {
+          fs::create_symlink(e.at("target").get<std::string>(), to);
+          continue;
+        }
+
+        // Objects come from the tree once and are read-only from then on, so
+        // an edit through one project cannot leak into the others.
+        const std::string name = e.at("object").get<std::string>();
+        const fs::path object = root_ / name;
+        if (!fs::exists(object))
+        {
+          const fs::path staged = object.string() + unique_suffix();
+          fs::copy_file(tree / rel, staged);
+          // Windows refuses to delete read-only files, so objects stay writable there.
+#ifndef _WIN32
+          fs::perms mode = fs::perms::owner_read | fs::perms::group_read | fs::perms::others_read;
+          if (name.size() > 2 && name.compare(name.size() - 2, 2, "-x") == 0)
+            mode |= fs::perms::owner_exec | fs::perms::group_exec | fs::perms::others_exec;
+          fs::permissions(staged, mode);
+#endif
+          fs::rename(staged, object);
+        }
+
+        switch (place(object, to))
+        {
+        case Placed::Linked: ++stats.linked; break;
+        case Placed::Cloned: ++stats.cloned; break;
+        case Placed::Copied: ++stats.copied; break;
+        }
+        ++stats.files;
+      }
+
+      std::ofstream(tmp / MARKER, std::ios::binary | std::ios::trunc)
+          << json{{"tree", manifest.value("tree", "")}, {"signature", signature}}.dump();
+    }
+    catch (...)
+    {
+      fs::remove_all(tmp, ec);
+      throw;
+    }
+
+    fs::remove_all(dst, ec);
+    fs::rename(tmp, dst, ec);
+    if (ec)
+    {
+      fs::remove_all(tmp, ec);
+      throw std::runtime_error("cannot move dependency into place: " + dst.string());
+    }
+    return stats;
+  }
+
+  bool ContentStore::is_materialized(const fs::path &tree, const fs::path &dst) const
+  {
+    const json marker = read_json(dst / MARKER);
+    if (!marker.is_object())
+      return false;
+    return marker.value("tree", "") == fs::absolute(tree).lexically_normal().generic_string() &&
+           marker.value("signature", "") == tree_signature(tree);
+  }
+
+  ContentStore::Collected ContentStore::gc(bool dryRun) const
+  {
+    Collected collected;
+    std::error_code ec;
+
+    if (fs::exists(root_, ec))
+    {
+      for (const auto &entry : fs::directory_iterator(root_, fs::directory_options::skip_permission_denied, ec))
+      {
+        std::error_code fileEc;
+        if (!entry.is_regular_file(fileEc))
+          continue;
+
+        const bool staging = entry.path().filename().string().find(".tmp-") != std::string::npos;
+        if (staging)
+        {
+          const auto mtime = entry.last_write_time(fileEc);
+          if (fileEc || fs::file_time_type::clock::now() - mtime < STAGING_GRACE)
+            continue;
+        }
+        else if (fs::hard_link_count(entry.path(), fileEc) > 1)
+          continue;
+
+        collected.bytes += entry.file_size(fileEc);
+        ++collected.objects;
+        if (!dryRun)
+          fs::remove(entry.path(), fileEc);
+      }
+    }
+
+    if (fs::exists(index_, ec))
+    {
+      for (const auto &entry : fs::directory_iterator(index_, fs::directory_options::skip_permission_denied, ec))
+      {
+        const json manifest = read_json(entry.path());
+        std::error_code fileEc;
+        if (manifest.is_object() && fs::exists(manifest.value("tree", ""), fileEc))
+          continue;
+
+        ++collected.manifests;
+        if (!dryRun)
+          fs::remove(entry.path(), fileEc);
+      }
+    }
+
+    return collected;
+  }
+}
@@ -0,0 +1,200 @@
+#include <vix/cli/util/FetchPool.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vix::cli::util
+{
+  FetchPool::FetchPool(std::size_t workers)
+  {
+    workers = std::clamp<std::size_t>(workers, 1, MAX_FETCH_JOBS);
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i)
+      threads_.emplace_back([this]() { worker_loop(); });
+  }
+
+  FetchPool::~FetchPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+      for (Entry &e : entries_)
+      {
+        if (e.state == State::Queued)
+          e.state = State::Cancelled;
+      }
+    }
+    wake_.notify_all();
+    for (std::thread &t : threads_)
+      t.join();
+  }
+
+  std::size_t FetchPool::submit(Job job)
+  {
+    std::size_t index = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      index = entries_.size();
+      entries_.push_back(Entry{std::move(job), State::Queued, nullptr});
+    }
+    wake_.notify_one();
+    return index;
+  }
+
+  void FetchPool::wait(std::size_t index)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&]()
+               { return entries_[index].state == State::Done || entries_[index].state == State::Cancelled; });
+
+    if (entries_[index].state == State::Cancelled)
+      throw std::runtime_error("fetch cancelled");
+    if (entries_[index].error)
+      std::rethrow_exception(entries_[index].error);
+  }
+
+  void FetchPool::cancel_pending()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (Entry &e : entries_)
+      {
+        if (e.state == State::Queued)
+          e.state = State::Cancelled;
+      }
+    }
+    done_.notify_all();
+  }
+
+  void FetchPool::worker_loop()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;)
+    {
+      while (next_ < entries_.size() && entries_[next_].state != State::Queued)
+        ++next_;
+
+      if (next_ == entries_.size())
+      {
+        if (stopping_)
+          return;
+        wake_.wait(lock);
+        continue;
+      }
+
+      Entry &entry = entries_[next_++];
+      entry.state = State::Running;
+      Job job = std::move(entry.job);
+
+      lock.unlock();
+      std::exception_ptr error;
+      try
+      {
+        job();
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+      lock.lock();
+
+      // deque::push_back keeps references to existing elements valid.
+      entry.error = error;
+      entry.state = State::Done;
+      done_.notify_all();
+    }
+  }
+
+  LiveProgressBoard::LiveProgressBoard(std::ostream &out, bool tty) : out_(out), tty_(tty) {}
+
+  LiveProgressBoard::~LiveProgressBoard()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    clear_locked();
+    out_ << std::flush;
+  }
+
+  std::size_t LiveProgressBoard::add_row(const std::string &key)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rows_.push_back(Row{key, {}, {}, true});
+    return rows_.size() - 1;
+  }
+
+  void LiveProgressBoard::update(std::size_t row, const std::string &phase, const std::string &text)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Row &r = rows_[row];
+    const bool phaseChanged = r.phase != phase;
+    r.phase = phase;
+    r.text = text;
+
+    if (!tty_)
+    {
+      if (phaseChanged)
+        out_ << r.key << ": " << phase << "\n" << std::flush;
+      return;
+    }
+
+    if (paused_ == 0)
+    {
+      clear_locked();
+      draw_locked();
+    }
+  }
+
+  void LiveProgressBoard::remove_row(std::size_t row)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tty_ && paused_ == 0)
+      clear_locked();
+    rows_[row].live = false;
+    if (tty_ && paused_ == 0)
+      draw_locked();
+  }
+
+  void LiveProgressBoard::pause()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (paused_++ == 0)
+    {
+      clear_locked();
+      out_ << std::flush;
+    }
+  }
+
+  void LiveProgressBoard::resume()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (paused_ > 0 && --paused_ == 0 && tty_)
+      draw_locked();
+  }
+
+  std::size_t LiveProgressBoard::live_rows() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<std::size_t>(std::count_if(rows_.begin(), rows_.end(), [](const Row &r) { return r.live; }));
+  }
+
+  void LiveProgressBoard::clear_locked()
+  {
+    if (!tty_ || drawn_ == 0)
+      return;
+
+    // Cursor to the first live line, then erase to the end of the screen.
+    out_ << "\033[" << drawn_ << "F\033[J";
+    drawn_ = 0;
+  }
+
+  void LiveProgressBoard::draw_locked()
+  {
+    for (const Row &r : rows_)
+    {
+      if (!r.live || r.text.empty())
+        continue;
+      out_ << "\033[2K" << r.text << "\n";
+      ++drawn_;
+    }
+    out_ << std::flush;
+  }
+}
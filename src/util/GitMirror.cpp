@@ -0,0 +1,197 @@
+#include <vix/cli/util/GitMirror.hpp>
+#include <vix/cli/util/Hash.hpp>
+#include <vix/process/Process.hpp>
+
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace vix::cli::util
+{
+  namespace fs = std::filesystem;
+
+  namespace
+  {
+    struct GitResult { bool ok{false}; std::string out, err; };
+
+    GitResult run_git(std::vector<std::string> args)
+    {
+      vix::process::Command command("git");
+      command.args(std::move(args));
+      command.search_in_path(true);
+      command.stdout_mode(vix::process::PipeMode::Pipe);
+      command.stderr_mode(vix::process::PipeMode::Pipe);
+      const auto result = vix::process::output(std::move(command));
+      if (!result)
+        return {false, {}, result.error().message()};
+      return {result.value().success(), result.value().stdout_text, result.value().stderr_text};
+    }
+
+    void run_git_or_throw(std::vector<std::string> args, const std::string &what)
+    {
+      const GitResult r = run_git(std::move(args));
+      if (!r.ok)
+        throw std::runtime_error(what + (r.err.empty() ? "" : ": " + r.err));
+    }
+
+    void network_or_throw(const GitNetworkRunner &network, std::vector<std::string> args, const std::string &what)
+    {
+      if (network)
+      {
+        if (!network(std::move(args)))
+          throw std::runtime_error(what);
+        return;
+      }
+      run_git_or_throw(std::move(args), what);
+    }
+
+    std::string trim(std::string s)
+    {
+      while (!s.empty() && (s.back() == '\n' || s.back() == '\r' || s.back() == ' '))
+        s.pop_back();
+      return s;
+    }
+
+    // Serializes writers of one mirror across threads and processes; flock
+    // locks belong to the open file, so two threads of one process exclude
+    // each other as well.
+    class MirrorLock
+    {
+    public:
+      explicit MirrorLock(const fs::path &mirror)
+      {
+#ifdef _WIN32
+        (void)mirror;
+        fallback_.lock();
+#else
+        const fs::path path = mirror.string() + ".lock";
+        fd_ = ::open(path.c_str(), O_CREAT | O_RDWR, 0600);
+        if (fd_ < 0 || ::flock(fd_, LOCK_EX) != 0)
+          throw std::runtime_error("cannot lock git mirror: " + mirror.string());
+#endif
+      }
+      ~MirrorLock()
+      {
+#ifdef _WIN32
+        fallback_.unlock();
+#else
+        if (fd_ >= 0) { ::flock(fd_, LOCK_UN); ::close(fd_); }
+#endif
+      }
+      MirrorLock(const MirrorLock &) = delete;
+      MirrorLock &operator=(const MirrorLock &) = delete;
+
+    private:
+#ifdef _WIN32
+      static inline std::mutex fallback_;
+#else
+      int fd_{-1};
+#endif
+    };
+
+    fs::path sibling(const fs::path &p, const std::string &suffix)
+    {
+#ifdef _WIN32
+      const std::string pid = "0";
+#else
+      const std::string pid = std::to_string(::getpid());
+#endif
+      return p.parent_path() / (p.filename().string() + suffix + "-" + pid);
+    }
+  }
+
+  fs::path git_mirror_dir(const fs::path &vixRoot) { return vixRoot / "cache" / "git-mirrors"; }
+
+  GitMirror::GitMirror(const fs::path &vixRoot, std::string url)
+      : url_(std::move(url)), path_(git_mirror_dir(vixRoot) / (hex64(fnv1a64_str(url_, 1469598103934665603ull)) + ".git")) {}
+
+  bool GitMirror::has_commit(const std::string &commit) const
+  {
+    if (!fs::exists(path_ / "HEAD"))
+      return false;
+    return run_git({"-C", path_.string(), "cat-file", "-e", commit + "^{commit}"}).ok;
+  }
+
+  void GitMirror::ensure_commit(const std::string &commit, const GitNetworkRunner &network) const
+  {
+    fs::create_directories(path_.parent_path());
+    MirrorLock lock(path_);
+
+    if (!fs::exists(path_ / "HEAD"))
+    {
+      const fs::path tmp = sibling(path_, ".tmp");
+      std::error_code ec;
+      fs::remove_all(tmp, ec);
+      network_or_throw(network, {"clone", "--bare", "--progress", "-q", url_, tmp.string()}, "git clone failed for: " + url_);
+
+      // Branches and tags only: pruning must not touch refs/vix/keep/.
+      run_git_or_throw({"-C", tmp.string(), "config", "--replace-all", "remote.origin.fetch", "+refs/heads/*:refs/heads/*"}, "cannot configure git mirror");
+      run_git_or_throw({"-C", tmp.string(), "config", "--add", "remote.origin.fetch", "+refs/tags/*:refs/tags/*"}, "cannot configure git mirror");
+
+      fs::rename(tmp, path_, ec);
+      if (ec)
+      {
+        fs::remove_all(tmp, ec);
+        throw std::runtime_error("cannot move git mirror into place: " + path_.string());
+      }
+    }
+
+    if (has_commit(commit))
+      return;
+
+    network_or_throw(network, {"-C", path_.string(), "fetch", "--progress", "-q", "--prune", "origin"}, "git fetch failed for: " + url_);
+    if (has_commit(commit))
+      return;
+
+    // Commits no branch or tag points at can still be fetched by id.
+    network_or_throw(network, {"-C", path_.string(), "fetch", "--progress", "-q", "origin", commit}, "git fetch failed for: " + url_);
+    if (!has_commit(commit))
+      throw std::runtime_error("commit " + commit + " not found in " + url_);
+  }
+
+  void GitMirror::checkout(const std::string &commit, const fs::path &dst) const
+  {
+    fs::create_directories(dst.parent_path());
+    const fs::path tmp = sibling(dst, ".tmp");
+    std::error_code ec;
+    fs::remove_all(tmp, ec);
+
+    {
+      MirrorLock lock(path_);
+      const GitResult id = run_git({"-C", path_.string(), "rev-parse", "--verify", commit + "^{commit}"});
+      if (!id.ok)
+        throw std::runtime_error("commit " + commit + " not found in " + url_);
+      run_git_or_throw({"-C", path_.string(), "update-ref", "refs/vix/keep/" + trim(id.out), trim(id.out)}, "cannot pin commit in git mirror");
+      run_git_or_throw({"clone", "--shared", "--no-checkout", "-q", path_.string(), tmp.string()}, "git clone failed for: " + url_);
+    }
+
+    try
+    {
+      run_git_or_throw({"-C", tmp.string(), "-c", "advice.detachedHead=false", "checkout", "-q", commit}, "git checkout failed for: " + commit);
+      run_git_or_throw({"-C", tmp.string(), "remote", "set-url", "origin", url_}, "cannot set checkout remote");
+    }
+    catch (...)
+    {
+      fs::remove_all(tmp, ec);
+      throw;
+    }
+
+    fs::rename(tmp, dst, ec);
+    if (ec)
+    {
+      fs::remove_all(dst, ec);
+      ec.clear();
+      fs::rename(tmp, dst, ec);
+      if (ec)
+      {
+        fs::remove_all(tmp, ec);
+        throw std::runtime_error("cannot move checkout into place: " + dst.string());
+      }
+    }
+  }
+}
@@ -0,0 +1,754 @@
+/**
+ *
+ *  @file Pubgrub.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira. All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#include <vix/cli/util/Pubgrub.hpp>
+#include <vix/cli/util/Semver.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace vix::cli::util::pubgrub
+{
+  namespace
+  {
+    constexpr int ROOT = 0;
+
+    // Versions of one package, as bits over its ascending version list.
+    class VersionSet
+    {
+    public:
+      static VersionSet none(std::size_t n)
+      {
+        VersionSet s;
+        s.n_ = n;
+        s.words_.assign((n + 63) / 64, 0);
+        return s;
+      }
+
+      static VersionSet all(std::size_t n)
+      {
+        VersionSet s = none(n);
+        for (std::size_t i = 0; i < n; ++i)
+          s.insert(i);
+        return s;
+      }
+
+      static VersionSet single(std::size_t n, std::size_t i)
+      {
+        VersionSet s = none(n);
+        s.insert(i);
+        return s;
+      }
+
+      void insert(std::size_t i) { words_[i / 64] |= std::uint64_t{1} << (i % 64); }
+      bool contains(std::size_t i) const { return (words_[i / 64] >> (i % 64)) & 1u; }
+      std::size_t domain() const { return n_; }
+
+      bool empty() const
+      {
+        return std::all_of(words_.begin(), words_.end(), [](std::uint64_t w)
+                           { return w == 0; });
+      }
+
+      std::size_t count() const
+      {
+        std::size_t c = 0;
+        for (std::uint64_t w : words_)
+          c += static_cast<std::size_t>(std::popcount(w));
+        return c;
+      }
+
+      std::optional<std::size_t> highest() const
+      {
+        for (std::size_t i = words_.size(); i-- > 0;)
+          if (words_[i] != 0)
+            return i * 64 + 63 - static_cast<std::size_t>(std::countl_zero(words_[i]));
+        return std::nullopt;
+      }
+
+      VersionSet operator&(const VersionSet &o) const { return combine(o, [](auto a, auto b)
+                                                                       { return a & b; }); }
+      VersionSet operator|(const VersionSet &o) const { return combine(o, [](auto a, auto b)
+                                                                       { return a | b; }); }
+      VersionSet minus(const VersionSet &o) const { return combine(o, [](auto a, auto b)
+                                                                   { return a & ~b; }); }
+
+      bool subset_of(const VersionSet &o) const
+      {
+        for (std::size_t i = 0; i < words_.size(); ++i)
+          if ((words_[i] & ~o.words_[i]) != 0)
+            return false;
+        return true;
+      }
+
+      bool disjoint(const VersionSet &o) const
+      {
+        for (std::size_t i = 0; i < words_.size(); ++i)
+          if ((words_[i] & o.words_[i]) != 0)
+            return false;
+        return true;
+      }
+
+    private:
+      template <typename Op>
+      VersionSet combine(const VersionSet &o, Op op) const
+      {
+        VersionSet s = none(n_);
+        for (std::size_t i = 0; i < words_.size(); ++i)
+          s.words_[i] = op(words_[i], o.words_[i]);
+        return s;
+      }
+
+      std::size_t n_{0};
+      std::vector<std::uint64_t> words_;
+    };
+
+    // A positive term allows the versions in its set. A negative term allows
+    // every other version and also the package being absent, so the empty
+    // negative term allows anything.
+    struct Term
+    {
+      int package{ROOT};
+      bool positive{true};
+      VersionSet set;
+    };
+
+    Term negate(const Term &t) { return {t.package, !t.positive, t.set}; }
+
+    Term intersect(const Term &a, const Term &b)
+    {
+      if (a.positive && b.positive)
+        return {a.package, true, a.set & b.set};
+      if (a.positive)
+        return {a.package, true, a.set.minus(b.set)};
+      if (b.positive)
+        return {a.package, true, b.set.minus(a.set)};
+      return {a.package, false, a.set | b.set};
+    }
+
+    // Everything `a` allows, `b` allows too.
+    bool satisfies(const Term &a, const Term &b)
+    {
+      if (a.positive && b.positive)
+        return a.set.subset_of(b.set);
+      if (a.positive)
+        return a.set.disjoint(b.set);
+      if (b.positive)
+        return false;
+      return b.set.subset_of(a.set);
+    }
+
+    // Nothing is allowed by both.
+    bool contradicts(const Term &a, const Term &b)
+    {
+      if (a.positive && b.positive)
+        return a.set.disjoint(b.set);
+      if (a.positive)
+        return a.set.subset_of(b.set);
+      if (b.positive)
+        return b.set.subset_of(a.set);
+      return false;
+    }
+
+    enum class Cause
+    {
+      Root,
+      NoVersions,
+      Dependency,
+      Derived
+    };
+
+    // Terms that cannot all hold at once.
+    struct Incompatibility
+    {
+      std::vector<Term> terms;
+      Cause cause{Cause::Derived};
+      int left{-1};
+      int right{-1};
+      int depender{-1};
+      int dependency{-1};
+      std::string range;
+    };
+
+    struct Assignment
+    {
+      Term term;
+      int level{0};
+      bool decision{false};
+      int cause{-1};
+    };
+
+    enum class Relation
+    {
+      Satisfied,
+      Contradicted,
+      AlmostSatisfied,
+      Inconclusive
+    };
+
+    class Solver
+    {
+    public:
+      explicit Solver(Provider &provider) : provider_(provider)
+      {
+        names_.push_back("");
+        versions_.push_back({"0"});
+        byPackage_.emplace_back();
+        current_.push_back(any(ROOT));
+        decided_.push_back(-1);
+      }
+
+      std::map<std::string, std::string> run(const std::vector<Requirement> &roots)
+      {
+        roots_ = roots;
+
+        Incompatibility root;
+        root.terms = {Term{ROOT, false, VersionSet::all(1)}};
+        root.cause = Cause::Root;
+        index(store(std::move(root)));
+
+        int next = ROOT;
+        while (next >= 0)
+        {
+          propagate(next);
+          next = decide_next();
+        }
+
+        std::map<std::string, std::string> solution;
+        for (std::size_t p = 1; p < names_.size(); ++p)
+          if (decided_[p] >= 0)
+            solution.emplace(names_[p], versions_[p][static_cast<std::size_t>(decided_[p])]);
+        return solution;
+      }
+
+      const Stats &stats() const { return stats_; }
+
+    private:
+      Term any(int p) const { return {p, false, VersionSet::none(versions_[p].size())}; }
+
+      int package(const std::string &name)
+      {
+        if (const auto it = ids_.find(name); it != ids_.end())
+          return it->second;
+
+        std::vector<std::string> versions = provider_.versions(name);
+        semver::sortAscending(versions);
+        versions.erase(std::unique(versions.begin(), versions.end()), versions.end());
+
+        const int id = static_cast<int>(names_.size());
+        ids_.emplace(name, id);
+        names_.push_back(name);
+        versions_.push_back(std::move(versions));
+        byPackage_.emplace_back();
+        current_.push_back(any(id));
+        decided_.push_back(-1);
+        return id;
+      }
+
+      const VersionSet &range_set(int p, const std::string &range)
+      {
+        const auto key = std::make_pair(p, range);
+        if (const auto it = ranges_.find(key); it != ranges_.end())
+          return it->second;
+
+        const auto &versions = versions_[p];
+        VersionSet s = VersionSet::none(versions.size());
+        for (std::size_t i = 0; i < versions.size(); ++i)
+          if (range.empty() || semver::satisfies(versions[i], range))
+            s.insert(i);
+        return ranges_.emplace(key, std::move(s)).first->second;
+      }
+
+      // One term per package; tautologies dropped. Learned incompatibilities
+      // also drop the root, which is always selected.
+      static std::vector<Term> normalize(const std::vector<Term> &terms, bool derived)
+      {
+        std::vector<Term> out;
+        for (const Term &t : terms)
+        {
+          const auto it = std::find_if(out.begin(), out.end(), [&](const Term &o)
+                                       { return o.package == t.package; });
+          if (it == out.end())
+            out.push_back(t);
+          else
+            *it = intersect(*it, t);
+        }
+
+        out.erase(std::remove_if(out.begin(), out.end(), [](const Term &t)
+                                 { return !t.positive && t.set.empty(); }),
+                  out.end());
+
+        if (derived && out.size() > 1)
+          out.erase(std::remove_if(out.begin(), out.end(), [](const Term &t)
+                                   { return t.positive && t.package == ROOT; }),
+                    out.end());
+        return out;
+      }
+
+      int store(Incompatibility inc)
+      {
+        incompats_.push_back(std::move(inc));
+        ++stats_.incompatibilities;
+        return static_cast<int>(incompats_.size()) - 1;
+      }
+
+      void index(int i)
+      {
+        for (const Term &t : incompats_[i].terms)
+          byPackage_[t.package].push_back(i);
+      }
+
+      void assign(const Term &term, bool decision, int cause)
+      {
+        if (decision)
+          ++decisionLevel_;
+        assignments_.push_back({term, decisionLevel_, decision, cause});
+        current_[term.package] = intersect(current_[term.package], term);
+      }
+
+      Relation relation(const Incompatibility &inc, int &unsatisfied) const
+      {
+        unsatisfied = -1;
+        for (std::size_t i = 0; i < inc.terms.size(); ++i)
+        {
+          const Term &t = inc.terms[i];
+          const Term &c = current_[t.package];
+          if (satisfies(c, t))
+            continue;
+          if (contradicts(c, t))
+            return Relation::Contradicted;
+          if (unsatisfied >= 0)
+            return Relation::Inconclusive;
+          unsatisfied = static_cast<int>(i);
+        }
+        return unsatisfied < 0 ? Relation::Satisfied : Relation::AlmostSatisfied;
+      }
+
+      void propagate(int start)
+      {
+        std::vector<int> changed{start};
+        while (!changed.empty())
+        {
+          const int p = changed.back();
+          changed.pop_back();
+
+          for (std::size_t k = byPackage_[p].size(); k-- > 0;)
+          {
+            const int i = byPackage_[p][k];
+            int unsatisfied = -1;
+            const Relation r = relation(incompats_[i], unsatisfied);
+
+            if (r == Relation::Satisfied)
+            {
+              const int learned = resolve_conflict(i);
+              relation(incompats_[learned], unsatisfied);
+              const Term t = incompats_[learned].terms[static_cast<std::size_t>(unsatisfied)];
+              assign(negate(t), false, learned);
+              changed.assign(1, t.package);
+              break;
+            }
+
+            if (r == Relation::AlmostSatisfied)
+            {
+              const Term t = incompats_[i].terms[static_cast<std::size_t>(unsatisfied)];
+              assign(negate(t), false, i);
+              if (std::find(changed.begin(), changed.end(), t.package) == changed.end())
+                changed.push_back(t.package);
+            }
+          }
+        }
+      }
+
+      static bool terminal(const Incompatibility &inc)
+      {
+        return inc.terms.empty() ||
+               (inc.terms.size() == 1 && inc.terms[0].positive && inc.terms[0].package == ROOT);
+      }
+
+      // Learns why the satisfied incompatibility `conflict` holds, until the
+      // cause is one decision that can be undone; then backtracks.
+      int resolve_conflict(int conflict)
+      {
+        ++stats_.conflicts;
+        int current = conflict;
+
+        while (!terminal(incompats_[current]))
+        {
+          const std::vector<Term> terms = incompats_[current].terms;
+
+          // Earliest assignment after which each term holds.
+          std::vector<int> found(terms.size(), -1);
+          std::vector<Term> acc;
+          for (const Term &t : terms)
+            acc.push_back(any(t.package));
+          for (std::size_t a = 0; a < assignments_.size(); ++a)
+          {
+            for (std::size_t ti = 0; ti < terms.size(); ++ti)
+            {
+              if (found[ti] >= 0 || terms[ti].package != assignments_[a].term.package)
+                continue;
+              acc[ti] = intersect(acc[ti], assignments_[a].term);
+              if (satisfies(acc[ti], terms[ti]))
+                found[ti] = static_cast<int>(a);
+            }
+          }
+
+          const std::size_t st = static_cast<std::size_t>(
+              std::max_element(found.begin(), found.end()) - found.begin());
+          const Assignment satisfier = assignments_[static_cast<std::size_t>(found[st])];
+
+          int previous = -1;
+          for (std::size_t ti = 0; ti < terms.size(); ++ti)
+            if (ti != st)
+              previous = std::max(previous, found[ti]);
+
+          Term withSatisfier = satisfier.term;
+          if (!satisfies(withSatisfier, terms[st]))
+          {
+            for (int a = 0; a < found[st]; ++a)
+            {
+              if (assignments_[static_cast<std::size_t>(a)].term.package != satisfier.term.package)
+                continue;
+              withSatisfier = intersect(withSatisfier, assignments_[static_cast<std::size_t>(a)].term);
+              if (satisfies(withSatisfier, terms[st]))
+              {
+                previous = std::max(previous, a);
+                break;
+              }
+            }
+          }
+
+          const int previousLevel =
+              previous >= 0 ? std::max(1, assignments_[static_cast<std::size_t>(previous)].level) : 1;
+
+          if (satisfier.decision || previousLevel != satisfier.level)
+          {
+            if (current != conflict)
+              index(current);
+            backtrack(previousLevel);
+            return current;
+          }
+
+          std::vector<Term> prior;
+          for (const Term &t : terms)
+            if (t.package != satisfier.term.package)
+              prior.push_back(t);
+          for (const Term &t : incompats_[satisfier.cause].terms)
+            if (t.package != satisfier.term.package)
+              prior.push_back(t);
+          if (!satisfies(satisfier.term, terms[st]))
+            prior.push_back(negate(intersect(satisfier.term, negate(terms[st]))));
+
+          Incompatibility derived;
+          derived.terms = normalize(prior, true);
+          derived.left = current;
+          derived.right = satisfier.cause;
+          current = store(std::move(derived));
+        }
+
+        throw SolveFailure(explain(current));
+      }
+
+      void backtrack(int level)
+      {
+        std::vector<int> touched;
+        while (!assignments_.empty() && assignments_.back().level > level)
+        {
+          const Assignment &a = assignments_.back();
+          if (a.decision)
+            decided_[a.term.package] = -1;
+          touched.push_back(a.term.package);
+          assignments_.pop_back();
+        }
+        decisionLevel_ = level;
+
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        for (int p : touched)
+          current_[p] = any(p);
+        for (const Assignment &a : assignments_)
+          if (std::binary_search(touched.begin(), touched.end(), a.term.package))
+            current_[a.term.package] = intersect(current_[a.term.package], a.term);
+      }
+
+      // Decides the newest allowed version of the most constrained package.
+      // Returns the package to propagate from, or -1 once every required
+      // package is decided.
+      int decide_next()
+      {
+        int best = -1;
+        std::size_t bestCount = 0;
+        for (std::size_t p = 0; p < names_.size(); ++p)
+        {
+          if (decided_[p] >= 0 || !current_[p].positive)
+            continue;
+          const std::size_t n = current_[p].set.count();
+          if (best < 0 || n < bestCount)
+          {
+            best = static_cast<int>(p);
+            bestCount = n;
+          }
+        }
+        if (best < 0)
+          return -1;
+
+        const auto version = current_[best].set.highest();
+        if (!version)
+        {
+          Incompatibility none;
+          none.terms = {current_[best]};
+          none.cause = Cause::NoVersions;
+          index(store(std::move(none)));
+          return best;
+        }
+
+        const Term chosen{best, true, VersionSet::single(versions_[best].size(), *version)};
+        const auto key = std::make_pair(best, *version);
+        if (!dependencyIncompats_.count(key))
+        {
+          const std::vector<Requirement> deps =
+              best == ROOT ? roots_ : provider_.dependencies(names_[best], versions_[best][*version]);
+
+          std::vector<int> added;
+          for (const Requirement &dep : deps)
+          {
+            const int d = package(dep.package);
+            Incompatibility inc;
+            inc.terms = normalize({chosen, Term{d, false, range_set(d, dep.range)}}, false);
+            inc.cause = Cause::Dependency;
+            inc.depender = best;
+            inc.dependency = d;
+            inc.range = dep.range;
+            const int i = store(std::move(inc));
+            index(i);
+            added.push_back(i);
+          }
+          dependencyIncompats_.emplace(key, std::move(added));
+        }
+
+        // Deciding must not satisfy one of its own dependency incompatibilities;
+        // if it would, propagation rules the version out instead.
+        bool conflict = false;
+        for (int i : dependencyIncompats_[key])
+        {
+          bool all = true;
+          for (const Term &t : incompats_[i].terms)
+            all = all && satisfies(t.package == best ? chosen : current_[t.package], t);
+          conflict = conflict || all;
+        }
+
+        if (!conflict)
+        {
+          assign(chosen, true, -1);
+          decided_[best] = static_cast<int>(*version);
+          ++stats_.decisions;
+        }
+        return best;
+      }
+
+      std::string set_text(int p, const VersionSet &set) const
+      {
+        const auto &versions = versions_[p];
+        if (set.count() == 1)
+          return versions[*set.highest()];
+        if (set.count() == versions.size())
+          return "any version";
+        if (set.empty())
+          return "no version";
+
+        std::string out;
+        for (std::size_t i = 0; i < versions.size();)
+        {
+          if (!set.contains(i))
+          {
+            ++i;
+            continue;
+          }
+          std::size_t j = i;
+          while (j + 1 < versions.size() && set.contains(j + 1))
+            ++j;
+
+          if (!out.empty())
+            out += " || ";
+          if (i == j)
+            out += versions[i];
+          else if (j + 1 == versions.size())
+            out += ">=" + versions[i];
+          else if (i == 0)
+            out += "<=" + versions[j];
+          else
+            out += versions[i] + " - " + versions[j];
+          i = j + 1;
+        }
+        return out;
+      }
+
+      std::string term_text(const Term &t) const
+      {
+        if (t.package == ROOT)
+          return "the project";
+        return names_[t.package] + " " + set_text(t.package, t.set);
+      }
+
+      std::string describe(int i) const
+      {
+        const Incompatibility &inc = incompats_[i];
+        const auto &terms = inc.terms;
+
+        switch (inc.cause)
+        {
+        case Cause::Root:
+          return "the project is required";
+
+        case Cause::NoVersions:
+          return "no versions of " + names_[terms[0].package] + " match " + set_text(terms[0].package, terms[0].set);
+
+        case Cause::Dependency:
+        {
+          std::string who = "the project";
+          if (inc.depender != ROOT)
+          {
+            const auto it = std::find_if(terms.begin(), terms.end(), [&](const Term &t)
+                                         { return t.package == inc.depender; });
+            who = it != terms.end() ? term_text(*it) : names_[inc.depender];
+          }
+
+          std::string text = who + " depends on " + names_[inc.dependency] + " " +
+                             (inc.range.empty() ? std::string("any version") : inc.range);
+          if (versions_[inc.dependency].empty())
+            text += ", which is not in the registry";
+          else if (std::none_of(terms.begin(), terms.end(), [&](const Term &t)
+                                { return t.package == inc.dependency; }))
+            text += ", which matches no published version";
+          return text;
+        }
+
+        case Cause::Derived:
+          break;
+        }
+
+        if (terminal(inc))
+          return "version solving failed";
+
+        if (terms.size() == 1)
+          return term_text(terms[0]) + (terms[0].positive ? " is forbidden" : " is required");
+
+        if (terms.size() == 2 && terms[0].positive != terms[1].positive)
+        {
+          const Term &pos = terms[0].positive ? terms[0] : terms[1];
+          const Term &neg = terms[0].positive ? terms[1] : terms[0];
+          return term_text(pos) + " requires " + term_text(negate(neg));
+        }
+
+        if (std::all_of(terms.begin(), terms.end(), [](const Term &t)
+                        { return t.positive; }))
+        {
+          if (terms.size() == 2)
+            return term_text(terms[0]) + " is incompatible with " + term_text(terms[1]);
+
+          std::string out;
+          for (std::size_t k = 0; k < terms.size(); ++k)
+            out += (k == 0 ? "" : (k + 1 == terms.size() ? " and " : ", ")) + term_text(terms[k]);
+          return out + " are incompatible";
+        }
+
+        std::string out = "these cannot all hold: ";
+        for (std::size_t k = 0; k < terms.size(); ++k)
+          out += (k == 0 ? "" : ", ") + std::string(terms[k].positive ? "" : "not ") + term_text(terms[k]);
+        return out;
+      }
+
+      // One line per learned fact, causes before conclusions:
+      //   (1) Because A 1.0.0 depends on B ^2.0.0 and ..., A 1.0.0 requires ...
+      //   (2) Because A 1.0.0 requires ... (1) and ..., version solving failed.
+      std::string explain(int failure) const
+      {
+        std::vector<std::string> lines;
+        std::unordered_map<int, std::size_t> numbers;
+
+        std::function<std::string(int)> ref = [&](int i) -> std::string
+        {
+          const auto it = numbers.find(i);
+          return describe(i) + (it == numbers.end() ? "" : " (" + std::to_string(it->second) + ")");
+        };
+
+        std::function<void(int)> visit = [&](int i)
+        {
+          const Incompatibility &inc = incompats_[i];
+          if (inc.cause != Cause::Derived || numbers.count(i))
+            return;
+          visit(inc.left);
+          visit(inc.right);
+          lines.push_back("Because " + ref(inc.left) + " and " + ref(inc.right) + ", " + describe(i) + ".");
+          numbers.emplace(i, lines.size());
+        };
+        visit(failure);
+
+        if (lines.empty())
+          return describe(failure);
+
+        std::string out;
+        for (std::size_t k = 0; k < lines.size(); ++k)
+        {
+          if (!out.empty())
+            out += "\n";
+          out += (lines.size() > 1 ? "(" + std::to_string(k + 1) + ") " : "") + lines[k];
+        }
+        return out;
+      }
+
+      Provider &provider_;
+      Stats stats_;
+      std::vector<Requirement> roots_;
+
+      std::vector<std::string> names_;
+      std::vector<std::vector<std::string>> versions_;
+      std::unordered_map<std::string, int> ids_;
+      std::map<std::pair<int, std::string>, VersionSet> ranges_;
+
+      std::vector<Incompatibility> incompats_;
+      std::vector<std::vector<int>> byPackage_;
+      std::map<std::pair<int, std::size_t>, std::vector<int>> dependencyIncompats_;
+
+      std::vector<Assignment> assignments_;
+      std::vector<Term> current_;
+      std::vector<int> decided_;
+      int decisionLevel_{0};
+    };
+  }
+
+  std::map<std::string, std::string> solve(
+      const std::vector<Requirement> &roots,
+      Provider &provider,
+      Stats *stats)
+  {
+    Solver solver(provider);
+    try
+    {
+      auto solution = solver.run(roots);
+      if (stats)
+        *stats = solver.stats();
+      return solution;
+    }
+    catch (...)
+    {
+      if (stats)
+        *stats = solver.stats();
+      throw;
+    }
+  }
+}
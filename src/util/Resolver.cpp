@@ -12,8 +12,10 @@
  */
 #include <vix/cli/util/Resolver.hpp>
 
+#include <vix/cli/registry/RegistryIndex.hpp>
+#include <vix/cli/util/GitMirror.hpp>
 #include <vix/cli/util/Hash.hpp>
-#include <vix/cli/util/Semver.hpp>
+#include <vix/cli/util/Pubgrub.hpp>
 #include <vix/cli/util/Shell.hpp>
 #include <vix/utils/Env.hpp>
 
@@ -21,12 +23,17 @@
 
 #include <algorithm>
 #include <cctype>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <map>
 #include <optional>
+#include <random>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -118,11 +125,6 @@ namespace vix::cli::util::resolver
       return j;
     }
 
-    fs::path entry_path(const std::string &ns, const std::string &name)
-    {
-      return registry_index_dir() / (ns + "." + name + ".json");
-    }
-
     void ensure_registry_present_or_throw()
     {
       if (fs::exists(registry_dir()) && fs::exists(registry_index_dir()))
@@ -158,46 +160,6 @@ namespace vix::cli::util::resolver
       return spec;
     }
 
-    int resolve_version_or_throw(const json &entry, PkgSpec &spec)
-    {
-      if (!entry.contains("versions") || !entry["versions"].is_object())
-      {
-        throw std::runtime_error(
-            "invalid registry entry: missing versions for " + spec.id());
-      }
-
-      std::vector<std::string> versions;
-      versions.reserve(entry["versions"].size());
-
-      for (auto it = entry["versions"].begin(); it != entry["versions"].end(); ++it)
-      {
-        versions.push_back(it.key());
-      }
-
-      if (versions.empty())
-      {
-        throw std::runtime_error("no versions available for: " + spec.id());
-      }
-
-      if (spec.requestedVersion.empty())
-      {
-        spec.resolvedVersion = vix::cli::util::semver::findLatest(versions);
-        return 0;
-      }
-
-      const auto resolved =
-          vix::cli::util::semver::resolveMaxSatisfying(versions, spec.requestedVersion);
-
-      if (!resolved.has_value())
-      {
-        throw std::runtime_error(
-            "no version matches range: " + spec.id() + "@" + spec.requestedVersion);
-      }
-
-      spec.resolvedVersion = *resolved;
-      return 0;
-    }
-
     int clone_checkout_or_throw(
         const std::string &repoUrl,
         const std::string &idDot,
@@ -214,28 +176,9 @@ namespace vix::cli::util::resolver
         return 0;
       }
 
-      fs::create_directories(dst.parent_path());
-
-      {
-        const std::string cmd =
-            "git clone -q " + repoUrl + " " + dst.string();
-        const int rc = vix::cli::util::run_cmd_retry_debug(cmd);
-        if (rc != 0)
-        {
-          throw std::runtime_error("git clone failed for: " + repoUrl);
-        }
-      }
-
-      {
-        const std::string cmd =
-            "git -C " + dst.string() +
-            " -c advice.detachedHead=false checkout -q " + commit;
-        const int rc = vix::cli::util::run_cmd_retry_debug(cmd);
-        if (rc != 0)
-        {
-          throw std::runtime_error("git checkout failed for commit: " + commit);
-        }
-      }
+      const GitMirror mirror(vix_root(), repoUrl);
+      mirror.ensure_commit(commit);
+      mirror.checkout(commit, dst);
 
       return 0;
     }
@@ -323,6 +266,35 @@ namespace vix::cli::util::resolver
       return spec;
     }
 
+    std::vector<PkgSpec> parse_deps_v1(const json &deps)
+    {
+      std::vector<PkgSpec> out;
+
+      for (const auto &dependency : deps)
+      {
+        if (dependency.is_object())
+        {
+          auto spec = parse_dep_obj_v1(dependency);
+          if (spec.has_value())
+          {
+            out.push_back(*spec);
+          }
+          continue;
+        }
+
+        if (dependency.is_string())
+        {
+          auto spec = parse_dep_string_v1(dependency.get<std::string>());
+          if (spec.has_value())
+          {
+            out.push_back(*spec);
+          }
+        }
+      }
+
+      return out;
+    }
+
     std::vector<PkgSpec> read_vix_json_deps_v1(const fs::path &repoDir)
     {
       std::vector<PkgSpec> out;
@@ -353,106 +325,306 @@ namespace vix::cli::util::resolver
         return out;
       }
 
-      for (const auto &dependency : root["deps"])
+      return parse_deps_v1(root["deps"]);
+    }
+
+    /**
+     * @brief Registry packages for the solver, looked up in the compiled
+     * index; requirements and checkouts are read at most once per resolution.
+     */
+    class RegistryProvider : public pubgrub::Provider
+    {
+    public:
+      explicit RegistryProvider(const vix::cli::registry::CompiledRegistryIndex &index)
+          : index_(index)
       {
-        if (dependency.is_object())
+      }
+
+      std::vector<std::string> versions(const std::string &id) override
+      {
+        std::vector<std::string> out;
+
+        const auto package = find(id);
+        if (!package.has_value())
         {
-          auto spec = parse_dep_obj_v1(dependency);
-          if (spec.has_value())
+          return out;
+        }
+
+        for (const auto &version : index_.versions(*package))
+        {
+          out.emplace_back(version.version);
+        }
+
+        return out;
+      }
+
+      std::vector<pubgrub::Requirement> dependencies(
+          const std::string &id,
+          const std::string &version) override
+      {
+        const std::string key = id + "@" + version;
+        if (const auto it = dependencies_.find(key); it != dependencies_.end())
+        {
+          return it->second;
+        }
+
+        // Requirements published in the index avoid a checkout; otherwise
+        // they come from the vix.json of the tagged commit.
+        const auto node = version_or_throw(id, version);
+        std::vector<PkgSpec> specs;
+        if (node.declaresDeps)
+        {
+          for (const auto line : vix::cli::registry::split_index_list(node.deps))
           {
-            out.push_back(*spec);
+            if (auto spec = parse_dep_string_v1(std::string(line)))
+            {
+              specs.push_back(std::move(*spec));
+            }
           }
-          continue;
+        }
+        else
+        {
+          specs = read_vix_json_deps_v1(checkout(id, version));
         }
 
-        if (dependency.is_string())
+        std::vector<pubgrub::Requirement> out;
+        out.reserve(specs.size());
+        for (const auto &spec : specs)
         {
-          auto spec = parse_dep_string_v1(dependency.get<std::string>());
-          if (spec.has_value())
+          out.push_back({spec.id(), spec.requestedVersion});
+        }
+
+        return dependencies_.emplace(key, std::move(out)).first->second;
+      }
+
+      vix::cli::registry::IndexedPackage package_or_throw(const std::string &id) const
+      {
+        const auto package = find(id);
+        if (!package.has_value())
+        {
+          throw std::runtime_error("package not found: " + id);
+        }
+
+        if (package->repository.empty())
+        {
+          throw std::runtime_error("invalid registry entry: missing repo url for " + id);
+        }
+
+        return *package;
+      }
+
+      vix::cli::registry::IndexedVersion version_or_throw(const std::string &id, const std::string &version) const
+      {
+        for (const auto &candidate : index_.versions(package_or_throw(id)))
+        {
+          if (candidate.version == version)
           {
-            out.push_back(*spec);
+            return candidate;
           }
         }
+
+        throw std::runtime_error("version not found: " + id + "@" + version);
       }
 
-      return out;
-    }
+      fs::path checkout(const std::string &id, const std::string &version)
+      {
+        const auto [it, inserted] = checkouts_.emplace(id + "@" + version, fs::path{});
+        if (inserted)
+        {
+          std::string idDot = id;
+          std::replace(idDot.begin(), idDot.end(), '/', '.');
+
+          std::string installedDir;
+          clone_checkout_or_throw(
+              std::string(package_or_throw(id).repository),
+              idDot,
+              std::string(version_or_throw(id, version).commit),
+              installedDir);
+          it->second = installedDir;
+        }
 
-    void upsert_locked_dependency(
-        std::vector<vix::cli::util::lockfile::LockedDependency> &dependencies,
-        const vix::cli::util::lockfile::LockedDependency &dependency)
-    {
-      for (auto &item : dependencies)
+        return it->second;
+      }
+
+    private:
+      std::optional<vix::cli::registry::IndexedPackage> find(const std::string &id) const
       {
-        if (item.id == dependency.id)
+        const auto spec = parse_dep_string_v1(id);
+        if (!spec.has_value())
         {
-          item = dependency;
-          return;
+          return std::nullopt;
         }
+
+        return index_.find(spec->ns, spec->name);
       }
 
-      dependencies.push_back(dependency);
-    }
+      const vix::cli::registry::CompiledRegistryIndex &index_;
+      std::unordered_map<std::string, std::vector<pubgrub::Requirement>> dependencies_;
+      std::unordered_map<std::string, fs::path> checkouts_;
+    };
 
-    void resolve_transitive_or_throw(
-        PkgSpec spec,
-        std::unordered_set<std::string> &visited,
-        std::vector<vix::cli::util::lockfile::LockedDependency> &lockedDependencies)
+    /**
+     * @brief Lock entries of a solution, direct dependencies first.
+     *
+     * A transitive dependency records the range of the first package that
+     * pulled it in.
+     */
+    std::vector<vix::cli::util::lockfile::LockedDependency> lock_solution(
+        const std::vector<PkgSpec> &roots,
+        const std::map<std::string, std::string> &solution,
+        RegistryProvider &provider)
     {
-      const fs::path registryEntryPath = entry_path(spec.ns, spec.name);
-      if (!fs::exists(registryEntryPath))
+      std::vector<vix::cli::util::lockfile::LockedDependency> lockedDependencies;
+      std::deque<std::pair<std::string, std::string>> queue;
+      std::unordered_set<std::string> seen;
+
+      for (const auto &spec : roots)
       {
-        throw std::runtime_error("package not found: " + spec.id());
+        if (seen.insert(spec.id()).second)
+        {
+          queue.emplace_back(spec.id(), spec.requestedVersion);
+        }
       }
 
-      const json entry = read_json_file_or_throw(registryEntryPath);
+      while (!queue.empty())
+      {
+        const auto [id, requested] = queue.front();
+        queue.pop_front();
 
-      resolve_version_or_throw(entry, spec);
+        const std::string &version = solution.at(id);
+        const auto node = provider.version_or_throw(id, version);
+        const fs::path installedDir = provider.checkout(id, version);
 
-      const json versions = entry.at("versions");
-      if (!versions.contains(spec.resolvedVersion))
-      {
-        throw std::runtime_error(
-            "version not found: " + spec.id() + "@" + spec.resolvedVersion);
+        const auto contentHash = vix::cli::util::sha256_package_directory(installedDir);
+
+        lockedDependencies.push_back(
+            vix::cli::util::lockfile::LockedDependency{
+                id,
+                requested.empty() ? version : requested,
+                version,
+                std::string(provider.package_or_throw(id).repository),
+                std::string(node.tag),
+                std::string(node.commit),
+                contentHash.value_or(""),
+                vix::cli::util::PACKAGE_HASH_ALGORITHM,
+                vix::cli::util::PACKAGE_HASH_VERSION});
+
+        for (const auto &requirement : provider.dependencies(id, version))
+        {
+          if (seen.insert(requirement.package).second)
+          {
+            queue.emplace_back(requirement.package, requirement.range);
+          }
+        }
       }
 
-      const json versionNode = versions.at(spec.resolvedVersion);
-      const std::string repoUrl = entry.at("repo").at("url").get<std::string>();
-      const std::string tag = versionNode.at("tag").get<std::string>();
-      const std::string commit = versionNode.at("commit").get<std::string>();
+      return lockedDependencies;
+    }
 
-      const std::string visitKey = spec.id() + "@" + spec.resolvedVersion;
-      if (visited.count(visitKey))
+    fs::path resolve_cache_dir()
+    {
+      return vix_root() / "cache" / "resolve";
+    }
+
+    /**
+     * @brief Everything a resolution depends on: the manifest constraints, in
+     * order, and the revision of the registry index.
+     */
+    std::string resolution_inputs(
+        const std::vector<PkgSpec> &roots,
+        const vix::cli::registry::CompiledRegistryIndex &index)
+    {
+      std::string inputs = "resolve-v1\n" + std::string(index.revision()) + "\n";
+      for (const auto &spec : roots)
       {
-        return;
+        inputs += spec.id() + "@" + spec.requestedVersion + "\n";
       }
-      visited.insert(visitKey);
 
-      const std::string idDot = spec.ns + "." + spec.name;
+      return inputs;
+    }
+
+    fs::path resolution_cache_path(const std::string &inputs)
+    {
+      return resolve_cache_dir() /
+             (vix::cli::util::hex64(vix::cli::util::fnv1a64_str(inputs, 1469598103934665603ull)) + ".json");
+    }
+
+    std::optional<std::vector<vix::cli::util::lockfile::LockedDependency>>
+    read_cached_resolution(const std::string &inputs)
+    {
+      try
+      {
+        const fs::path path = resolution_cache_path(inputs);
+        if (!fs::exists(path))
+        {
+          return std::nullopt;
+        }
 
-      std::string installedDir;
-      clone_checkout_or_throw(repoUrl, idDot, commit, installedDir);
+        const json cached = read_json_file_or_throw(path);
+        if (cached.value("inputs", "") != inputs || !cached.contains("dependencies"))
+        {
+          return std::nullopt;
+        }
 
-      const auto contentHash = vix::cli::util::sha256_package_directory(installedDir);
-      const std::string hashStr = contentHash.value_or("");
+        std::vector<vix::cli::util::lockfile::LockedDependency> out;
+        for (const auto &item : cached.at("dependencies"))
+        {
+          out.push_back(vix::cli::util::lockfile::LockedDependency{
+              item.at("id").get<std::string>(),
+              item.at("requested").get<std::string>(),
+              item.at("version").get<std::string>(),
+              item.at("repo").get<std::string>(),
+              item.at("tag").get<std::string>(),
+              item.at("commit").get<std::string>(),
+              item.at("hash").get<std::string>(),
+              item.at("hashAlgorithm").get<std::string>(),
+              item.at("hashVersion").get<int>()});
+        }
 
-      upsert_locked_dependency(
-          lockedDependencies,
-          vix::cli::util::lockfile::LockedDependency{
-              spec.id(),
-              spec.requestedVersion.empty() ? spec.resolvedVersion : spec.requestedVersion,
-              spec.resolvedVersion,
-              repoUrl,
-              tag,
-              commit,
-              hashStr,
-              vix::cli::util::PACKAGE_HASH_ALGORITHM,
-              vix::cli::util::PACKAGE_HASH_VERSION});
+        return out;
+      }
+      catch (...)
+      {
+        return std::nullopt;
+      }
+    }
 
-      const auto transitiveDependencies = read_vix_json_deps_v1(fs::path(installedDir));
-      for (auto transitiveSpec : transitiveDependencies)
+    void write_cached_resolution(
+        const std::string &inputs,
+        const std::vector<vix::cli::util::lockfile::LockedDependency> &lockedDependencies)
+    {
+      json cached;
+      cached["inputs"] = inputs;
+      cached["dependencies"] = json::array();
+      for (const auto &dependency : lockedDependencies)
+      {
+        cached["dependencies"].push_back({{"id", dependency.id},
+                                          {"requested", dependency.requested},
+                                          {"version", dependency.version},
+                                          {"repo", dependency.repo},
+                                          {"tag", dependency.tag},
+                                          {"commit", dependency.commit},
+                                          {"hash", dependency.hash},
+                                          {"hashAlgorithm", dependency.hashAlgorithm},
+                                          {"hashVersion", dependency.hashVersion}});
+      }
+
+      std::error_code ec;
+      fs::create_directories(resolve_cache_dir(), ec);
+
+      const fs::path path = resolution_cache_path(inputs);
+      const fs::path tmp = path.string() + ".tmp." + std::to_string(std::random_device{}());
+      {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out || !(out << cached.dump(2) << "\n"))
+        {
+          return;
+        }
+      }
+      fs::rename(tmp, path, ec);
+      if (ec)
       {
-        resolve_transitive_or_throw(transitiveSpec, visited, lockedDependencies);
+        fs::remove(tmp, ec);
       }
     }
   }
@@ -463,9 +635,7 @@ namespace vix::cli::util::resolver
   {
     ensure_registry_present_or_throw();
 
-    std::vector<vix::cli::util::lockfile::LockedDependency> lockedDependencies;
-    std::unordered_set<std::string> visited;
-
+    std::vector<PkgSpec> roots;
     for (const auto &dependency : manifestDependencies)
     {
       const auto spec = parse_dependency_spec(dependency);
@@ -474,9 +644,41 @@ namespace vix::cli::util::resolver
         throw std::runtime_error("invalid manifest dependency: " + dependency.id);
       }
 
-      resolve_transitive_or_throw(*spec, visited, lockedDependencies);
+      roots.push_back(*spec);
+    }
+
+    std::string indexError;
+    const auto index = vix::cli::registry::open_registry_index(registry_dir(), &indexError);
+    if (!index.has_value())
+    {
+      throw std::runtime_error(indexError);
+    }
+
+    const std::string inputs = resolution_inputs(roots, *index);
+    if (auto cached = read_cached_resolution(inputs))
+    {
+      return std::move(*cached);
+    }
+
+    std::vector<pubgrub::Requirement> requirements;
+    for (const auto &spec : roots)
+    {
+      requirements.push_back({spec.id(), spec.requestedVersion});
+    }
+
+    RegistryProvider provider(*index);
+    std::map<std::string, std::string> solution;
+    try
+    {
+      solution = pubgrub::solve(requirements, provider);
+    }
+    catch (const pubgrub::SolveFailure &failure)
+    {
+      throw std::runtime_error(std::string("dependency resolution failed:\n") + failure.what());
     }
 
+    auto lockedDependencies = lock_solution(roots, solution, provider);
+    write_cached_resolution(inputs, lockedDependencies);
     return lockedDependencies;
   }
 
@@ -486,10 +688,13 @@ namespace vix::cli::util::resolver
     ensure_registry_present_or_throw();
     const auto spec = parse_dep_string_v1(packageId);
     if (!spec.has_value()) throw std::runtime_error("invalid registry package id: " + packageId);
-    const json entry = read_json_file_or_throw(entry_path(spec->ns, spec->name));
-    if (!entry.contains("versions") || !entry["versions"].is_object()) throw std::runtime_error("invalid registry entry: missing versions for " + packageId);
+    std::string indexError;
+    const auto index = vix::cli::registry::open_registry_index(registry_dir(), &indexError);
+    if (!index.has_value()) throw std::runtime_error(indexError);
+    const auto package = index->find(spec->ns, spec->name);
+    if (!package.has_value()) throw std::runtime_error("package not found: " + packageId);
     std::vector<std::string> versions;
-    for (auto it = entry["versions"].begin(); it != entry["versions"].end(); ++it) versions.push_back(it.key());
+    for (const auto &version : index->versions(*package)) versions.emplace_back(version.version);
     return versions;
   }
 }
@@ -0,0 +1,153 @@
+#include <vix/cli/commands/bench/BenchResults.hpp>
+#include <vix/cli/commands/bench/BenchStats.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace detail = vix::commands::BenchCommand::detail;
+
+namespace
+{
+  bool near(double a, double b, double eps)
+  {
+    return std::abs(a - b) < eps;
+  }
+
+  detail::BenchRun run_of(const std::string &name, const std::vector<double> &samples)
+  {
+    detail::BenchRun run;
+    run.commit = "abc";
+    run.series.push_back(detail::BenchSeries{name, samples});
+    return run;
+  }
+}
+
+int main()
+{
+  // Medians.
+  {
+    assert(detail::median({3.0, 1.0, 2.0}) == 2.0);
+    assert(detail::median({4.0, 1.0, 3.0, 2.0}) == 2.5);
+    assert(detail::median({}) == 0.0);
+  }
+
+  // Mann-Whitney U: exact distribution for small samples without ties.
+  {
+    // Complete separation of 3 vs 3: p = 2 / C(6, 3) = 0.1.
+    const auto separated = detail::mann_whitney_u({1.0, 2.0, 3.0}, {4.0, 5.0, 6.0});
+    assert(separated.exact);
+    assert(separated.u == 0.0);
+    assert(near(separated.pValue, 0.1, 1e-12));
+
+    // Interleaved samples are indistinguishable.
+    const auto mixed = detail::mann_whitney_u({1.0, 4.0, 5.0, 8.0}, {2.0, 3.0, 6.0, 7.0});
+    assert(mixed.pValue > 0.5);
+
+    // Symmetric in its arguments.
+    const auto swapped = detail::mann_whitney_u({4.0, 5.0, 6.0}, {1.0, 2.0, 3.0});
+    assert(swapped.u == 9.0);
+    assert(near(swapped.pValue, separated.pValue, 1e-12));
+  }
+
+  // Normal approximation with ties.
+  {
+    std::vector<double> a;
+    std::vector<double> b;
+    for (int i = 0; i < 30; ++i)
+    {
+      a.push_back(10.0 + (i % 5));
+      b.push_back(12.0 + (i % 5));
+    }
+
+    const auto result = detail::mann_whitney_u(a, b);
+    assert(!result.exact);
+    assert(result.pValue < 0.01);
+
+    assert(detail::mann_whitney_u({1.0, 1.0}, {1.0, 1.0}).pValue == 1.0);
+  }
+
+  // Verdicts need both a significant test and a change over the threshold.
+  {
+    const std::vector<double> before = {1.00, 1.01, 0.99, 1.02, 0.98, 1.00, 1.01, 0.99, 1.00, 1.01};
+    std::vector<double> slower;
+    std::vector<double> slightly;
+    for (const double v : before)
+    {
+      slower.push_back(v * 1.20);
+      slightly.push_back(v * 1.03 + 0.001);
+    }
+
+    const detail::BenchRun baseline = run_of("parse", before);
+    const detail::BenchCompareOptions options{0.05, 0.05};
+
+    const auto regressed = detail::compare_bench_runs(run_of("parse", slower), &baseline, options);
+    assert(regressed.size() == 1);
+    assert(regressed[0].verdict == detail::BenchVerdict::Regressed);
+    assert(near(regressed[0].change, 0.20, 1e-9));
+
+    const auto fresh = detail::compare_bench_runs(baseline, nullptr, options);
+    assert(fresh[0].verdict == detail::BenchVerdict::New);
+
+    // Significant but under the threshold.
+    const auto small = detail::compare_bench_runs(run_of("parse", slightly), &baseline, options);
+    assert(small[0].verdict == detail::BenchVerdict::Unchanged);
+
+    const detail::BenchRun slowRun = run_of("parse", slower);
+    const auto better = detail::compare_bench_runs(baseline, &slowRun, options);
+    assert(better[0].verdict == detail::BenchVerdict::Improved);
+
+    // Three samples cannot reach p < 0.05, whatever the change.
+    const detail::BenchRun tiny = run_of("parse", {1.0, 1.0, 1.0});
+    const auto noisy = detail::compare_bench_runs(run_of("parse", {2.0, 2.1, 2.2}), &tiny, options);
+    assert(noisy[0].verdict == detail::BenchVerdict::Unchanged);
+  }
+
+  // Google Benchmark JSON: repetitions only, converted to seconds.
+  {
+    const std::string text = R"({
+      "context": {"date": "2026-01-01"},
+      "benchmarks": [
+        {"name": "BM_Parse/64", "run_name": "BM_Parse/64", "run_type": "iteration",
+         "repetition_index": 0, "real_time": 120.0, "cpu_time": 119.0, "time_unit": "ns"},
+        {"name": "BM_Parse/64", "run_name": "BM_Parse/64", "run_type": "iteration",
+         "repetition_index": 1, "real_time": 130.0, "cpu_time": 129.0, "time_unit": "ns"},
+        {"name": "BM_Parse/64_mean", "run_name": "BM_Parse/64", "run_type": "aggregate",
+         "aggregate_name": "mean", "real_time": 125.0, "time_unit": "ns"},
+        {"name": "BM_Load", "run_name": "BM_Load", "run_type": "iteration",
+         "real_time": 2.5, "time_unit": "ms"},
+        {"name": "BM_Broken", "run_type": "iteration", "error_occurred": true,
+         "real_time": 1.0, "time_unit": "ns"}
+      ]
+    })";
+
+    const auto series = detail::parse_google_benchmark_json(text, "bench_parser");
+    assert(series.size() == 2);
+    assert(series[0].name == "bench_parser/BM_Parse/64");
+    assert(series[0].samples.size() == 2);
+    assert(near(series[0].samples[1], 130e-9, 1e-15));
+    assert(series[1].name == "bench_parser/BM_Load");
+    assert(near(series[1].samples[0], 2.5e-3, 1e-12));
+
+    assert(detail::parse_google_benchmark_json("not json", "x").empty());
+  }
+
+  // Stored runs round trip.
+  {
+    detail::BenchRun run = run_of("bench_io", {0.5, 0.25});
+    run.cpu = "7";
+
+    const auto parsed = detail::parse_bench_run_json(detail::bench_run_json(run));
+    assert(parsed);
+    assert(parsed->commit == "abc" && parsed->cpu == "7");
+    assert(parsed->find("bench_io")->samples == (std::vector<double>{0.5, 0.25}));
+    assert(!parsed->find("missing"));
+
+    assert(!detail::parse_bench_run_json("{\"version\":2,\"benchmarks\":[]}"));
+    assert(detail::bench_run_path("/p", "abc") == std::filesystem::path("/p/.vix/bench/abc.json"));
+    assert(detail::bench_baseline_path("/p").filename() == "baseline.json");
+  }
+
+  return 0;
+}
@@ -0,0 +1,140 @@
+#include <vix/cli/util/CompilerIdentity.hpp>
+
+#include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+namespace util = vix::cli::util;
+
+namespace
+{
+  const char *GCC_PROBE =
+      "Using built-in specs.\n"
+      "Target: x86_64-linux-gnu\n"
+      "gcc version 12.2.0 (Debian 12.2.0-14)\n"
+      "#include \"...\" search starts here:\n"
+      "#include <...> search starts here:\n"
+      " /usr/include/c++/12\n"
+      " /usr/include\n"
+      "End of search list.\n"
+      "#define __GNUC__ 12\n"
+      "#define __GNUC_MINOR__ 2\n"
+      "#define __GNUC_PATCHLEVEL__ 0\n"
+      "#define __cplusplus 201703L\n";
+
+  const char *CLANG_PROBE =
+      "clang version 18.1.3\n"
+      "Target: x86_64-pc-linux-gnu\n"
+      "#include <...> search starts here:\n"
+      " /usr/lib/llvm-18/lib/clang/18/include\n"
+      " /System/Library/Frameworks (framework directory)\n"
+      "End of search list.\n"
+      "#define __GNUC__ 4\n"
+      "#define __clang__ 1\n"
+      "#define __clang_major__ 18\n"
+      "#define __clang_minor__ 1\n"
+      "#define __clang_patchlevel__ 3\n"
+      "#define __cplusplus 201703L\n";
+
+  int count_lines(const fs::path &p)
+  {
+    std::ifstream in(p);
+    int n = 0;
+    for (std::string line; std::getline(in, line);)
+      ++n;
+    return n;
+  }
+} // namespace
+
+int main()
+{
+  util::CompilerIdentity gcc;
+  assert(util::parse_compiler_probe_output(GCC_PROBE, gcc));
+  assert(gcc.family == "gcc" && gcc.version == "12.2.0");
+  assert(gcc.target == "x86_64-linux-gnu");
+  assert(gcc.defaultStandard == "c++17");
+  assert(gcc.builtinIncludeDirs.size() == 2);
+  assert(util::compiler_identity_tag(gcc) == "g++-12.2.0");
+
+  util::CompilerIdentity clang;
+  assert(util::parse_compiler_probe_output(CLANG_PROBE, clang));
+  assert(clang.family == "clang" && clang.version == "18.1.3");
+  assert(clang.target == "x86_64-pc-linux-gnu");
+  assert(clang.builtinIncludeDirs.size() == 2);
+  assert(clang.builtinIncludeDirs[1].find("framework") == std::string::npos);
+  assert(util::compiler_identity_tag(clang) == "clang++-18.1.3");
+
+  util::CompilerIdentity broken;
+  assert(!util::parse_compiler_probe_output("error: unknown argument\n", broken));
+
+#ifndef _WIN32
+  // A fake compiler that logs every invocation: a warm lookup must not run it.
+  const fs::path root = fs::temp_directory_path() / "vix compiler identity test";
+  fs::remove_all(root);
+  fs::create_directories(root / "home");
+  ::setenv("HOME", (root / "home").c_str(), 1);
+
+  const fs::path fake = root / "fake-c++";
+  const fs::path calls = root / "calls.log";
+  {
+    std::ofstream script(fake);
+    script << "#!/bin/sh\n"
+           << "echo run >> '" << calls.string() << "'\n"
+           << "cat <<'EOF'\n"
+           << GCC_PROBE
+           << "EOF\n";
+  }
+  fs::permissions(fake, fs::perms::owner_all);
+
+  auto first = util::compiler_identity(fake.string());
+  assert(first && !first->fromCache && first->version == "12.2.0");
+  assert(count_lines(calls) == 1);
+  assert(fs::exists(util::compiler_identity_cache_file()));
+
+  util::reset_compiler_identity_memo_for_test();
+  auto second = util::compiler_identity(fake.string());
+  assert(second && second->fromCache && second->target == "x86_64-linux-gnu");
+  assert(count_lines(calls) == 1);
+
+  // Replacing the binary invalidates the entry.
+  {
+    std::ofstream script(fake, std::ios::app);
+    script << "# upgraded\n";
+  }
+  util::reset_compiler_identity_memo_for_test();
+  auto third = util::compiler_identity(fake.string());
+  assert(third && !third->fromCache);
+  assert(count_lines(calls) == 2);
+
+  // Two links to one multi-call driver are two compilers.
+  const fs::path driver = root / "driver";
+  {
+    std::ofstream script(driver);
+    script << "#!/bin/sh\n"
+           << "case \"$0\" in\n"
+           << "*clang*) cat <<'EOF'\n" << CLANG_PROBE << "EOF\n;;\n"
+           << "*) cat <<'EOF'\n" << GCC_PROBE << "EOF\n;;\n"
+           << "esac\n";
+  }
+  fs::permissions(driver, fs::perms::owner_all);
+  fs::create_symlink(driver, root / "g++");
+  fs::create_symlink(driver, root / "clang++");
+
+  util::reset_compiler_identity_memo_for_test();
+  auto viaGcc = util::compiler_identity((root / "g++").string());
+  auto viaClang = util::compiler_identity((root / "clang++").string());
+  assert(viaGcc && viaGcc->family == "gcc");
+  assert(viaClang && viaClang->family == "clang" && !viaClang->fromCache);
+
+  util::reset_compiler_identity_memo_for_test();
+  viaClang = util::compiler_identity((root / "clang++").string());
+  assert(viaClang && viaClang->fromCache && viaClang->family == "clang");
+  assert(util::compiler_identity((root / "g++").string())->family == "gcc");
+
+  assert(!util::compiler_identity((root / "missing-c++").string()));
+  fs::remove_all(root);
+#endif
+}
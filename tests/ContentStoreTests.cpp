@@ -0,0 +1,124 @@
+#include <vix/cli/util/ContentStore.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+using vix::cli::util::ContentStore;
+
+namespace
+{
+  void write(const fs::path &p, const std::string &text)
+  {
+    fs::create_directories(p.parent_path());
+    std::ofstream(p, std::ios::binary | std::ios::trunc) << text;
+  }
+
+  std::string read(const fs::path &p)
+  {
+    std::ifstream in(p, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  std::size_t count_objects(const fs::path &root)
+  {
+    std::size_t n = 0;
+    for (const auto &entry : fs::directory_iterator(root))
+      n += entry.is_regular_file() ? 1 : 0;
+    return n;
+  }
+}
+
+int main()
+{
+  const fs::path root = fs::temp_directory_path() / ("vix-content-store-" + std::to_string(::getpid()));
+  fs::remove_all(root);
+
+  const fs::path tree = root / "store" / "git" / "gk.pkg" / "abc123";
+  write(tree / "include" / "pkg.hpp", "#pragma once\n");
+  write(tree / "include" / "copy.hpp", "#pragma once\n");
+  write(tree / "tools" / "gen.sh", "#!/bin/sh\n");
+  fs::permissions(tree / "tools" / "gen.sh", fs::perms::owner_exec, fs::perm_options::add);
+  fs::create_symlink("include/pkg.hpp", tree / "pkg.hpp");
+  write(tree / ".git" / "HEAD", "abc123\n");
+
+  const ContentStore store(root);
+  assert(store.root() == root / "store" / "cas");
+
+  // Identical files share one object; projects are hardlinks to it.
+  const fs::path a = root / "a" / ".vix" / "deps" / "gk.pkg";
+  const fs::path b = root / "b" / ".vix" / "deps" / "gk.pkg";
+  const auto first = store.materialize(tree, a);
+  assert(first.files == 3 && first.hashed == 3);
+  assert(first.linked + first.cloned + first.copied == 3);
+  assert(count_objects(store.root()) == 2);
+
+  const auto second = store.materialize(tree, b);
+  assert(second.files == 3 && second.hashed == 0);
+
+  assert(read(b / "include" / "pkg.hpp") == "#pragma once\n");
+  assert(fs::is_symlink(b / "pkg.hpp"));
+  assert(fs::read_symlink(b / "pkg.hpp") == "include/pkg.hpp");
+  assert(!fs::exists(b / ".git"));
+  assert((fs::status(b / "tools" / "gen.sh").permissions() & fs::perms::owner_exec) != fs::perms::none);
+  assert((fs::status(b / "include" / "pkg.hpp").permissions() & fs::perms::owner_write) == fs::perms::none);
+  if (first.linked == 3)
+  {
+    assert(fs::equivalent(a / "include" / "pkg.hpp", b / "include" / "copy.hpp"));
+    assert(fs::hard_link_count(a / "include" / "pkg.hpp") == 5);
+  }
+
+  // The marker follows the tree it came from.
+  assert(store.is_materialized(tree, a));
+  assert(!store.is_materialized(tree, root / "missing"));
+  assert(!store.is_materialized(root / "other", a));
+  write(tree / "include" / "pkg.hpp", "#pragma once // edited\n");
+  assert(!store.is_materialized(tree, a));
+  assert(read(a / "include" / "pkg.hpp") == "#pragma once\n");
+
+  const auto third = store.materialize(tree, a);
+  assert(third.hashed == 3);
+  assert(read(a / "include" / "pkg.hpp") == "#pragma once // edited\n");
+  assert(store.is_materialized(tree, a));
+
+  // Nothing referenced is collected; a dry run removes nothing.
+  auto collected = store.gc(false);
+  assert(collected.objects == 0 && collected.manifests == 0);
+
+  fs::remove_all(root / "b");
+  collected = store.gc(false);
+  assert(collected.objects == 0);
+  assert(count_objects(store.root()) == 3);
+
+  fs::remove_all(root / "a");
+  collected = store.gc(true);
+  assert(collected.objects == 3 && collected.manifests == 0);
+  assert(collected.bytes > 0);
+  assert(count_objects(store.root()) == 3);
+
+  // Manifests go with their tree.
+  fs::remove_all(tree);
+  collected = store.gc(false);
+  assert(collected.objects == 3 && collected.manifests == 1);
+  assert(count_objects(store.root()) == 0);
+
+  // A staging file may be one a concurrent materialize() is writing.
+  const fs::path staged = store.root() / "0123abcd.tmp-1-1";
+  write(staged, "partial");
+  collected = store.gc(false);
+  assert(collected.objects == 0 && fs::exists(staged));
+
+  fs::last_write_time(staged, fs::file_time_type::clock::now() - std::chrono::hours(2));
+  collected = store.gc(false);
+  assert(collected.objects == 1 && !fs::exists(staged));
+
+  fs::remove_all(root);
+  return 0;
+}
@@ -0,0 +1,161 @@
+#include <vix/cli/cmake/DepArtifacts.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+using namespace vix::cli::build;
+
+namespace
+{
+  void write(const fs::path &p, const std::string &text)
+  {
+    fs::create_directories(p.parent_path());
+    std::ofstream(p, std::ios::binary | std::ios::trunc) << text;
+  }
+
+  fs::path source_of_tiny(const fs::path &root)
+  {
+    const fs::path source = root / "tiny";
+    write(source / "CMakeLists.txt",
+          "cmake_minimum_required(VERSION 3.16)\n"
+          "project(tiny CXX)\n"
+          "add_library(tiny tiny.cpp)\n"
+          "target_include_directories(tiny PUBLIC $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}/include>)\n"
+          "install(TARGETS tiny ARCHIVE DESTINATION lib)\n"
+          "install(DIRECTORY include/ DESTINATION include)\n");
+    write(source / "include" / "tiny.hpp", "int tiny();\n");
+    write(source / "tiny.cpp", "#include \"tiny.hpp\"\nint tiny() { return 42; }\n");
+    return source;
+  }
+
+  DepArtifactKey key_for(const std::string &buildType)
+  {
+    DepArtifactKey key;
+    key.id = "gk/tiny";
+    key.version = "1.0.0";
+    key.commit = "0123456789abcdef";
+    key.compiler = "g++-13.2.0";
+    key.target = "x86_64-linux-gnu";
+    key.buildType = buildType;
+    key.cmakeArgs = {"-DBUILD_SHARED_LIBS=OFF"};
+    return key;
+  }
+}
+
+int main()
+{
+  const fs::path root = fs::temp_directory_path() / ("vix-dep-artifacts-" + std::to_string(::getpid()));
+  fs::remove_all(root);
+  const fs::path cache = root / "cache" / "build";
+
+  // Every field of the key is part of the fingerprint.
+  const DepArtifactKey release = key_for("Release");
+  const std::string fp = dep_artifact_fingerprint(release);
+  assert(fp == dep_artifact_fingerprint(key_for("Release")));
+  assert(fp != dep_artifact_fingerprint(key_for("Debug")));
+  for (auto change : {+[](DepArtifactKey &k) { k.commit = "fedcba"; },
+                      +[](DepArtifactKey &k) { k.compiler = "clang++-18.1.3"; },
+                      +[](DepArtifactKey &k) { k.target = "aarch64-linux-gnu"; },
+                      +[](DepArtifactKey &k) { k.cmakeArgs.push_back("-DGK_TINY_SIMD=ON"); }})
+  {
+    DepArtifactKey other = release;
+    change(other);
+    assert(dep_artifact_fingerprint(other) != fp);
+  }
+
+  // <target>/<compiler>/<build-type>/<pkg>@<version>/<fingerprint>
+  assert(dep_artifact_prefix(cache, release) ==
+         cache / "x86_64-linux-gnu" / "g++-13.2.0" / "Release" / "gk.tiny@1.0.0" / fp);
+  assert(cache_component("a b/c") == "a_b_c");
+  assert(cache_component("") == "unknown");
+
+  const DepArtifact missing = describe_dep_artifact(cache, release);
+  assert(!missing.ready && !missing.failed);
+  assert(missing.fingerprint == fp);
+
+  // An unidentified compiler is never guessed from the one that built vix.
+  {
+    const char *cxx = std::getenv("CXX");
+    const std::string saved = cxx ? cxx : "";
+    ::setenv("CXX", (root / "no-such-compiler").c_str(), 1);
+    assert(compiler_identity_component().empty());
+
+    DepArtifactKey unknown = release;
+    unknown.compiler = compiler_identity_component();
+    std::string unknownError;
+    assert(!ensure_dep_artifact(cache, unknown, root, unknownError).ready && !unknownError.empty());
+
+    if (cxx)
+      ::setenv("CXX", saved.c_str(), 1);
+    else
+      ::unsetenv("CXX");
+  }
+
+  if (std::system("cmake --version >/dev/null 2>&1") != 0)
+  {
+    fs::remove_all(root);
+    return 0;
+  }
+
+  // First use builds and installs the static library; later uses reuse it.
+  const fs::path source = source_of_tiny(root);
+
+  std::string error;
+  const DepArtifact built = ensure_dep_artifact(cache, release, source, error);
+  assert(built.ready && !built.failed && error.empty());
+  assert(built.libs == std::vector<std::string>{"lib/libtiny.a"});
+  assert(built.configPackages.empty());
+  assert(fs::exists(built.prefix / "include" / "tiny.hpp"));
+  assert(fs::exists(built.prefix / "manifest.json"));
+  assert(!fs::exists(built.prefix.string() + ".build"));
+
+  fs::remove_all(source);
+  const DepArtifact reused = ensure_dep_artifact(cache, release, source, error);
+  assert(reused.ready && error.empty());
+  assert(describe_dep_artifact(cache, release).libs == built.libs);
+
+  // A manifest of another commit does not count.
+  DepArtifactKey moved = release;
+  moved.commit = "fedcba";
+  fs::create_directories(dep_artifact_prefix(cache, moved));
+  fs::copy_file(built.prefix / "manifest.json", dep_artifact_prefix(cache, moved) / "manifest.json");
+  assert(!describe_dep_artifact(cache, moved).ready);
+
+  // A failed build is remembered and not retried at once for the same key...
+  const fs::path broken = root / "broken";
+  write(broken / "CMakeLists.txt", "cmake_minimum_required(VERSION 3.16)\nproject(broken CXX)\nadd_library(broken missing.cpp)\n");
+  const DepArtifactKey debug = key_for("Debug");
+  const DepArtifact failed = ensure_dep_artifact(cache, debug, broken, error);
+  assert(!failed.ready && failed.failed && !error.empty());
+  assert(!fs::exists(failed.prefix));
+  assert(fs::exists(failed.prefix.string() + ".log"));
+
+  error.clear();
+  fs::remove_all(failed.prefix.string() + ".log");
+  assert(ensure_dep_artifact(cache, debug, broken, error).failed);
+  assert(!error.empty() && !fs::exists(failed.prefix.string() + ".log"));
+
+  // ...but retried once the failure is a day old; a success forgets it.
+  const fs::path marker = failed.prefix.string() + ".failed";
+  fs::last_write_time(marker, fs::file_time_type::clock::now() - std::chrono::hours(25));
+  assert(!dep_build_failed_recently(marker));
+  assert(!describe_dep_artifact(cache, debug).failed);
+
+  error.clear();
+  const DepArtifact fixed = ensure_dep_artifact(cache, debug, source_of_tiny(root), error);
+  assert(fixed.ready && error.empty() && !fs::exists(marker));
+
+  // Shared with the script runner: package configs under share/<name>/.
+  write(root / "prefix" / "share" / "tinyjson" / "tinyjson-config.cmake", "");
+  write(root / "prefix" / "lib" / "cmake" / "Tiny" / "TinyConfig.cmake", "");
+  assert((find_installed_config_packages(root / "prefix") == std::vector<std::string>{"Tiny", "tinyjson"}));
+
+  fs::remove_all(root);
+  return 0;
+}
@@ -0,0 +1,140 @@
+#include <vix/cli/commands/run/dev/DevSocketHandoff.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace dev = vix::commands::RunCommand::dev;
+
+namespace
+{
+  int free_loopback_port()
+  {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    assert(::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+    socklen_t len = sizeof(addr);
+    assert(::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) == 0);
+    ::close(fd);
+    return ntohs(addr.sin_port);
+  }
+
+  // Behaves like an app that supports socket activation and sd_notify.
+  [[noreturn]] void run_activated_child()
+  {
+    const char *fds = std::getenv("LISTEN_FDS");
+    const char *pid = std::getenv("LISTEN_PID");
+    const char *notify = std::getenv("NOTIFY_SOCKET");
+    if (!fds || std::string(fds) != "1" || !pid || std::atoi(pid) != ::getpid() || !notify)
+      _exit(10);
+
+    int accepting = 0;
+    socklen_t len = sizeof(accepting);
+    if (::getsockopt(3, SOL_SOCKET, SO_ACCEPTCONN, &accepting, &len) != 0 || !accepting)
+      _exit(11);
+
+    const int n = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, notify, sizeof(addr.sun_path) - 1);
+    const char ready[] = "STATUS=up\nREADY=1";
+    if (::sendto(n, ready, sizeof(ready) - 1, 0, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0)
+      _exit(12);
+
+    const int client = ::accept(3, nullptr, nullptr);
+    if (client < 0)
+      _exit(13);
+    if (::write(client, "ok", 2) != 2)
+      _exit(14);
+    ::close(client);
+    _exit(0);
+  }
+} // namespace
+
+int main()
+{
+  dev::DevListenAddress address;
+  std::string err;
+
+  assert(dev::parse_listen_address("8080", address, err));
+  assert(address.host.empty() && address.port == 8080);
+  assert(address.to_string() == "*:8080");
+
+  assert(dev::parse_listen_address("127.0.0.1:3000", address, err));
+  assert(address.host == "127.0.0.1" && address.port == 3000);
+
+  assert(dev::parse_listen_address("[::1]:443", address, err));
+  assert(address.host == "::1" && address.port == 443);
+  assert(address.to_string() == "[::1]:443");
+
+  assert(!dev::parse_listen_address("", address, err));
+  assert(!dev::parse_listen_address("0", address, err));
+  assert(!dev::parse_listen_address("70000", address, err));
+  assert(!dev::parse_listen_address("host:http", address, err));
+  assert(!dev::parse_listen_address("::1:80", address, err));
+  assert(!dev::parse_listen_address("[::1]80", address, err));
+
+  const int port = free_loopback_port();
+
+  dev::DevSocketHandoff handoff;
+  assert(handoff.open({"127.0.0.1:" + std::to_string(port)}, err));
+  assert(handoff.active());
+
+  // A second session cannot take the same port.
+  dev::DevSocketHandoff busy;
+  assert(!busy.open({"127.0.0.1:" + std::to_string(port)}, err));
+  assert(!busy.active());
+
+  handoff.discard_notifications();
+
+  const pid_t child = ::fork();
+  assert(child >= 0);
+  if (child == 0)
+  {
+    handoff.prepare_child();
+    run_activated_child();
+  }
+
+  bool ready = false;
+  for (int i = 0; i < 200 && !ready; ++i)
+  {
+    ready = handoff.poll_ready();
+    if (!ready)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  assert(ready);
+
+  const int client = ::socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(static_cast<std::uint16_t>(port));
+  assert(::connect(client, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+
+  char reply[2] = {};
+  assert(::read(client, reply, sizeof(reply)) == 2);
+  assert(std::string(reply, 2) == "ok");
+  ::close(client);
+
+  int status = 0;
+  assert(::waitpid(child, &status, 0) == child);
+  assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  handoff.close();
+  assert(!handoff.active());
+
+  return 0;
+}
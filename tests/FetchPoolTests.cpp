@@ -0,0 +1,263 @@
+#include <vix/cli/util/FetchPool.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+using vix::cli::util::FetchPool;
+using vix::cli::util::LiveProgressBoard;
+
+namespace
+{
+  int sh(const std::string &command)
+  {
+    return std::system((command + " >/dev/null 2>&1").c_str());
+  }
+
+  bool contains(const std::string &text, const std::string &needle)
+  {
+    return text.find(needle) != std::string::npos;
+  }
+
+  // Shaped like install_project_dependencies: the first fetch fails while
+  // the others are still running, and the caller returns early. Results
+  // are declared before the pool so ~FetchPool joins the running jobs
+  // while their storage is still alive.
+  int fetch_until_failure(std::atomic<int> &finished)
+  {
+    std::deque<std::string> results;
+    FetchPool pool(4);
+    std::vector<std::size_t> jobs;
+    for (int i = 0; i < 4; ++i)
+    {
+      results.emplace_back();
+      std::string &out = results.back();
+      jobs.push_back(pool.submit([&out, &finished, i]()
+                                 {
+                                   if (i == 0)
+                                     throw std::runtime_error("clone failed");
+                                   std::this_thread::sleep_for(std::chrono::milliseconds(30));
+                                   out.assign(4096, 'x');
+                                   ++finished; }));
+    }
+
+    for (const std::size_t job : jobs)
+    {
+      try
+      {
+        pool.wait(job);
+      }
+      catch (const std::runtime_error &)
+      {
+        pool.cancel_pending();
+        return 1;
+      }
+    }
+    return 0;
+  }
+}
+
+int main()
+{
+  // Never more jobs in flight than workers, and every job runs once.
+  {
+    std::atomic<int> running{0}, peak{0}, ran{0};
+    FetchPool pool(3);
+    assert(pool.workers() == 3);
+
+    std::vector<std::size_t> jobs;
+    for (int i = 0; i < 12; ++i)
+    {
+      jobs.push_back(pool.submit([&]()
+                                 {
+                                   const int now = ++running;
+                                   int seen = peak.load();
+                                   while (now > seen && !peak.compare_exchange_weak(seen, now))
+                                     ;
+                                   std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                                   --running;
+                                   ++ran; }));
+    }
+    for (std::size_t job : jobs)
+      pool.wait(job);
+
+    assert(ran == 12);
+    assert(peak <= 3 && peak >= 1);
+    assert(FetchPool(0).workers() == 1);
+  }
+
+  // Errors come back through wait(); cancelled jobs never run.
+  {
+    std::atomic<bool> cancelledRan{false};
+    FetchPool pool(1);
+    const std::size_t failing = pool.submit([]()
+                                            { throw std::runtime_error("clone failed"); });
+    const std::size_t later = pool.submit([&]()
+                                          { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+    const std::size_t dropped = pool.submit([&]()
+                                            { cancelledRan = true; });
+
+    bool threw = false;
+    try
+    {
+      pool.wait(failing);
+    }
+    catch (const std::runtime_error &ex)
+    {
+      threw = std::string(ex.what()) == "clone failed";
+    }
+    assert(threw);
+
+    pool.cancel_pending();
+    try
+    {
+      pool.wait(later);
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+
+    threw = false;
+    try
+    {
+      pool.wait(dropped);
+    }
+    catch (const std::runtime_error &ex)
+    {
+      threw = std::string(ex.what()) == "fetch cancelled";
+    }
+    assert(threw);
+    assert(!cancelledRan);
+  }
+
+  // A failed fetch returns early while others are in flight; they finish
+  // before the pool and their results go away.
+  {
+    std::atomic<int> finished{0};
+    assert(fetch_until_failure(finished) == 1);
+    const int settled = finished.load();
+    assert(settled <= 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    assert(finished.load() == settled);
+  }
+
+  // Plain output: one line per phase change, nothing redrawn.
+  {
+    std::ostringstream out;
+    {
+      LiveProgressBoard board(out, false);
+      const std::size_t a = board.add_row("gk.jwt");
+      const std::size_t b = board.add_row("gk.json");
+      board.update(a, "receiving objects", "a 10%");
+      board.update(a, "receiving objects", "a 50%");
+      board.update(b, "receiving objects", "b 10%");
+      board.update(a, "resolving deltas", "a done");
+      assert(board.live_rows() == 2);
+      board.remove_row(a);
+      assert(board.live_rows() == 1);
+    }
+    assert(out.str() ==
+           "gk.jwt: receiving objects\n"
+           "gk.json: receiving objects\n"
+           "gk.jwt: resolving deltas\n");
+  }
+
+  // Terminal output: every live row is redrawn in place; pause() clears.
+  {
+    std::ostringstream out;
+    LiveProgressBoard board(out, true);
+    const std::size_t a = board.add_row("a");
+    const std::size_t b = board.add_row("b");
+    board.update(a, "receiving objects", "A1");
+    board.update(b, "receiving objects", "B1");
+    assert(contains(out.str(), "\033[1F\033[J\033[2KA1\n\033[2KB1\n"));
+
+    out.str("");
+    board.pause();
+    assert(out.str() == "\033[2F\033[J");
+    board.update(a, "receiving objects", "A2");
+    assert(out.str() == "\033[2F\033[J");
+    board.resume();
+    assert(contains(out.str(), "A2") && contains(out.str(), "B1"));
+
+    out.str("");
+    board.remove_row(a);
+    assert(out.str() == "\033[2F\033[J\033[2KB1\n");
+  }
+
+  // Parallel clones of local bare repositories over file://.
+  if (sh("git --version") == 0)
+  {
+    const fs::path root = fs::temp_directory_path() / ("vix-fetch-pool-" + std::to_string(::getpid()));
+    fs::remove_all(root);
+    fs::create_directories(root);
+
+    const int repos = 4;
+    for (int i = 0; i < repos; ++i)
+    {
+      const fs::path work = root / ("work" + std::to_string(i));
+      const fs::path bare = root / ("repo" + std::to_string(i) + ".git");
+      fs::create_directories(work);
+      const std::string git = "git -C '" + work.string() + "' ";
+      assert(sh(git + "init -q") == 0);
+      assert(sh("echo " + std::to_string(i) + " > '" + (work / "value.txt").string() + "'") == 0);
+      assert(sh(git + "add value.txt") == 0);
+      assert(sh(git + "-c user.email=t@example.invalid -c user.name=t commit -q -m init") == 0);
+      assert(sh("git clone -q --bare '" + work.string() + "' '" + bare.string() + "'") == 0);
+    }
+
+    std::ostringstream progress;
+    LiveProgressBoard board(progress, false);
+    FetchPool pool(2);
+    std::vector<std::size_t> jobs;
+    for (int i = 0; i < repos; ++i)
+    {
+      jobs.push_back(pool.submit([&, i]()
+                                 {
+                                   const std::string key = "repo" + std::to_string(i);
+                                   const std::size_t row = board.add_row(key);
+                                   board.update(row, "cloning", key);
+                                   const fs::path dst = root / ("out" + std::to_string(i));
+                                   if (sh("git clone -q 'file://" + (root / (key + ".git")).string() + "' '" + dst.string() + "'") != 0)
+                                     throw std::runtime_error("clone failed: " + key);
+                                   board.remove_row(row); }));
+    }
+    jobs.push_back(pool.submit([&]()
+                               {
+                                 if (sh("git clone -q 'file://" + (root / "missing.git").string() + "' '" + (root / "missing").string() + "'") != 0)
+                                   throw std::runtime_error("clone failed: missing"); }));
+
+    for (int i = 0; i < repos; ++i)
+    {
+      pool.wait(jobs[static_cast<std::size_t>(i)]);
+      assert(fs::exists(root / ("out" + std::to_string(i)) / "value.txt"));
+    }
+
+    bool threw = false;
+    try
+    {
+      pool.wait(jobs.back());
+    }
+    catch (const std::runtime_error &ex)
+    {
+      threw = contains(ex.what(), "missing");
+    }
+    assert(threw);
+    assert(board.live_rows() == 0);
+    assert(contains(progress.str(), "repo3: cloning"));
+
+    fs::remove_all(root);
+  }
+
+  return 0;
+}
@@ -120,6 +120,35 @@ rm "$NOOP_LINK" "$NOOP_CMAKE"
 test -e "$NOOP_LINK"
 test -e "$NOOP_CMAKE"
 
+# Once installed, an unchanged project is answered from the install stamp
+# without spawning git at all; losing generated integration invalidates it.
+NO_GIT_BIN="$ROOT/no-git-bin"
+mkdir -p "$NO_GIT_BIN"
+cat > "$NO_GIT_BIN/git" <<'EOF'
+#!/usr/bin/env bash
+echo "unexpected git $* during no-op install" >&2
+exit 89
+EOF
+chmod +x "$NO_GIT_BIN/git"
+test -f "$CMAKE_APP/.vix/install-stamp.json"
+(cd "$CMAKE_APP" && PATH="$NO_GIT_BIN:$PATH" "$VIX_BIN" install) | grep -q "already up to date"
+rm "$NOOP_CMAKE"
+(cd "$CMAKE_APP" && PATH="$NO_GIT_BIN:$PATH" "$VIX_BIN" install >/dev/null)
+test -e "$NOOP_CMAKE"
+
+# A project without dependencies is stamped too.
+EMPTY_APP="$ROOT/empty-app"
+mkdir -p "$EMPTY_APP"
+cat > "$EMPTY_APP/vix.app" <<'APP'
+name = "no_deps"
+type = "executable"
+standard = "c++20"
+APP
+echo '{"dependencies": []}' > "$EMPTY_APP/vix.lock"
+(cd "$EMPTY_APP" && "$VIX_BIN" install >/dev/null)
+test -f "$EMPTY_APP/.vix/install-stamp.json"
+(cd "$EMPTY_APP" && PATH="$NO_GIT_BIN:$PATH" "$VIX_BIN" install) | grep -q "already up to date"
+
 # Structured Git execution keeps local repository paths with spaces as one
 # argument through direct installation.
 SPACED_REPO="$ROOT/header repo with spaces"
@@ -314,3 +343,38 @@ if (cd "$ATOMIC_APP" && "$VIX_BIN" install >/dev/null 2>&1); then
   exit 1
 fi
 cmp "$ATOMIC_APP/vix.lock.before" "$ATOMIC_APP/vix.lock"
+
+# Fetches run on a bounded pool; a fresh cache forces both clones to happen
+# in the same install.
+PARALLEL_APP="$ROOT/parallel-fetch-app"
+mkdir -p "$PARALLEL_APP" "$ROOT/parallel-home"
+cat > "$PARALLEL_APP/vix.app" <<APP
+name = "parallel_fetch"
+type = "executable"
+standard = "c++20"
+sources = ["main.cpp"]
+
+[dependencies.sample]
+git = "file://$HEADER_REPO"
+rev = "$HEADER_COMMIT"
+header_only = true
+include = "include"
+
+[dependencies.cm]
+git = "file://$CMAKE_REPO"
+rev = "$CMAKE_COMMIT"
+target = "cm::cm"
+APP
+cat > "$PARALLEL_APP/main.cpp" <<'CPP'
+#include <cm/cm.hpp>
+#include <sample/sample.hpp>
+int main() { return cm::value() == sample::value() ? 0 : 1; }
+CPP
+if (cd "$PARALLEL_APP" && "$VIX_BIN" install --fetch-jobs 0 >/dev/null 2>&1); then
+  echo "install accepted --fetch-jobs 0" >&2
+  exit 1
+fi
+(cd "$PARALLEL_APP" && HOME="$ROOT/parallel-home" "$VIX_BIN" install --fetch-jobs 2 >/dev/null)
+test -e "$PARALLEL_APP/.vix/deps/sample"
+test -e "$PARALLEL_APP/.vix/deps/cm"
+(cd "$PARALLEL_APP" && HOME="$ROOT/parallel-home" "$VIX_BIN" run main.cpp >/dev/null)
@@ -0,0 +1,151 @@
+#include <vix/cli/util/GitMirror.hpp>
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+using vix::cli::util::GitMirror;
+
+namespace
+{
+  std::string quote(const std::string &s)
+  {
+    std::string out = "'";
+    for (char c : s)
+      out += c == '\'' ? std::string("'\\''") : std::string(1, c);
+    return out + "'";
+  }
+
+  int sh(const std::string &command)
+  {
+    return std::system((command + " >/dev/null 2>&1").c_str());
+  }
+
+  std::string capture(const std::string &command)
+  {
+    std::string out;
+    FILE *pipe = ::popen(command.c_str(), "r");
+    assert(pipe);
+    char buf[256];
+    while (std::fgets(buf, sizeof buf, pipe))
+      out += buf;
+    ::pclose(pipe);
+    while (!out.empty() && out.back() == '\n')
+      out.pop_back();
+    return out;
+  }
+
+  std::string read_file(const fs::path &p)
+  {
+    std::ifstream in(p);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  std::string commit_value(const fs::path &work, const std::string &value)
+  {
+    std::ofstream(work / "value.txt") << value << "\n";
+    const std::string git = "git -C " + quote(work.string()) + " ";
+    assert(sh(git + "add value.txt") == 0);
+    assert(sh(git + "-c user.email=t@example.invalid -c user.name=t commit -q -m " + value) == 0);
+    return capture(git + "rev-parse HEAD");
+  }
+}
+
+int main()
+{
+  if (sh("git --version") != 0)
+    return 0;
+
+  const fs::path root = fs::temp_directory_path() / ("vix-git-mirror-" + std::to_string(::getpid()));
+  fs::remove_all(root);
+  fs::create_directories(root / "work");
+
+  const fs::path work = root / "work";
+  const fs::path remote = root / "remote.git";
+  assert(sh("git -C " + quote(work.string()) + " init -q") == 0);
+  const std::string first = commit_value(work, "1");
+  assert(sh("git clone -q --bare " + quote(work.string()) + " " + quote(remote.string())) == 0);
+
+  const std::string url = "file://" + remote.string();
+  const fs::path vixRoot = root / "vix";
+
+  // One mirror per URL, under cache/git-mirrors.
+  const GitMirror mirror(vixRoot, url);
+  assert(mirror.path().parent_path() == vixRoot / "cache" / "git-mirrors");
+  assert(mirror.path().extension() == ".git");
+  assert(GitMirror(vixRoot, url).path() == mirror.path());
+  assert(GitMirror(vixRoot, url + "/other").path() != mirror.path());
+
+  std::vector<std::string> calls;
+  const auto network = [&](std::vector<std::string> args)
+  {
+    calls.push_back(args.front() == "-C" ? args[2] : args[0]);
+    std::string command = "git";
+    for (const std::string &arg : args)
+      command += " " + quote(arg);
+    return sh(command) == 0;
+  };
+
+  // First use clones the mirror; checkouts borrow its objects.
+  mirror.ensure_commit(first, network);
+  assert(calls == std::vector<std::string>{"clone"});
+  assert(mirror.has_commit(first));
+
+  const fs::path v1 = root / "checkouts" / "v1";
+  mirror.checkout(first, v1);
+  assert(read_file(v1 / "value.txt") == "1\n");
+  assert(fs::exists(v1 / ".git" / "objects" / "info" / "alternates"));
+  assert(fs::exists(mirror.path() / "refs" / "vix" / "keep" / first));
+  assert(capture("git -C " + quote(v1.string()) + " remote get-url origin") == url);
+  assert(capture("git -C " + quote(v1.string()) + " rev-parse HEAD") == first);
+
+  // A commit the mirror already has costs nothing.
+  calls.clear();
+  mirror.ensure_commit(first, network);
+  assert(calls.empty());
+
+  // A newer version is an incremental fetch into the same mirror.
+  const std::string second = commit_value(work, "2");
+  assert(sh("git -C " + quote(work.string()) + " push -q " + quote(remote.string()) + " HEAD") == 0);
+  assert(!mirror.has_commit(second));
+  mirror.ensure_commit(second, network);
+  assert(calls == std::vector<std::string>{"fetch"});
+
+  const fs::path v2 = root / "checkouts" / "v2";
+  mirror.checkout(second, v2);
+  assert(read_file(v2 / "value.txt") == "2\n");
+  assert(read_file(v1 / "value.txt") == "1\n");
+
+  // Unknown commits fail after a fetch by id.
+  calls.clear();
+  bool threw = false;
+  try
+  {
+    mirror.ensure_commit("0123456789abcdef0123456789abcdef01234567", network);
+  }
+  catch (const std::runtime_error &)
+  {
+    threw = true;
+  }
+  assert(threw);
+  assert(calls.size() == 2);
+
+  // Without a runner the mirror runs git itself.
+  const fs::path quiet = root / "checkouts" / "quiet";
+  GitMirror(root / "vix-quiet", url).ensure_commit(second);
+  GitMirror(root / "vix-quiet", url).checkout(second, quiet);
+  assert(read_file(quiet / "value.txt") == "2\n");
+
+  fs::remove_all(root);
+  return 0;
+}
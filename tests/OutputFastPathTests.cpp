@@ -0,0 +1,68 @@
+#include <vix/cli/commands/run/detail/OutputFastPath.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <string>
+
+namespace run = vix::commands::RunCommand::detail;
+
+int main()
+{
+  using namespace std::chrono_literals;
+
+  // Positions around the 16-byte SIMD block boundary and the scalar tail.
+  const std::string pad(40, 'x');
+  for (std::size_t at = 0; at <= pad.size(); ++at)
+  {
+    std::string hay = pad;
+    hay.insert(at, "Sanitizer");
+    assert(run::find_output_marker(hay, "Sanitizer") == at);
+    assert(run::find_output_marker(hay, "sanitizer", true) == at);
+    assert(run::find_output_marker(hay, "sanitizer") == std::string::npos);
+  }
+  assert(run::find_output_marker("short", "longer needle") == std::string::npos);
+
+  assert(run::output_reports_port_in_use("bind: Address already in use\n"));
+  assert(run::output_reports_port_in_use("listen failed: EADDRINUSE"));
+  assert(!run::output_reports_port_in_use("address already in us"));
+
+  assert(!run::output_has_filter_trigger("[I] GET /users 200 0.2ms\n[I] GET /health 200\n"));
+  assert(run::output_has_filter_trigger("==4242==ERROR: AddressSanitizer: heap-use-after-free\n"));
+  assert(run::output_has_filter_trigger("terminate called after throwing an instance of 'x'\n"));
+  assert(run::output_has_filter_trigger("libc++abi: terminating with uncaught exception\n"));
+  assert(run::output_has_filter_trigger("src/main.cpp:3:1: runtime error: signed integer overflow\n"));
+  assert(run::output_has_filter_trigger("ninja: no work to do.\n"));
+
+  assert(run::output_is_build_progress("[3/12] Building CXX object a.o\n"));
+  assert(run::output_is_build_progress("[]"));
+  assert(!run::output_is_build_progress("[info] listening on 8080\n"));
+  assert(!run::output_is_build_progress("[I] request\n"));
+  assert(!run::output_is_build_progress("[2026-01-02 10:00:00] tick\n"));
+  assert(!run::output_is_build_progress("[12/40 unterminated"));
+  assert(!run::output_is_build_progress("log [1/2]\n"));
+
+  assert(run::output_has_blank_line("a\n\nb\n"));
+  assert(run::output_has_blank_line("a\n \t\r\nb\n"));
+  assert(!run::output_has_blank_line("a\nb\n  "));
+
+  run::OutputRateMeter meter(1000.0, 100.0, 100ms);
+  const auto t0 = run::OutputRateMeter::Clock::now();
+  assert(!meter.observe(50, t0));
+  assert(meter.observe(500, t0 + 100ms));   // 5000 B/s: enter
+  assert(meter.observe(20, t0 + 200ms));    // 200 B/s: stay above leave
+  assert(!meter.observe(5, t0 + 300ms));    // 50 B/s: leave
+
+  run::BoundedOutputCapture small(4, 8);
+  small.append("head");
+  assert(small.str() == "head" && small.dropped_bytes() == 0);
+  small.append("0123");
+  small.append("4567");
+  assert(small.str() == "head01234567");
+  small.append("89AB");
+  assert(small.dropped_bytes() == 4);
+  assert(small.total_bytes() == 16);
+  assert(small.str() == "head\n[vix] 4 bytes of output omitted\n456789AB");
+  small.append(std::string(20, 'z') + "tailtail");
+  assert(small.str().substr(small.str().size() - 8) == "tailtail");
+  assert(small.dropped_bytes() == small.total_bytes() - 12);
+}
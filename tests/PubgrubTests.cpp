@@ -0,0 +1,233 @@
+#include <vix/cli/util/Pubgrub.hpp>
+#include <vix/cli/util/Semver.hpp>
+
+#include <cassert>
+#include <functional>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace vix::cli::util::pubgrub;
+namespace semver = vix::cli::util::semver;
+
+namespace
+{
+  // package -> version -> dependencies
+  using Registry = std::map<std::string, std::map<std::string, std::vector<Requirement>>>;
+
+  class MapProvider : public Provider
+  {
+  public:
+    explicit MapProvider(Registry registry) : registry_(std::move(registry)) {}
+
+    std::vector<std::string> versions(const std::string &package) override
+    {
+      assert(askedVersions.insert(package).second);
+      std::vector<std::string> out;
+      if (const auto it = registry_.find(package); it != registry_.end())
+        for (const auto &[v, deps] : it->second)
+          out.push_back(v);
+      return out;
+    }
+
+    std::vector<Requirement> dependencies(const std::string &package, const std::string &version) override
+    {
+      assert(askedDeps.insert(package + "@" + version).second);
+      return registry_.at(package).at(version);
+    }
+
+    std::set<std::string> askedVersions;
+    std::set<std::string> askedDeps;
+
+  private:
+    Registry registry_;
+  };
+
+  bool contains(const std::string &text, const std::string &needle)
+  {
+    return text.find(needle) != std::string::npos;
+  }
+
+  std::string failure(const Registry &registry, const std::vector<Requirement> &roots)
+  {
+    MapProvider provider(registry);
+    try
+    {
+      solve(roots, provider);
+    }
+    catch (const SolveFailure &e)
+    {
+      return e.what();
+    }
+    assert(false && "expected no solution");
+    return {};
+  }
+
+  bool valid(const Registry &registry, const std::vector<Requirement> &roots,
+             const std::map<std::string, std::string> &solution)
+  {
+    auto holds = [&](const Requirement &r)
+    {
+      const auto it = solution.find(r.package);
+      return it != solution.end() && (r.range.empty() || semver::satisfies(it->second, r.range));
+    };
+    for (const auto &r : roots)
+      if (!holds(r))
+        return false;
+    for (const auto &[pkg, version] : solution)
+      for (const auto &r : registry.at(pkg).at(version))
+        if (!holds(r))
+          return false;
+    return true;
+  }
+
+  // Tries every assignment; only usable on tiny registries.
+  bool brute_force_solvable(const Registry &registry, const std::vector<Requirement> &roots)
+  {
+    std::vector<std::string> names;
+    for (const auto &[name, versions] : registry)
+      names.push_back(name);
+
+    std::map<std::string, std::string> pick;
+    std::function<bool(std::size_t)> go = [&](std::size_t i) -> bool
+    {
+      if (i == names.size())
+      {
+        std::map<std::string, std::string> used;
+        std::vector<std::string> queue;
+        auto need = [&](const Requirement &r)
+        {
+          const auto it = pick.find(r.package);
+          if (it == pick.end() || (!r.range.empty() && !semver::satisfies(it->second, r.range)))
+            return false;
+          if (used.emplace(r.package, it->second).second)
+            queue.push_back(r.package);
+          return true;
+        };
+        for (const auto &r : roots)
+          if (!need(r))
+            return false;
+        while (!queue.empty())
+        {
+          const std::string p = queue.back();
+          queue.pop_back();
+          for (const auto &r : registry.at(p).at(used.at(p)))
+            if (!need(r))
+              return false;
+        }
+        return true;
+      }
+      for (const auto &[v, deps] : registry.at(names[i]))
+      {
+        pick[names[i]] = v;
+        if (go(i + 1))
+          return true;
+      }
+      pick.erase(names[i]);
+      return go(i + 1);
+    };
+    return go(0);
+  }
+}
+
+int main()
+{
+  // Diamond: the newest versions that agree are picked.
+  {
+    Registry registry{
+        {"gk/app", {{"1.0.0", {{"gk/json", "^1.0.0"}, {"gk/http", "^1.0.0"}}}}},
+        {"gk/http", {{"1.0.0", {{"gk/json", "^1.2.0"}}}, {"1.1.0", {{"gk/json", "^2.0.0"}}}}},
+        {"gk/json", {{"1.0.0", {}}, {"1.2.0", {}}, {"1.4.0", {}}, {"2.0.0", {}}}},
+    };
+    MapProvider provider(registry);
+    Stats stats;
+    const auto solution = solve({{"gk/app", ""}}, provider, &stats);
+    assert(solution.at("gk/http") == "1.0.0");
+    assert(solution.at("gk/json") == "1.4.0");
+    assert(valid(registry, {{"gk/app", ""}}, solution));
+    assert(stats.decisions == 4);
+  }
+
+  // Nothing is required: nothing is picked.
+  {
+    MapProvider provider({});
+    assert(solve({}, provider).empty());
+  }
+
+  // Conflicting transitive ranges are explained, not just reported.
+  {
+    Registry registry{
+        {"gk/auth", {{"1.0.0", {{"gk/json", "^1.0.0"}}}}},
+        {"gk/billing", {{"1.0.0", {{"gk/json", "^2.0.0"}}}}},
+        {"gk/json", {{"1.0.0", {}}, {"2.0.0", {}}}},
+    };
+    const std::string why = failure(registry, {{"gk/auth", "^1.0.0"}, {"gk/billing", "^1.0.0"}});
+    assert(contains(why, "gk/auth 1.0.0 depends on gk/json ^1.0.0"));
+    assert(contains(why, "gk/billing 1.0.0 depends on gk/json ^2.0.0"));
+    assert(contains(why, "version solving failed"));
+  }
+
+  // Unknown packages and empty ranges say so.
+  {
+    Registry registry{{"gk/app", {{"1.0.0", {{"gk/missing", "^1.0.0"}}}}}};
+    assert(contains(failure(registry, {{"gk/app", ""}}), "which is not in the registry"));
+    assert(contains(failure({{"gk/json", {{"1.0.0", {}}}}}, {{"gk/json", "^3.0.0"}}),
+                    "which matches no published version"));
+  }
+
+  // Backtracking: the newest app needs a lib that cannot be satisfied.
+  {
+    Registry registry{
+        {"gk/app", {{"1.0.0", {{"gk/lib", "^1.0.0"}}}, {"2.0.0", {{"gk/lib", "^2.0.0"}}}}},
+        {"gk/lib", {{"1.0.0", {}}, {"2.0.0", {{"gk/gone", "^1.0.0"}}}}},
+    };
+    MapProvider provider(registry);
+    const auto solution = solve({{"gk/app", ""}}, provider);
+    assert(solution.at("gk/app") == "1.0.0");
+    assert(solution.at("gk/lib") == "1.0.0");
+  }
+
+  // Random registries agree with exhaustive search.
+  std::mt19937 rng(7);
+  const std::vector<std::string> versions{"1.0.0", "1.1.0", "2.0.0", "2.1.0"};
+  const std::vector<std::string> ranges{"", "^1.0.0", "^1.1.0", "^2.0.0", ">=1.1.0", "<2.0.0", "2.1.0"};
+  for (int round = 0; round < 300; ++round)
+  {
+    Registry registry;
+    const int packages = 2 + static_cast<int>(rng() % 4);
+    for (int p = 0; p < packages; ++p)
+    {
+      const std::string name = "p" + std::to_string(p);
+      for (const auto &v : versions)
+      {
+        if (rng() % 3 == 0)
+          continue;
+        std::vector<Requirement> deps;
+        for (int q = p + 1; q < packages + 1; ++q)
+          if (rng() % 3 == 0)
+            deps.push_back({"p" + std::to_string(q), ranges[rng() % ranges.size()]});
+        registry[name][v] = deps;
+      }
+      registry[name];
+    }
+    registry["p" + std::to_string(packages)];
+
+    const std::vector<Requirement> roots{{"p0", ranges[rng() % ranges.size()]}};
+    MapProvider provider(registry);
+    bool solved = true;
+    try
+    {
+      const auto solution = solve(roots, provider);
+      assert(valid(registry, roots, solution));
+    }
+    catch (const SolveFailure &)
+    {
+      solved = false;
+    }
+    assert(solved == brute_force_solvable(registry, roots));
+  }
+
+  return 0;
+}
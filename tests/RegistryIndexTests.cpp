@@ -0,0 +1,114 @@
+#include <vix/cli/registry/RegistryIndex.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+using namespace vix::cli::registry;
+
+namespace
+{
+  void write(const fs::path &p, const std::string &text)
+  {
+    fs::create_directories(p.parent_path());
+    std::ofstream(p, std::ios::binary | std::ios::trunc) << text;
+  }
+
+  void write_entry(const fs::path &repo, const std::string &ns, const std::string &name, const std::string &body)
+  {
+    write(repo / "index" / (ns + "." + name + ".json"),
+          R"({"namespace":")" + ns + R"(","name":")" + name + R"(",)" + body + "}");
+  }
+}
+
+int main()
+{
+  const fs::path root = fs::temp_directory_path() / ("vix-registry-index-" + std::to_string(::getpid()));
+  fs::remove_all(root);
+  const fs::path repo = root / "registry" / "index";
+
+  std::string error;
+  assert(!open_registry_index(repo, &error) && error == "registry not synced");
+
+  write_entry(repo, "gk", "json",
+              R"("description":"JSON for C++","type":"header-only","keywords":["json","parser"],)"
+              R"("repo":{"url":"https://github.com/gk/json"},)"
+              R"("versions":{"1.10.0":{"tag":"v1.10.0","commit":"c110","deps":["gk/core@^1.0.0",{"id":"gk/fmt","version":"^2.0.0"}]},)"
+              R"("1.2.0":{"tag":"v1.2.0","commit":"c12"},"0.9.0":{"tag":"v0.9.0","commit":"c09"}})");
+  write_entry(repo, "gk", "core", R"("versions":{"1.0.0":{"tag":"v1.0.0","commit":"c1"}},"latest":"1.0.0")");
+  write_entry(repo, "ada", "notebook",
+              R"("displayName":"Notebook","extensions":{"note":{"api":"1","capabilities":["kernel","render"],"cellTypes":[{"id":"python"}]}},"versions":{})");
+  write(repo / "index" / "broken.json", "{ not json");
+  write(repo / "README.md", "not an entry");
+
+  const auto compiled = compile_registry_index(repo, &error);
+  assert(compiled && *compiled == 3);
+  assert(fs::exists(compiled_index_path(repo)));
+  assert(compiled_index_path(repo) == root / "registry" / "index.bin");
+
+  auto index = CompiledRegistryIndex::open(compiled_index_path(repo));
+  assert(index && index->size() == 3);
+  assert(index->revision() == registry_index_revision(repo));
+
+  // Sorted by entry file stem, looked up by binary search.
+  assert(index->package(0).file == "ada.notebook" && index->package(2).file == "gk.json");
+  assert(!index->find("gk.nope") && !index->find("") && !index->find("zz.last"));
+
+  const auto json = index->find("gk", "json");
+  assert(json && json->namespaceName == "gk" && json->name == "json");
+  assert(json->description == "JSON for C++" && json->type == "header-only");
+  assert(json->repository == "https://github.com/gk/json");
+  assert(json->latest == "1.10.0");
+  assert(split_index_list(json->keywords) == (std::vector<std::string_view>{"json", "parser"}));
+
+  const auto versions = index->versions(*json);
+  assert(versions.size() == 3);
+  assert(versions[0].version == "0.9.0" && versions[1].version == "1.2.0" && versions[2].version == "1.10.0");
+  assert(versions[2].tag == "v1.10.0" && versions[2].commit == "c110");
+  assert(versions[2].declaresDeps && !versions[1].declaresDeps);
+  assert(split_index_list(versions[2].deps) == (std::vector<std::string_view>{"gk/core@^1.0.0", "gk/fmt@^2.0.0"}));
+
+  const auto note = index->find("ada.notebook");
+  assert(note && note->displayName == "Notebook" && index->versions(*note).empty());
+  const auto ext = index->extension(*note, "note");
+  assert(ext && ext->api == "1");
+  assert(split_index_list(ext->capabilities) == (std::vector<std::string_view>{"kernel", "render"}));
+  assert(ext->cellTypes == "python");
+  assert(!index->extension(*note, "code"));
+
+  // Up to date: served from the file as is.
+  assert(open_registry_index(repo)->revision() == index->revision());
+
+  // An entry changes: the revision moves and the next open recompiles.
+  write_entry(repo, "gk", "core", R"("versions":{"1.0.0":{"tag":"v1.0.0","commit":"c1"},"1.1.0":{"tag":"v1.1.0","commit":"c11"}})");
+  fs::last_write_time(repo / "index" / "gk.core.json", fs::file_time_type::clock::now() + std::chrono::seconds(5));
+  assert(registry_index_revision(repo) != index->revision());
+  auto reopened = open_registry_index(repo);
+  assert(reopened && reopened->revision() == registry_index_revision(repo));
+  assert(reopened->versions(*reopened->find("gk.core")).size() == 2);
+  assert(CompiledRegistryIndex::open(compiled_index_path(repo))->revision() == reopened->revision());
+
+  // The old mapping stays valid after the file was replaced.
+  assert(index->versions(*index->find("gk.core")).size() == 1);
+
+  // A git checkout is identified by its HEAD commit.
+  write(repo / ".git" / "HEAD", "ref: refs/heads/main\n");
+  write(repo / ".git" / "packed-refs", "# pack-refs\n0123456789abcdef0123456789abcdef01234567 refs/heads/main\n");
+  assert(registry_index_revision(repo) == "git:0123456789abcdef0123456789abcdef01234567");
+  write(repo / ".git" / "refs" / "heads" / "main", "89abcdef0123456789abcdef0123456789abcdef\n");
+  assert(registry_index_revision(repo) == "git:89abcdef0123456789abcdef0123456789abcdef");
+
+  // Corrupt or foreign files are rejected and rebuilt.
+  write(compiled_index_path(repo), "VIXRIDX\nshort");
+  assert(!CompiledRegistryIndex::open(compiled_index_path(repo)));
+  assert(!CompiledRegistryIndex::from_bytes(std::string(200, 'x')));
+  auto rebuilt = open_registry_index(repo);
+  assert(rebuilt && rebuilt->size() == 3 && CompiledRegistryIndex::open(compiled_index_path(repo)));
+
+  fs::remove_all(root);
+  return 0;
+}
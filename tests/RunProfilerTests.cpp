@@ -0,0 +1,123 @@
+#include <vix/cli/commands/run/detail/RunProfiler.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace detail = vix::commands::RunCommand::detail;
+
+namespace
+{
+  bool contains(const std::string &text, const std::string &needle)
+  {
+    return text.find(needle) != std::string::npos;
+  }
+
+  std::size_t count_of(const std::string &text, const std::string &needle)
+  {
+    std::size_t n = 0;
+    for (std::size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1))
+      ++n;
+    return n;
+  }
+}
+
+// Kept out of line so the symbol table has an entry to find.
+__attribute__((noinline)) int profiled_function(int x)
+{
+  return x * 3 + 1;
+}
+
+int main()
+{
+  // Collapsed stacks, one line per stack.
+  {
+    const detail::FoldedStacks stacks{
+        {"main;parse;lex", 7},
+        {"main;parse", 2},
+        {"main;emit", 1}};
+
+    const std::string text = detail::render_folded_stacks(stacks);
+    assert(text == "main;emit 1\nmain;parse 2\nmain;parse;lex 7\n");
+  }
+
+  // Flamegraph: one frame per tree node plus the root, names escaped.
+  {
+    const detail::FoldedStacks stacks{
+        {"main;parse;lex", 7},
+        {"main;parse", 2},
+        {"main;std::vector<int>::push_back", 1}};
+
+    const std::string svg = detail::render_flamegraph_svg(stacks, "app & co");
+    assert(contains(svg, "<svg"));
+    assert(contains(svg, "</svg>"));
+    assert(count_of(svg, "<rect") == 1 + 5);
+    assert(contains(svg, "<title>all (10 samples, 100.00%)</title>"));
+    assert(contains(svg, "<title>parse (9 samples, 90.00%)</title>"));
+    assert(contains(svg, "std::vector&lt;int&gt;::push_back"));
+    assert(contains(svg, "app &amp; co"));
+    assert(!contains(svg, "<script"));
+
+    const std::string empty = detail::render_flamegraph_svg({}, "nothing");
+    assert(contains(empty, "</svg>"));
+    assert(count_of(empty, "<rect") == 1);
+  }
+
+  // /proc/<pid>/maps: executable, file-backed mappings only.
+  {
+    const std::string text =
+        "55d0c7a00000-55d0c7a02000 r--p 00000000 08:02 1311 /usr/bin/app\n"
+        "55d0c7a02000-55d0c7a21000 r-xp 00002000 08:02 1311 /usr/bin/app\n"
+        "7f1c2a000000-7f1c2a180000 r-xp 00028000 08:02 2222 /usr/lib/libc.so.6\n"
+        "7ffd1e3f0000-7ffd1e3f2000 r-xp 00000000 00:00 0 [vdso]\n"
+        "7f1c2b000000-7f1c2b001000 rw-p 00000000 00:00 0\n"
+        "garbage\n";
+
+    const auto maps = detail::parse_proc_maps(text);
+    assert(maps.size() == 2);
+    assert(maps[0].start == 0x55d0c7a02000ull);
+    assert(maps[0].end == 0x55d0c7a21000ull);
+    assert(maps[0].offset == 0x2000);
+    assert(maps[0].path == "/usr/bin/app");
+    assert(maps[1].path == "/usr/lib/libc.so.6");
+  }
+
+#ifdef __linux__
+  // Symbolization of this test binary, through its own mappings.
+  {
+    std::ifstream in("/proc/self/maps");
+    std::stringstream text;
+    text << in.rdbuf();
+
+    const auto address = reinterpret_cast<std::uintptr_t>(&profiled_function);
+
+    std::string path;
+    std::uint64_t offset = 0;
+    for (const detail::ProcMapping &m : detail::parse_proc_maps(text.str()))
+    {
+      if (address >= m.start && address < m.end)
+      {
+        path = m.path;
+        offset = address - m.start + m.offset;
+      }
+    }
+    assert(!path.empty());
+
+    detail::ElfSymbolTable table;
+    assert(table.load(path));
+    assert(table.size() > 0);
+
+    const auto name = table.lookup(offset + 1);
+    assert(name && contains(*name, "profiled_function"));
+
+    assert(!detail::ElfSymbolTable{}.load("/nonexistent/binary"));
+  }
+#endif
+
+  assert(detail::profiles_dir("/p") == std::filesystem::path("/p/.vix/profiles"));
+  assert(profiled_function(1) == 4);
+
+  return 0;
+}
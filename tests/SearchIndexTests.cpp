@@ -0,0 +1,107 @@
+#include <vix/cli/registry/SearchIndex.hpp>
+
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+using namespace vix::cli::registry;
+
+namespace
+{
+  void write(const fs::path &p, const std::string &text)
+  {
+    fs::create_directories(p.parent_path());
+    std::ofstream(p, std::ios::binary | std::ios::trunc) << text;
+  }
+
+  void write_entry(const fs::path &repo, const std::string &ns, const std::string &name, const std::string &body)
+  {
+    write(repo / "index" / (ns + "." + name + ".json"),
+          R"({"namespace":")" + ns + R"(","name":")" + name + R"(",)" + body + R"(,"versions":{}})");
+  }
+
+  std::string top(const CompiledRegistryIndex &index, const RegistrySearchIndex &search, const std::string &query)
+  {
+    const auto hits = search.search(query);
+    if (hits.empty())
+      return {};
+    const auto p = index.package(hits.front().package);
+    return std::string(p.namespaceName) + "/" + std::string(p.name);
+  }
+
+  bool finds(const CompiledRegistryIndex &index, const RegistrySearchIndex &search, const std::string &query, const std::string &id)
+  {
+    for (const auto &hit : search.search(query))
+    {
+      const auto p = index.package(hit.package);
+      if (std::string(p.namespaceName) + "/" + std::string(p.name) == id)
+        return true;
+    }
+    return false;
+  }
+}
+
+int main()
+{
+  assert((search_tokens("Fast JSON-parser, v2!") == std::vector<std::string>{"fast", "json", "parser", "v2"}));
+  assert(search_tokens("  --  ").empty());
+
+  const fs::path root = fs::temp_directory_path() / ("vix-search-index-" + std::to_string(::getpid()));
+  fs::remove_all(root);
+  const fs::path repo = root / "registry" / "index";
+
+  write_entry(repo, "gk", "json", R"("description":"JSON for modern C++","keywords":["json","serialization"])");
+  write_entry(repo, "gk", "yaml", R"("description":"YAML reader that can also emit json","keywords":["yaml"])");
+  write_entry(repo, "ada", "jsonrpc", R"("description":"Remote procedure calls","keywords":["rpc"])");
+  write_entry(repo, "ada", "http", R"("displayName":"HTTP client","description":"Requests over http and https","keywords":["network","client"])");
+  write_entry(repo, "ada", "notebook", R"("description":"Notebook kernel","extensions":{"note":{"api":"1","capabilities":["kernel"],"cellTypes":[{"id":"python"}]}})");
+
+  const auto index = open_registry_index(repo);
+  assert(index && index->size() == 5);
+  const auto search = open_search_index(repo, *index);
+  assert(search && search->documents() == 5 && search->revision() == index->revision());
+  assert(fs::exists(search_index_path(repo)));
+
+  // Name matches outrank keyword and description matches.
+  assert(top(*index, *search, "json") == "gk/json");
+  assert(finds(*index, *search, "json", "gk/yaml"));
+  const auto jsonHits = search->search("json");
+  assert(jsonHits.size() == 3 && index->package(jsonHits.back().package).name == "yaml");
+
+  // An exact id comes first; ranking is case-insensitive.
+  assert(top(*index, *search, "ada/http") == "ada/http");
+  assert(top(*index, *search, "HTTP Client") == "ada/http");
+
+  // Substrings and prefixes through trigrams and the sorted vocabulary.
+  assert(finds(*index, *search, "rpc", "ada/jsonrpc"));
+  assert(finds(*index, *search, "note", "ada/notebook"));
+  assert(finds(*index, *search, "ht", "ada/http"));
+
+  // Typos of unknown tokens.
+  assert(top(*index, *search, "jsno") == "gk/json");
+  assert(top(*index, *search, "notebok") == "ada/notebook");
+  assert(top(*index, *search, "serialisation") == "gk/json");
+  assert(search->search("zzzz").empty());
+
+  // Extension metadata is searchable.
+  assert(top(*index, *search, "python kernel") == "ada/notebook");
+
+  // Reopened from disk while fresh; rebuilt once the compiled index moves.
+  assert(RegistrySearchIndex::open(search_index_path(repo))->terms() == search->terms());
+  write_entry(repo, "gk", "toml", R"("description":"TOML parser")");
+  const auto moved = open_registry_index(repo);
+  assert(moved && moved->size() == 6 && moved->revision() != index->revision());
+  const auto rebuilt = open_search_index(repo, *moved);
+  assert(rebuilt && rebuilt->documents() == 6 && top(*moved, *rebuilt, "toml") == "gk/toml");
+
+  write(search_index_path(repo), "VIXSIDX\nshort");
+  assert(!RegistrySearchIndex::open(search_index_path(repo)));
+  assert(!RegistrySearchIndex::from_bytes(std::string(200, 'x')));
+  assert(open_search_index(repo, *moved)->documents() == 6);
+
+  fs::remove_all(root);
+  return 0;
+}
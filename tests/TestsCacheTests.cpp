@@ -0,0 +1,137 @@
+#include <vix/cli/commands/tests/TestsCache.hpp>
+
+#include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace detail = vix::commands::TestsCommand::detail;
+namespace fs = std::filesystem;
+
+namespace
+{
+  void write_file(const fs::path &path, const std::string &text)
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << text;
+  }
+
+  detail::TestJobResult result(bool passed, double seconds = 0.5)
+  {
+    detail::TestJobResult r;
+    r.name = "unit";
+    r.ran = true;
+    r.passed = passed;
+    r.seconds = seconds;
+    return r;
+  }
+}
+
+int main()
+{
+  const fs::path dir = fs::temp_directory_path() / "vix-tests-cache-tests";
+  fs::remove_all(dir);
+  fs::create_directories(dir / "data");
+
+  const fs::path binary = dir / "unit_tests";
+  const fs::path library = dir / "libcore.so";
+  write_file(binary, "binary v1");
+  write_file(library, "library v1");
+  write_file(dir / "data" / "input.txt", "data v1");
+
+  detail::TestJob job;
+  job.name = "unit";
+  job.command = {binary.string(), "--fast"};
+  job.requiredFiles = {dir / "data"};
+
+  // Shared libraries reached through the link edges.
+  {
+    std::vector<detail::ImpactEdge> edges(2);
+    edges[0].outputs = {binary.generic_string()};
+    edges[0].inputs = {(dir / "main.o").generic_string(), library.generic_string()};
+    edges[1].outputs = {library.generic_string()};
+    edges[1].inputs = {(dir / "core.o").generic_string()};
+
+    const detail::SharedLibraryIndex index(edges);
+    assert(index.libraries_of(binary.generic_string()) == std::vector<fs::path>{library.generic_string()});
+    assert(index.libraries_of("/elsewhere").empty());
+  }
+
+  const std::vector<fs::path> libraries = {library};
+  const std::vector<std::string> allowlist = {"VIX_CACHE_TEST_VAR"};
+  ::unsetenv("VIX_CACHE_TEST_VAR");
+
+  detail::TestResultCache cache;
+  const std::string key = *cache.key_for(job, libraries, allowlist);
+
+  // Passing results are reused under the same key only.
+  assert(!cache.cached_pass("unit", key));
+  cache.record("unit", key, result(true, 0.25));
+  assert(*cache.cached_pass("unit", key) == 0.25);
+  assert(*cache.key_for(job, libraries, allowlist) == key);
+
+  // Every declared input moves the key.
+  {
+    detail::TestJob changed = job;
+    changed.command.push_back("--other");
+    assert(*cache.key_for(changed, libraries, allowlist) != key);
+
+    changed = job;
+    changed.environment = {"MODE=slow"};
+    assert(*cache.key_for(changed, libraries, allowlist) != key);
+
+    ::setenv("VIX_CACHE_TEST_VAR", "1", 1);
+    assert(*cache.key_for(job, libraries, allowlist) != key);
+    ::unsetenv("VIX_CACHE_TEST_VAR");
+
+    write_file(library, "library v2 (relinked)");
+    assert(*cache.key_for(job, libraries, allowlist) != key);
+    write_file(library, "library v1");
+
+    write_file(dir / "data" / "input.txt", "data v2");
+    assert(*cache.key_for(job, libraries, allowlist) != key);
+    write_file(dir / "data" / "input.txt", "data v1");
+
+    write_file(binary, "binary v2");
+    assert(*cache.key_for(job, libraries, allowlist) != key);
+    write_file(binary, "binary v1");
+
+    assert(*cache.key_for(job, libraries, allowlist) == key);
+  }
+
+  // A missing test program is not cacheable.
+  {
+    detail::TestJob missing = job;
+    missing.command = {(dir / "not_built").string()};
+    assert(!cache.key_for(missing, {}, allowlist));
+  }
+
+  // Failures are never reused, and a pass after a failure with the same
+  // key marks the test flaky.
+  {
+    cache.record("unit", key, result(false));
+    assert(!cache.cached_pass("unit", key));
+
+    cache.record("unit", key, result(true));
+    assert(!cache.cached_pass("unit", key));
+
+    cache.record("unit", "other-key", result(true));
+    assert(cache.cached_pass("unit", "other-key"));
+  }
+
+  // Round trip.
+  {
+    const fs::path path = detail::TestResultCache::default_path(dir / "build");
+    assert(cache.save(path));
+
+    detail::TestResultCache loaded;
+    assert(loaded.load(path));
+    assert(loaded.cached_pass("unit", "other-key"));
+    assert(*loaded.key_for(job, libraries, allowlist) == key);
+  }
+
+  fs::remove_all(dir);
+  return 0;
+}
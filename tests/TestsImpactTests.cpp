@@ -0,0 +1,127 @@
+#include <vix/cli/commands/tests/TestsImpact.hpp>
+
+#include <cassert>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace detail = vix::commands::TestsCommand::detail;
+
+namespace
+{
+  const char *const BUILD_NINJA = R"(# CMAKE generated file: DO NOT EDIT!
+rule CXX_COMPILER__core_Debug
+  command = c++ -c $in -o $out
+
+build CMakeFiles/core.dir/src/tree.cpp.o: CXX_COMPILER__core_Debug /p/src/tree.cpp || cmake_object_order_depends_target_core
+  FLAGS = -g
+
+build libcore.a: CXX_STATIC_LIBRARY_LINKER__core_Debug CMakeFiles/core.dir/src/tree.cpp.o
+
+build CMakeFiles/tree_tests.dir/tests/tree_tests.cpp.o: CXX_COMPILER__tree_tests_Debug /p/tests/tree_tests.cpp
+
+build tests/tree_tests: CXX_EXECUTABLE_LINKER__tree_tests_Debug CMakeFiles/tree_tests.dir/tests/tree_tests.cpp.o | libcore.a || libcore.a
+
+build CMakeFiles/other.dir/tests/other$ tests.cpp.o: CXX_COMPILER__other_Debug /p/tests/other$ tests.cpp
+
+build tests/other_tests: CXX_EXECUTABLE_LINKER__other_tests_Debug $
+    CMakeFiles/other.dir/tests/other$ tests.cpp.o
+)";
+
+  const char *const NINJA_DEPS = R"(CMakeFiles/core.dir/src/tree.cpp.o: #deps 2, deps mtime 1700000000 (VALID)
+    /p/src/tree.cpp
+    /p/include/tree.hpp
+
+CMakeFiles/tree_tests.dir/tests/tree_tests.cpp.o: #deps 2, deps mtime 1700000000 (VALID)
+    /p/tests/tree_tests.cpp
+    /p/include/tree.hpp
+
+CMakeFiles/other.dir/tests/other$ tests.cpp.o: #deps 0, deps mtime 0 (STALE)
+
+)";
+
+  const char *const CTEST_FILE = R"(# CMake generated Testfile for
+add_test([=[tree.basic]=] "/b/tests/tree_tests" "--case" "basic")
+set_tests_properties([=[tree.basic]=] PROPERTIES  _BACKTRACE_TRIPLES "/p/CMakeLists.txt;12;add_test")
+add_test(other "/b/tests/other_tests")
+add_test(script.check "/bin/sh" "/p/tests/check.sh")
+subdirs("sub")
+include("/b/tests/gtest[1]_include.cmake")
+)";
+
+  std::vector<detail::ImpactEdge> all_edges()
+  {
+    std::vector<detail::ImpactEdge> edges = detail::parse_ninja_build_edges(BUILD_NINJA, "/b");
+    std::vector<detail::ImpactEdge> deps = detail::parse_ninja_deps_output(NINJA_DEPS, "/b");
+    edges.insert(edges.end(), deps.begin(), deps.end());
+    return edges;
+  }
+
+  std::vector<std::string> names_of(const detail::AffectedTestsResult &result)
+  {
+    std::vector<std::string> names;
+    for (const auto &test : result.tests)
+      names.push_back(test.name);
+    return names;
+  }
+}
+
+int main()
+{
+  const std::vector<detail::ImpactEdge> build = detail::parse_ninja_build_edges(BUILD_NINJA, "/b");
+  assert(build.size() == 6);
+
+  // Order-only inputs are dropped, implicit ones kept.
+  assert(build[0].inputs == std::vector<std::string>{"/p/src/tree.cpp"});
+  assert(build[3].outputs == std::vector<std::string>{"/b/tests/tree_tests"});
+  assert((build[3].inputs == std::vector<std::string>{
+                                 "/b/CMakeFiles/tree_tests.dir/tests/tree_tests.cpp.o",
+                                 "/b/libcore.a"}));
+
+  // Escaped spaces and "$" line continuations.
+  assert(build[4].outputs.front() == "/b/CMakeFiles/other.dir/tests/other tests.cpp.o");
+  assert(build[5].inputs.size() == 1);
+
+  const std::vector<detail::ImpactEdge> deps = detail::parse_ninja_deps_output(NINJA_DEPS, "/b");
+  assert(deps.size() == 2);
+  assert(deps[1].inputs.back() == "/p/include/tree.hpp");
+
+  const detail::CTestFile ctest = detail::parse_ctest_testfile(CTEST_FILE, "/b");
+  assert(ctest.tests.size() == 3);
+  assert(ctest.tests[0].name == "tree.basic");
+  assert((ctest.tests[0].command == std::vector<std::string>{"/b/tests/tree_tests", "--case", "basic"}));
+  assert(ctest.subdirs.size() == 1 && ctest.subdirs[0] == "/b/sub");
+  assert(ctest.includes.size() == 1 && ctest.includes[0] == "/b/tests/gtest[1]_include.cmake");
+
+  const std::vector<detail::ImpactEdge> edges = all_edges();
+
+  // A header reaches the tests through objects, the library and the link.
+  detail::AffectedTestsResult header =
+      detail::compute_affected_tests({"/p/include/tree.hpp"}, edges, ctest.tests);
+  assert(!header.runAll);
+  assert(names_of(header) == std::vector<std::string>{"tree.basic"});
+  assert(header.tests[0].chain.front() == "/p/include/tree.hpp");
+  assert(header.tests[0].chain.back() == "/b/tests/tree_tests");
+
+  detail::AffectedTestsResult other =
+      detail::compute_affected_tests({"/p/tests/other tests.cpp"}, edges, ctest.tests);
+  assert(names_of(other) == std::vector<std::string>{"other"});
+
+  // Test scripts are matched on the test command itself.
+  detail::AffectedTestsResult script =
+      detail::compute_affected_tests({"/p/tests/check.sh", "/p/README.md"}, edges, ctest.tests);
+  assert(names_of(script) == std::vector<std::string>{"script.check"});
+  assert(script.unusedFiles == std::vector<std::string>{"/p/README.md"});
+
+  // Build files and unknown sources cannot be followed: run everything.
+  assert(detail::compute_affected_tests({"/p/CMakeLists.txt"}, edges, ctest.tests).runAll);
+  assert(detail::compute_affected_tests({"/p/src/new.cpp"}, edges, ctest.tests).runAll);
+  assert(!detail::compute_affected_tests({"/p/include/new.hpp"}, edges, ctest.tests).runAll);
+
+  const std::string regex = detail::ctest_exact_names_regex({"tree.basic", "a+b"});
+  assert(regex == "^(tree\\.basic|a\\+b)$");
+  assert(std::regex_search("tree.basic", std::regex(regex)));
+  assert(!std::regex_search("treeXbasic", std::regex(regex)));
+
+  return 0;
+}
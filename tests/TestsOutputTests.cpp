@@ -0,0 +1,96 @@
+#include <vix/cli/commands/tests/TestsOutput.hpp>
+
+#include <cassert>
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+namespace detail = vix::commands::TestsCommand::detail;
+namespace fs = std::filesystem;
+
+int main()
+{
+  const fs::path dir = fs::temp_directory_path() / "vix-tests-output-tests";
+  fs::remove_all(dir);
+
+  const detail::TestOutputLimits limits{16, 32};
+
+  // Short output is kept whole.
+  {
+    detail::OutputExcerpt excerpt(limits);
+    excerpt.append("one\n");
+    excerpt.append("two\n");
+    assert(excerpt.text() == "one\ntwo\n");
+    assert(excerpt.omitted_bytes() == 0);
+  }
+
+  // Long output keeps its head and a tail that starts on a line.
+  {
+    detail::OutputExcerpt excerpt(limits);
+    for (int i = 0; i < 1000; ++i)
+      excerpt.append("line " + std::to_string(i) + "\n");
+
+    const std::string text = excerpt.text();
+    assert(text.rfind("line 0\nline 1\n", 0) == 0);
+    assert(text.find("bytes omitted ...\n") != std::string::npos);
+    assert(text.find("\nline 999\n") != std::string::npos);
+    assert(text.size() < 100);
+    assert(excerpt.bytes() > 8000);
+  }
+
+  // Spool files get file-safe names.
+  {
+    assert(detail::test_output_file(dir, "net/http tests").filename() == "net_http_tests.log");
+    assert(detail::test_output_file(dir, "..").filename() == "_...log");
+    assert(detail::test_output_dir("/b") == fs::path("/b/.vix/test-output"));
+  }
+
+  // Status lines survive; what a test printed is cut down.
+  {
+    detail::CTestOutputDigest digest(limits);
+    assert(digest.open(dir / "ctest.log"));
+
+    digest.append_line("Test project /b\n");
+    digest.append_line("    Start 1: chatty\n");
+    digest.append_line("1/2 Test #1: chatty ...........***Failed    0.10 sec\n");
+    for (int i = 0; i < 1000; ++i)
+      digest.append_line("noise " + std::to_string(i) + "\n");
+
+    // A line longer than the reader's buffer arrives in pieces.
+    digest.append_line("Test #2 is mentioned by a long ");
+    digest.append_line("line of test output\n");
+
+    digest.append_line("2/2 Test #2: quiet ............   Passed    0.01 sec\n");
+    digest.append_line("\n");
+    digest.append_line("50% tests passed, 1 tests failed out of 2\n");
+    digest.append_line("The following tests FAILED:\n");
+    digest.append_line("\t  1 - chatty (Failed)\n");
+    digest.close();
+
+    const std::string text = digest.text();
+    assert(digest.truncated());
+    assert(text.find("Test project /b\n") != std::string::npos);
+    assert(text.find("Test #1: chatty") != std::string::npos);
+    assert(text.find("noise 0\n") != std::string::npos);
+    assert(text.find("noise 500\n") == std::string::npos);
+    assert(text.find("noise 999\n") != std::string::npos);
+    assert(text.find("Test #2: quiet") != std::string::npos);
+    assert(text.find("1 tests failed out of 2") != std::string::npos);
+    assert(text.find("1 - chatty (Failed)") != std::string::npos);
+    assert(text.size() < 1000);
+
+    std::ostringstream full;
+    assert(detail::stream_output_file(digest.file(), full, "> "));
+    assert(full.str().find("> noise 500\n") != std::string::npos);
+    assert(full.str().find("> Test #2 is mentioned by a long line of test output\n") != std::string::npos);
+  }
+
+  assert(detail::is_ctest_status_line("Total Test time (real) =   0.12 sec"));
+  assert(detail::is_ctest_status_line("Start 3: parser"));
+  assert(!detail::is_ctest_status_line("assertion failed: x == 1"));
+  std::ostringstream none;
+  assert(!detail::stream_output_file(dir / "missing.log", none));
+
+  fs::remove_all(dir);
+  return 0;
+}
@@ -0,0 +1,382 @@
+#include <vix/cli/commands/tests/TestsScheduler.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace detail = vix::commands::TestsCommand::detail;
+namespace fs = std::filesystem;
+
+namespace
+{
+  detail::TestJob shell_job(const std::string &name, const std::string &script)
+  {
+    detail::TestJob job;
+    job.name = name;
+    job.command = {"/bin/sh", "-c", script};
+    job.timeout = std::chrono::milliseconds(5000);
+    return job;
+  }
+
+  const detail::TestJobResult &result_of(
+      const std::vector<detail::TestJobResult> &results,
+      const std::string &name)
+  {
+    const auto it = std::find_if(
+        results.begin(),
+        results.end(),
+        [&name](const detail::TestJobResult &r)
+        {
+          return r.name == name;
+        });
+    assert(it != results.end());
+    return *it;
+  }
+}
+
+int main()
+{
+  const fs::path dir = fs::temp_directory_path() / ("vix-tests-scheduler-" + std::to_string(::getpid()));
+  fs::create_directories(dir);
+
+  // Duration history round trip and smoothing.
+  {
+    detail::TestDurationHistory history;
+    history.record("slow", 4.0);
+    history.record("slow", 2.0);
+    history.record("fast", 0.1);
+
+    const fs::path path = detail::TestDurationHistory::default_path(dir);
+    assert(history.save(path));
+
+    detail::TestDurationHistory loaded;
+    assert(loaded.load(path));
+    assert(*loaded.expected_seconds("slow") == 3.0);
+    assert(loaded.expected_seconds("fast").has_value());
+    assert(!loaded.expected_seconds("missing"));
+  }
+
+  // LPT order; unknown durations count as the mean of known ones.
+  {
+    std::vector<detail::TestJob> jobs(4);
+    jobs[0].name = "a";
+    jobs[0].expectedSeconds = 1.0;
+    jobs[1].name = "b";
+    jobs[2].name = "c";
+    jobs[2].expectedSeconds = 5.0;
+    jobs[3].name = "d";
+    jobs[3].expectedSeconds = 2.0;
+
+    detail::order_longest_first(jobs);
+    assert(jobs[0].name == "c");
+    assert(jobs[1].name == "b"); // mean of 1, 5, 2
+    assert(jobs[2].name == "d");
+    assert(jobs[3].name == "a");
+
+    assert(detail::ideal_makespan_seconds({4.0, 1.0, 1.0}, 2) == 4.0);
+    assert(detail::ideal_makespan_seconds({2.0, 2.0, 2.0, 2.0}, 2) == 4.0);
+  }
+
+  // set_tests_properties() reaches the job.
+  {
+    const detail::CTestFile file = detail::parse_ctest_testfile(
+        "add_test(net \"/b/net_tests\")\n"
+        "set_tests_properties(net PROPERTIES  RESOURCE_LOCK \"port;db\" TIMEOUT \"2.5\" "
+        "WORKING_DIRECTORY \"/b/work\" ENVIRONMENT \"A=1;B=2\" RUN_SERIAL \"TRUE\")\n",
+        "/b");
+    assert(file.tests.size() == 1);
+
+    const detail::TestJob job = detail::make_test_job(file.tests[0], std::chrono::milliseconds(60000));
+    assert(job.timeout == std::chrono::milliseconds(2500));
+    assert((job.resourceLocks == std::vector<std::string>{"port", "db"}));
+    assert((job.environment == std::vector<std::string>{"A=1", "B=2"}));
+    assert(job.workingDirectory == "/b/work");
+    assert(job.runSerial);
+  }
+
+  // Outcome and ordering properties reach the job; unknown ones are kept
+  // aside so the run falls back to CTest.
+  {
+    const detail::CTestFile file = detail::parse_ctest_testfile(
+        "add_test(db \"/b/db_tests\")\n"
+        "set_tests_properties(db PROPERTIES  WILL_FAIL \"TRUE\" PASS_REGULAR_EXPRESSION \"ok;done\" "
+        "FAIL_REGULAR_EXPRESSION \"ERROR\" SKIP_RETURN_CODE \"77\" SKIP_REGULAR_EXPRESSION \"\\\\[  SKIPPED \\\\]\" "
+        "DEPENDS \"init\" FIXTURES_SETUP \"a\" FIXTURES_CLEANUP \"b\" FIXTURES_REQUIRED \"c;d\" "
+        "_BACKTRACE_TRIPLES \"CMakeLists.txt;3;add_test\")\n"
+        "add_test(slow \"/b/slow_tests\")\n"
+        "set_tests_properties(slow PROPERTIES  TIMEOUT_AFTER_MATCH \"1;started\")\n",
+        "/b");
+    assert(file.tests.size() == 2);
+
+    const detail::TestJob job = detail::make_test_job(file.tests[0], std::chrono::milliseconds(60000));
+    assert(job.willFail);
+    assert((job.passRegex == std::vector<std::string>{"ok", "done"}));
+    assert((job.failRegex == std::vector<std::string>{"ERROR"}));
+    assert(job.skipReturnCode == 77);
+    assert((job.skipRegex == std::vector<std::string>{"\\[  SKIPPED \\]"}));
+    assert((job.depends == std::vector<std::string>{"init"}));
+    assert((job.fixturesSetup == std::vector<std::string>{"a"}));
+    assert((job.fixturesCleanup == std::vector<std::string>{"b"}));
+    assert((job.fixturesRequired == std::vector<std::string>{"c", "d"}));
+    assert(job.unsupportedProperties.empty());
+
+    assert((file.tests[1].unsupportedProperties == std::vector<std::string>{"TIMEOUT_AFTER_MATCH"}));
+  }
+
+  // Setup and cleanup tests of required fixtures join the selection.
+  {
+    std::vector<detail::TestJob> available(5);
+    available[0].name = "db_setup";
+    available[0].fixturesSetup = {"db"};
+    available[0].fixturesRequired = {"net"};
+    available[1].name = "net_setup";
+    available[1].fixturesSetup = {"net"};
+    available[2].name = "query";
+    available[2].fixturesRequired = {"db"};
+    available[3].name = "db_cleanup";
+    available[3].fixturesCleanup = {"db"};
+    available[4].name = "other";
+
+    std::vector<detail::TestJob> jobs = {available[2]};
+    detail::add_fixture_jobs(jobs, available);
+
+    std::vector<std::string> names;
+    for (const detail::TestJob &job : jobs)
+      names.push_back(job.name);
+    std::sort(names.begin(), names.end());
+    assert((names == std::vector<std::string>{"db_cleanup", "db_setup", "net_setup", "query"}));
+  }
+
+  assert(detail::native_test_scheduler_supported());
+
+  // WILL_FAIL, pass, fail and skip rules decide the outcome, not only the
+  // exit code.
+  {
+    std::vector<detail::TestJob> jobs;
+
+    detail::TestJob willFail = shell_job("will fail", "exit 1");
+    willFail.willFail = true;
+    jobs.push_back(willFail);
+
+    detail::TestJob willFailPassing = shell_job("will fail but passes", "exit 0");
+    willFailPassing.willFail = true;
+    jobs.push_back(willFailPassing);
+
+    detail::TestJob passRegex = shell_job("pass regex", "echo all ok; exit 4");
+    passRegex.passRegex = {"nothing", "all o+k"};
+    jobs.push_back(passRegex);
+
+    detail::TestJob passRegexMissing = shell_job("pass regex missing", "echo fine");
+    passRegexMissing.passRegex = {"all ok"};
+    jobs.push_back(passRegexMissing);
+
+    detail::TestJob failRegex = shell_job("fail regex", "echo 'ERROR: leak'");
+    failRegex.failRegex = {"ERROR"};
+    jobs.push_back(failRegex);
+
+    detail::TestJob skipCode = shell_job("skip code", "exit 77");
+    skipCode.skipReturnCode = 77;
+    jobs.push_back(skipCode);
+
+    // gtest_discover_tests() registers this one for GTEST_SKIP().
+    detail::TestJob skipRegex = shell_job("skip regex", "echo '[  SKIPPED ] Suite.Case'; exit 0");
+    skipRegex.skipRegex = {"\\[  SKIPPED \\]"};
+    jobs.push_back(skipRegex);
+
+    detail::TestSchedulerOptions options;
+    options.jobs = 4;
+    options.outputDir = dir / "rules";
+
+    const std::vector<detail::TestJobResult> results = detail::run_test_jobs(jobs, options);
+    assert(result_of(results, "will fail").passed);
+    assert(!result_of(results, "will fail but passes").passed);
+    assert(result_of(results, "pass regex").passed);
+    assert(!result_of(results, "pass regex missing").passed);
+    assert(result_of(results, "pass regex missing").output.find("Required regular expression") != std::string::npos);
+    assert(!result_of(results, "fail regex").passed);
+    assert(result_of(results, "skip code").passed && result_of(results, "skip code").skipped);
+    assert(result_of(results, "skip regex").passed && result_of(results, "skip regex").skipped);
+    assert(!result_of(results, "pass regex").skipped);
+  }
+
+  // DEPENDS orders tests even with free workers.
+  {
+    const fs::path marker = dir / "depends-marker";
+
+    std::vector<detail::TestJob> jobs;
+    detail::TestJob second = shell_job("second", "test -e '" + marker.string() + "'");
+    second.depends = {"first", "not selected"};
+    jobs.push_back(second);
+    jobs.push_back(shell_job("first", "sleep 0.2; touch '" + marker.string() + "'"));
+
+    detail::TestSchedulerOptions options;
+    options.jobs = 2;
+
+    for (const detail::TestJobResult &result : detail::run_test_jobs(jobs, options))
+      assert(result.passed);
+  }
+
+  // Fixtures: setup before the tests requiring it, cleanup after them all.
+  {
+    const fs::path fixture = dir / "fixture";
+    const fs::path used = dir / "fixture-used";
+
+    std::vector<detail::TestJob> jobs;
+    detail::TestJob cleanup = shell_job("cleanup", "test -e '" + used.string() + "' && rm -r '" + fixture.string() + "'");
+    cleanup.fixturesCleanup = {"tree"};
+    jobs.push_back(cleanup);
+
+    for (int i = 0; i < 2; ++i)
+    {
+      detail::TestJob user = shell_job(
+          "user" + std::to_string(i),
+          "test -d '" + fixture.string() + "' && sleep 0.1 && touch '" + used.string() + "'");
+      user.fixturesRequired = {"tree"};
+      jobs.push_back(user);
+    }
+
+    detail::TestJob setup = shell_job("setup", "sleep 0.1; mkdir '" + fixture.string() + "'");
+    setup.fixturesSetup = {"tree"};
+    jobs.push_back(setup);
+
+    detail::TestSchedulerOptions options;
+    options.jobs = 4;
+
+    for (const detail::TestJobResult &result : detail::run_test_jobs(jobs, options))
+      assert(result.ran && result.passed);
+    assert(!fs::exists(fixture));
+  }
+
+  // A failed setup fails the tests requiring it without running them;
+  // the cleanup still runs.
+  {
+    const fs::path ran = dir / "fixture-user-ran";
+    const fs::path cleaned = dir / "fixture-cleaned";
+
+    std::vector<detail::TestJob> jobs;
+    detail::TestJob setup = shell_job("broken setup", "exit 1");
+    setup.fixturesSetup = {"db"};
+    jobs.push_back(setup);
+
+    detail::TestJob user = shell_job("needs db", "touch '" + ran.string() + "'");
+    user.fixturesRequired = {"db"};
+    jobs.push_back(user);
+
+    detail::TestJob cleanup = shell_job("db cleanup", "touch '" + cleaned.string() + "'");
+    cleanup.fixturesCleanup = {"db"};
+    jobs.push_back(cleanup);
+
+    detail::TestSchedulerOptions options;
+    options.jobs = 3;
+
+    const std::vector<detail::TestJobResult> results = detail::run_test_jobs(jobs, options);
+    assert(!result_of(results, "broken setup").passed);
+    assert(result_of(results, "needs db").ran && !result_of(results, "needs db").passed);
+    assert(result_of(results, "needs db").output.find("broken setup") != std::string::npos);
+    assert(!fs::exists(ran));
+    assert(result_of(results, "db cleanup").passed && fs::exists(cleaned));
+  }
+
+  // Parallel run: results, environment, working directory and timeouts.
+  {
+    std::vector<detail::TestJob> jobs;
+    jobs.push_back(shell_job("pass", "echo hello"));
+    jobs.push_back(shell_job("fail", "echo broken >&2; exit 3"));
+
+    detail::TestJob env = shell_job("env", "test \"$VIX_SCHED\" = yes && test \"$(pwd)\" = \"$EXPECTED\"");
+    env.environment = {"VIX_SCHED=yes", "EXPECTED=" + fs::canonical(dir).string()};
+    env.workingDirectory = dir;
+    jobs.push_back(env);
+
+    detail::TestJob hang = shell_job("hang", "sleep 30");
+    hang.timeout = std::chrono::milliseconds(200);
+    jobs.push_back(hang);
+
+    int finished = 0;
+    detail::TestSchedulerOptions options;
+    options.jobs = 4;
+    options.onFinish = [&finished](const detail::TestJobResult &)
+    {
+      ++finished;
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<detail::TestJobResult> results = detail::run_test_jobs(jobs, options);
+    assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+
+    assert(finished == 4);
+    assert(result_of(results, "pass").passed);
+    assert(result_of(results, "pass").output == "hello\n");
+    assert(!result_of(results, "fail").passed);
+    assert(result_of(results, "fail").exitCode == 3);
+    assert(result_of(results, "fail").output.find("broken") != std::string::npos);
+    assert(result_of(results, "env").passed);
+    assert(result_of(results, "hang").timedOut);
+    assert(!result_of(results, "hang").passed);
+  }
+
+  // Tests sharing a resource lock never overlap.
+  {
+    const fs::path marker = dir / "lock-marker";
+    const std::string script =
+        "if [ -e '" + marker.string() + "' ]; then exit 9; fi; touch '" + marker.string() +
+        "'; sleep 0.2; rm '" + marker.string() + "'";
+
+    std::vector<detail::TestJob> jobs;
+    for (int i = 0; i < 3; ++i)
+    {
+      detail::TestJob job = shell_job("port" + std::to_string(i), script);
+      job.resourceLocks = {"port"};
+      jobs.push_back(job);
+    }
+
+    detail::TestSchedulerOptions options;
+    options.jobs = 3;
+
+    for (const detail::TestJobResult &result : detail::run_test_jobs(jobs, options))
+      assert(result.passed);
+  }
+
+  // Chatty tests are spooled to disk; only head and tail stay in memory.
+  {
+    std::vector<detail::TestJob> jobs;
+    jobs.push_back(shell_job("chatty tests", "i=0; while [ $i -lt 20000 ]; do echo line $i; i=$((i+1)); done"));
+
+    detail::TestSchedulerOptions options;
+    options.outputDir = dir / "output";
+    options.outputLimits = detail::TestOutputLimits{1024, 4096};
+
+    const detail::TestJobResult result = detail::run_test_jobs(jobs, options).front();
+    assert(result.passed);
+    assert(result.outputFile == detail::test_output_file(options.outputDir, "chatty tests"));
+    assert(fs::file_size(result.outputFile) > 100000);
+    assert(result.output.size() < 8 * 1024);
+    assert(result.output.rfind("line 0\n", 0) == 0);
+    assert(result.output.find("bytes omitted") != std::string::npos);
+    assert(result.output.find("line 19999\n") != std::string::npos);
+  }
+
+  // --fail-fast stops launching after the first failure.
+  {
+    std::vector<detail::TestJob> jobs;
+    jobs.push_back(shell_job("first", "exit 1"));
+    jobs.push_back(shell_job("second", "exit 0"));
+
+    detail::TestSchedulerOptions options;
+    options.jobs = 1;
+    options.failFast = true;
+
+    const std::vector<detail::TestJobResult> results = detail::run_test_jobs(jobs, options);
+    assert(results[0].ran && !results[0].passed);
+    assert(!results[1].ran);
+  }
+
+  fs::remove_all(dir);
+  return 0;
+}
@@ -0,0 +1,146 @@
+#include <vix/cli/commands/tests/TestsDetail.hpp>
+#include <vix/cli/commands/tests/TestsShard.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace detail = vix::commands::TestsCommand::detail;
+
+namespace
+{
+  bool parse_throws(const std::vector<std::string> &args)
+  {
+    try
+    {
+      (void)detail::parse(args);
+    }
+    catch (const std::invalid_argument &)
+    {
+      return true;
+    }
+    return false;
+  }
+
+  std::vector<detail::ShardTest> suite()
+  {
+    return {
+        {"slow", 9.0},
+        {"medium", 4.0},
+        {"medium2", 4.0},
+        {"fast", 1.0},
+        {"fast2", 1.0},
+        {"new_test", -1.0},
+    };
+  }
+}
+
+int main()
+{
+  // Shard specs and command line.
+  {
+    assert(detail::parse_shard_spec("3/8")->index == 3);
+    assert(detail::parse_shard_spec("3/8")->count == 8);
+    assert(!detail::parse_shard_spec("0/8"));
+    assert(!detail::parse_shard_spec("9/8"));
+    assert(!detail::parse_shard_spec("3"));
+    assert(!detail::parse_shard_spec("a/b"));
+
+    const detail::Options opt = detail::parse({"--shard", "2/4", "--report=out.json"});
+    assert(opt.shardIndex == 2 && opt.shardCount == 4);
+    assert(opt.reportPath.filename() == "out.json");
+
+    assert(detail::parse({"--shard=1/3", "--shard-report"}).shardReportCount == 3);
+    assert(detail::parse({"--shard-report=5"}).shardReportCount == 5);
+    assert(parse_throws({"--shard-report"}));
+    assert(parse_throws({"--shard", "4/3"}));
+
+    const detail::MergeOptions merge = detail::parse_merge({"a.json", "b.json", "--junit", "r.xml"});
+    assert(merge.inputs.size() == 2);
+    assert(merge.junitPath.filename() == "r.xml");
+  }
+
+  // Greedy packing: balanced, complete, and independent of input order.
+  {
+    const detail::ShardPlan plan = detail::plan_test_shards(suite(), 2);
+    assert(plan.shards.size() == 2);
+    assert(plan.estimatedTests == 1);
+
+    std::size_t total = 0;
+    for (const auto &shard : plan.shards)
+      total += shard.names.size();
+    assert(total == 6);
+
+    // 9 | 4 4 1 1 + the unknown test at the mean (3.8).
+    assert(plan.shards[0].names.front() == "slow");
+    assert(std::abs(plan.shards[0].expectedSeconds - plan.shards[1].expectedSeconds) < 4.0);
+
+    std::vector<detail::ShardTest> reversed = suite();
+    std::reverse(reversed.begin(), reversed.end());
+    const detail::ShardPlan again = detail::plan_test_shards(reversed, 2);
+    assert(again.shards[0].names == plan.shards[0].names);
+    assert(again.shards[1].names == plan.shards[1].names);
+
+    // Small timing noise keeps the same partition.
+    std::vector<detail::ShardTest> noisy = suite();
+    noisy[0].expectedSeconds = 9.04;
+    noisy[3].expectedSeconds = 1.02;
+    assert(detail::plan_test_shards(noisy, 2).shards[1].names == plan.shards[1].names);
+
+    // More shards than tests leaves some empty.
+    const detail::ShardPlan wide = detail::plan_test_shards({{"a", 1.0}}, 3);
+    assert(wide.shards[0].names.size() == 1 && wide.shards[2].names.empty());
+
+    assert(detail::shard_plan_json(plan).find("\"estimatedTests\": 1") != std::string::npos);
+  }
+
+  // Reports: round trip, merge and JUnit.
+  {
+    detail::TestReport first;
+    first.shardCount = 3;
+    first.shards = {{1, 2.5}};
+    first.cases = {
+        {"a", "passed", 1.0, "", 1},
+        {"b", "failed", 0.5, "expected <1> & got 2", 1},
+    };
+
+    const auto parsed = detail::parse_test_report_json(detail::test_report_json(first));
+    assert(parsed && parsed->cases.size() == 2);
+    assert(parsed->cases[1].output == "expected <1> & got 2");
+    assert(parsed->shards[0].wallSeconds == 2.5);
+
+    detail::TestReport second;
+    second.shardCount = 3;
+    second.shards = {{2, 4.0}};
+    second.cases = {
+        {"c", "timeout", 60.0, "", 2},
+        {"a", "skipped", 0.0, "", 2},
+    };
+
+    const detail::MergedTestReport merged = detail::merge_test_reports({second, *parsed});
+    assert(merged.report.cases.size() == 3);
+    assert(merged.missingShards == std::vector<int>{3});
+    assert(merged.repeatedTests == std::vector<std::string>{"a"});
+    assert(merged.report.cases.front().name == "a"); // shard order
+    assert(merged.report.cases.front().status == "passed");
+    assert(!merged.mixedShardCounts);
+
+    const std::string xml = detail::test_report_junit_xml(merged.report);
+    assert(xml.find("<testsuites name=\"vix tests\" tests=\"3\" failures=\"2\"") != std::string::npos);
+    assert(xml.find("time=\"4.000\">") != std::string::npos);
+    assert(xml.find("<testsuite name=\"shard 1/3\"") != std::string::npos);
+    assert(xml.find("expected &lt;1&gt; &amp; got 2") != std::string::npos);
+    assert(xml.find("<failure message=\"Timed out\">") != std::string::npos);
+
+    detail::TestReport other = first;
+    other.shardCount = 4;
+    assert(detail::merge_test_reports({first, other}).mixedShardCounts);
+
+    assert(!detail::parse_test_report_json("{\"version\":2,\"tests\":[]}"));
+  }
+
+  return 0;
+}
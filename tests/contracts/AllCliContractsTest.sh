@@ -19,6 +19,8 @@ run run/RunCacheContractTest.sh
 run run/RunVixAppContractTest.sh
 run run/RunExecutionPathsContractTest.sh
 run run/RunCompiledDependencyContractTest.sh
+run run/RunHotReloadContractTest.sh
+run run/RunTimingsContractTest.sh
 run dev/DevProjectContractTest.sh
 run dev/DevSingleCppContractTest.sh
 run dev/DevSingleCppSignalContractTest.sh
@@ -0,0 +1,46 @@
+#!/usr/bin/env bash
+set -euo pipefail
+VIX_BIN="${1:-/vixcpp/vix/modules/cli/build-ninja/vix}"
+ROOT="$(mktemp -d)"
+trap 'if [[ -n "${RUN_PID:-}" ]]; then kill -INT "$RUN_PID" 2>/dev/null || true; wait "$RUN_PID" 2>/dev/null || true; fi; rm -rf "$ROOT"' EXIT
+export HOME="$ROOT/home"
+mkdir -p "$HOME"
+fail() { echo "RunHotReloadContractTest: $*" >&2; [[ -f "$ROOT/run.out" ]] && cat "$ROOT/run.out" >&2; exit 1; }
+wait_for() { local pattern="$1"; for _ in $(seq 1 200); do grep -Fq -- "$pattern" "$ROOT/run.out" 2>/dev/null && return 0; sleep 0.1; done; fail "missing: $pattern"; }
+grep -Fq -- '--hot-reload' <<<"$("$VIX_BIN" run --help)" || fail "--hot-reload missing from help"
+cat >"$ROOT/server.cpp" <<'CPP'
+#include <chrono>
+#include <cstdio>
+#include <thread>
+struct vix_reload_context { int version; int generation; int argc; char **argv; void *state; int exit_code; };
+struct State { int steps = 0; };
+extern "C" int vix_reload(vix_reload_context *ctx, int op) {
+  if (op == 0) {
+    if (!ctx->state) ctx->state = new State;
+    std::printf("generation %d says one, kept=%d\n", ctx->generation, static_cast<State *>(ctx->state)->steps > 0);
+    std::fflush(stdout);
+  } else if (op == 1) {
+    ++static_cast<State *>(ctx->state)->steps;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return 0;
+}
+CPP
+"$VIX_BIN" run "$ROOT/server.cpp" --hot-reload >"$ROOT/run.out" 2>&1 &
+RUN_PID=$!
+wait_for 'generation 1 says one, kept=0'
+sleep 1
+sed -i.bak 's/says one/says two/' "$ROOT/server.cpp"
+wait_for 'generation 2 says two, kept=1'
+wait_for 'Reloaded server.cpp in'
+kill -INT "$RUN_PID"; wait "$RUN_PID" || true; RUN_PID=
+cat >"$ROOT/plain.cpp" <<'CPP'
+#include <cstdio>
+int main() { std::puts("plain main"); return 0; }
+CPP
+"$VIX_BIN" run "$ROOT/plain.cpp" --hot-reload --no-san >"$ROOT/run.out" 2>&1 &
+RUN_PID=$!
+wait_for 'does not export vix_reload()'
+wait_for 'plain main'
+kill -INT "$RUN_PID"; wait "$RUN_PID" || true; RUN_PID=
+echo "RunHotReloadContractTest passed"
@@ -0,0 +1,32 @@
+#!/usr/bin/env bash
+# `vix run --timings[=json]` reports startup stages on stderr and leaves the
+# program's stdout untouched. A warm run must reach exec without compiling.
+set -euo pipefail
+VIX_BIN="${1:-/vixcpp/vix/modules/cli/build-ninja/vix}"
+ROOT="$(mktemp -d)"; trap 'rm -rf "$ROOT"' EXIT
+export HOME="$ROOT/home"; mkdir -p "$HOME"
+fail() { echo "RunTimingsContractTest: $*" >&2; exit 1; }
+grep -Fq -- '--timings' <<<"$("$VIX_BIN" run --help)" || fail "--timings missing from help"
+cat >"$ROOT/hello.cpp" <<'CPP'
+#include <iostream>
+int main() { std::cout << "hello timings\n"; }
+CPP
+"$VIX_BIN" run "$ROOT/hello.cpp" --no-san --timings=json >"$ROOT/cold.out" 2>"$ROOT/cold.err" || fail "cold run failed"
+grep -Fxq 'hello timings' "$ROOT/cold.out" || fail "program stdout changed"
+cold="$(grep -F '"vix_run_timings":1' "$ROOT/cold.err")" || fail "missing json report"
+for stage in args prepare probe fingerprint cache_validation compile_link exec; do
+  grep -Fq "\"name\":\"$stage\"" <<<"$cold" || fail "cold run missing stage $stage"
+done
+grep -Eq '"time_to_exec_ms":[0-9]' <<<"$cold" || fail "missing time_to_exec_ms"
+"$VIX_BIN" run "$ROOT/hello.cpp" --no-san --timings=json >/dev/null 2>"$ROOT/warm.err" || fail "warm run failed"
+warm="$(grep -F '"vix_run_timings":1' "$ROOT/warm.err")" || fail "missing warm json report"
+grep -Fq '"name":"exec"' <<<"$warm" || fail "warm run missing exec"
+! grep -Fq '"name":"compile_link"' <<<"$warm" || fail "warm run recompiled"
+text="$("$VIX_BIN" run "$ROOT/hello.cpp" --no-san --timings 2>&1 >/dev/null)"
+grep -Fq 'time to exec' <<<"$text" || fail "missing text report"
+set +e
+"$VIX_BIN" run "$ROOT/hello.cpp" --timings=yaml >/dev/null 2>&1
+rc=$?
+set -e
+[[ "$rc" -eq 2 ]] || fail "invalid --timings value should exit 2, got $rc"
+echo "RunTimingsContractTest passed"